@@ -125,6 +125,7 @@ ATCA_STATUS kit_host_init(
         ctx->iface_count = iface_count;
         ctx->phy = phy;
         ctx->flags = (uint32_t)flags;
+        ctx->binary_mode = false;
         ret = ATCA_SUCCESS;
     }
     return ret;
@@ -199,6 +200,25 @@ size_t kit_host_format_response(uint8_t* response, size_t rlen, ATCA_STATUS stat
     return ret;
 }
 
+/** \brief Format the status and data in the framing negotiated with the host */
+static size_t kit_host_format(ascii_kit_host_context_t* ctx, uint8_t* response, size_t rlen, ATCA_STATUS status, uint8_t* data, size_t dlen)
+{
+    size_t ret = rlen;
+
+    if (ctx->binary_mode)
+    {
+        if (ATCA_SUCCESS != kit_wrap_frame((uint8_t)status, data, dlen, response, &ret))
+        {
+            ret = 0;
+        }
+    }
+    else
+    {
+        ret = kit_host_format_response(response, rlen, status, data, dlen);
+    }
+    return ret;
+}
+
 /** \brief Iterate through a command list to match the given command and then will execute it */
 ATCA_STATUS kit_host_process_cmd(
     ascii_kit_host_context_t* ctx,
@@ -235,15 +255,15 @@ static ATCA_STATUS kit_host_ca_wake(ascii_kit_host_context_t* ctx, int argc, cha
         status = calib_wakeup(ctx->device);
         if (ATCA_SUCCESS == status)
         {
-            *rlen = kit_host_format_response(response, *rlen, status, (uint8_t*)expected_response, sizeof(expected_response));
+            *rlen = kit_host_format(ctx, response, *rlen, status, (uint8_t*)expected_response, sizeof(expected_response));
         }
         else if (ATCA_STATUS_SELFTEST_ERROR == status)
         {
-            *rlen = kit_host_format_response(response, *rlen, status, (uint8_t*)selftest_fail_resp, sizeof(selftest_fail_resp));
+            *rlen = kit_host_format(ctx, response, *rlen, status, (uint8_t*)selftest_fail_resp, sizeof(selftest_fail_resp));
         }
         else
         {
-            *rlen = kit_host_format_response(response, *rlen, status, NULL, 0);
+            *rlen = kit_host_format(ctx, response, *rlen, status, NULL, 0);
         }
     }
     return status;
@@ -275,6 +295,22 @@ static ATCA_STATUS kit_host_ca_sleep(ascii_kit_host_context_t* ctx, int argc, ch
     return status;
 }
 
+/** \brief Run a command packet and format the device response */
+static ATCA_STATUS kit_host_ca_execute(ascii_kit_host_context_t* ctx, ATCAPacket* packet, uint8_t* response, size_t* rlen)
+{
+    ATCA_STATUS status;
+
+    if (ATCA_SUCCESS == (status = calib_execute_command(packet, ctx->device)))
+    {
+        *rlen = kit_host_format(ctx, response, *rlen, status, (uint8_t*)&packet->data, packet->data[0]);
+    }
+    else
+    {
+        *rlen = kit_host_format(ctx, response, *rlen, status, NULL, 0);
+    }
+    return status;
+}
+
 static ATCA_STATUS kit_host_ca_talk(ascii_kit_host_context_t* ctx, int argc, char* argv[], uint8_t* response, size_t* rlen)
 {
     ATCA_STATUS status = ATCA_BAD_PARAM;
@@ -289,20 +325,34 @@ static ATCA_STATUS kit_host_ca_talk(ascii_kit_host_context_t* ctx, int argc, cha
         size_t plen = sizeof(packet) - 2;
 
         atcab_hex2bin(argv[0], strlen(argv[0]), (uint8_t*)&packet.txsize, &plen);
-        if (ATCA_SUCCESS == (status = calib_execute_command(&packet, ctx->device)))
-        {
-            *rlen = kit_host_format_response(response, *rlen, status, (uint8_t*)&packet.data, packet.data[0]);
-        }
-        else
-        {
-            *rlen = kit_host_format_response(response, *rlen, status, NULL, 0);
-        }
+        status = kit_host_ca_execute(ctx, &packet, response, rlen);
 #ifdef __XC8          
         (void)memset(&packet, 0, sizeof(ATCAPacket));
 #endif        
     }
     return status;
 }
+
+/** \brief Run a command packet carried in a binary frame */
+static ATCA_STATUS kit_host_ca_talk_frame(ascii_kit_host_context_t* ctx, const uint8_t* data, size_t dlen, uint8_t* response, size_t* rlen)
+{
+    ATCA_STATUS status = ATCA_BAD_PARAM;
+#ifdef __XC8        
+    static ATCAPacket packet;
+#else
+    ATCAPacket packet;
+#endif                
+
+    if (dlen && (dlen <= sizeof(packet) - 2))
+    {
+        memcpy((uint8_t*)&packet.txsize, data, dlen);
+        status = kit_host_ca_execute(ctx, &packet, response, rlen);
+    }
+#ifdef __XC8          
+    (void)memset(&packet, 0, sizeof(ATCAPacket));
+#endif        
+    return status;
+}
 #endif
 
 static ATCA_STATUS kit_host_ca_select(ascii_kit_host_context_t* ctx, int argc, char* argv[], uint8_t* response, size_t* rlen)
@@ -591,11 +641,25 @@ static ATCA_STATUS kit_host_board_get_device(ascii_kit_host_context_t* ctx, int
     return status;
 }
 
+/** \brief Switch to binary framing once this response has been sent */
+static ATCA_STATUS kit_host_board_binary(ascii_kit_host_context_t* ctx, int argc, char* argv[], uint8_t* response, size_t* rlen)
+{
+    ATCA_STATUS status = ATCA_UNIMPLEMENTED;
+
+    if ((argc > 0) && (KIT_FRAME_VERSION == strtol(argv[0], NULL, 16)))
+    {
+        *rlen = kit_host_format_response(response, *rlen, ATCA_SUCCESS, NULL, 0);
+        ctx->binary_mode = true;
+        status = ATCA_SUCCESS;
+    }
+    return status;
+}
 
 static kit_host_map_entry_t kit_host_board_map[] = {
     { "version",  kit_host_board_get_version  },
     { "firmware", kit_host_board_get_firmware },
     { "device",   kit_host_board_get_device   },
+    { "binary",   kit_host_board_binary       },
     { NULL,       NULL                        }
 };
 
@@ -669,6 +733,50 @@ ATCA_STATUS kit_host_process_line(
     return status;
 }
 
+/** \brief Process a binary kit frame. Frames carry the same wake, idle,
+ *  sleep and talk operations as the ascii "d:w()" style commands */
+ATCA_STATUS kit_host_process_frame(
+    ascii_kit_host_context_t* ctx,      /**< Kit protocol parser context */
+    uint8_t *                 frame,    /**< Received frame */
+    size_t                    flen,     /**< Size of the received frame */
+    uint8_t*                  response, /**< Response frame is returned here */
+    size_t*                   rlen      /**< As input the size of the response buffer, as output the response size */
+    )
+{
+    ATCA_STATUS status = ATCA_BAD_PARAM;
+    uint8_t code;
+    const uint8_t* data;
+    size_t dlen;
+
+    if (ctx && frame && response && rlen)
+    {
+        if (ATCA_SUCCESS == (status = kit_parse_frame(frame, flen, &code, &data, &dlen)))
+        {
+            switch (code)
+            {
+#if ATCA_CA_SUPPORT
+            case KIT_FRAME_WAKE:
+                status = kit_host_ca_wake(ctx, 0, NULL, response, rlen);
+                break;
+            case KIT_FRAME_IDLE:
+                status = kit_host_ca_idle(ctx, 0, NULL, response, rlen);
+                break;
+            case KIT_FRAME_SLEEP:
+                status = kit_host_ca_sleep(ctx, 0, NULL, response, rlen);
+                break;
+            case KIT_FRAME_TALK:
+                status = kit_host_ca_talk_frame(ctx, data, dlen, response, rlen);
+                break;
+#endif
+            default:
+                status = ATCA_UNIMPLEMENTED;
+                break;
+            }
+        }
+    }
+    return status;
+}
+
 /** \brief Non returning kit protocol runner using the configured physical interface
    that was provided when the context was initialized */
 void kit_host_task(ascii_kit_host_context_t* ctx)
@@ -676,13 +784,47 @@ void kit_host_task(ascii_kit_host_context_t* ctx)
     uint8_t* ptr = ctx->buffer;
     uint16_t rxlen = 1;
     size_t txlen;
+    size_t flen;
     ATCA_STATUS status;
 
     for (;; )
     {
         if (ATCA_SUCCESS == ctx->phy->recv((void*)ctx->phy, ptr, &rxlen))
         {
-            if (KIT_MESSAGE_DELIMITER == *ptr++)
+            if ((ptr == ctx->buffer) && (KIT_FRAME_SYNC != *ptr))
+            {
+                /* An ascii line means the host started over */
+                ctx->binary_mode = false;
+            }
+
+            if (ctx->binary_mode)
+            {
+                ptr++;
+                if (KIT_FRAME_HEADER_SIZE <= (size_t)(ptr - ctx->buffer))
+                {
+                    flen = kit_frame_size(ctx->buffer);
+                    if (flen > sizeof(ctx->buffer))
+                    {
+                        /* Can not be held - resynchronize on the next frame */
+                        ptr = ctx->buffer;
+                    }
+                    else if (flen == (size_t)(ptr - ctx->buffer))
+                    {
+                        txlen = sizeof(ctx->buffer);
+                        status = kit_host_process_frame(ctx, ctx->buffer, flen, ctx->buffer, &txlen);
+
+                        if ((ATCA_SUCCESS != status) || !txlen)
+                        {
+                            txlen = sizeof(ctx->buffer);
+                            (void)kit_wrap_frame((uint8_t)status, NULL, 0, ctx->buffer, &txlen);
+                        }
+                        ctx->phy->send((void*)ctx->phy, ctx->buffer, txlen);
+
+                        ptr = ctx->buffer;
+                    }
+                }
+            }
+            else if (KIT_MESSAGE_DELIMITER == *ptr++)
             {
                 txlen = sizeof(ctx->buffer);
                 status = kit_host_process_line(ctx, ctx->buffer, ptr - ctx->buffer, ctx->buffer, &txlen);
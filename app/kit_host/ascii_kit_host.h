@@ -71,6 +71,7 @@ typedef struct _ascii_kit_host_context
     ATCAIfaceCfg**            iface;
     size_t                    iface_count;
     uint32_t                  flags;
+    bool                      binary_mode; /**< Binary framing was negotiated with "board:binary()" */
 } ascii_kit_host_context_t;
 
 /** Used to create command tables for the kit host parser */
@@ -94,6 +95,8 @@ ATCA_STATUS kit_host_process_cmd(ascii_kit_host_context_t* ctx, const kit_host_m
 /* Kit Protocol Runners */
 ATCA_STATUS kit_host_process_line(ascii_kit_host_context_t* ctx, uint8_t * input_line,
                                   size_t ilen, uint8_t* response, size_t* rlen);
+ATCA_STATUS kit_host_process_frame(ascii_kit_host_context_t* ctx, uint8_t * frame,
+                                   size_t flen, uint8_t* response, size_t* rlen);
 
 void kit_host_task(ascii_kit_host_context_t* ctx);
 
@@ -365,6 +365,130 @@ ATCA_STATUS atcab_sleep(void)
     return status;
 }
 
+#if ATCA_KEEP_AWAKE_EN
+/** \brief Begin a session in which the device is kept awake between commands
+ *  \param[in] device  Device context
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_session_begin_ext(ATCADevice device)
+{
+    ATCA_STATUS status = ATCA_UNIMPLEMENTED;
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
+
+    if (atcab_is_ca_device(dev_type) || atcab_is_ca2_device(dev_type))
+    {
+#if ATCA_CA_SUPPORT
+        status = calib_session_begin(device);
+#endif
+    }
+    else if (atcab_is_ta_device(dev_type))
+    {
+#if ATCA_TA_SUPPORT
+        status = ATCA_SUCCESS;
+#endif
+    }
+    else
+    {
+        status = ATCA_NOT_INITIALIZED;
+    }
+    return status;
+}
+
+/** \brief Begin a session in which the device is kept awake between commands
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_session_begin(void)
+{
+    return atcab_session_begin_ext(atcab_get_device());
+}
+
+/** \brief End a keep awake session and idle the device
+ *  \param[in] device  Device context
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_session_end_ext(ATCADevice device)
+{
+    ATCA_STATUS status = ATCA_UNIMPLEMENTED;
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
+
+    if (atcab_is_ca_device(dev_type) || atcab_is_ca2_device(dev_type))
+    {
+#if ATCA_CA_SUPPORT
+        status = calib_session_end(device);
+#endif
+    }
+    else if (atcab_is_ta_device(dev_type))
+    {
+#if ATCA_TA_SUPPORT
+        status = ATCA_SUCCESS;
+#endif
+    }
+    else
+    {
+        status = ATCA_NOT_INITIALIZED;
+    }
+    return status;
+}
+
+/** \brief End a keep awake session and idle the device
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_session_end(void)
+{
+    return atcab_session_end_ext(atcab_get_device());
+}
+#endif
+
+#if ATCA_ASYNC_EN && ATCA_CA_SUPPORT
+/** \brief Initialize a handle for non-blocking operations
+ *  \param[out] ctx  Handle to initialize
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_async_init(calib_async_t* ctx)
+{
+    return calib_async_init(ctx);
+}
+
+/** \brief Release the resources held by a non-blocking operation handle
+ *  \param[in] ctx  Handle to release
+ */
+void atcab_async_release(calib_async_t* ctx)
+{
+    calib_async_release(ctx);
+}
+
+/** \brief Advance a non-blocking operation without waiting on the device
+ *  \param[in,out] ctx  Handle of a started operation
+ *  \return ATCA_RX_NO_RESPONSE while the operation is in progress, otherwise
+ *          the result of the operation.
+ */
+ATCA_STATUS atcab_async_poll(calib_async_t* ctx)
+{
+    return calib_async_poll(ctx);
+}
+
+/** \brief Time until the next poll of a non-blocking operation is useful
+ *  \param[in] ctx  Handle of a started operation
+ *  \return Milliseconds to wait before the next poll
+ */
+uint32_t atcab_async_wait_time(const calib_async_t* ctx)
+{
+    return calib_async_wait_time(ctx);
+}
+
+#if ATCA_HAL_TIMER_FD_EN
+/** \brief Get a descriptor that becomes readable when the operation should be
+ *          polled next
+ *  \param[in] ctx  Handle of the operation
+ *  \return Descriptor on success, -1 on failure
+ */
+int atcab_async_get_fd(calib_async_t* ctx)
+{
+    return calib_async_get_fd(ctx);
+}
+#endif
+#endif
+
 /** \brief Gets the size of the specified zone in bytes.
  *
  * \param[in]  device Device context
@@ -1195,20 +1319,38 @@ ATCA_STATUS atcab_ecdh_base(uint8_t mode, uint16_t key_id, const uint8_t* public
  *  \return ATCA_SUCCESS on success
  */
 ATCA_STATUS atcab_ecdh(uint16_t key_id, const uint8_t* public_key, uint8_t* pms)
+{
+    return atcab_ecdh_ext(g_atcab_device_ptr, key_id, public_key, pms);
+}
+
+/** \brief ECDH command with a private key in a slot and the premaster secret
+ *         is returned in the clear.
+ *
+ *  \param[in] device     Device context pointer
+ *  \param[in] key_id     Slot of private key for ECDH computation
+ *  \param[in] public_key Public key input to ECDH calculation. X and Y
+ *                        integers in big-endian format. 64 bytes for P256
+ *                        key.
+ *  \param[out] pms       Computed ECDH premaster secret is returned here.
+ *                        32 bytes.
+ *
+ *  \return ATCA_SUCCESS on success
+ */
+ATCA_STATUS atcab_ecdh_ext(ATCADevice device, uint16_t key_id, const uint8_t* public_key, uint8_t* pms)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type) || atcab_is_ca2_device(dev_type))
     {
 #if ATCA_ECC_SUPPORT
-        status = calib_ecdh(g_atcab_device_ptr, key_id, public_key, pms);
+        status = calib_ecdh(device, key_id, public_key, pms);
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
     {
 #if ATCA_TA_SUPPORT
-        status = talib_ecdh_compat(g_atcab_device_ptr, key_id, public_key, pms);
+        status = talib_ecdh_compat(device, key_id, public_key, pms);
 #endif
     }
     else
@@ -2458,6 +2600,48 @@ ATCA_STATUS atcab_random(uint8_t* rand_out)
 {
     return atcab_random_ext(g_atcab_device_ptr, rand_out);
 }
+
+#if ATCA_ASYNC_EN && ATCA_CA_SUPPORT
+/** \brief Starts a Random command without waiting for it to complete
+ *
+ * \param[in]     device    Device context pointer
+ * \param[in,out] ctx       Initialized handle that is not in use
+ * \param[out]    rand_out  32 bytes of random data is returned here once the
+ *                          operation completes.
+ *
+ * \return ATCA_SUCCESS if the command was started, otherwise an error code.
+ */
+ATCA_STATUS atcab_random_async_ext(ATCADevice device, calib_async_t* ctx, uint8_t* rand_out)
+{
+    ATCA_STATUS status = ATCA_UNIMPLEMENTED;
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
+
+    if (atcab_is_ca_device(dev_type))
+    {
+#if CALIB_RANDOM_EN
+        status = calib_random_async(device, ctx, rand_out);
+#endif
+    }
+    else if (!atcab_is_ta_device(dev_type))
+    {
+        status = ATCA_NOT_INITIALIZED;
+    }
+    return status;
+}
+
+/** \brief Starts a Random command without waiting for it to complete
+ *
+ * \param[in,out] ctx       Initialized handle that is not in use
+ * \param[out]    rand_out  32 bytes of random data is returned here once the
+ *                          operation completes.
+ *
+ * \return ATCA_SUCCESS if the command was started, otherwise an error code.
+ */
+ATCA_STATUS atcab_random_async(calib_async_t* ctx, uint8_t* rand_out)
+{
+    return atcab_random_async_ext(g_atcab_device_ptr, ctx, rand_out);
+}
+#endif
 #endif /* ATCAB_RANDOM_EN */
 
 // Read command functions
@@ -3402,20 +3586,34 @@ ATCA_STATUS atcab_sha_write_context(const uint8_t* context, uint16_t context_siz
  *  \return ATCA_SUCCESS on success, otherwise an error code.
  */
 ATCA_STATUS atcab_sha(uint16_t length, const uint8_t* message, uint8_t* digest)
+{
+    return atcab_sha_ext(g_atcab_device_ptr, length, message, digest);
+}
+
+/** \brief Use the SHA command to compute a SHA-256 digest.
+ *
+ * \param[in]  device   Device context pointer
+ * \param[in]  length   Size of message parameter in bytes.
+ * \param[in]  message  Message data to be hashed.
+ * \param[out] digest   Digest is returned here (32 bytes).
+ *
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_sha_ext(ATCADevice device, uint16_t length, const uint8_t* message, uint8_t* digest)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type) || atcab_is_ca2_device(dev_type))
     {
 #if ATCA_CA_SUPPORT
-        status = calib_sha(g_atcab_device_ptr, length, message, digest);
+        status = calib_sha(device, length, message, digest);
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
     {
 #if ATCA_TA_SUPPORT
-        status = talib_sha_compat(g_atcab_device_ptr, length, message, digest);
+        status = talib_sha_compat(device, length, message, digest);
 #endif
     }
     else
@@ -3810,6 +4008,58 @@ ATCA_STATUS atcab_sign(uint16_t key_id, const uint8_t* msg, uint8_t* signature)
 {
     return atcab_sign_ext(g_atcab_device_ptr, key_id, msg, signature);
 }
+
+#if ATCA_ASYNC_EN && ATCA_CA_SUPPORT
+/** \brief Starts signing a 32-byte external message without waiting for the
+ *          commands to complete
+ *
+ *  \param[in]     device     Device context pointer
+ *  \param[in,out] ctx        Initialized handle that is not in use
+ *  \param[in]     key_id     Slot of the private key to be used to sign the
+ *                            message.
+ *  \param[in]     msg        32-byte message to be signed. Must remain valid
+ *                            until the operation completes.
+ *  \param[out]    signature  Signature is returned here once the operation
+ *                            completes.
+ *
+ * \return ATCA_SUCCESS if the operation was started, otherwise an error code.
+ */
+ATCA_STATUS atcab_sign_async_ext(ATCADevice device, calib_async_t* ctx, uint16_t key_id, const uint8_t* msg, uint8_t* signature)
+{
+    ATCA_STATUS status = ATCA_UNIMPLEMENTED;
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
+
+    if (atcab_is_ca_device(dev_type))
+    {
+#if CALIB_SIGN_EN
+        status = calib_sign_async(device, ctx, key_id, msg, signature);
+#endif
+    }
+    else if (!atcab_is_ca2_device(dev_type) && !atcab_is_ta_device(dev_type))
+    {
+        status = ATCA_NOT_INITIALIZED;
+    }
+    return status;
+}
+
+/** \brief Starts signing a 32-byte external message without waiting for the
+ *          commands to complete
+ *
+ *  \param[in,out] ctx        Initialized handle that is not in use
+ *  \param[in]     key_id     Slot of the private key to be used to sign the
+ *                            message.
+ *  \param[in]     msg        32-byte message to be signed. Must remain valid
+ *                            until the operation completes.
+ *  \param[out]    signature  Signature is returned here once the operation
+ *                            completes.
+ *
+ * \return ATCA_SUCCESS if the operation was started, otherwise an error code.
+ */
+ATCA_STATUS atcab_sign_async(calib_async_t* ctx, uint16_t key_id, const uint8_t* msg, uint8_t* signature)
+{
+    return atcab_sign_async_ext(g_atcab_device_ptr, ctx, key_id, msg, signature);
+}
+#endif
 #endif
 
 #if ATCAB_SIGN_INTERNAL_EN && defined(ATCA_USE_ATCAB_FUNCTIONS)
@@ -4011,6 +4261,57 @@ ATCA_STATUS atcab_verify_extern(const uint8_t* message, const uint8_t* signature
 {
     return atcab_verify_extern_ext(g_atcab_device_ptr, message, signature, public_key, is_verified);
 }
+
+#if ATCA_ASYNC_EN && ATCA_CA_SUPPORT
+/** \brief Starts verifying a signature with an external public key without
+ *          waiting for the commands to complete. All inputs must remain valid
+ *          until the operation completes.
+ *
+ * \param[in]     device       Device context pointer
+ * \param[in,out] ctx          Initialized handle that is not in use
+ * \param[in]     message      32 byte message to be verified.
+ * \param[in]     signature    Signature to be verified (R and S, 64 bytes).
+ * \param[in]     public_key   Public key to verify with (X and Y, 64 bytes).
+ * \param[out]    is_verified  Verification result once the operation completes.
+ *
+ * \return ATCA_SUCCESS if the operation was started, otherwise an error code.
+ */
+ATCA_STATUS atcab_verify_extern_async_ext(ATCADevice device, calib_async_t* ctx, const uint8_t* message, const uint8_t* signature,
+                                          const uint8_t* public_key, bool* is_verified)
+{
+    ATCA_STATUS status = ATCA_UNIMPLEMENTED;
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
+
+    if (atcab_is_ca_device(dev_type))
+    {
+#if CALIB_VERIFY_EXTERN_EN
+        status = calib_verify_extern_async(device, ctx, message, signature, public_key, is_verified);
+#endif
+    }
+    else if (!atcab_is_ta_device(dev_type))
+    {
+        status = ATCA_NOT_INITIALIZED;
+    }
+    return status;
+}
+
+/** \brief Starts verifying a signature with an external public key without
+ *          waiting for the commands to complete. All inputs must remain valid
+ *          until the operation completes.
+ *
+ * \param[in,out] ctx          Initialized handle that is not in use
+ * \param[in]     message      32 byte message to be verified.
+ * \param[in]     signature    Signature to be verified (R and S, 64 bytes).
+ * \param[in]     public_key   Public key to verify with (X and Y, 64 bytes).
+ * \param[out]    is_verified  Verification result once the operation completes.
+ *
+ * \return ATCA_SUCCESS if the operation was started, otherwise an error code.
+ */
+ATCA_STATUS atcab_verify_extern_async(calib_async_t* ctx, const uint8_t* message, const uint8_t* signature, const uint8_t* public_key, bool* is_verified)
+{
+    return atcab_verify_extern_async_ext(g_atcab_device_ptr, ctx, message, signature, public_key, is_verified);
+}
+#endif
 #endif /* ATCAB_VERIFY_EXTERN */
 
 #if ATCAB_VERIFY_MAC_EN && defined(ATCA_USE_ATCAB_FUNCTIONS)
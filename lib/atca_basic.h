@@ -72,6 +72,16 @@ bool atcab_is_ta_device(ATCADeviceType dev_type);
 
 // Hardware Accelerated algorithms
 #if ATCAB_PBKDF2_SHA256_EN
+/** \brief Progress of a device PBKDF2 derivation - done of the iter
+ *         iterations of output block block (0 based) are complete
+ */
+typedef void (*atcab_pbkdf2_progress_cb)(void* user_data, size_t block, uint32_t done, uint32_t iter);
+
+ATCA_STATUS atcab_pbkdf2_sha256_block(ATCADevice device, const uint32_t iter, const uint16_t slot, const uint8_t* message,
+                                      const size_t message_len, uint8_t* digest);
+ATCA_STATUS atcab_pbkdf2_sha256_progress(ATCADevice device, const uint32_t iter, const uint16_t slot, const uint8_t* salt,
+                                         const size_t salt_len, uint8_t* result, size_t result_len,
+                                         atcab_pbkdf2_progress_cb progress, void* user_data);
 ATCA_STATUS atcab_pbkdf2_sha256_ext(ATCADevice device, const uint32_t iter, const uint16_t slot, const uint8_t* salt, const size_t salt_len, uint8_t* result,
                                     size_t result_len);
 ATCA_STATUS atcab_pbkdf2_sha256(const uint32_t iter, const uint16_t slot, const uint8_t* salt, const size_t salt_len, uint8_t* result, size_t result_len);
@@ -83,6 +93,21 @@ ATCA_STATUS atcab_pbkdf2_sha256(const uint32_t iter, const uint16_t slot, const
 ATCA_STATUS atcab_wakeup(void);
 ATCA_STATUS atcab_idle(void);
 ATCA_STATUS atcab_sleep(void);
+#if ATCA_KEEP_AWAKE_EN
+ATCA_STATUS atcab_session_begin(void);
+ATCA_STATUS atcab_session_begin_ext(ATCADevice device);
+ATCA_STATUS atcab_session_end(void);
+ATCA_STATUS atcab_session_end_ext(ATCADevice device);
+#endif
+#if ATCA_ASYNC_EN && ATCA_CA_SUPPORT
+ATCA_STATUS atcab_async_init(calib_async_t* ctx);
+void atcab_async_release(calib_async_t* ctx);
+ATCA_STATUS atcab_async_poll(calib_async_t* ctx);
+uint32_t atcab_async_wait_time(const calib_async_t* ctx);
+#if ATCA_HAL_TIMER_FD_EN
+int atcab_async_get_fd(calib_async_t* ctx);
+#endif
+#endif
 //ATCA_STATUS atcab_get_addr(uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, uint16_t* addr);
 ATCA_STATUS atcab_get_zone_size(uint8_t zone, uint16_t slot, size_t* size);
 ATCA_STATUS atcab_get_zone_size_ext(ATCADevice device, uint8_t zone, uint16_t slot, size_t* size);
@@ -131,6 +156,7 @@ ATCA_STATUS atcab_derivekey_ext(ATCADevice device, uint8_t mode, uint16_t key_id
 /* ECDH command */
 ATCA_STATUS atcab_ecdh_base(uint8_t mode, uint16_t key_id, const uint8_t* public_key, uint8_t* pms, uint8_t* out_nonce);
 ATCA_STATUS atcab_ecdh(uint16_t key_id, const uint8_t* public_key, uint8_t* pms);
+ATCA_STATUS atcab_ecdh_ext(ATCADevice device, uint16_t key_id, const uint8_t* public_key, uint8_t* pms);
 
 #if defined(ATCA_USE_CONSTANT_HOST_NONCE)
 ATCA_STATUS atcab_ecdh_enc(uint16_t key_id, const uint8_t* public_key, uint8_t* pms, const uint8_t* read_key, uint16_t read_key_id);
@@ -205,6 +231,10 @@ ATCA_STATUS atcab_priv_write(uint16_t key_id, const uint8_t priv_key[36], uint16
 // Random command functions
 ATCA_STATUS atcab_random(uint8_t* rand_out);
 ATCA_STATUS atcab_random_ext(ATCADevice device, uint8_t* rand_out);
+#if ATCA_ASYNC_EN && ATCA_CA_SUPPORT
+ATCA_STATUS atcab_random_async(calib_async_t* ctx, uint8_t* rand_out);
+ATCA_STATUS atcab_random_async_ext(ATCADevice device, calib_async_t* ctx, uint8_t* rand_out);
+#endif
 
 // Read command functions
 ATCA_STATUS atcab_read_zone(uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, uint8_t* data, uint8_t len);
@@ -253,6 +283,7 @@ ATCA_STATUS atcab_sha_end(uint8_t* digest, uint16_t length, const uint8_t* messa
 ATCA_STATUS atcab_sha_read_context(uint8_t* context, uint16_t* context_size);
 ATCA_STATUS atcab_sha_write_context(const uint8_t* context, uint16_t context_size);
 ATCA_STATUS atcab_sha(uint16_t length, const uint8_t* message, uint8_t* digest);
+ATCA_STATUS atcab_sha_ext(ATCADevice device, uint16_t length, const uint8_t* message, uint8_t* digest);
 ATCA_STATUS atcab_hw_sha2_256(const uint8_t* data, size_t data_size, uint8_t* digest);
 
 ATCA_STATUS atcab_hw_sha2_256_init(atca_sha256_ctx_t* ctx);
@@ -269,6 +300,10 @@ ATCA_STATUS atcab_sha_hmac_ext(ATCADevice device, const uint8_t* data, size_t da
 ATCA_STATUS atcab_sign_base(uint8_t mode, uint16_t key_id, uint8_t* signature);
 ATCA_STATUS atcab_sign(uint16_t key_id, const uint8_t* msg, uint8_t* signature);
 ATCA_STATUS atcab_sign_ext(ATCADevice device, uint16_t key_id, const uint8_t* msg, uint8_t* signature);
+#if ATCA_ASYNC_EN && ATCA_CA_SUPPORT
+ATCA_STATUS atcab_sign_async(calib_async_t* ctx, uint16_t key_id, const uint8_t* msg, uint8_t* signature);
+ATCA_STATUS atcab_sign_async_ext(ATCADevice device, calib_async_t* ctx, uint16_t key_id, const uint8_t* msg, uint8_t* signature);
+#endif
 ATCA_STATUS atcab_sign_internal(uint16_t key_id, bool is_invalidate, bool is_full_sn, uint8_t* signature);
 
 /* UpdateExtra command */
@@ -278,6 +313,11 @@ ATCA_STATUS atcab_updateextra(uint8_t mode, uint16_t new_value);
 ATCA_STATUS atcab_verify(uint8_t mode, uint16_t key_id, const uint8_t* signature, const uint8_t* public_key, const uint8_t* other_data, uint8_t* mac);
 ATCA_STATUS atcab_verify_extern(const uint8_t* message, const uint8_t* signature, const uint8_t* public_key, bool* is_verified);
 ATCA_STATUS atcab_verify_extern_ext(ATCADevice device, const uint8_t* message, const uint8_t* signature, const uint8_t* public_key, bool* is_verified);
+#if ATCA_ASYNC_EN && ATCA_CA_SUPPORT
+ATCA_STATUS atcab_verify_extern_async(calib_async_t* ctx, const uint8_t* message, const uint8_t* signature, const uint8_t* public_key, bool* is_verified);
+ATCA_STATUS atcab_verify_extern_async_ext(ATCADevice device, calib_async_t* ctx, const uint8_t* message, const uint8_t* signature,
+                                          const uint8_t* public_key, bool* is_verified);
+#endif
 ATCA_STATUS atcab_verify_extern_mac(const uint8_t* message, const uint8_t* signature, const uint8_t* public_key, const uint8_t* num_in, const uint8_t* io_key,
                                     bool* is_verified);
 ATCA_STATUS atcab_verify_stored(const uint8_t* message, const uint8_t* signature, uint16_t key_id, bool* is_verified);
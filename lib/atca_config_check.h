@@ -137,6 +137,133 @@
 #define MULTIPART_BUF_EN        (DEFAULT_DISABLED)
 #endif
 
+/** \def ATCA_ADAPTIVE_POLL_EN
+ * Enables learning of the command execution times per device and opcode so the
+ * polling schedule can be derived from them rather than from fixed intervals
+ */
+#ifndef ATCA_ADAPTIVE_POLL_EN
+#define ATCA_ADAPTIVE_POLL_EN   (DEFAULT_DISABLED)
+#endif
+
+/** \def ATCA_ADAPTIVE_POLL_ENTRIES
+ * Number of opcodes for which execution time estimates are kept per device
+ */
+#if ATCA_ADAPTIVE_POLL_EN && !defined(ATCA_ADAPTIVE_POLL_ENTRIES)
+#define ATCA_ADAPTIVE_POLL_ENTRIES  (8u)
+#endif
+
+/** \def ATCA_KEEP_AWAKE_EN
+ * Enables keep awake sessions which leave the device active between commands
+ * rather than idling it after every command
+ */
+#ifndef ATCA_KEEP_AWAKE_EN
+#define ATCA_KEEP_AWAKE_EN      (DEFAULT_ENABLED)
+#endif
+
+/** \def ATCA_KEEP_AWAKE_BUDGET_MSEC
+ * Time a device may be kept awake before it is cycled through idle to restart
+ * its watchdog. Default leaves margin below the minimum short watchdog period
+ * (nominally 1.3s) for bus transfers. Devices configured for the long watchdog
+ * may raise this.
+ */
+#if ATCA_KEEP_AWAKE_EN && !defined(ATCA_KEEP_AWAKE_BUDGET_MSEC)
+#define ATCA_KEEP_AWAKE_BUDGET_MSEC (600u)
+#endif
+
+/** \def ATCA_CONFIG_CACHE_EN
+ * Keeps a copy of a locked configuration zone in the device context so
+ * configuration and lock state queries are answered without reading the device.
+ * Configuration writes through this library update the copy in place.
+ */
+#ifndef ATCA_CONFIG_CACHE_EN
+#define ATCA_CONFIG_CACHE_EN    (DEFAULT_ENABLED)
+#endif
+
+/** \def ATCA_PUBKEY_CACHE_EN
+ * Keeps recently computed public keys in the device context so repeated
+ * GenKey public key calculations for a slot are answered without the device.
+ * Entries are dropped when the slot is changed through this library so it is
+ * only safe to enable when no other host or process writes to the device
+ */
+#ifndef ATCA_PUBKEY_CACHE_EN
+#define ATCA_PUBKEY_CACHE_EN    (DEFAULT_DISABLED)
+#endif
+
+/** \def ATCA_PUBKEY_CACHE_ENTRIES
+ * Number of public keys held per device
+ */
+#if ATCA_PUBKEY_CACHE_EN && !defined(ATCA_PUBKEY_CACHE_ENTRIES)
+#define ATCA_PUBKEY_CACHE_ENTRIES   (4u)
+#endif
+
+/** \def ATCACERT_CACHE_EN
+ * Keeps certificates rebuilt from compressed certificates in the device
+ * context. It relies on the same assumption as the public key cache so it
+ * follows ATCA_PUBKEY_CACHE_EN unless set explicitly
+ */
+#ifndef ATCACERT_CACHE_EN
+#define ATCACERT_CACHE_EN       (ATCA_PUBKEY_CACHE_EN)
+#endif
+
+/** \def ATCACERT_CACHE_ENTRIES
+ * Number of certificates held per device
+ */
+#if ATCACERT_CACHE_EN && !defined(ATCACERT_CACHE_ENTRIES)
+#define ATCACERT_CACHE_ENTRIES      (2u)
+#endif
+
+/** \def ATCACERT_CACHE_CERT_SIZE
+ * Largest certificate that will be cached
+ */
+#if ATCACERT_CACHE_EN && !defined(ATCACERT_CACHE_CERT_SIZE)
+#define ATCACERT_CACHE_CERT_SIZE    (768u)
+#endif
+
+/* Both caches are checked against the per slot generation counters */
+#define ATCA_SLOT_GENERATION_EN     (ATCA_PUBKEY_CACHE_EN || ATCACERT_CACHE_EN)
+
+/** \def ATCA_POOL_EN
+ * Enables the device pool (atca_pool_) which dispatches operations over several
+ * devices from a worker thread per bus. Requires the hal thread and semaphore
+ * interfaces
+ */
+#ifndef ATCA_POOL_EN
+#define ATCA_POOL_EN            (DEFAULT_DISABLED)
+#endif
+
+/** \def ATCA_POOL_MAX_DEVICES
+ * Maximum number of devices in a pool
+ */
+#if ATCA_POOL_EN && !defined(ATCA_POOL_MAX_DEVICES)
+#define ATCA_POOL_MAX_DEVICES   (8u)
+#endif
+
+/** \def ATCA_ASYNC_EN
+ * Enables non-blocking command execution (calib_async_) where a command is
+ * started and then polled for completion instead of waiting on the device
+ */
+#ifndef ATCA_ASYNC_EN
+#define ATCA_ASYNC_EN           (DEFAULT_DISABLED)
+#endif
+
+/** \def ATCA_BASE64_SIMD_EN
+ * Lets atcab_base64encode_ and atcab_base64decode_ use SSSE3/AVX2 (selected
+ * at runtime) or NEON for long runs of data. Only has an effect on x86 and
+ * AArch64 hosts
+ */
+#ifndef ATCA_BASE64_SIMD_EN
+#define ATCA_BASE64_SIMD_EN     (DEFAULT_ENABLED)
+#endif
+
+/** \def ATCA_SWI_UART_CHUNK_SIZE
+ * Number of bytes the SWI over UART hal sends or receives per uart transfer.
+ * Every byte takes 8 uart bytes so the hal needs 8 times this on the stack, and
+ * the uart receive has to wait long enough for a whole chunk to arrive
+ */
+#if defined(ATCA_HAL_SWI_UART) && !defined(ATCA_SWI_UART_CHUNK_SIZE)
+#define ATCA_SWI_UART_CHUNK_SIZE    (16u)
+#endif
+
 #ifndef ATCA_NO_HEAP
 #define ATCA_HEAP
 #endif
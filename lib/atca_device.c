@@ -104,6 +104,35 @@ ATCA_STATUS initATCADevice(ATCAIfaceCfg *cfg, ATCADevice ca_dev)
         return status;
     }
 
+#if ATCA_ADAPTIVE_POLL_EN
+    (void)memset(ca_dev->poll_stats, 0, sizeof(ca_dev->poll_stats));
+    ca_dev->poll_stats_next = 0;
+#endif
+
+#if ATCA_KEEP_AWAKE_EN
+    ca_dev->keep_awake = 0u;
+    ca_dev->awake_time_msec = 0u;
+    ca_dev->wait_time_msec = 0u;
+#endif
+
+#if ATCA_CONFIG_CACHE_EN
+    ca_dev->config_cache_state = 0u;
+#endif
+
+#if ATCA_PUBKEY_CACHE_EN
+    (void)memset(ca_dev->pubkey_cache, 0, sizeof(ca_dev->pubkey_cache));
+    ca_dev->pubkey_cache_next = 0u;
+#endif
+
+#if ATCACERT_CACHE_EN
+    (void)memset(ca_dev->cert_cache, 0, sizeof(ca_dev->cert_cache));
+    ca_dev->cert_cache_next = 0u;
+#endif
+
+#if ATCA_SLOT_GENERATION_EN
+    (void)memset(ca_dev->slot_generation, 0, sizeof(ca_dev->slot_generation));
+#endif
+
     return ATCA_SUCCESS;
 }
 
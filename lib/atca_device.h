@@ -30,6 +30,7 @@
 #define ATCA_DEVICE_H
 /*lint +flb */
 
+#include "atca_config_check.h"
 #include "atca_iface.h"
 /** \defgroup device ATCADevice (atca_)
    @{ */
@@ -48,6 +49,53 @@ typedef enum
     ATCA_DEVICE_STATE_ACTIVE
 } ATCADeviceState;
 
+#if ATCA_ADAPTIVE_POLL_EN
+/** \brief Execution time estimate for a single command opcode. Times are
+ *         stored in 1/16 msec units
+ */
+typedef struct
+{
+    uint8_t  opcode;            /**< Command opcode - zero if the entry is unused */
+    uint8_t  samples;           /**< Number of observations (saturates) */
+    uint16_t max_time;          /**< Maximum execution time of the opcode (msec) */
+    uint32_t avg_time;          /**< Moving average of the completion time */
+    uint32_t p90_time;          /**< Running estimate of the 90th percentile */
+} atca_poll_stats_t;
+#endif
+
+#if ATCA_PUBKEY_CACHE_EN
+/** \brief Public key computed for a slot */
+typedef struct
+{
+    uint16_t slot;              /**< Slot holding the private key */
+    uint8_t  valid;             /**< Entry holds a public key */
+    uint8_t  public_key[64];    /**< X and Y integers in big-endian format */
+} atca_pubkey_cache_t;
+#endif
+
+#if ATCA_SLOT_GENERATION_EN
+/** \brief Number of slot generation counters - data slots 0-15 plus one shared by the config and OTP zones */
+#define ATCA_SLOT_GENERATION_COUNT  (17u)
+#endif
+
+#if ATCACERT_CACHE_EN
+/** \brief Certificate rebuilt from a compressed certificate along with
+ *         everything the result depends on
+ */
+typedef struct
+{
+    const void* cert_def;                   /**< Certificate definition the certificate was built with */
+    uint8_t     serial_num[9];              /**< Device serial number */
+    uint8_t     ca_public_key[64];          /**< CA public key the certificate was built with */
+    size_t      ca_public_key_size;         /**< 0 when built without a CA public key */
+    size_t      max_cert_size;              /**< Input cert_size the certificate was built for */
+    uint32_t    slot_mask;                  /**< Generation counters the certificate was read from */
+    uint32_t    generation[ATCA_SLOT_GENERATION_COUNT];
+    size_t      cert_size;                  /**< 0 when the entry is empty */
+    uint8_t     cert[ATCACERT_CACHE_CERT_SIZE];
+} atca_cert_cache_t;
+#endif
+
 /** \brief Callback function to clean up the session context
  */
 typedef void (*ctx_cb)(void* ctx);
@@ -63,6 +111,42 @@ struct atca_device
     uint8_t  clock_divider;
     uint16_t execution_time_msec;
 
+#if ATCA_ADAPTIVE_POLL_EN
+    /* Learned execution times */
+    atca_poll_stats_t poll_stats[ATCA_ADAPTIVE_POLL_ENTRIES];
+    uint8_t           poll_stats_next;
+#endif
+
+#if ATCA_KEEP_AWAKE_EN
+    /* Keep awake session */
+    uint8_t  keep_awake;                /**< Open (nested) sessions - device is left active between commands */
+    uint32_t awake_time_msec;           /**< Time of the last wake */
+    uint32_t wait_time_msec;            /**< Total time waited on the device - used as the clock without a timestamp source */
+#endif
+
+#if ATCA_CONFIG_CACHE_EN
+    /* Configuration zone cache */
+    uint8_t config_cache[128];          /**< Copy of the configuration zone once it is locked */
+    uint8_t config_cache_state;         /**< calib_config_cache_state_t */
+#endif
+
+#if ATCA_PUBKEY_CACHE_EN
+    /* Public key cache */
+    atca_pubkey_cache_t pubkey_cache[ATCA_PUBKEY_CACHE_ENTRIES];
+    uint8_t             pubkey_cache_next;
+#endif
+
+#if ATCACERT_CACHE_EN
+    /* Certificate cache - kept per device so it is only used under the same
+       serialization as the device itself */
+    atca_cert_cache_t cert_cache[ATCACERT_CACHE_ENTRIES];
+    uint8_t           cert_cache_next;
+#endif
+
+#if ATCA_SLOT_GENERATION_EN
+    uint32_t slot_generation[ATCA_SLOT_GENERATION_COUNT];   /**< Bumped whenever the contents of a slot may have changed */
+#endif
+
     /* Session Management */
     void * session_ctx;
     ctx_cb session_cb;
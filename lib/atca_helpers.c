@@ -32,6 +32,61 @@
 #include "cryptoauthlib.h"
 #include "atca_helpers.h"
 
+#if ATCA_BASE64_SIMD_EN
+#if (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)) && \
+    (defined(__GNUC__) || defined(_MSC_VER))
+#define ATCA_B64_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define ATCA_B64_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+#if defined(ATCA_B64_X86)
+/* Vector routines are compiled for their instruction set and only called once
+   the processor has been checked for it */
+#if defined(__GNUC__)
+#define ATCA_B64_TARGET(isa)    __attribute__((target(isa)))
+#else
+#define ATCA_B64_TARGET(isa)
+#endif
+
+/* Read a cpuid leaf */
+static void atca_b64_cpuid(uint32_t leaf, uint32_t regs[4])
+{
+#if defined(_MSC_VER)
+    int r[4];
+
+    __cpuidex(r, (int)leaf, 0);
+    regs[0] = (uint32_t)r[0];
+    regs[1] = (uint32_t)r[1];
+    regs[2] = (uint32_t)r[2];
+    regs[3] = (uint32_t)r[3];
+#else
+    __cpuid_count(leaf, 0u, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+/* Register state the OS saves on context switches (XCR0) */
+static uint64_t atca_b64_xgetbv(void)
+{
+#if defined(_MSC_VER)
+    return (uint64_t)_xgetbv(0);
+#else
+    uint32_t lo;
+    uint32_t hi;
+
+    __asm__ __volatile__ ("xgetbv" : "=a" (lo), "=d" (hi) : "c" (0));
+    return ((uint64_t)hi << 32) | lo;
+#endif
+}
+#endif
 
 
 /* Ruleset:
@@ -502,7 +557,37 @@ ATCA_STATUS atcab_printbin(uint8_t* binary, size_t bin_len, bool add_space)
 // Base 64 Encode/Decode
 
 #define B64_IS_EQUAL        (64u)
-#define B64_IS_INVALID      (-1)
+#define B64_IS_BLANK        (0xFEu)
+#define B64_IS_INVALID      (0xFFu)
+
+/** \brief Base 64 characters for indexes 0 to 61, the last two are taken from the ruleset */
+static const char atca_b64_alphabet[62] = {
+    'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P',
+    'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z', 'a', 'b', 'c', 'd', 'e', 'f',
+    'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v',
+    'w', 'x', 'y', 'z', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9'
+};
+
+/** \brief Base 64 index of each character. Characters which depend on the
+ *         ruleset are marked invalid and resolved by base64Index */
+static const uint8_t atca_b64_index[256] = {
+    0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFEu, 0xFEu, 0xFFu, 0xFFu, 0xFEu, 0xFFu, 0xFFu,
+    0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu,
+    0xFEu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu,
+    0x34u, 0x35u, 0x36u, 0x37u, 0x38u, 0x39u, 0x3Au, 0x3Bu, 0x3Cu, 0x3Du, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu,
+    0xFFu, 0x00u, 0x01u, 0x02u, 0x03u, 0x04u, 0x05u, 0x06u, 0x07u, 0x08u, 0x09u, 0x0Au, 0x0Bu, 0x0Cu, 0x0Du, 0x0Eu,
+    0x0Fu, 0x10u, 0x11u, 0x12u, 0x13u, 0x14u, 0x15u, 0x16u, 0x17u, 0x18u, 0x19u, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu,
+    0xFFu, 0x1Au, 0x1Bu, 0x1Cu, 0x1Du, 0x1Eu, 0x1Fu, 0x20u, 0x21u, 0x22u, 0x23u, 0x24u, 0x25u, 0x26u, 0x27u, 0x28u,
+    0x29u, 0x2Au, 0x2Bu, 0x2Cu, 0x2Du, 0x2Eu, 0x2Fu, 0x30u, 0x31u, 0x32u, 0x33u, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu,
+    0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu,
+    0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu,
+    0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu,
+    0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu,
+    0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu,
+    0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu,
+    0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu,
+    0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu
+};
 
 /**
  * \brief Returns true if this character is a valid base 64 character or if this is space (A character can be
@@ -531,75 +616,478 @@ bool isBase64Digit(char c, const uint8_t * rules)
  * \brief Returns the base 64 index of the given character.
  * \param[in] c      character to check
  * \param[in] rules  base64 ruleset to use
- * \return the base 64 index of the given character
+ * \return the base 64 index of the given character, B64_IS_EQUAL for the pad
+ *         character, B64_IS_BLANK for blank space or B64_IS_INVALID
  */
 static uint8_t base64Index(char c, const uint8_t * rules)
 {
-    if (((int8_t)c >= (int8_t)'A') && ((int8_t)c <= (int8_t)'Z'))
+    uint8_t id = atca_b64_index[(uint8_t)c];
+
+    if (B64_IS_INVALID == id)
     {
-        return (uint8_t)c - (uint8_t)'A';
+        if ((uint8_t)c == rules[0])
+        {
+            id = 62u;
+        }
+        else if ((uint8_t)c == rules[1])
+        {
+            id = 63u;
+        }
+        else if ((uint8_t)c == rules[2])
+        {
+            id = B64_IS_EQUAL;
+        }
+        else
+        {
+            /* Not a base 64 character */
+        }
     }
-    else if (((int8_t)c >= (int8_t)'a') && ((int8_t)c <= (int8_t)'z'))
+
+    return id;
+}
+
+#if defined(ATCA_B64_X86)
+#define ATCA_B64_CAP_SSSE3      (0x01u)     //!< x86 SSSE3
+#define ATCA_B64_CAP_AVX2       (0x02u)     //!< x86 AVX2 enabled by the OS
+#define ATCA_B64_CAP_DETECTED   (0x80u)     //!< Processor features have been read
+
+static uint32_t atca_b64_caps;
+
+/** \brief Detect the processor features the vectorized base 64 routines can use */
+static uint32_t base64CpuCaps(void)
+{
+    uint32_t caps = atca_b64_caps;
+
+    if (0u == (caps & ATCA_B64_CAP_DETECTED))
     {
-        return 26u + (uint8_t)c - (uint8_t)'a';
+        uint32_t regs[4] = { 0u, 0u, 0u, 0u };
+        uint32_t max_leaf;
+        uint32_t ecx1 = 0u;
+
+        caps = ATCA_B64_CAP_DETECTED;
+
+        atca_b64_cpuid(0u, regs);
+        max_leaf = regs[0];
+
+        if (1u <= max_leaf)
+        {
+            atca_b64_cpuid(1u, regs);
+            ecx1 = regs[2];
+
+            /* SSSE3 (ecx:9) */
+            if (0u != (ecx1 & (1uL << 9)))
+            {
+                caps |= ATCA_B64_CAP_SSSE3;
+            }
+        }
+
+        if (7u <= max_leaf)
+        {
+            atca_b64_cpuid(7u, regs);
+
+            /* AVX2 (ebx:5) with OSXSAVE (ecx:27) and the OS saving the YMM state */
+            if ((0u != (regs[1] & (1uL << 5))) && (0u != (ecx1 & (1uL << 27))))
+            {
+                if (0x6u == (atca_b64_xgetbv() & 0x6u))
+                {
+                    caps |= ATCA_B64_CAP_AVX2;
+                }
+            }
+        }
+
+        atca_b64_caps = caps;
     }
-    else if (((int8_t)c >= (int8_t)'0') && ((int8_t)c <= (int8_t)'9'))
+
+    return caps;
+}
+
+/* Select a where the mask is set and b elsewhere */
+#define ATCA_B64_SEL128(m, a, b)    _mm_or_si128(_mm_and_si128((m), (a)), _mm_andnot_si128((m), (b)))
+#define ATCA_B64_SEL256(m, a, b)    _mm256_or_si256(_mm256_and_si256((m), (a)), _mm256_andnot_si256((m), (b)))
+
+/**
+ * \brief Encodes groups of 3 bytes four at a time with SSSE3. Each load reads
+ *        16 bytes of which 12 are encoded.
+ * \return Number of groups encoded
+ */
+ATCA_B64_TARGET("ssse3")
+static size_t base64EncodeSsse3(const uint8_t* data, size_t data_size, size_t groups, char* encoded, const char alphabet[64])
+{
+    const __m128i shuf = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const __m128i off62 = _mm_set1_epi8((char)((uint8_t)alphabet[62] - 62u));
+    const __m128i off63 = _mm_set1_epi8((char)((uint8_t)alphabet[63] - 63u));
+    size_t done = 0u;
+
+    while (((groups - done) >= 4u) && ((data_size - done * 3u) >= 16u))
     {
-        return 52u + (uint8_t)c - (uint8_t)'0';
+        __m128i v = _mm_loadu_si128((const __m128i*)&data[done * 3u]);
+        __m128i id;
+        __m128i off;
+
+        /* Split each 3 byte group into 4 bytes holding the 6 bit indexes */
+        v = _mm_shuffle_epi8(v, shuf);
+        id = _mm_or_si128(_mm_mulhi_epu16(_mm_and_si128(v, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040)),
+                          _mm_mullo_epi16(_mm_and_si128(v, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010)));
+
+        /* Offset from the index to the character of each range */
+        off = _mm_set1_epi8('A');
+        off = ATCA_B64_SEL128(_mm_cmpgt_epi8(id, _mm_set1_epi8(25)), _mm_set1_epi8('a' - 26), off);
+        off = ATCA_B64_SEL128(_mm_cmpgt_epi8(id, _mm_set1_epi8(51)), _mm_set1_epi8('0' - 52), off);
+        off = ATCA_B64_SEL128(_mm_cmpeq_epi8(id, _mm_set1_epi8(62)), off62, off);
+        off = ATCA_B64_SEL128(_mm_cmpeq_epi8(id, _mm_set1_epi8(63)), off63, off);
+
+        _mm_storeu_si128((__m128i*)&encoded[done * 4u], _mm_add_epi8(id, off));
+        done += 4u;
     }
-    else if ((uint8_t)c == rules[0])
+
+    return done;
+}
+
+/**
+ * \brief Encodes groups of 3 bytes eight at a time with AVX2. Each iteration
+ *        reads 28 bytes of which 24 are encoded.
+ * \return Number of groups encoded
+ */
+ATCA_B64_TARGET("avx2")
+static size_t base64EncodeAvx2(const uint8_t* data, size_t data_size, size_t groups, char* encoded, const char alphabet[64])
+{
+    const __m256i shuf = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                          1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const __m256i off62 = _mm256_set1_epi8((char)((uint8_t)alphabet[62] - 62u));
+    const __m256i off63 = _mm256_set1_epi8((char)((uint8_t)alphabet[63] - 63u));
+    size_t done = 0u;
+
+    while (((groups - done) >= 8u) && ((data_size - done * 3u) >= 28u))
     {
-        return 62u;
+        __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)&data[done * 3u])),
+                                            _mm_loadu_si128((const __m128i*)&data[done * 3u + 12u]), 1);
+        __m256i id;
+        __m256i off;
+
+        v = _mm256_shuffle_epi8(v, shuf);
+        id = _mm256_or_si256(_mm256_mulhi_epu16(_mm256_and_si256(v, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040)),
+                             _mm256_mullo_epi16(_mm256_and_si256(v, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010)));
+
+        off = _mm256_set1_epi8('A');
+        off = ATCA_B64_SEL256(_mm256_cmpgt_epi8(id, _mm256_set1_epi8(25)), _mm256_set1_epi8('a' - 26), off);
+        off = ATCA_B64_SEL256(_mm256_cmpgt_epi8(id, _mm256_set1_epi8(51)), _mm256_set1_epi8('0' - 52), off);
+        off = ATCA_B64_SEL256(_mm256_cmpeq_epi8(id, _mm256_set1_epi8(62)), off62, off);
+        off = ATCA_B64_SEL256(_mm256_cmpeq_epi8(id, _mm256_set1_epi8(63)), off63, off);
+
+        _mm256_storeu_si256((__m256i*)&encoded[done * 4u], _mm256_add_epi8(id, off));
+        done += 8u;
     }
-    else if ((uint8_t)c == rules[1])
+
+    return done;
+}
+
+/**
+ * \brief Decodes 16 characters at a time with SSSE3 until a character which
+ *        is not a base 64 digit is found. Each store writes 16 bytes of which
+ *        12 are decoded data.
+ * \return Number of characters decoded
+ */
+ATCA_B64_TARGET("ssse3")
+static size_t base64DecodeSsse3(const char* encoded, size_t encoded_size, uint8_t* data, size_t data_space, const uint8_t * rules)
+{
+    const __m128i c62 = _mm_set1_epi8((char)rules[0]);
+    const __m128i c63 = _mm_set1_epi8((char)rules[1]);
+    const __m128i off62 = _mm_set1_epi8((char)(62u - rules[0]));
+    const __m128i off63 = _mm_set1_epi8((char)(63u - rules[1]));
+    const __m128i shuf = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    size_t count = 0u;
+    size_t out = 0u;
+
+    while (((encoded_size - count) >= 16u) && ((data_space - out) >= 16u))
     {
-        return 63u;
+        __m128i c = _mm_loadu_si128((const __m128i*)&encoded[count]);
+        __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(c, _mm_set1_epi8('Z' + 1)));
+        __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(c, _mm_set1_epi8('z' + 1)));
+        __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(c, _mm_set1_epi8('9' + 1)));
+        __m128i is62 = _mm_cmpeq_epi8(c, c62);
+        __m128i is63 = _mm_cmpeq_epi8(c, c63);
+        __m128i off;
+
+        /* Blank space, padding or invalid characters are left to the block decoder */
+        if (0xFFFF != _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, _mm_or_si128(is62, is63)))))
+        {
+            break;
+        }
+
+        /* Letters and digits take precedence over the ruleset characters */
+        off = _mm_and_si128(is63, off63);
+        off = ATCA_B64_SEL128(is62, off62, off);
+        off = ATCA_B64_SEL128(digit, _mm_set1_epi8(52 - '0'), off);
+        off = ATCA_B64_SEL128(lower, _mm_set1_epi8(26 - 'a'), off);
+        off = ATCA_B64_SEL128(upper, _mm_set1_epi8(-'A'), off);
+        c = _mm_add_epi8(c, off);
+
+        /* Pack the 6 bit indexes into 3 bytes per group */
+        c = _mm_maddubs_epi16(c, _mm_set1_epi32(0x01400140));
+        c = _mm_madd_epi16(c, _mm_set1_epi32(0x00011000));
+        _mm_storeu_si128((__m128i*)&data[out], _mm_shuffle_epi8(c, shuf));
+
+        count += 16u;
+        out += 12u;
     }
-    else
+
+    return count;
+}
+
+/**
+ * \brief Decodes 32 characters at a time with AVX2 until a character which
+ *        is not a base 64 digit is found. Each store writes 32 bytes of which
+ *        24 are decoded data.
+ * \return Number of characters decoded
+ */
+ATCA_B64_TARGET("avx2")
+static size_t base64DecodeAvx2(const char* encoded, size_t encoded_size, uint8_t* data, size_t data_space, const uint8_t * rules)
+{
+    const __m256i c62 = _mm256_set1_epi8((char)rules[0]);
+    const __m256i c63 = _mm256_set1_epi8((char)rules[1]);
+    const __m256i off62 = _mm256_set1_epi8((char)(62u - rules[0]));
+    const __m256i off63 = _mm256_set1_epi8((char)(63u - rules[1]));
+    const __m256i shuf = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                          2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m256i perm = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+    size_t count = 0u;
+    size_t out = 0u;
+
+    while (((encoded_size - count) >= 32u) && ((data_space - out) >= 32u))
+    {
+        __m256i c = _mm256_loadu_si256((const __m256i*)&encoded[count]);
+        __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('A' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), c));
+        __m256i lower = _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('a' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), c));
+        __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('0' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), c));
+        __m256i is62 = _mm256_cmpeq_epi8(c, c62);
+        __m256i is63 = _mm256_cmpeq_epi8(c, c63);
+        __m256i off;
+
+        if (-1 != _mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(upper, lower), _mm256_or_si256(digit, _mm256_or_si256(is62, is63)))))
+        {
+            break;
+        }
+
+        off = _mm256_and_si256(is63, off63);
+        off = ATCA_B64_SEL256(is62, off62, off);
+        off = ATCA_B64_SEL256(digit, _mm256_set1_epi8(52 - '0'), off);
+        off = ATCA_B64_SEL256(lower, _mm256_set1_epi8(26 - 'a'), off);
+        off = ATCA_B64_SEL256(upper, _mm256_set1_epi8(-'A'), off);
+        c = _mm256_add_epi8(c, off);
+
+        c = _mm256_maddubs_epi16(c, _mm256_set1_epi32(0x01400140));
+        c = _mm256_madd_epi16(c, _mm256_set1_epi32(0x00011000));
+        c = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(c, shuf), perm);
+        _mm256_storeu_si256((__m256i*)&data[out], c);
+
+        count += 32u;
+        out += 24u;
+    }
+
+    return count;
+}
+#endif /* ATCA_B64_X86 */
+
+#if defined(ATCA_B64_NEON)
+/**
+ * \brief Encodes 16 groups of 3 bytes at a time with NEON
+ * \return Number of groups encoded
+ */
+static size_t base64EncodeNeon(const uint8_t* data, size_t groups, char* encoded, const char alphabet[64])
+{
+    uint8x16x4_t table;
+    size_t done = 0u;
+
+    table.val[0] = vld1q_u8((const uint8_t*)&alphabet[0]);
+    table.val[1] = vld1q_u8((const uint8_t*)&alphabet[16]);
+    table.val[2] = vld1q_u8((const uint8_t*)&alphabet[32]);
+    table.val[3] = vld1q_u8((const uint8_t*)&alphabet[48]);
+
+    while ((groups - done) >= 16u)
     {
-        return B64_IS_EQUAL;
+        uint8x16x3_t in = vld3q_u8(&data[done * 3u]);
+        uint8x16x4_t out;
+
+        out.val[0] = vshrq_n_u8(in.val[0], 2);
+        out.val[1] = vorrq_u8(vshlq_n_u8(vandq_u8(in.val[0], vdupq_n_u8(0x03u)), 4), vshrq_n_u8(in.val[1], 4));
+        out.val[2] = vorrq_u8(vshlq_n_u8(vandq_u8(in.val[1], vdupq_n_u8(0x0Fu)), 2), vshrq_n_u8(in.val[2], 6));
+        out.val[3] = vandq_u8(in.val[2], vdupq_n_u8(0x3Fu));
+
+        out.val[0] = vqtbl4q_u8(table, out.val[0]);
+        out.val[1] = vqtbl4q_u8(table, out.val[1]);
+        out.val[2] = vqtbl4q_u8(table, out.val[2]);
+        out.val[3] = vqtbl4q_u8(table, out.val[3]);
+
+        vst4q_u8((uint8_t*)&encoded[done * 4u], out);
+        done += 16u;
     }
+
+    return done;
+}
+
+/** \brief Converts 16 characters to base 64 indexes, clearing valid for any other character */
+static uint8x16_t base64IndexNeon(uint8x16_t c, uint8x16_t c62, uint8x16_t c63, uint8x16_t* valid)
+{
+    uint8x16_t upper = vcleq_u8(vsubq_u8(c, vdupq_n_u8((uint8_t)'A')), vdupq_n_u8(25u));
+    uint8x16_t lower = vcleq_u8(vsubq_u8(c, vdupq_n_u8((uint8_t)'a')), vdupq_n_u8(25u));
+    uint8x16_t digit = vcleq_u8(vsubq_u8(c, vdupq_n_u8((uint8_t)'0')), vdupq_n_u8(9u));
+    uint8x16_t is62 = vceqq_u8(c, c62);
+    uint8x16_t is63 = vceqq_u8(c, c63);
+    uint8x16_t id;
+
+    *valid = vandq_u8(*valid, vorrq_u8(vorrq_u8(upper, lower), vorrq_u8(digit, vorrq_u8(is62, is63))));
+
+    id = vandq_u8(is63, vdupq_n_u8(63u));
+    id = vbslq_u8(is62, vdupq_n_u8(62u), id);
+    id = vbslq_u8(digit, vaddq_u8(c, vdupq_n_u8((uint8_t)(52u - (uint8_t)'0'))), id);
+    id = vbslq_u8(lower, vaddq_u8(c, vdupq_n_u8((uint8_t)(26u - (uint8_t)'a'))), id);
+    id = vbslq_u8(upper, vsubq_u8(c, vdupq_n_u8((uint8_t)'A')), id);
+
+    return id;
 }
 
 /**
- * \brief Returns the base 64 character of the given index.
- * \param[in] id     index to check
- * \param[in] rules  base64 ruleset to use
- * \return the base 64 character of the given index
+ * \brief Decodes 64 characters at a time with NEON until a character which
+ *        is not a base 64 digit is found.
+ * \return Number of characters decoded
  */
-static char base64Char(uint8_t id, const uint8_t * rules)
+static size_t base64DecodeNeon(const char* encoded, size_t encoded_size, uint8_t* data, size_t data_space, const uint8_t * rules)
 {
-    int8_t rv;
+    const uint8x16_t c62 = vdupq_n_u8(rules[0]);
+    const uint8x16_t c63 = vdupq_n_u8(rules[1]);
+    size_t count = 0u;
+    size_t out = 0u;
 
-    if (id < 26u)
+    while (((encoded_size - count) >= 64u) && ((data_space - out) >= 48u))
     {
-        rv = ((int8_t)'A' + (int8_t)id);
+        uint8x16x4_t in = vld4q_u8((const uint8_t*)&encoded[count]);
+        uint8x16_t valid = vdupq_n_u8(0xFFu);
+        uint8x16x3_t dec;
+
+        in.val[0] = base64IndexNeon(in.val[0], c62, c63, &valid);
+        in.val[1] = base64IndexNeon(in.val[1], c62, c63, &valid);
+        in.val[2] = base64IndexNeon(in.val[2], c62, c63, &valid);
+        in.val[3] = base64IndexNeon(in.val[3], c62, c63, &valid);
+        if (0xFFu != vminvq_u8(valid))
+        {
+            break;
+        }
+
+        dec.val[0] = vorrq_u8(vshlq_n_u8(in.val[0], 2), vshrq_n_u8(in.val[1], 4));
+        dec.val[1] = vorrq_u8(vshlq_n_u8(in.val[1], 4), vshrq_n_u8(in.val[2], 2));
+        dec.val[2] = vorrq_u8(vshlq_n_u8(in.val[2], 6), in.val[3]);
+        vst3q_u8(&data[out], dec);
+
+        count += 64u;
+        out += 48u;
     }
-    else if (id < 52u)
+
+    return count;
+}
+#endif /* ATCA_B64_NEON */
+
+/**
+ * \brief Encodes complete groups of 3 bytes into 4 base 64 characters each.
+ * \param[in]  data       Data to encode
+ * \param[in]  data_size  Bytes readable from data, at least groups * 3
+ * \param[in]  groups     Number of groups to encode
+ * \param[out] encoded    Receives groups * 4 characters
+ * \param[in]  alphabet   Characters of the ruleset
+ */
+static void base64EncodeGroups(const uint8_t* data, size_t data_size, size_t groups, char* encoded, const char alphabet[64])
+{
+    size_t done = 0u;
+
+#if defined(ATCA_B64_X86)
+    uint32_t caps = base64CpuCaps();
+
+    if (0u != (caps & ATCA_B64_CAP_AVX2))
     {
-        rv = ((int8_t)'a' + (int8_t)id - 26);
+        done = base64EncodeAvx2(data, data_size, groups, encoded, alphabet);
     }
-    else if (id < 62u)
+    if (0u != (caps & ATCA_B64_CAP_SSSE3))
     {
-        rv = ((int8_t)'0' + (int8_t)id - 52);
+        done += base64EncodeSsse3(&data[done * 3u], data_size - done * 3u, groups - done, &encoded[done * 4u], alphabet);
     }
-    else if (id == 62u)
+#elif defined(ATCA_B64_NEON)
+    ((void)data_size);
+    done = base64EncodeNeon(data, groups, encoded, alphabet);
+#else
+    ((void)data_size);
+#endif
+
+    for (; done < groups; done++)
     {
-        /* coverity[cert_int31_c_violation] Rule is expected to be a valid character */
-        rv = (int8_t)rules[0];
+        const uint8_t* in = &data[done * 3u];
+        char* out = &encoded[done * 4u];
+
+        out[0] = alphabet[in[0] >> 2u];
+        out[1] = alphabet[(uint8_t)((in[0] & 0x03u) << 4u) | (uint8_t)(in[1] >> 4u)];
+        out[2] = alphabet[(uint8_t)((in[1] & 0x0Fu) << 2u) | (uint8_t)(in[2] >> 6u)];
+        out[3] = alphabet[in[2] & 0x3Fu];
     }
-    else if (id == 63u)
+}
+
+/**
+ * \brief Decodes complete blocks of 4 base 64 digits up to the first blank
+ *        space, padding or invalid character, or until the output is full.
+ *        Those are left for atcab_base64decode_ to handle.
+ * \param[in]     encoded        Base 64 characters
+ * \param[in]     encoded_size   Number of characters
+ * \param[out]    data           Output buffer
+ * \param[in,out] data_size      Bytes already decoded, updated with the new ones
+ * \param[in]     data_max_size  Size of the output buffer
+ * \param[in]     rules          base64 ruleset to use
+ * \return Number of characters decoded
+ */
+static size_t base64DecodeBlocks(const char* encoded, size_t encoded_size, uint8_t* data, size_t* data_size, size_t data_max_size, const uint8_t * rules)
+{
+    size_t count = 0u;
+    uint8_t id[4];
+
+#if defined(ATCA_B64_X86) || defined(ATCA_B64_NEON)
+    /* The vector paths do not know about blank space so rulesets which use it are left to the table */
+    if (!isBlankSpace((char)rules[0]) && !isBlankSpace((char)rules[1]))
     {
-        /* coverity[cert_int31_c_violation] Rule is expected to be a valid character */
-        rv = (int8_t)rules[1];
+#if defined(ATCA_B64_X86)
+        uint32_t caps = base64CpuCaps();
+
+        if (0u != (caps & ATCA_B64_CAP_AVX2))
+        {
+            count = base64DecodeAvx2(encoded, encoded_size, &data[*data_size], data_max_size - *data_size, rules);
+            *data_size += (count / 4u) * 3u;
+        }
+        if (0u != (caps & ATCA_B64_CAP_SSSE3))
+        {
+            size_t n = base64DecodeSsse3(&encoded[count], encoded_size - count, &data[*data_size], data_max_size - *data_size, rules);
+            count += n;
+            *data_size += (n / 4u) * 3u;
+        }
+#else
+        count = base64DecodeNeon(encoded, encoded_size, &data[*data_size], data_max_size - *data_size, rules);
+        *data_size += (count / 4u) * 3u;
+#endif
     }
-    else
+#endif
+
+    while (((encoded_size - count) >= 4u) && ((data_max_size - *data_size) >= 3u))
     {
-        /* coverity[cert_int31_c_violation] Rule is expected to be a valid character */
-        rv = (int8_t)rules[2];
+        id[0] = base64Index(encoded[count], rules);
+        id[1] = base64Index(encoded[count + 1u], rules);
+        id[2] = base64Index(encoded[count + 2u], rules);
+        id[3] = base64Index(encoded[count + 3u], rules);
+        if (0u != ((id[0] | id[1] | id[2] | id[3]) & 0xC0u))
+        {
+            break;
+        }
+
+        data[(*data_size)++] = ((uint8_t)(id[0] << 2u) | (uint8_t)(id[1] >> 4u));
+        data[(*data_size)++] = ((uint8_t)(id[1] << 4u) | (uint8_t)(id[2] >> 2u));
+        data[(*data_size)++] = ((uint8_t)(id[2] << 6u) | (uint8_t)id[3]);
+        count += 4u;
     }
 
-    return (char)rv;
+    return count;
 }
 
 static ATCA_STATUS atcab_base64decode_block(const uint8_t id[4], uint8_t* data, size_t* data_size, size_t data_max_size)
@@ -689,11 +1177,21 @@ ATCA_STATUS atcab_base64decode_(const char* encoded, size_t encoded_size, uint8_
         // Start decoding the input data
         for (enc_index = 0; enc_index < encoded_size; enc_index++)
         {
-            if (isBlankSpace(encoded[enc_index]))
+            // Decode runs of whole blocks directly when no characters are pending
+            if ((0 == id_index) && !is_done)
+            {
+                enc_index += base64DecodeBlocks(&encoded[enc_index], encoded_size - enc_index, data, data_size, data_max_size, rules);
+                if (enc_index >= encoded_size)
+                {
+                    break;
+                }
+            }
+            id[id_index] = base64Index(encoded[enc_index], rules);
+            if (B64_IS_BLANK == id[id_index])
             {
                 continue; // Skip any empty characters
             }
-            if (!isBase64Digit(encoded[enc_index], rules))
+            if (B64_IS_INVALID == id[id_index])
             {
                 status = ATCA_TRACE(ATCA_BAD_PARAM, "Invalid base64 character");
                 break;
@@ -705,9 +1203,8 @@ ATCA_STATUS atcab_base64decode_(const char* encoded, size_t encoded_size, uint8_
                 status = ATCA_TRACE(ATCA_BAD_PARAM, "Base64 chars after end padding");
                 break;
             }
-            id[id_index++] = base64Index(encoded[enc_index], rules);
             // Process data 4 characters at a time
-            if (id_index >= 4)
+            if (++id_index >= 4)
             {
                 id_index = 0;
                 status = atcab_base64decode_block(id, data, data_size, data_max_size);
@@ -757,9 +1254,12 @@ ATCA_STATUS atcab_base64encode_(
     ATCA_STATUS status = ATCA_SUCCESS;
     size_t data_idx = 0;
     size_t b64_idx = 0;
-    size_t offset = 0;
+    size_t line_groups;
+    size_t groups = 0;
+    size_t run;
     uint8_t id = 0;
     size_t b64_len;
+    char alphabet[64];
 
     do
     {
@@ -803,45 +1303,64 @@ ATCA_STATUS atcab_base64encode_(
         // Initialize the return length to 0
         *encoded_size = 0u;
 
-        // Loop through the byte array by 3 then map to 4 base 64 encoded characters
-        for (data_idx = 0u; data_idx < data_size; data_idx += 3u)
+        (void)memcpy(alphabet, atca_b64_alphabet, sizeof(atca_b64_alphabet));
+        /* coverity[cert_int31_c_violation] Rule is expected to be a valid character */
+        alphabet[62] = (char)rules[0];
+        /* coverity[cert_int31_c_violation] Rule is expected to be a valid character */
+        alphabet[63] = (char)rules[1];
+
+        // Groups of 3 bytes per line (0 for no line breaks)
+        line_groups = (size_t)rules[3] / 4u;
+
+        // Map the byte array by 3 to 4 base 64 encoded characters a line at a time
+        while ((data_size - data_idx) >= 3u)
         {
             // Add \r\n every n bytes if specified
-            if ((0u < rules[3]) && (data_idx > 0u) && ((b64_idx - offset) % rules[3] == 0u))
+            if ((0u < line_groups) && (groups == line_groups))
+            {
+                encoded[b64_idx++] = (char)'\r';
+                encoded[b64_idx++] = (char)'\n';
+                groups = 0u;
+            }
+
+            run = (data_size - data_idx) / 3u;
+            if ((0u < line_groups) && (run > (line_groups - groups)))
+            {
+                run = line_groups - groups;
+            }
+            base64EncodeGroups(&data[data_idx], data_size - data_idx, run, &encoded[b64_idx], alphabet);
+            data_idx += run * 3u;
+            b64_idx += run * 4u;
+            groups += run;
+        }
+
+        // Pad the final partial group
+        if (data_idx < data_size)
+        {
+            if ((0u < line_groups) && (groups == line_groups))
             {
-                // as soon as we do this, we introduce an offset
                 encoded[b64_idx++] = (char)'\r';
                 encoded[b64_idx++] = (char)'\n';
-                offset += 2u;
             }
 
             id = (data[data_idx] & 0xFCu) >> 2u;
-            encoded[b64_idx++] = base64Char(id, rules);
+            encoded[b64_idx++] = alphabet[id];
             id = (uint8_t)((data[data_idx] & 0x03u) << 4u);
             if (data_idx + 1u < data_size)
             {
                 id |= (data[data_idx + 1u] & 0xF0u) >> 4u;
-                encoded[b64_idx++] = base64Char(id, rules);
+                encoded[b64_idx++] = alphabet[id];
                 id = (uint8_t)((data[data_idx + 1u] & 0x0Fu) << 2u);
-                if (data_idx + 2u < data_size)
-                {
-                    id |= (data[data_idx + 2u] & 0xC0u) >> 6u;
-                    encoded[b64_idx++] = base64Char(id, rules);
-                    id = data[data_idx + 2u] & 0x3Fu;
-                    encoded[b64_idx++] = base64Char(id, rules);
-                }
-                else
-                {
-                    encoded[b64_idx++] = base64Char(id, rules);
-                    encoded[b64_idx++] = base64Char(B64_IS_EQUAL, rules);
-                }
+                encoded[b64_idx++] = alphabet[id];
             }
             else
             {
-                encoded[b64_idx++] = base64Char(id, rules);
-                encoded[b64_idx++] = base64Char(B64_IS_EQUAL, rules);
-                encoded[b64_idx++] = base64Char(B64_IS_EQUAL, rules);
+                encoded[b64_idx++] = alphabet[id];
+                /* coverity[cert_int31_c_violation] Rule is expected to be a valid character */
+                encoded[b64_idx++] = (char)rules[2];
             }
+            /* coverity[cert_int31_c_violation] Rule is expected to be a valid character */
+            encoded[b64_idx++] = (char)rules[2];
         }
 
         // Strip any trailing nulls
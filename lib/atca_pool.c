@@ -0,0 +1,527 @@
+/**
+ * \file
+ * \brief Device pool which spreads operations over several devices with a worker
+ *        thread per bus
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+
+
+#include "atca_pool.h"
+
+#if ATCA_POOL_EN
+
+#ifdef ATCA_NO_HEAP
+#error "The device pool requires heap allocation (ATCA_HEAP)"
+#endif
+
+/** \brief Check if two devices share a bus and so have to be served by the
+ *         same worker. Devices on interfaces without a shared bus each get
+ *         their own worker.
+ */
+static bool atca_pool_same_bus(const ATCAIfaceCfg* a, const ATCAIfaceCfg* b)
+{
+    bool same = false;
+
+    if (a->iface_type == b->iface_type)
+    {
+        if (ATCA_I2C_IFACE == a->iface_type)
+        {
+            same = (ATCA_IFACECFG_VALUE(a, atcai2c.bus) == ATCA_IFACECFG_VALUE(b, atcai2c.bus));
+        }
+        else if (ATCA_SPI_IFACE == a->iface_type)
+        {
+            same = (ATCA_IFACECFG_VALUE(a, atcaspi.bus) == ATCA_IFACECFG_VALUE(b, atcaspi.bus));
+        }
+        else
+        {
+            same = false;
+        }
+    }
+
+    return same;
+}
+
+/** \brief Execute a job on the device it was dispatched to */
+static void atca_pool_run(atca_pool_job_t* job)
+{
+    ATCA_STATUS status = ATCA_UNIMPLEMENTED;
+
+    switch (job->op)
+    {
+#if ATCAB_SIGN_EN
+    case ATCA_POOL_OP_SIGN:
+        status = atcab_sign_ext(job->device, job->key_id, job->message, job->result);
+        break;
+#endif
+#if ATCAB_VERIFY_EXTERN_EN
+    case ATCA_POOL_OP_VERIFY:
+        status = atcab_verify_extern_ext(job->device, job->message, job->signature, job->public_key, &job->is_verified);
+        break;
+#endif
+#if ATCAB_ECDH_EN
+    case ATCA_POOL_OP_ECDH:
+        status = atcab_ecdh_ext(job->device, job->key_id, job->public_key, job->result);
+        break;
+#endif
+#if ATCAB_RANDOM_EN
+    case ATCA_POOL_OP_RANDOM:
+        status = atcab_random_ext(job->device, job->result);
+        break;
+#endif
+#if ATCAB_SHA_EN
+    case ATCA_POOL_OP_SHA:
+        if (UINT16_MAX >= job->message_size)
+        {
+            status = atcab_sha_ext(job->device, (uint16_t)job->message_size, job->message, job->result);
+        }
+        else
+        {
+            status = ATCA_TRACE(ATCA_BAD_PARAM, "message_size is too large");
+        }
+        break;
+#endif
+#if ATCAB_PBKDF2_SHA256_EN
+    case ATCA_POOL_OP_PBKDF2:
+        status = atcab_pbkdf2_sha256_block(job->device, job->iterations, job->key_id, job->message, job->message_size, job->result);
+        break;
+#endif
+    default:
+        status = ATCA_UNIMPLEMENTED;
+        break;
+    }
+
+    job->status = status;
+}
+
+/** \brief Worker thread - executes the jobs queued for the devices of one bus */
+static void atca_pool_worker_main(void* arg)
+{
+    atca_pool_worker_t* worker = (atca_pool_worker_t*)arg;
+    atca_pool_t* pool = worker->pool;
+    atca_pool_job_t* job;
+    bool stop;
+
+    do
+    {
+        (void)hal_wait_semaphore(worker->signal);
+
+        (void)hal_lock_mutex(pool->lock);
+        job = worker->head;
+        if (NULL != job)
+        {
+            worker->head = job->next;
+            if (NULL == worker->head)
+            {
+                worker->tail = NULL;
+            }
+        }
+        stop = worker->stop;
+        (void)hal_unlock_mutex(pool->lock);
+
+        if (NULL != job)
+        {
+            atca_pool_run(job);
+
+            /* Release the load before completing as the callback may reuse the job */
+            (void)hal_lock_mutex(pool->lock);
+            worker->pending--;
+            pool->pending[job->device_index]--;
+            (void)hal_unlock_mutex(pool->lock);
+
+            if (NULL != job->callback)
+            {
+                job->callback(job);
+            }
+            else
+            {
+                (void)hal_post_semaphore(job->done);
+            }
+        }
+    } while ((NULL != job) || !stop);
+}
+
+/** \brief Open the devices of a pool and start a worker thread for every bus
+ *         they are attached to.
+ *
+ * \param[out] pool   Pool to initialize
+ * \param[in]  cfgs   Configuration of each device
+ * \param[in]  count  Number of devices (up to ATCA_POOL_MAX_DEVICES)
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atca_pool_init(atca_pool_t* pool, const atca_pool_device_cfg_t* cfgs, size_t count)
+{
+    ATCA_STATUS status;
+    atca_pool_worker_t* worker;
+    size_t i;
+    size_t j;
+
+    if ((NULL == pool) || (NULL == cfgs) || (0u == count))
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
+
+    if (ATCA_POOL_MAX_DEVICES < count)
+    {
+        return ATCA_TRACE(ATCA_INVALID_SIZE, "Too many devices for the pool");
+    }
+
+    (void)memset(pool, 0, sizeof(*pool));
+
+    if (ATCA_SUCCESS != (status = hal_create_mutex(&pool->lock, NULL)))
+    {
+        return ATCA_TRACE(status, "Failed to create the pool lock");
+    }
+
+    for (i = 0; (i < count) && (ATCA_SUCCESS == status); i++)
+    {
+        if (ATCA_SUCCESS != (status = atcab_init_ext(&pool->devices[i], cfgs[i].cfg)))
+        {
+            (void)ATCA_TRACE(status, "atcab_init_ext - failed");
+            break;
+        }
+        pool->key_mask[i] = cfgs[i].key_mask;
+        pool->device_count++;
+
+        /* Devices sharing a bus share a worker */
+        for (j = 0; j < i; j++)
+        {
+            if (atca_pool_same_bus(cfgs[j].cfg, cfgs[i].cfg))
+            {
+                break;
+            }
+        }
+
+        if (j < i)
+        {
+            pool->worker_index[i] = pool->worker_index[j];
+        }
+        else
+        {
+            worker = &pool->workers[pool->worker_count];
+            worker->pool = pool;
+
+            if (ATCA_SUCCESS != (status = hal_create_semaphore(&worker->signal)))
+            {
+                (void)ATCA_TRACE(status, "hal_create_semaphore - failed");
+                break;
+            }
+
+            if (ATCA_SUCCESS != (status = hal_create_thread(&worker->thread, atca_pool_worker_main, worker)))
+            {
+                (void)hal_destroy_semaphore(worker->signal);
+                worker->signal = NULL;
+                (void)ATCA_TRACE(status, "hal_create_thread - failed");
+                break;
+            }
+
+            pool->worker_index[i] = (uint8_t)pool->worker_count;
+            pool->worker_count++;
+        }
+    }
+
+    if (ATCA_SUCCESS != status)
+    {
+        (void)atca_pool_release(pool);
+    }
+
+    return status;
+}
+
+/** \brief Stop the workers once all queued jobs have completed and release
+ *         the devices of the pool.
+ *
+ * \param[in] pool  Pool to release
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atca_pool_release(atca_pool_t* pool)
+{
+    size_t i;
+
+    if ((NULL == pool) || (NULL == pool->lock))
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
+
+    for (i = 0; i < pool->worker_count; i++)
+    {
+        (void)hal_lock_mutex(pool->lock);
+        pool->workers[i].stop = true;
+        (void)hal_unlock_mutex(pool->lock);
+        (void)hal_post_semaphore(pool->workers[i].signal);
+    }
+
+    for (i = 0; i < pool->worker_count; i++)
+    {
+        (void)hal_join_thread(pool->workers[i].thread);
+        (void)hal_destroy_semaphore(pool->workers[i].signal);
+    }
+
+    for (i = 0; i < pool->device_count; i++)
+    {
+        (void)atcab_release_ext(&pool->devices[i]);
+    }
+
+    (void)hal_destroy_mutex(pool->lock);
+    (void)memset(pool, 0, sizeof(*pool));
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief Queue a job on the least loaded device able to execute it.
+ *
+ * Sign and ECDH jobs are only dispatched to devices whose key_mask includes
+ * the requested key_id. Load is measured first by the jobs outstanding on the
+ * bus of a device and then by the jobs outstanding on the device itself.
+ *
+ * \param[in]     pool  Pool to execute the job on
+ * \param[in,out] job   Job to execute. Completion is reported through its
+ *                      callback or with atca_pool_wait.
+ *
+ * \return ATCA_SUCCESS if the job was queued, otherwise an error code.
+ */
+ATCA_STATUS atca_pool_submit(atca_pool_t* pool, atca_pool_job_t* job)
+{
+    ATCA_STATUS status;
+    atca_pool_worker_t* worker;
+    size_t best = ATCA_POOL_MAX_DEVICES;
+    size_t i;
+    bool keyed;
+
+    if ((NULL == pool) || (NULL == pool->lock) || (NULL == job))
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
+
+    keyed = (ATCA_POOL_OP_SIGN == job->op) || (ATCA_POOL_OP_ECDH == job->op) || (ATCA_POOL_OP_PBKDF2 == job->op);
+    if (keyed && (32u <= job->key_id))
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "Invalid key_id received");
+    }
+
+    job->next = NULL;
+    job->done = NULL;
+    job->status = ATCA_GEN_FAIL;
+    if (NULL == job->callback)
+    {
+        if (ATCA_SUCCESS != (status = hal_create_semaphore(&job->done)))
+        {
+            return ATCA_TRACE(status, "hal_create_semaphore - failed");
+        }
+    }
+
+    (void)hal_lock_mutex(pool->lock);
+
+    for (i = 0; i < pool->device_count; i++)
+    {
+        if (keyed && (0u == (pool->key_mask[i] & ((uint32_t)1u << job->key_id))))
+        {
+            continue;
+        }
+
+        if ((ATCA_POOL_MAX_DEVICES == best)
+            || (pool->workers[pool->worker_index[i]].pending < pool->workers[pool->worker_index[best]].pending)
+            || ((pool->workers[pool->worker_index[i]].pending == pool->workers[pool->worker_index[best]].pending)
+                && (pool->pending[i] < pool->pending[best])))
+        {
+            best = i;
+        }
+    }
+
+    if (ATCA_POOL_MAX_DEVICES != best)
+    {
+        worker = &pool->workers[pool->worker_index[best]];
+
+        job->device = pool->devices[best];
+        job->device_index = (uint8_t)best;
+
+        if (NULL == worker->tail)
+        {
+            worker->head = job;
+        }
+        else
+        {
+            worker->tail->next = job;
+        }
+        worker->tail = job;
+        worker->pending++;
+        pool->pending[best]++;
+    }
+
+    (void)hal_unlock_mutex(pool->lock);
+
+    if (ATCA_POOL_MAX_DEVICES == best)
+    {
+        if (NULL != job->done)
+        {
+            (void)hal_destroy_semaphore(job->done);
+            job->done = NULL;
+        }
+        return ATCA_TRACE(ATCA_NO_DEVICES, "No device holds a suitable key");
+    }
+
+    return hal_post_semaphore(worker->signal);
+}
+
+/** \brief Wait for a job submitted without a callback to complete
+ *
+ * \param[in,out] job  Job to wait on
+ *
+ * \return Status of the operation the job performed
+ */
+ATCA_STATUS atca_pool_wait(atca_pool_job_t* job)
+{
+    if ((NULL == job) || (NULL == job->done))
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "Job was not submitted for waiting");
+    }
+
+    (void)hal_wait_semaphore(job->done);
+    (void)hal_destroy_semaphore(job->done);
+    job->done = NULL;
+
+    return job->status;
+}
+
+/** \brief Submit a job and wait for it to complete
+ *
+ * \param[in]     pool  Pool to execute the job on
+ * \param[in,out] job   Job to execute - must not have a callback
+ *
+ * \return Status of the operation the job performed
+ */
+ATCA_STATUS atca_pool_execute(atca_pool_t* pool, atca_pool_job_t* job)
+{
+    ATCA_STATUS status;
+
+    if ((NULL == job) || (NULL != job->callback))
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "Invalid job received");
+    }
+
+    if (ATCA_SUCCESS == (status = atca_pool_submit(pool, job)))
+    {
+        status = atca_pool_wait(job);
+    }
+
+    return status;
+}
+
+#if ATCAB_PBKDF2_SHA256_EN
+/** \brief Calculate a PBKDF2 password hash with the output blocks spread over
+ *         the devices of the pool that hold the password in slot. Each block
+ *         runs its iterations on a single device, so a derivation of n blocks
+ *         runs up to n times faster when as many devices are available.
+ *
+ * \param[in]  pool        Pool to execute on
+ * \param[in]  iter        Number of iterations of the algorithm to perform
+ * \param[in]  slot        Slot with the stored key (password) - must be set in
+ *                         the key_mask of the devices to use
+ * \param[in]  salt        Salt bytes to use
+ * \param[in]  salt_len    Length of the salt bytes buffer
+ * \param[out] result      Output buffer to hold the derived key
+ * \param[in]  result_len  Length of the key to derive
+ * \param[in]  progress    Optional callback invoked as each block completes
+ * \param[in]  user_data   Caller context for the callback
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atca_pool_pbkdf2_sha256(atca_pool_t* pool, uint32_t iter, uint16_t slot, const uint8_t* salt, size_t salt_len,
+                                    uint8_t* result, size_t result_len, atcab_pbkdf2_progress_cb progress, void* user_data)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    atca_pool_job_t jobs[ATCA_POOL_MAX_DEVICES];
+    uint8_t messages[ATCA_POOL_MAX_DEVICES][ATCA_SHA256_BLOCK_SIZE];
+    uint8_t digests[ATCA_POOL_MAX_DEVICES][ATCA_SHA256_DIGEST_SIZE];
+    uint32_t total = (0u < iter) ? iter : 1u;
+    uint32_t counter = 1;
+    size_t count;
+    size_t i;
+
+    if ((NULL == pool) || (0u == pool->device_count) || (NULL == result) || (0u == result_len)
+        || ((NULL == salt) && (0u < salt_len)) || ((ATCA_SHA256_BLOCK_SIZE - 4u) < salt_len))
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "Invalid parameter received");
+    }
+
+    while ((ATCA_SUCCESS == status) && (0u < result_len))
+    {
+        /* One block per device in each round */
+        for (count = 0; (count < pool->device_count) && ((count * ATCA_SHA256_DIGEST_SIZE) < result_len); count++)
+        {
+            uint32_t temp_u32 = ATCA_UINT32_HOST_TO_BE(counter + (uint32_t)count);
+
+            if (0u < salt_len)
+            {
+                (void)memcpy(messages[count], salt, salt_len);
+            }
+            (void)memcpy(&messages[count][salt_len], (uint8_t*)&temp_u32, 4);
+
+            (void)memset(&jobs[count], 0, sizeof(jobs[count]));
+            jobs[count].op = ATCA_POOL_OP_PBKDF2;
+            jobs[count].key_id = slot;
+            jobs[count].message = messages[count];
+            jobs[count].message_size = salt_len + 4u;
+            jobs[count].iterations = iter;
+            jobs[count].result = digests[count];
+
+            if (ATCA_SUCCESS != (status = atca_pool_submit(pool, &jobs[count])))
+            {
+                break;
+            }
+        }
+
+        for (i = 0; i < count; i++)
+        {
+            ATCA_STATUS job_status = atca_pool_wait(&jobs[i]);
+
+            if (ATCA_SUCCESS == status)
+            {
+                status = job_status;
+            }
+
+            if (ATCA_SUCCESS == status)
+            {
+                size_t copy_len = (result_len < ATCA_SHA256_DIGEST_SIZE) ? result_len : ATCA_SHA256_DIGEST_SIZE;
+                (void)memcpy(result, digests[i], copy_len);
+
+                result_len -= copy_len;
+                result += copy_len;
+
+                if (NULL != progress)
+                {
+                    progress(user_data, (size_t)counter + i - 1u, total, total);
+                }
+            }
+        }
+
+        counter += (uint32_t)count;
+    }
+
+    return status;
+}
+#endif
+
+#endif /* ATCA_POOL_EN */
@@ -0,0 +1,142 @@
+/**
+ * \file
+ * \brief Device pool which spreads operations over several devices with a worker
+ *        thread per bus
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+
+
+#ifndef ATCA_POOL_H
+#define ATCA_POOL_H
+
+#include "cryptoauthlib.h"
+
+/** \defgroup pool_ Device pool (atca_pool_)
+ *
+ * \brief
+ * A pool owns several devices and executes operations on them from a worker
+ * thread per bus. Jobs are dispatched to the least loaded device that is able
+ * to execute them and complete asynchronously.
+ *
+   @{ */
+
+#if ATCA_POOL_EN
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \brief Operations that can be submitted to a device pool */
+typedef enum
+{
+    ATCA_POOL_OP_SIGN,          /**< Sign a 32 byte digest with the private key in key_id */
+    ATCA_POOL_OP_VERIFY,        /**< Verify a signature of a 32 byte digest with an external public key */
+    ATCA_POOL_OP_ECDH,          /**< ECDH between the private key in key_id and an external public key */
+    ATCA_POOL_OP_RANDOM,        /**< Generate 32 random bytes */
+    ATCA_POOL_OP_SHA,           /**< SHA-256 digest of a message of up to 65535 bytes */
+    ATCA_POOL_OP_PBKDF2         /**< PBKDF2 output block with the HMAC key in key_id - message is salt || INT(i) */
+} atca_pool_op_t;
+
+typedef struct atca_pool_job_s atca_pool_job_t;
+
+/** \brief Completion callback - called from the worker thread of the bus */
+typedef void (*atca_pool_cb)(atca_pool_job_t* job);
+
+/** \brief A single operation submitted to a pool. The job and the buffers it
+ *         references must remain valid until it completes.
+ */
+struct atca_pool_job_s
+{
+    atca_pool_op_t   op;            /**< Operation to perform */
+    uint16_t         key_id;        /**< Private key slot (Sign, ECDH) or HMAC key slot (PBKDF2) */
+    const uint8_t*   message;       /**< Digest (Sign, Verify) or message (SHA, PBKDF2) */
+    size_t           message_size;  /**< Size of the message (SHA, PBKDF2) */
+    uint32_t         iterations;    /**< Iteration count (PBKDF2) */
+    const uint8_t*   signature;     /**< Signature to check (Verify) */
+    const uint8_t*   public_key;    /**< External public key (Verify, ECDH) */
+    uint8_t*         result;        /**< Signature, shared secret, random bytes, digest or PBKDF2 block */
+    bool             is_verified;   /**< Result of a Verify */
+    ATCA_STATUS      status;        /**< Status of the operation once completed */
+    ATCADevice       device;        /**< Device the operation was executed on */
+    atca_pool_cb     callback;      /**< Optional completion callback - otherwise use atca_pool_wait */
+    void*            user_data;     /**< Caller context for the callback */
+
+    /* Managed by the pool */
+    atca_pool_job_t* next;
+    void*            done;
+    uint8_t          device_index;
+};
+
+/** \brief Configuration of a single device of a pool */
+typedef struct
+{
+    ATCAIfaceCfg* cfg;              /**< Interface configuration of the device */
+    uint32_t      key_mask;         /**< Bit n is set if slot n holds a key usable by Sign, ECDH and PBKDF2 jobs */
+} atca_pool_device_cfg_t;
+
+struct atca_pool_s;
+
+/** \brief Worker thread serving all the devices on one bus */
+typedef struct
+{
+    struct atca_pool_s* pool;
+    void*               thread;
+    void*               signal;     /**< Posted once per queued job and on shutdown */
+    atca_pool_job_t*    head;
+    atca_pool_job_t*    tail;
+    size_t              pending;    /**< Jobs queued or executing on the bus */
+    bool                stop;
+} atca_pool_worker_t;
+
+/** \brief Pool of devices */
+typedef struct atca_pool_s
+{
+    void*              lock;        /**< Protects the queues and load counters */
+    ATCADevice         devices[ATCA_POOL_MAX_DEVICES];
+    uint32_t           key_mask[ATCA_POOL_MAX_DEVICES];
+    uint8_t            worker_index[ATCA_POOL_MAX_DEVICES];
+    size_t             pending[ATCA_POOL_MAX_DEVICES];
+    size_t             device_count;
+    atca_pool_worker_t workers[ATCA_POOL_MAX_DEVICES];
+    size_t             worker_count;
+} atca_pool_t;
+
+ATCA_STATUS atca_pool_init(atca_pool_t* pool, const atca_pool_device_cfg_t* cfgs, size_t count);
+ATCA_STATUS atca_pool_release(atca_pool_t* pool);
+ATCA_STATUS atca_pool_submit(atca_pool_t* pool, atca_pool_job_t* job);
+ATCA_STATUS atca_pool_wait(atca_pool_job_t* job);
+ATCA_STATUS atca_pool_execute(atca_pool_t* pool, atca_pool_job_t* job);
+#if ATCAB_PBKDF2_SHA256_EN
+ATCA_STATUS atca_pool_pbkdf2_sha256(atca_pool_t* pool, uint32_t iter, uint16_t slot, const uint8_t* salt, size_t salt_len,
+                                    uint8_t* result, size_t result_len, atcab_pbkdf2_progress_cb progress, void* user_data);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ATCA_POOL_EN */
+
+/** @} */
+#endif /* ATCA_POOL_H */
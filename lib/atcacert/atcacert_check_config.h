@@ -46,6 +46,15 @@
 #define ATCACERT_COMPCERT_EN                DEFAULT_ENABLED
 #endif
 
+#ifndef ATCACERT_READ_PLAN_SIZE
+#define ATCACERT_READ_PLAN_SIZE             (32u)
+#endif
+
+/* Certificates whose TBS data is hashed together by the batch functions */
+#ifndef ATCACERT_TBS_DIGEST_BATCH_SIZE
+#define ATCACERT_TBS_DIGEST_BATCH_SIZE      (16u)
+#endif
+
 #ifndef ATCACERT_EN
 #define ATCACERT_EN                         (ATCACERT_FULLSTOREDCERT_EN || ATCACERT_COMPCERT_EN)
 #endif
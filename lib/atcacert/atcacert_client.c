@@ -208,6 +208,402 @@ ATCA_STATUS atcacert_read_device_loc(const atcacert_device_loc_t*   device_loc,
 {
     return atcacert_read_device_loc_ext(atcab_get_device(), device_loc, data);
 }
+
+#if ATCA_CA_SUPPORT
+/** \brief Block of a zone read by the device location planner */
+typedef struct
+{
+    uint8_t  zone;
+    uint8_t  block;
+    uint8_t  length;    /**< 32 for a block read, less for the words at the end of a zone */
+    uint16_t slot;
+} atcacert_read_block_t;
+
+/** \brief Locations the planner reads in blocks, everything else is read
+ *         with atcacert_read_device_loc_ext
+ */
+static bool atcacert_is_plannable_loc(const atcacert_device_loc_t* device_loc)
+{
+    return (0u == device_loc->is_genkey)
+           && ((DEVZONE_CONFIG == device_loc->zone) || (DEVZONE_OTP == device_loc->zone) || (DEVZONE_DATA == device_loc->zone));
+}
+
+/** \brief Slot of a location normalized so config and OTP blocks compare equal */
+static uint16_t atcacert_plan_slot(const atcacert_device_loc_t* device_loc)
+{
+    return (DEVZONE_DATA == device_loc->zone) ? device_loc->slot : 0u;
+}
+
+/** \brief Finds a planned block */
+static const atcacert_read_block_t* atcacert_plan_find(const atcacert_read_block_t* plan, size_t plan_count,
+                                                       uint8_t zone, uint16_t slot, uint8_t block)
+{
+    size_t i;
+
+    for (i = 0; i < plan_count; i++)
+    {
+        if ((plan[i].zone == zone) && (plan[i].slot == slot) && (plan[i].block == block))
+        {
+            return &plan[i];
+        }
+    }
+    return NULL;
+}
+
+/** \brief Adds every block covering a location to the plan. The plan is left
+ *         unchanged if it can't hold them all.
+ *
+ * \return ATCACERT_E_SUCCESS, ATCACERT_E_BUFFER_TOO_SMALL if the plan is full
+ *         or an error from the location checks
+ */
+static ATCA_STATUS atcacert_plan_add(ATCADevice device, atcacert_read_block_t* plan, size_t* plan_count,
+                                     const atcacert_device_loc_t* device_loc)
+{
+    ATCA_STATUS ret;
+    uint8_t zone = (uint8_t)device_loc->zone;
+    uint16_t slot = atcacert_plan_slot(device_loc);
+    size_t zone_size = 0u;
+    size_t count = device_loc->count;
+    size_t block;
+    size_t new_count = *plan_count;
+
+    if (ATCA_SUCCESS != (ret = atcab_get_zone_size_ext(device, zone, device_loc->slot, &zone_size)))
+    {
+        return ret;
+    }
+    if (device_loc->offset > zone_size)
+    {
+        return ATCACERT_E_BAD_PARAMS;
+    }
+    if ((size_t)device_loc->offset + count > zone_size)
+    {
+        count = zone_size - device_loc->offset;
+    }
+
+    for (block = device_loc->offset / ATCA_BLOCK_SIZE; block * ATCA_BLOCK_SIZE < (size_t)device_loc->offset + count; block++)
+    {
+        if (NULL == atcacert_plan_find(plan, new_count, zone, slot, (uint8_t)block))
+        {
+            if (new_count >= ATCACERT_READ_PLAN_SIZE)
+            {
+                return ATCACERT_E_BUFFER_TOO_SMALL;
+            }
+            plan[new_count].zone = zone;
+            plan[new_count].slot = slot;
+            plan[new_count].block = (uint8_t)block;
+            plan[new_count].length = (uint8_t)(((zone_size - block * ATCA_BLOCK_SIZE) < ATCA_BLOCK_SIZE) ?
+                                               (zone_size - block * ATCA_BLOCK_SIZE) : ATCA_BLOCK_SIZE);
+            new_count++;
+        }
+    }
+    *plan_count = new_count;
+
+    return ATCACERT_E_SUCCESS;
+}
+
+/** \brief Checks whether every block of a location is in the plan */
+static bool atcacert_plan_covers(const atcacert_read_block_t* plan, size_t plan_count,
+                                 const atcacert_device_loc_t* device_loc)
+{
+    size_t block;
+
+    for (block = device_loc->offset / ATCA_BLOCK_SIZE; block * ATCA_BLOCK_SIZE < (size_t)device_loc->offset + device_loc->count; block++)
+    {
+        const atcacert_read_block_t* planned = atcacert_plan_find(plan, plan_count, (uint8_t)device_loc->zone,
+                                                                  atcacert_plan_slot(device_loc), (uint8_t)block);
+        if (NULL == planned)
+        {
+            return false;
+        }
+        if (planned->length < ATCA_BLOCK_SIZE)
+        {
+            break;  // Last block of the zone, the location is truncated here
+        }
+    }
+    return true;
+}
+
+/** \brief Reads one planned block, using word reads for a partial block at
+ *         the end of a zone
+ */
+static ATCA_STATUS atcacert_plan_read(ATCADevice device, const atcacert_read_block_t* planned, uint8_t* block_data)
+{
+    ATCA_STATUS ret = ATCA_SUCCESS;
+    uint8_t word;
+
+    if (ATCA_BLOCK_SIZE == planned->length)
+    {
+        ret = atcab_read_zone_ext(device, planned->zone, planned->slot, planned->block, 0u, block_data, ATCA_BLOCK_SIZE);
+    }
+    else
+    {
+        for (word = 0u; (word * ATCA_WORD_SIZE) < planned->length; word++)
+        {
+            if (ATCA_SUCCESS != (ret = atcab_read_zone_ext(device, planned->zone, planned->slot, planned->block, word,
+                                                           &block_data[word * ATCA_WORD_SIZE], ATCA_WORD_SIZE)))
+            {
+                break;
+            }
+        }
+    }
+    return ret;
+}
+
+/** \brief Copies the part of a block that falls within a location */
+static void atcacert_plan_scatter(const atcacert_read_block_t* planned, const uint8_t* block_data,
+                                  const atcacert_device_loc_t* device_loc, uint8_t* data)
+{
+    size_t block_start = (size_t)planned->block * ATCA_BLOCK_SIZE;
+    size_t block_end = block_start + planned->length;
+    size_t loc_start = device_loc->offset;
+    size_t loc_end = loc_start + device_loc->count;
+    size_t start = (block_start > loc_start) ? block_start : loc_start;
+    size_t end = (block_end < loc_end) ? block_end : loc_end;
+
+    if ((planned->zone == (uint8_t)device_loc->zone) && (planned->slot == atcacert_plan_slot(device_loc)) && (start < end))
+    {
+        (void)memcpy(&data[start - loc_start], &block_data[start - block_start], end - start);
+    }
+}
+#endif
+
+ATCA_STATUS atcacert_read_device_locs_ext(ATCADevice                     device,
+                                          const atcacert_device_loc_t*   device_locs,
+                                          size_t                         device_locs_count,
+                                          uint8_t* const*                data)
+{
+    ATCA_STATUS ret = ATCACERT_E_SUCCESS;
+    size_t i;
+#if ATCA_CA_SUPPORT
+    atcacert_read_block_t plan[ATCACERT_READ_PLAN_SIZE];
+    size_t plan_count = 0;
+    uint8_t block_data[ATCA_BLOCK_SIZE];
+    size_t j;
+#if ATCA_KEEP_AWAKE_EN
+    ATCA_STATUS end_ret;
+#endif
+#endif
+
+#if ATCA_CHECK_PARAMS_EN
+    if ((NULL == device_locs) || (NULL == data))
+    {
+        return ATCACERT_E_BAD_PARAMS;
+    }
+#endif
+
+#if ATCA_CA_SUPPORT
+    if (atcab_is_ca_device(atcab_get_device_type_ext(device)))
+    {
+        // Collect the distinct blocks covering all locations
+        for (i = 0; i < device_locs_count; i++)
+        {
+            if (atcacert_is_plannable_loc(&device_locs[i]))
+            {
+                ret = atcacert_plan_add(device, plan, &plan_count, &device_locs[i]);
+                if ((ATCACERT_E_SUCCESS != ret) && (ATCACERT_E_BUFFER_TOO_SMALL != ret))
+                {
+                    return ret;
+                }
+            }
+        }
+
+#if ATCA_KEEP_AWAKE_EN
+        if (ATCA_SUCCESS != (ret = atcab_session_begin_ext(device)))
+        {
+            return ret;
+        }
+#endif
+        ret = ATCACERT_E_SUCCESS;
+
+        // Read each planned block once and copy it to every location it covers
+        for (j = 0; (j < plan_count) && (ATCACERT_E_SUCCESS == ret); j++)
+        {
+            if (ATCA_SUCCESS == (ret = atcacert_plan_read(device, &plan[j], block_data)))
+            {
+                for (i = 0; i < device_locs_count; i++)
+                {
+                    if (atcacert_is_plannable_loc(&device_locs[i]))
+                    {
+                        atcacert_plan_scatter(&plan[j], block_data, &device_locs[i], data[i]);
+                    }
+                }
+            }
+        }
+
+        // Public keys and locations that didn't fit in the plan
+        for (i = 0; (i < device_locs_count) && (ATCACERT_E_SUCCESS == ret); i++)
+        {
+            if (!atcacert_is_plannable_loc(&device_locs[i]) || !atcacert_plan_covers(plan, plan_count, &device_locs[i]))
+            {
+                ret = atcacert_read_device_loc_ext(device, &device_locs[i], data[i]);
+            }
+        }
+
+#if ATCA_KEEP_AWAKE_EN
+        end_ret = atcab_session_end_ext(device);
+        if (ATCACERT_E_SUCCESS == ret)
+        {
+            ret = end_ret;
+        }
+#endif
+        return ret;
+    }
+#endif
+
+    for (i = 0; (i < device_locs_count) && (ATCACERT_E_SUCCESS == ret); i++)
+    {
+        ret = atcacert_read_device_loc_ext(device, &device_locs[i], data[i]);
+    }
+    return ret;
+}
+#endif
+
+#if ATCACERT_CACHE_EN && ATCACERT_COMPCERT_EN && ATCA_CA_SUPPORT
+/** \brief Zone and slot tracked by a slot generation counter */
+static uint8_t atcacert_cache_gen_zone(size_t index)
+{
+    return (index < (ATCA_SLOT_GENERATION_COUNT - 1u)) ? (uint8_t)DEVZONE_DATA : (uint8_t)DEVZONE_CONFIG;
+}
+
+/** \brief Checks whether an entry was built for the same inputs and none of
+ *         the device locations it was read from have changed since
+ */
+static bool atcacert_cache_match(const atca_cert_cache_t*   entry,
+                                 ATCADevice                 device,
+                                 const atcacert_def_t*      cert_def,
+                                 const uint8_t*             serial_num,
+                                 const cal_buffer*          ca_public_key,
+                                 size_t                     max_cert_size)
+{
+    size_t ca_public_key_size = ((NULL != ca_public_key) && (NULL != ca_public_key->buf)) ? ca_public_key->len : 0u;
+    size_t i;
+
+    if ((0u == entry->cert_size) || (entry->cert_def != (const void*)cert_def)
+        || (entry->max_cert_size != max_cert_size) || (entry->ca_public_key_size != ca_public_key_size))
+    {
+        return false;
+    }
+    if ((0 != memcmp(entry->serial_num, serial_num, ATCA_SERIAL_NUM_SIZE))
+        || ((0u != ca_public_key_size) && (0 != memcmp(entry->ca_public_key, ca_public_key->buf, ca_public_key_size))))
+    {
+        return false;
+    }
+    for (i = 0; i < ATCA_SLOT_GENERATION_COUNT; i++)
+    {
+        if ((0u != (entry->slot_mask & (1UL << i)))
+            && (entry->generation[i] != calib_slot_generation(device, atcacert_cache_gen_zone(i), (uint16_t)i)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/** \brief Copies a cached certificate if one matches */
+static bool atcacert_cache_read(ATCADevice              device,
+                                const atcacert_def_t*   cert_def,
+                                const uint8_t*          serial_num,
+                                const cal_buffer*       ca_public_key,
+                                uint8_t*                cert,
+                                size_t*                 cert_size)
+{
+    size_t i;
+
+    if (NULL == device)
+    {
+        return false;
+    }
+    for (i = 0; i < ATCACERT_CACHE_ENTRIES; i++)
+    {
+        if (atcacert_cache_match(&device->cert_cache[i], device, cert_def, serial_num, ca_public_key, *cert_size))
+        {
+            (void)memcpy(cert, device->cert_cache[i].cert, device->cert_cache[i].cert_size);
+            *cert_size = device->cert_cache[i].cert_size;
+            return true;
+        }
+    }
+    return false;
+}
+
+/** \brief Claims an entry for a certificate about to be built and records
+ *         the generation of every location it will be read from
+ *
+ * \return the entry or NULL if the certificate can't be cached
+ */
+static atca_cert_cache_t* atcacert_cache_begin(ATCADevice                      device,
+                                               const atcacert_def_t*           cert_def,
+                                               const uint8_t*                  serial_num,
+                                               const cal_buffer*               ca_public_key,
+                                               size_t                          max_cert_size,
+                                               const atcacert_device_loc_t*    device_locs,
+                                               size_t                          device_locs_count)
+{
+    atca_cert_cache_t* entry;
+    size_t ca_public_key_size = ((NULL != ca_public_key) && (NULL != ca_public_key->buf)) ? ca_public_key->len : 0u;
+    uint32_t slot_mask = 0u;
+    size_t i;
+
+    if ((NULL == device) || (max_cert_size > ATCACERT_CACHE_CERT_SIZE)
+        || (ca_public_key_size > sizeof(entry->ca_public_key)))
+    {
+        return NULL;
+    }
+
+    for (i = 0; i < device_locs_count; i++)
+    {
+        if ((DEVZONE_DATA == device_locs[i].zone) && (device_locs[i].slot < (ATCA_SLOT_GENERATION_COUNT - 1u)))
+        {
+            slot_mask |= (1UL << device_locs[i].slot);
+        }
+        else if ((DEVZONE_CONFIG == device_locs[i].zone) || (DEVZONE_OTP == device_locs[i].zone))
+        {
+            slot_mask |= (1UL << (ATCA_SLOT_GENERATION_COUNT - 1u));
+        }
+        else
+        {
+            // Location isn't tracked so the certificate can't be cached
+            return NULL;
+        }
+    }
+
+    entry = &device->cert_cache[device->cert_cache_next];
+    device->cert_cache_next = (uint8_t)((device->cert_cache_next + 1u) % ATCACERT_CACHE_ENTRIES);
+
+    entry->cert_size = 0u;
+    entry->cert_def = cert_def;
+    (void)memcpy(entry->serial_num, serial_num, ATCA_SERIAL_NUM_SIZE);
+    entry->ca_public_key_size = ca_public_key_size;
+    if (0u != ca_public_key_size)
+    {
+        (void)memcpy(entry->ca_public_key, ca_public_key->buf, ca_public_key_size);
+    }
+    entry->max_cert_size = max_cert_size;
+    entry->slot_mask = slot_mask;
+    for (i = 0; i < ATCA_SLOT_GENERATION_COUNT; i++)
+    {
+        entry->generation[i] = calib_slot_generation(device, atcacert_cache_gen_zone(i), (uint16_t)i);
+    }
+
+    return entry;
+}
+
+void atcacert_cache_clear_ext(ATCADevice device)
+{
+    size_t i;
+
+    if (NULL != device)
+    {
+        for (i = 0; i < ATCACERT_CACHE_ENTRIES; i++)
+        {
+            device->cert_cache[i].cert_size = 0u;
+        }
+    }
+}
+
+void atcacert_cache_clear(void)
+{
+    atcacert_cache_clear_ext(atcab_get_device());
+}
 #endif
 
 ATCA_STATUS atcacert_read_cert_ext(ATCADevice               device,
@@ -223,6 +619,13 @@ ATCA_STATUS atcacert_read_cert_ext(ATCADevice               device,
     size_t device_locs_count = 0;
     size_t i = 0;
     atcacert_build_state_t build_state;
+    static uint8_t data[ATCA_MAX_DATA_SIZE];
+    uint8_t* loc_data[ATCA_MAX_SLOT_NUM];
+    size_t loc_data_size = 0u;
+#endif
+#if ATCACERT_CACHE_EN && ATCACERT_COMPCERT_EN && ATCA_CA_SUPPORT
+    atca_cert_cache_t* cache_entry = NULL;
+    uint8_t serial_num[ATCA_SERIAL_NUM_SIZE];
 #endif
 
     UNUSED_VAR(ca_public_key->buf[0]);
@@ -296,6 +699,19 @@ ATCA_STATUS atcacert_read_cert_ext(ATCADevice               device,
             return ret;
         }
 
+#if ATCACERT_CACHE_EN && ATCA_CA_SUPPORT
+        if (atcab_is_ca_device(atcab_get_device_type_ext(device))
+            && (ATCA_SUCCESS == atcab_read_serial_number_ext(device, serial_num)))
+        {
+            if (atcacert_cache_read(device, cert_def, serial_num, ca_public_key, cert, cert_size))
+            {
+                return ATCACERT_E_SUCCESS;
+            }
+            cache_entry = atcacert_cache_begin(device, cert_def, serial_num, ca_public_key, *cert_size,
+                                               device_locs, device_locs_count);
+        }
+#endif
+
         ret = atcacert_cert_build_start(device, &build_state, cert_def, cert, cert_size, ca_public_key);
         if (ret != ATCACERT_E_SUCCESS)
         {
@@ -304,18 +720,50 @@ ATCA_STATUS atcacert_read_cert_ext(ATCADevice               device,
 
         for (i = 0; i < device_locs_count; i++)
         {
-            static uint8_t data[ATCA_MAX_DATA_SIZE];
-            ret = atcacert_read_device_loc_ext(device, &device_locs[i], data);
-            if (ret != ATCACERT_E_SUCCESS)
+            loc_data_size += device_locs[i].count;
+        }
+
+        if (loc_data_size <= sizeof(data))
+        {
+            // Read all locations together so shared blocks are read once
+            loc_data_size = 0u;
+            for (i = 0; i < device_locs_count; i++)
             {
-                return ret;
+                loc_data[i] = &data[loc_data_size];
+                loc_data_size += device_locs[i].count;
             }
 
-            ret = atcacert_cert_build_process(&build_state, &device_locs[i], data);
+            ret = atcacert_read_device_locs_ext(device, device_locs, device_locs_count, loc_data);
             if (ret != ATCACERT_E_SUCCESS)
             {
                 return ret;
             }
+
+            for (i = 0; i < device_locs_count; i++)
+            {
+                ret = atcacert_cert_build_process(&build_state, &device_locs[i], loc_data[i]);
+                if (ret != ATCACERT_E_SUCCESS)
+                {
+                    return ret;
+                }
+            }
+        }
+        else
+        {
+            for (i = 0; i < device_locs_count; i++)
+            {
+                ret = atcacert_read_device_loc_ext(device, &device_locs[i], data);
+                if (ret != ATCACERT_E_SUCCESS)
+                {
+                    return ret;
+                }
+
+                ret = atcacert_cert_build_process(&build_state, &device_locs[i], data);
+                if (ret != ATCACERT_E_SUCCESS)
+                {
+                    return ret;
+                }
+            }
         }
 
         ret = atcacert_cert_build_finish(&build_state);
@@ -323,6 +771,14 @@ ATCA_STATUS atcacert_read_cert_ext(ATCADevice               device,
         {
             return ret;
         }
+
+#if ATCACERT_CACHE_EN && ATCA_CA_SUPPORT
+        if ((NULL != cache_entry) && (*cert_size <= sizeof(cache_entry->cert)))
+        {
+            (void)memcpy(cache_entry->cert, cert, *cert_size);
+            cache_entry->cert_size = *cert_size;
+        }
+#endif
 #endif
     }
 
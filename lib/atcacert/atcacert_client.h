@@ -71,6 +71,28 @@ ATCA_STATUS atcacert_read_device_loc(const atcacert_device_loc_t* device_loc,
 ATCA_STATUS atcacert_read_device_loc_ext(ATCADevice                   device,
                                          const atcacert_device_loc_t* device_loc,
                                          uint8_t*                     data);
+
+/** \brief Read the data for a list of device locations with as few reads as
+ *         possible.
+ *
+ * Locations in the config, OTP and data zones are planned into the distinct
+ * 32-byte blocks covering them. Each block is read once, in a single wake
+ * session, and copied to every location it overlaps. Locations from several
+ * certificate definitions (e.g. a signer and device chain gathered with
+ * atcacert_get_device_locs) can be read together.
+ *
+ * \param[in]  device             Device context
+ * \param[in]  device_locs        Device locations to read data from.
+ * \param[in]  device_locs_count  Number of device locations.
+ * \param[out] data               Array of device_locs_count buffers. The data
+ *                                of each location is returned in its buffer.
+ *
+ * \return ATCACERT_E_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcacert_read_device_locs_ext(ATCADevice                   device,
+                                          const atcacert_device_loc_t* device_locs,
+                                          size_t                       device_locs_count,
+                                          uint8_t* const*              data);
 #endif
 
 /**
@@ -127,6 +149,22 @@ ATCA_STATUS atcacert_read_cert_ext(ATCADevice            device,
                                    uint8_t*              cert,
                                    size_t*               cert_size);
 
+#if ATCACERT_CACHE_EN && ATCACERT_COMPCERT_EN && ATCA_CA_SUPPORT
+/**
+ * \brief Drops all certificates cached by atcacert_read_cert for the global
+ *        device. Entries are otherwise dropped automatically when a slot they
+ *        were read from is changed through this library.
+ */
+void atcacert_cache_clear(void);
+
+/**
+ * \brief Drops all certificates cached by atcacert_read_cert_ext for a device.
+ *
+ * \param[in] device  Device context
+ */
+void atcacert_cache_clear_ext(ATCADevice device);
+#endif
+
 /**
  * \brief Take a full certificate and write it to the ATECC508A device according to the
  *        certificate definition.
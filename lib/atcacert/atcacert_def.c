@@ -29,6 +29,9 @@
 #include "crypto/atca_crypto_sw.h"
 #include "crypto/atca_crypto_sw_sha1.h"
 #include "crypto/atca_crypto_sw_sha2.h"
+#if ATCA_CRYPTO_SHA256_EN
+#include "crypto/hashes/sha2_routines.h"
+#endif
 #include "atcacert_der.h"
 #include "atcacert_date.h"
 #include <string.h>
@@ -2348,25 +2351,10 @@ ATCA_STATUS atcacert_get_tbs(const atcacert_def_t*  cert_def,
     return ATCACERT_E_SUCCESS;
 }
 
-ATCA_STATUS atcacert_get_tbs_digest(const atcacert_def_t*   cert_def,
-                                    const uint8_t*          cert,
-                                    size_t                  cert_size,
-                                    cal_buffer*             tbs_digest)
+/** \brief Hash TBS data with the algorithm selected by the digest buffer length */
+static ATCA_STATUS atcacert_calc_tbs_digest(const uint8_t* tbs, size_t tbs_size, cal_buffer* tbs_digest)
 {
     ATCA_STATUS ret = ATCACERT_E_SUCCESS;
-    const uint8_t* tbs = NULL;
-    size_t tbs_size = 0;
-
-    if (cert_def == NULL || cert == NULL || tbs_digest == NULL || tbs_digest->buf == NULL)
-    {
-        return ATCACERT_E_BAD_PARAMS;
-    }
-
-    ret = atcacert_get_tbs(cert_def, cert, cert_size, &tbs, &tbs_size);
-    if (ret != ATCACERT_E_SUCCESS)
-    {
-        return ret;
-    }
 
     if (ATCA_SHA2_256_DIGEST_SIZE == tbs_digest->len)
     {
@@ -2391,11 +2379,106 @@ ATCA_STATUS atcacert_get_tbs_digest(const atcacert_def_t*   cert_def,
         ret = ATCACERT_E_BAD_PARAMS;
     }
 
+    return ret;
+}
+
+ATCA_STATUS atcacert_get_tbs_digest(const atcacert_def_t*   cert_def,
+                                    const uint8_t*          cert,
+                                    size_t                  cert_size,
+                                    cal_buffer*             tbs_digest)
+{
+    ATCA_STATUS ret = ATCACERT_E_SUCCESS;
+    const uint8_t* tbs = NULL;
+    size_t tbs_size = 0;
+
+    if (cert_def == NULL || cert == NULL || tbs_digest == NULL || tbs_digest->buf == NULL)
+    {
+        return ATCACERT_E_BAD_PARAMS;
+    }
+
+    ret = atcacert_get_tbs(cert_def, cert, cert_size, &tbs, &tbs_size);
     if (ret != ATCACERT_E_SUCCESS)
     {
         return ret;
     }
 
+    return atcacert_calc_tbs_digest(tbs, tbs_size, tbs_digest);
+}
+
+ATCA_STATUS atcacert_get_tbs_digest_batch(const atcacert_def_t*   cert_def,
+                                          const uint8_t* const    certs[],
+                                          const size_t            cert_sizes[],
+                                          size_t                  count,
+                                          cal_buffer              tbs_digests[])
+{
+    ATCA_STATUS ret = ATCACERT_E_SUCCESS;
+    const uint8_t* tbs = NULL;
+    size_t tbs_size = 0;
+    size_t i;
+#if ATCA_CRYPTO_SHA256_EN
+    const uint8_t* batch_tbs[ATCACERT_TBS_DIGEST_BATCH_SIZE];
+    uint32_t batch_tbs_size[ATCACERT_TBS_DIGEST_BATCH_SIZE];
+    uint8_t batch_digest[ATCACERT_TBS_DIGEST_BATCH_SIZE][ATCA_SHA2_256_DIGEST_SIZE];
+    size_t batch_index[ATCACERT_TBS_DIGEST_BATCH_SIZE];
+    uint32_t batch_count = 0u;
+    uint32_t j;
+#endif
+
+    if (cert_def == NULL || (count > 0u && (certs == NULL || cert_sizes == NULL || tbs_digests == NULL)))
+    {
+        return ATCACERT_E_BAD_PARAMS;
+    }
+
+    for (i = 0; (i < count) && (ATCACERT_E_SUCCESS == ret); i++)
+    {
+        if (certs[i] == NULL || tbs_digests[i].buf == NULL)
+        {
+            ret = ATCACERT_E_BAD_PARAMS;
+            break;
+        }
+
+        ret = atcacert_get_tbs(cert_def, certs[i], cert_sizes[i], &tbs, &tbs_size);
+        if (ret != ATCACERT_E_SUCCESS)
+        {
+            break;
+        }
+
+#if ATCA_CRYPTO_SHA256_EN
+        if ((ATCA_SHA2_256_DIGEST_SIZE == tbs_digests[i].len) && (tbs_size <= UINT32_MAX))
+        {
+            // Collect SHA256 digests so they get hashed side by side
+            batch_tbs[batch_count] = tbs;
+            batch_tbs_size[batch_count] = (uint32_t)tbs_size;
+            batch_index[batch_count] = i;
+            batch_count++;
+
+            if ((ATCACERT_TBS_DIGEST_BATCH_SIZE == batch_count) || ((i + 1u) == count))
+            {
+                ret = sw_sha256_multi(batch_tbs, batch_tbs_size, batch_count, batch_digest);
+                for (j = 0u; (j < batch_count) && (ATCACERT_E_SUCCESS == ret); j++)
+                {
+                    (void)memcpy(tbs_digests[batch_index[j]].buf, batch_digest[j], ATCA_SHA2_256_DIGEST_SIZE);
+                }
+                batch_count = 0u;
+            }
+            continue;
+        }
+#endif
+        ret = atcacert_calc_tbs_digest(tbs, tbs_size, &tbs_digests[i]);
+    }
+
+#if ATCA_CRYPTO_SHA256_EN
+    // Digests still collected when the last certificate used another hash
+    if ((ATCACERT_E_SUCCESS == ret) && (0u < batch_count))
+    {
+        ret = sw_sha256_multi(batch_tbs, batch_tbs_size, batch_count, batch_digest);
+        for (j = 0u; (j < batch_count) && (ATCACERT_E_SUCCESS == ret); j++)
+        {
+            (void)memcpy(tbs_digests[batch_index[j]].buf, batch_digest[j], ATCA_SHA2_256_DIGEST_SIZE);
+        }
+    }
+#endif
+
     return ret;
 }
 
@@ -826,6 +826,26 @@ ATCA_STATUS atcacert_get_tbs_digest(const atcacert_def_t *  cert_def,
                                     size_t                  cert_size,
                                     cal_buffer*             tbs_digest);
 
+/**
+ * \brief Get the digests of the TBS data of several certificates sharing a
+ *        certificate definition. SHA256 digests are computed side by side
+ *        with sw_sha256_multi when the software SHA256 is in use.
+ *
+ * \param[in]  cert_def     Certificate definition for the certificates.
+ * \param[in]  certs        Certificates to get the TBS digests for.
+ * \param[in]  cert_sizes   Size of each certificate in bytes.
+ * \param[in]  count        Number of certificates.
+ * \param[out] tbs_digests  TBS data digest of each certificate will be returned here. The
+ *                          length of each buffer selects SHA256, SHA384 or SHA512.
+ *
+ * \return ATCACERT_E_SUCCESS on success, otherwise the error of the first certificate that failed.
+ */
+ATCA_STATUS atcacert_get_tbs_digest_batch(const atcacert_def_t *  cert_def,
+                                          const uint8_t * const   certs[],
+                                          const size_t            cert_sizes[],
+                                          size_t                  count,
+                                          cal_buffer              tbs_digests[]);
+
 /**
  * \brief Sets an element in a certificate. The data_size must match the size in cert_loc.
  *
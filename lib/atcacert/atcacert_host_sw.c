@@ -32,20 +32,14 @@
 #if ATCACERT_EN 
 
 #if ATCAC_VERIFY_EN && ATCACERT_COMPCERT_EN
-ATCA_STATUS atcacert_verify_cert_sw(const atcacert_def_t* cert_def,
-                                    const uint8_t*        cert,
-                                    size_t                cert_size,
-                                    const cal_buffer*     ca_public_key)
+ATCA_STATUS atcacert_verifier_init(atcacert_verifier_t* verifier,
+                                   const cal_buffer*    ca_public_key)
 {
-    ATCA_STATUS ret = 0;
-    uint8_t tbs_digest[ATCA_SHA2_512_DIGEST_SIZE];
-    cal_buffer dig = CAL_BUF_INIT(0u, tbs_digest);
-    uint8_t signature[ATCA_MAX_ECC_SIG_SIZE];
-    cal_buffer sig = CAL_BUF_INIT(0u, signature);
-    atcac_pk_ctx_t pkey_ctx;
+    ATCA_STATUS ret = ATCACERT_E_SUCCESS;
+    uint8_t key_type = ATCA_KEY_TYPE_ECCP256;
 
 #if ATCA_CHECK_PARAMS_EN
-    if (cert_def == NULL || ca_public_key == NULL || cert == NULL)
+    if (verifier == NULL || ca_public_key == NULL || ca_public_key->buf == NULL)
     {
         return ATCACERT_E_BAD_PARAMS;
     }
@@ -53,15 +47,17 @@ ATCA_STATUS atcacert_verify_cert_sw(const atcacert_def_t* cert_def,
 
     switch(ca_public_key->len)
     {
-        case ATCA_KEY_TYPE_ECCP256:
-            dig.len = ATCA_SHA2_256_DIGEST_SIZE;
+        case ATCA_ECCP256_PUBKEY_SIZE:
+            verifier->digest_len = ATCA_SHA2_256_DIGEST_SIZE;
             break;
 #if ATCA_TA_SUPPORT
-        case TA_KEY_TYPE_ECCP384_SIZE:
-            dig.len = ATCA_SHA2_384_DIGEST_SIZE;
+        case ATCA_ECCP384_PUBKEY_SIZE:
+            key_type = TA_KEY_TYPE_ECCP384;
+            verifier->digest_len = ATCA_SHA2_384_DIGEST_SIZE;
             break;
-        case TA_KEY_TYPE_ECCP521_SIZE:
-            dig.len = ATCA_SHA2_512_DIGEST_SIZE;
+        case ATCA_ECCP521_PUBKEY_SIZE:
+            key_type = TA_KEY_TYPE_ECCP521;
+            verifier->digest_len = ATCA_SHA2_512_DIGEST_SIZE;
             break;
 #endif
         default:
@@ -73,31 +69,190 @@ ATCA_STATUS atcacert_verify_cert_sw(const atcacert_def_t* cert_def,
         return ret;
     }
 
-    ret = atcacert_get_tbs_digest(cert_def, cert, cert_size, &dig);
+    /* Initialize the key using the provided X,Y cordinantes. The backend key object (and any
+       curve tables it builds) then lives until atcacert_verifier_free */
+    return atcac_pk_init(&verifier->pkey_ctx, ca_public_key->buf, ca_public_key->len, key_type, true);
+}
+
+/* Check the signature of a certificate whose TBS digest has already been computed */
+static ATCA_STATUS atcacert_verifier_check(atcacert_verifier_t*  verifier,
+                                           const atcacert_def_t* cert_def,
+                                           const uint8_t*        cert,
+                                           size_t                cert_size,
+                                           const uint8_t*        tbs_digest)
+{
+    ATCA_STATUS ret;
+    uint8_t signature[ATCA_MAX_ECC_SIG_SIZE];
+    cal_buffer sig = CAL_BUF_INIT(0u, signature);
+
+    sig.len = (0u == cert_def->std_sig_size) ? ATCA_ECCP256_SIG_SIZE : cert_def->std_sig_size;
+    ret = atcacert_get_signature(cert_def, cert, cert_size, &sig);
     if (ret != ATCACERT_E_SUCCESS)
     {
         return ret;
     }
 
-    sig.len = (0u == cert_def->std_sig_size) ? ATCA_ECCP256_SIG_SIZE : cert_def->std_sig_size;
-    ret = atcacert_get_signature(cert_def, cert, cert_size, &sig);
+    return atcac_pk_verify(&verifier->pkey_ctx, tbs_digest, verifier->digest_len, signature, sig.len);
+}
+
+ATCA_STATUS atcacert_verifier_verify(atcacert_verifier_t*  verifier,
+                                     const atcacert_def_t* cert_def,
+                                     const uint8_t*        cert,
+                                     size_t                cert_size)
+{
+    ATCA_STATUS ret;
+    uint8_t tbs_digest[ATCA_SHA2_512_DIGEST_SIZE];
+    cal_buffer dig = CAL_BUF_INIT(0u, tbs_digest);
+
+#if ATCA_CHECK_PARAMS_EN
+    if (verifier == NULL || cert_def == NULL || cert == NULL)
+    {
+        return ATCACERT_E_BAD_PARAMS;
+    }
+#endif
+
+    dig.len = verifier->digest_len;
+    ret = atcacert_get_tbs_digest(cert_def, cert, cert_size, &dig);
     if (ret != ATCACERT_E_SUCCESS)
     {
         return ret;
     }
 
-    /* Initialize the key using the provided X,Y cordinantes */
-    ret = atcac_pk_init(&pkey_ctx, ca_public_key->buf, ca_public_key->len, 0, true);
+    return atcacert_verifier_check(verifier, cert_def, cert, cert_size, tbs_digest);
+}
+
+ATCA_STATUS atcacert_verifier_verify_batch(atcacert_verifier_t*  verifier,
+                                           const atcacert_def_t* cert_def,
+                                           const uint8_t* const  certs[],
+                                           const size_t          cert_sizes[],
+                                           size_t                count,
+                                           ATCA_STATUS           results[])
+{
+    ATCA_STATUS ret;
+    ATCA_STATUS first_error = ATCACERT_E_SUCCESS;
+    uint8_t tbs_digest[ATCACERT_TBS_DIGEST_BATCH_SIZE][ATCA_SHA2_512_DIGEST_SIZE];
+    cal_buffer dig[ATCACERT_TBS_DIGEST_BATCH_SIZE];
+    size_t start;
+    size_t batch;
+    size_t i;
+
+#if ATCA_CHECK_PARAMS_EN
+    if (verifier == NULL || cert_def == NULL || (count > 0u && (certs == NULL || cert_sizes == NULL || results == NULL)))
+    {
+        return ATCACERT_E_BAD_PARAMS;
+    }
+#endif
+
+    for (start = 0; start < count; start += batch)
+    {
+        batch = count - start;
+        if (batch > ATCACERT_TBS_DIGEST_BATCH_SIZE)
+        {
+            batch = ATCACERT_TBS_DIGEST_BATCH_SIZE;
+        }
+
+        for (i = 0; i < batch; i++)
+        {
+            dig[i].buf = tbs_digest[i];
+            dig[i].len = verifier->digest_len;
+            results[start + i] = ATCACERT_E_SUCCESS;
+        }
+
+        ret = atcacert_get_tbs_digest_batch(cert_def, &certs[start], &cert_sizes[start], batch, dig);
+        if (ret != ATCACERT_E_SUCCESS)
+        {
+            /* Find out which certificates are bad */
+            for (i = 0; i < batch; i++)
+            {
+                results[start + i] = atcacert_get_tbs_digest(cert_def, certs[start + i], cert_sizes[start + i], &dig[i]);
+            }
+        }
+
+        for (i = 0; i < batch; i++)
+        {
+            if (results[start + i] == ATCACERT_E_SUCCESS)
+            {
+                results[start + i] = atcacert_verifier_check(verifier, cert_def, certs[start + i], cert_sizes[start + i], tbs_digest[i]);
+            }
+
+            if ((first_error == ATCACERT_E_SUCCESS) && (results[start + i] != ATCACERT_E_SUCCESS))
+            {
+                first_error = results[start + i];
+            }
+        }
+    }
+
+    return first_error;
+}
+
+ATCA_STATUS atcacert_verifier_free(atcacert_verifier_t* verifier)
+{
+#if ATCA_CHECK_PARAMS_EN
+    if (verifier == NULL)
+    {
+        return ATCACERT_E_BAD_PARAMS;
+    }
+#endif
+
+    return atcac_pk_free(&verifier->pkey_ctx);
+}
+
+ATCA_STATUS atcacert_verify_cert_sw(const atcacert_def_t* cert_def,
+                                    const uint8_t*        cert,
+                                    size_t                cert_size,
+                                    const cal_buffer*     ca_public_key)
+{
+    ATCA_STATUS ret;
+    atcacert_verifier_t verifier;
+
+#if ATCA_CHECK_PARAMS_EN
+    if (cert_def == NULL || ca_public_key == NULL || cert == NULL)
+    {
+        return ATCACERT_E_BAD_PARAMS;
+    }
+#endif
+
+    ret = atcacert_verifier_init(&verifier, ca_public_key);
     if (ret != ATCACERT_E_SUCCESS)
     {
         return ret;
     }
 
-    /* Perform the verification */
-    ret = atcac_pk_verify(&pkey_ctx, tbs_digest, sizeof(tbs_digest), signature, sig.len);
+    ret = atcacert_verifier_verify(&verifier, cert_def, cert, cert_size);
 
     /* Make sure to free the key before testing the result of the verify */
-    (void)atcac_pk_free(&pkey_ctx);
+    (void)atcacert_verifier_free(&verifier);
+
+    return ret;
+}
+
+ATCA_STATUS atcacert_verify_cert_sw_batch(const atcacert_def_t* cert_def,
+                                          const uint8_t* const  certs[],
+                                          const size_t          cert_sizes[],
+                                          size_t                count,
+                                          const cal_buffer*     ca_public_key,
+                                          ATCA_STATUS           results[])
+{
+    ATCA_STATUS ret;
+    atcacert_verifier_t verifier;
+
+#if ATCA_CHECK_PARAMS_EN
+    if (cert_def == NULL || ca_public_key == NULL || (count > 0u && (certs == NULL || cert_sizes == NULL || results == NULL)))
+    {
+        return ATCACERT_E_BAD_PARAMS;
+    }
+#endif
+
+    /* The CA key is shared by every certificate so it is only loaded once */
+    ret = atcacert_verifier_init(&verifier, ca_public_key);
+    if (ret != ATCACERT_E_SUCCESS)
+    {
+        return ret;
+    }
+
+    ret = atcacert_verifier_verify_batch(&verifier, cert_def, certs, cert_sizes, count, results);
+
+    (void)atcacert_verifier_free(&verifier);
 
     return ret;
 }
@@ -48,9 +48,76 @@ extern "C" {
    @{ */
 
 #if ATCAC_VERIFY_EN && ATCACERT_COMPCERT_EN
+/** \brief Certificate verification context. Holds a certificate authority public key that has
+ *         been imported into the crypto backend so many certificates can be checked against it.
+ */
+typedef struct atcacert_verifier_s
+{
+    atcac_pk_ctx_t pkey_ctx;    //!< Imported CA public key
+    size_t         digest_len;  //!< TBS digest size matching the CA key curve
+} atcacert_verifier_t;
+
+/**
+ * \brief Import a certificate authority public key into a verification context.
+ *
+ * \param[out] verifier       Verification context to initialize.
+ * \param[in]  ca_public_key  Buffer pointing to the ECC P256/P384/P521 public key of the
+ *                            certificate authority. Formatted as the X and Y integers
+ *                            concatenated together.
+ *
+ * \return ATCACERT_E_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcacert_verifier_init(atcacert_verifier_t* verifier,
+                                   const cal_buffer*    ca_public_key);
+
+/**
+ * \brief Verify a certificate against the CA public key held by a verification context.
+ *
+ * \param[in] verifier   Verification context initialized by atcacert_verifier_init.
+ * \param[in] cert_def   Certificate definition describing how to extract the TBS and signature
+ *                       components from the certificate specified.
+ * \param[in] cert       Certificate to verify.
+ * \param[in] cert_size  Size of the certificate (cert) in bytes.
+ *
+ * \return ATCACERT_E_SUCCESS if the certificate verified, otherwise an error code.
+ */
+ATCA_STATUS atcacert_verifier_verify(atcacert_verifier_t*  verifier,
+                                     const atcacert_def_t* cert_def,
+                                     const uint8_t*        cert,
+                                     size_t                cert_size);
+
+/**
+ * \brief Verify a batch of certificates against the CA public key held by a verification
+ *        context. The TBS digests are computed several at a time.
+ *
+ * \param[in]  verifier    Verification context initialized by atcacert_verifier_init.
+ * \param[in]  cert_def    Certificate definition shared by all the certificates.
+ * \param[in]  certs       Certificates to verify.
+ * \param[in]  cert_sizes  Size of each certificate in bytes.
+ * \param[in]  count       Number of certificates.
+ * \param[out] results     Verification result of each certificate.
+ *
+ * \return ATCACERT_E_SUCCESS if every certificate verified, otherwise the first failing result.
+ */
+ATCA_STATUS atcacert_verifier_verify_batch(atcacert_verifier_t*  verifier,
+                                           const atcacert_def_t* cert_def,
+                                           const uint8_t* const  certs[],
+                                           const size_t          cert_sizes[],
+                                           size_t                count,
+                                           ATCA_STATUS           results[]);
+
+/**
+ * \brief Release the CA public key held by a verification context.
+ *
+ * \param[in] verifier  Verification context to release.
+ *
+ * \return ATCACERT_E_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcacert_verifier_free(atcacert_verifier_t* verifier);
+
 /**
  * \brief Verify a certificate against its certificate authority's public key using software crypto
- *        functions.The function is currently not implemented.
+ *        functions. Use an atcacert_verifier_t when several certificates share the same CA.
  *
  * \param[in] cert_def       Certificate definition describing how to extract the TBS and signature
  *                           components from the certificate specified.
@@ -60,12 +127,34 @@ extern "C" {
  *                           authority that signed this certificate. Formatted as the X and Y integers 
  *                           concatenated together.                      
  *
- * \return ATCA_UNIMPLEMENTED , as the function is currently not implemented.
+ * \return ATCACERT_E_SUCCESS if the certificate verified, otherwise an error code.
  */
 ATCA_STATUS atcacert_verify_cert_sw(const atcacert_def_t* cert_def,
                                     const uint8_t*        cert,
                                     size_t                cert_size,
                                     const cal_buffer*     ca_public_key);
+
+/**
+ * \brief Verify a batch of certificates issued by the same certificate authority using software
+ *        crypto functions. The TBS digests are computed several at a time and the CA key is only
+ *        loaded once.
+ *
+ * \param[in]  cert_def       Certificate definition shared by all the certificates.
+ * \param[in]  certs          Certificates to verify.
+ * \param[in]  cert_sizes     Size of each certificate in bytes.
+ * \param[in]  count          Number of certificates.
+ * \param[in]  ca_public_key  Buffer pointing to the ECC P256/P384/P521 public key of the certificate
+ *                            authority that signed the certificates.
+ * \param[out] results        Verification result of each certificate.
+ *
+ * \return ATCACERT_E_SUCCESS if every certificate verified, otherwise the first failing result.
+ */
+ATCA_STATUS atcacert_verify_cert_sw_batch(const atcacert_def_t* cert_def,
+                                          const uint8_t* const  certs[],
+                                          const size_t          cert_sizes[],
+                                          size_t                count,
+                                          const cal_buffer*     ca_public_key,
+                                          ATCA_STATUS           results[]);
 #endif
 
 
@@ -49,6 +49,208 @@ const char* atca_basic_aes_gcm_version = "2.0";
 /* Compatibility define */
 #define RETURN  return ATCA_TRACE
 
+#if CALIB_GHASH_ENGINE == CALIB_GHASH_HOST_CLMUL
+#if defined(__PCLMUL__) && defined(__SSSE3__)
+#define CALIB_GHASH_PCLMUL
+#include <wmmintrin.h>
+#include <tmmintrin.h>
+#elif defined(__aarch64__) && (defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES))
+#define CALIB_GHASH_PMULL
+#include <arm_neon.h>
+#endif
+#endif
+
+#if defined(CALIB_GHASH_PCLMUL)
+/** \brief Multiplies two GHASH field elements (z = x * h) with PCLMULQDQ.
+ *
+ * The operands are byte reversed so the bit reflected GCM representation can
+ * be multiplied directly; the 256-bit product is shifted left by one and
+ * reduced modulo x^128 + x^7 + x^2 + x + 1.
+ */
+static void calib_aes_gcm_gfmul_clmul(const uint8_t* x, const uint8_t* h, uint8_t* z)
+{
+    const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    __m128i a = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)x), bswap);
+    __m128i b = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)h), bswap);
+    __m128i lo;
+    __m128i hi;
+    __m128i mid;
+    __m128i t1;
+    __m128i t2;
+    __m128i t3;
+
+    lo = _mm_clmulepi64_si128(a, b, 0x00);
+    hi = _mm_clmulepi64_si128(a, b, 0x11);
+    mid = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10), _mm_clmulepi64_si128(a, b, 0x01));
+    lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+    hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+
+    // Shift the product left by one to account for the reflected bit order
+    t1 = _mm_srli_epi32(lo, 31);
+    t2 = _mm_srli_epi32(hi, 31);
+    lo = _mm_slli_epi32(lo, 1);
+    hi = _mm_slli_epi32(hi, 1);
+    t3 = _mm_srli_si128(t1, 12);
+    t2 = _mm_slli_si128(t2, 4);
+    t1 = _mm_slli_si128(t1, 4);
+    lo = _mm_or_si128(lo, t1);
+    hi = _mm_or_si128(hi, t2);
+    hi = _mm_or_si128(hi, t3);
+
+    // Reduce
+    t1 = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(lo, 31), _mm_slli_epi32(lo, 30)), _mm_slli_epi32(lo, 25));
+    t2 = _mm_srli_si128(t1, 4);
+    t1 = _mm_slli_si128(t1, 12);
+    lo = _mm_xor_si128(lo, t1);
+    t3 = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2)), _mm_srli_epi32(lo, 7));
+    t3 = _mm_xor_si128(t3, t2);
+    lo = _mm_xor_si128(lo, t3);
+    hi = _mm_xor_si128(hi, lo);
+
+    _mm_storeu_si128((__m128i*)z, _mm_shuffle_epi8(hi, bswap));
+}
+#elif defined(CALIB_GHASH_PMULL)
+/** \brief Multiplies two GHASH field elements (z = x * h) with PMULL.
+ *
+ * Reversing the bits of every byte turns the GCM representation into a plain
+ * little endian polynomial which is multiplied and then reduced modulo
+ * x^128 + x^7 + x^2 + x + 1 by folding the upper half twice.
+ */
+static void calib_aes_gcm_gfmul_clmul(const uint8_t* x, const uint8_t* h, uint8_t* z)
+{
+    uint64x2_t a = vreinterpretq_u64_u8(vrbitq_u8(vld1q_u8(x)));
+    uint64x2_t b = vreinterpretq_u64_u8(vrbitq_u8(vld1q_u8(h)));
+    uint64x2_t lo = vreinterpretq_u64_p128(vmull_p64((poly64_t)vgetq_lane_u64(a, 0), (poly64_t)vgetq_lane_u64(b, 0)));
+    uint64x2_t hi = vreinterpretq_u64_p128(vmull_p64((poly64_t)vgetq_lane_u64(a, 1), (poly64_t)vgetq_lane_u64(b, 1)));
+    uint64x2_t mid = veorq_u64(vreinterpretq_u64_p128(vmull_p64((poly64_t)vgetq_lane_u64(a, 0), (poly64_t)vgetq_lane_u64(b, 1))),
+                               vreinterpretq_u64_p128(vmull_p64((poly64_t)vgetq_lane_u64(a, 1), (poly64_t)vgetq_lane_u64(b, 0))));
+    uint64_t r0 = vgetq_lane_u64(lo, 0);
+    uint64_t r1 = vgetq_lane_u64(lo, 1) ^ vgetq_lane_u64(mid, 0);
+    uint64_t r2 = vgetq_lane_u64(hi, 0) ^ vgetq_lane_u64(mid, 1);
+    uint64_t r3 = vgetq_lane_u64(hi, 1);
+    uint64x2_t fold;
+
+    // x^128 = x^7 + x^2 + x + 1
+    fold = vreinterpretq_u64_p128(vmull_p64((poly64_t)r3, (poly64_t)0x87u));
+    r1 ^= vgetq_lane_u64(fold, 0);
+    r2 ^= vgetq_lane_u64(fold, 1);
+    fold = vreinterpretq_u64_p128(vmull_p64((poly64_t)r2, (poly64_t)0x87u));
+    r0 ^= vgetq_lane_u64(fold, 0);
+    r1 ^= vgetq_lane_u64(fold, 1);
+
+    vst1q_u8(z, vrbitq_u8(vreinterpretq_u8_u64(vcombine_u64(vcreate_u64(r0), vcreate_u64(r1)))));
+}
+#endif
+
+#if CALIB_GHASH_ENGINE != CALIB_GHASH_DEVICE
+/** \brief Loads 8 bytes as a big endian value */
+static uint64_t calib_aes_gcm_load64(const uint8_t* data)
+{
+    uint64_t value = 0;
+    size_t i;
+
+    for (i = 0; i < 8u; i++)
+    {
+        value = (value << 8) | data[i];
+    }
+    return value;
+}
+
+/** \brief Stores a value as 8 big endian bytes */
+static void calib_aes_gcm_store64(uint64_t value, uint8_t* data)
+{
+    size_t i;
+
+    for (i = 8u; i > 0u; i--)
+    {
+        data[i - 1u] = (uint8_t)(value & 0xFFu);
+        value >>= 8;
+    }
+}
+
+/** \brief Multiplies two GHASH field elements (z = x * h) a bit at a time
+ *         (NIST SP 800-38D algorithm 1). Masks are used instead of branches so
+ *         the time taken doesn't depend on the operands.
+ *
+ * \param[in]  x  First operand (16 bytes)
+ * \param[in]  h  Second operand, normally the hash subkey (16 bytes)
+ * \param[out] z  Product (16 bytes). May be the same buffer as x.
+ */
+void calib_aes_gcm_gfmul_portable(const uint8_t* x, const uint8_t* h, uint8_t* z)
+{
+    uint64_t x_hi = calib_aes_gcm_load64(&x[0]);
+    uint64_t x_lo = calib_aes_gcm_load64(&x[8]);
+    uint64_t v_hi = calib_aes_gcm_load64(&h[0]);
+    uint64_t v_lo = calib_aes_gcm_load64(&h[8]);
+    uint64_t z_hi = 0;
+    uint64_t z_lo = 0;
+    uint64_t mask;
+    unsigned int i;
+
+    for (i = 0; i < 128u; i++)
+    {
+        mask = (uint64_t)0u - (((i < 64u) ? (x_hi >> (63u - i)) : (x_lo >> (127u - i))) & 1u);
+        z_hi ^= v_hi & mask;
+        z_lo ^= v_lo & mask;
+
+        mask = (uint64_t)0u - (v_lo & 1u);
+        v_lo = (v_lo >> 1) | (v_hi << 63);
+        v_hi = (v_hi >> 1) ^ (0xE100000000000000u & mask);
+    }
+
+    calib_aes_gcm_store64(z_hi, &z[0]);
+    calib_aes_gcm_store64(z_lo, &z[8]);
+}
+
+/** \brief Multiplies two GHASH field elements (z = x * h) with the host engine
+ *         selected by CALIB_GHASH_ENGINE. This is the carry-less multiply when
+ *         the compiler targets it and the portable multiply otherwise.
+ *
+ * \param[in]  x  First operand (16 bytes)
+ * \param[in]  h  Second operand, normally the hash subkey (16 bytes)
+ * \param[out] z  Product (16 bytes). May be the same buffer as x.
+ */
+void calib_aes_gcm_gfmul(const uint8_t* x, const uint8_t* h, uint8_t* z)
+{
+#if defined(CALIB_GHASH_PCLMUL) || defined(CALIB_GHASH_PMULL)
+    calib_aes_gcm_gfmul_clmul(x, h, z);
+#else
+    calib_aes_gcm_gfmul_portable(x, h, z);
+#endif
+}
+
+/** \brief Reports whether calib_aes_gcm_gfmul uses a carry-less multiply
+ *         instruction rather than the portable multiply
+ */
+bool calib_aes_gcm_gfmul_is_clmul(void)
+{
+#if defined(CALIB_GHASH_PCLMUL) || defined(CALIB_GHASH_PMULL)
+    return true;
+#else
+    return false;
+#endif
+}
+#endif
+
+/** \brief Multiplies the running GHASH value by the hash subkey
+ *
+ * \param[in]     device  Device context pointer
+ * \param[in]     h       Subkey to use in GHASH calculations.
+ * \param[in,out] y       Value to multiply, replaced by the product.
+ *
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+static ATCA_STATUS calib_aes_gcm_mult_h(ATCADevice device, const uint8_t* h, uint8_t* y)
+{
+#if CALIB_GHASH_ENGINE == CALIB_GHASH_DEVICE
+    return calib_aes_gfm(device, h, y, y);
+#else
+    (void)device;
+    calib_aes_gcm_gfmul(y, h, y);
+    return ATCA_SUCCESS;
+#endif
+}
+
 /** \brief Performs running GHASH calculations using the current hash value,
  *         hash subkey, and data received. In case of partial blocks, the last
  *         block is padded with zeros to get the output.
@@ -84,7 +286,7 @@ static ATCA_STATUS calib_aes_ghash(ATCADevice device, const uint8_t* h, const ui
             y[xor_index] ^= *data++;
         }
 
-        if (ATCA_SUCCESS != (status = calib_aes_gfm(device, h, y, y)))
+        if (ATCA_SUCCESS != (status = calib_aes_gcm_mult_h(device, h, y)))
         {
             RETURN(status, "GHASH GFM (full block) failed");
         }
@@ -102,7 +304,7 @@ static ATCA_STATUS calib_aes_ghash(ATCADevice device, const uint8_t* h, const ui
             y[xor_index] ^= pad_bytes[xor_index];
         }
 
-        if (ATCA_SUCCESS != (status = calib_aes_gfm(device, h, y, y)))
+        if (ATCA_SUCCESS != (status = calib_aes_gcm_mult_h(device, h, y)))
         {
             RETURN(status, "GHASH GFM (partial block) failed");
         }
@@ -71,6 +71,12 @@ ATCA_STATUS calib_aes_gcm_encrypt_finish(ATCADevice device, atca_aes_gcm_ctx_t*
 ATCA_STATUS calib_aes_gcm_decrypt_update(ATCADevice device, atca_aes_gcm_ctx_t* ctx, const uint8_t* ciphertext, uint32_t ciphertext_size, uint8_t* plaintext);
 ATCA_STATUS calib_aes_gcm_decrypt_finish(ATCADevice device, atca_aes_gcm_ctx_t* ctx, const uint8_t* tag, size_t tag_size, bool* is_verified);
 
+#if CALIB_GHASH_ENGINE != CALIB_GHASH_DEVICE
+void calib_aes_gcm_gfmul(const uint8_t* x, const uint8_t* h, uint8_t* z);
+void calib_aes_gcm_gfmul_portable(const uint8_t* x, const uint8_t* h, uint8_t* z);
+bool calib_aes_gcm_gfmul_is_clmul(void);
+#endif
+
 #endif
 
 #ifdef __cplusplus
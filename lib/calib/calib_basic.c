@@ -201,6 +201,66 @@ ATCA_STATUS calib_exit(ATCADevice device)
     return calib_idle(device);
 }
 
+#if ATCA_KEEP_AWAKE_EN
+/** \brief Begin a keep awake session. Commands executed during the session
+ *         leave the device active instead of idling it after every command
+ *         so the wake and idle overhead is only paid once. The device is
+ *         cycled through idle (which preserves TempKey) before its watchdog
+ *         would put it to sleep.
+ *
+ *  Without a platform timestamp (ATCA_HAL_TIMESTAMP_EN) only the time spent
+ *  executing commands is accounted for so the caller should not pause between
+ *  commands of a session. Sessions may be nested, the device is idled when the
+ *  outermost session ends.
+ *
+ *  \param[in] device     Device context pointer
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS calib_session_begin(ATCADevice device)
+{
+    if (NULL == device)
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
+
+    if (UINT8_MAX == device->keep_awake)
+    {
+        return ATCA_TRACE(ATCA_FUNC_FAIL, "Too many nested sessions");
+    }
+    device->keep_awake++;
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief End a keep awake session. Ending the outermost session idles the
+ *         device if it was left active.
+ *  \param[in] device     Device context pointer
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS calib_session_end(ATCADevice device)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+
+    if (NULL == device)
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
+
+    if (0u < device->keep_awake)
+    {
+        device->keep_awake--;
+    }
+
+    if ((0u == device->keep_awake) && ((uint8_t)ATCA_DEVICE_STATE_ACTIVE == device->device_state))
+    {
+        status = calib_idle(device);
+        device->device_state = (uint8_t)ATCA_DEVICE_STATE_IDLE;
+    }
+
+    return status;
+}
+#endif
+
 
 /** \brief Compute the address given the zone, slot, block, and offset
  *  \param[in] zone   Zone to get address from. Config(0), OTP(1), or
@@ -24,6 +24,10 @@ ATCA_STATUS calib_wakeup(ATCADevice device);
 ATCA_STATUS calib_idle(ATCADevice device);
 ATCA_STATUS calib_sleep(ATCADevice device);
 ATCA_STATUS calib_exit(ATCADevice device);
+#if ATCA_KEEP_AWAKE_EN
+ATCA_STATUS calib_session_begin(ATCADevice device);
+ATCA_STATUS calib_session_end(ATCADevice device);
+#endif
 ATCA_STATUS calib_get_addr(uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, uint16_t* addr);
 ATCA_STATUS calib_get_zone_size(ATCADevice device, uint8_t zone, uint16_t slot, size_t* size);
 
@@ -186,6 +190,9 @@ ATCA_STATUS calib_priv_write(ATCADevice device, uint16_t key_id, const uint8_t p
 // Random command functions
 #if CALIB_RANDOM_EN
 ATCA_STATUS calib_random(ATCADevice device, uint8_t* rand_out);
+#if ATCA_ASYNC_EN
+ATCA_STATUS calib_random_async(ATCADevice device, calib_async_t* ctx, uint8_t* rand_out);
+#endif
 #endif
 
 // Read command functions
@@ -198,6 +205,24 @@ bool calib_ecc_compare_config(uint8_t* expected, uint8_t* other);
 bool calib_ecc608_compare_config(uint8_t* expected, uint8_t* other);
 ATCA_STATUS calib_read_sig(ATCADevice device, uint16_t slot, uint8_t *sig);
 #endif
+#if ATCA_CONFIG_CACHE_EN
+/** \brief State of the configuration zone cache held in the device context */
+typedef enum
+{
+    CALIB_CONFIG_CACHE_EMPTY = 0,   /**< Not read yet or invalidated */
+    CALIB_CONFIG_CACHE_FILLING,     /**< Being read from the device */
+    CALIB_CONFIG_CACHE_VALID,       /**< Holds the locked configuration zone */
+    CALIB_CONFIG_CACHE_UNLOCKED     /**< Configuration zone is not locked so reads go to the device */
+} calib_config_cache_state_t;
+
+void calib_config_cache_invalidate(ATCADevice device);
+void calib_config_cache_update(ATCADevice device, size_t offset, const uint8_t* data, size_t len);
+#endif
+#if ATCA_SLOT_GENERATION_EN
+void calib_slot_modified(ATCADevice device, uint8_t zone, uint16_t slot);
+uint32_t calib_slot_generation(ATCADevice device, uint8_t zone, uint16_t slot);
+void calib_pubkey_cache_invalidate(ATCADevice device);
+#endif
 // CA2 Read command functions
 #if CALIB_READ_CA2_EN
 ATCA_STATUS calib_ca2_read_zone(ATCADevice device, uint8_t zone, uint16_t slot, uint8_t block, size_t offset,
@@ -267,12 +292,17 @@ ATCA_STATUS calib_sha_hmac_init(ATCADevice device, atca_hmac_sha256_ctx_t* ctx,
 ATCA_STATUS calib_sha_hmac_update(ATCADevice device, atca_hmac_sha256_ctx_t* ctx, const uint8_t* data, size_t data_size);
 ATCA_STATUS calib_sha_hmac_finish(ATCADevice device, atca_hmac_sha256_ctx_t* ctx, uint8_t* digest, uint8_t target);
 ATCA_STATUS calib_sha_hmac(ATCADevice device, const uint8_t * data, size_t data_size, uint16_t key_slot, uint8_t* digest, uint8_t target);
+ATCA_STATUS calib_sha_hmac_iterate(ATCADevice device, uint16_t key_slot, uint8_t* message, uint8_t* accumulator,
+                                   uint32_t iterations);
 #endif
 
 // Sign command functions
 #if CALIB_SIGN_EN
 ATCA_STATUS calib_sign_base(ATCADevice device, uint8_t mode, uint16_t key_id, uint8_t *signature);
 ATCA_STATUS calib_sign(ATCADevice device, uint16_t key_id, const uint8_t *msg, uint8_t *signature);
+#if ATCA_ASYNC_EN
+ATCA_STATUS calib_sign_async(ATCADevice device, calib_async_t* ctx, uint16_t key_id, const uint8_t *msg, uint8_t *signature);
+#endif
 #endif
 #if CALIB_SIGN_EN || CALIB_SIGN_CA2_EN
 ATCA_STATUS calib_sign_ext(ATCADevice device, uint16_t key_id, const uint8_t *msg, uint8_t *signature);
@@ -297,6 +327,10 @@ ATCA_STATUS calib_verify(ATCADevice device, uint8_t mode, uint16_t key_id, const
 
 #if CALIB_VERIFY_EXTERN_EN
 ATCA_STATUS calib_verify_extern(ATCADevice device, const uint8_t *message, const uint8_t *signature, const uint8_t *public_key, bool *is_verified);
+#if ATCA_ASYNC_EN
+ATCA_STATUS calib_verify_extern_async(ATCADevice device, calib_async_t* ctx, const uint8_t *message, const uint8_t *signature,
+                                      const uint8_t *public_key, bool *is_verified);
+#endif
 #if CALIB_VERIFY_MAC_EN
 ATCA_STATUS calib_verify_extern_mac(ATCADevice device, const uint8_t *message, const uint8_t* signature, const uint8_t* public_key, const uint8_t* num_in, const uint8_t* io_key, bool* is_verified);
 #endif
@@ -362,6 +396,15 @@ ATCA_STATUS calib_ca2_write_enc(ATCADevice device, uint16_t slot, uint8_t* data,
 #define atcab_wakeup()                          calib_wakeup(g_atcab_device_ptr)
 #define atcab_idle()                            calib_idle(g_atcab_device_ptr)
 #define atcab_sleep()                           calib_sleep(g_atcab_device_ptr)
+#define atcab_session_begin()                   calib_session_begin(g_atcab_device_ptr)
+#define atcab_session_begin_ext                 calib_session_begin
+#define atcab_session_end()                     calib_session_end(g_atcab_device_ptr)
+#define atcab_session_end_ext                   calib_session_end
+#define atcab_async_init                        calib_async_init
+#define atcab_async_release                     calib_async_release
+#define atcab_async_poll                        calib_async_poll
+#define atcab_async_wait_time                   calib_async_wait_time
+#define atcab_async_get_fd                      calib_async_get_fd
 #define atcab_get_zone_size(...)                calib_get_zone_size(g_atcab_device_ptr, __VA_ARGS__)
 #define atcab_get_zone_size_ext                 calib_get_zone_size
 
@@ -404,6 +447,7 @@ ATCA_STATUS calib_ca2_write_enc(ATCADevice device, uint16_t slot, uint8_t* data,
 // ECDH command functions
 #define atcab_ecdh_base(...)                    calib_ecdh_base(g_atcab_device_ptr, __VA_ARGS__)
 #define atcab_ecdh(...)                         calib_ecdh(g_atcab_device_ptr, __VA_ARGS__)
+#define atcab_ecdh_ext                          calib_ecdh
 #define atcab_ecdh_enc(...)                     calib_ecdh_enc(g_atcab_device_ptr, __VA_ARGS__)
 #define atcab_ecdh_ioenc(...)                   calib_ecdh_ioenc(g_atcab_device_ptr, __VA_ARGS__)
 #define atcab_ecdh_tempkey(...)                 calib_ecdh_tempkey(g_atcab_device_ptr, __VA_ARGS__)
@@ -476,6 +520,8 @@ ATCA_STATUS calib_ca2_write_enc(ATCADevice device, uint16_t slot, uint8_t* data,
 // Random command functions
 #define atcab_random(...)                       calib_random(g_atcab_device_ptr, __VA_ARGS__)
 #define atcab_random_ext                        calib_random
+#define atcab_random_async(...)                 calib_random_async(g_atcab_device_ptr, __VA_ARGS__)
+#define atcab_random_async_ext                  calib_random_async
 
 // Read command functions
 #define atcab_is_slot_locked(...)               calib_is_slot_locked(g_atcab_device_ptr, __VA_ARGS__)
@@ -533,6 +579,7 @@ ATCA_STATUS calib_ca2_write_enc(ATCADevice device, uint16_t slot, uint8_t* data,
 #define atcab_sha_read_context(...)             calib_sha_read_context(g_atcab_device_ptr, __VA_ARGS__)
 #define atcab_sha_write_context(...)            calib_sha_write_context(g_atcab_device_ptr, __VA_ARGS__)
 #define atcab_sha(...)                          calib_sha(g_atcab_device_ptr, __VA_ARGS__)
+#define atcab_sha_ext                           calib_sha
 #define atcab_hw_sha2_256(...)                  calib_hw_sha2_256(g_atcab_device_ptr, __VA_ARGS__)
 #define atcab_hw_sha2_256_init(...)             calib_hw_sha2_256_init(g_atcab_device_ptr, __VA_ARGS__)
 #define atcab_hw_sha2_256_update(...)           calib_hw_sha2_256_update(g_atcab_device_ptr, __VA_ARGS__)
@@ -554,6 +601,8 @@ ATCA_STATUS calib_ca2_write_enc(ATCADevice device, uint16_t slot, uint8_t* data,
 #define atcab_sign_ext                          calib_sign_ext
 #endif
 
+#define atcab_sign_async(...)                   calib_sign_async(g_atcab_device_ptr, __VA_ARGS__)
+#define atcab_sign_async_ext                    calib_sign_async
 #define atcab_sign_internal(...)                calib_sign_internal(g_atcab_device_ptr, __VA_ARGS__)
 
 // UpdateExtra command functions
@@ -563,6 +612,8 @@ ATCA_STATUS calib_ca2_write_enc(ATCADevice device, uint16_t slot, uint8_t* data,
 #define atcab_verify(...)                       calib_verify(g_atcab_device_ptr, __VA_ARGS__)
 #define atcab_verify_extern(...)                calib_verify_extern(g_atcab_device_ptr, __VA_ARGS__)
 #define atcab_verify_extern_ext                 calib_verify_extern
+#define atcab_verify_extern_async(...)          calib_verify_extern_async(g_atcab_device_ptr, __VA_ARGS__)
+#define atcab_verify_extern_async_ext           calib_verify_extern_async
 #define atcab_verify_extern_mac(...)            calib_verify_extern_mac(g_atcab_device_ptr, __VA_ARGS__)
 #define atcab_verify_stored(...)                calib_verify_stored(g_atcab_device_ptr, __VA_ARGS__)
 #define atcab_verify_stored_ext                 calib_verify_stored
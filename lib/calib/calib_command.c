@@ -695,40 +695,6 @@ ATCA_STATUS atKDF(ATCADeviceType device_type, ATCAPacket *packet)
 }
 #endif
 
-/** \brief Calculates CRC over the given raw data and returns the CRC in
- *         little-endian byte order.
- *
- * \param[in]  length  Size of data not including the CRC byte positions
- * \param[in]  data    Pointer to the data over which to compute the CRC
- * \param[out] crc_le  Pointer to the place where the two-bytes of CRC will be
- *                     returned in little-endian byte order.
- */
-void atCRC(size_t length, const uint8_t *data, uint8_t *crc_le)
-{
-    size_t counter;
-    uint16_t crc_register = 0;
-    uint16_t polynom = 0x8005;
-    uint8_t shift_register;
-    uint8_t data_bit, crc_bit;
-
-    for (counter = 0; counter < length; counter++)
-    {
-        for (shift_register = 0x01; shift_register > 0x00u; shift_register <<= 1)
-        {
-            data_bit = ((data[counter] & shift_register) != 0u) ? 1u : 0u;
-            crc_bit = (uint8_t)(crc_register >> 15);
-            crc_register <<= 1;
-            if (data_bit != crc_bit)
-            {
-                crc_register ^= polynom;
-            }
-        }
-    }
-    crc_le[0] = (uint8_t)(crc_register & 0x00FFu);
-    crc_le[1] = (uint8_t)(crc_register >> 8u);
-}
-
-
 /** \brief This function calculates CRC and adds it to the correct offset in the packet data
  * \param[in] packet Packet to calculate CRC data for
  */
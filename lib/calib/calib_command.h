@@ -201,6 +201,9 @@ ATCA_STATUS isATCAError(uint8_t *data);
 
 
 // command helpers
+#define ATCA_CRC_INIT           ((uint16_t)0x0000u) //!< Starting value of a running CRC
+uint16_t atCRC_update(uint16_t crc, const uint8_t *data, size_t length);
+void atCRC_final(uint16_t crc, uint8_t *crc_le);
 void atCRC(size_t length, const uint8_t *data, uint8_t *crc_le);
 void atCalcCrc(ATCAPacket *packet);
 ATCA_STATUS atCheckCrc(const uint8_t *response);
@@ -103,6 +103,25 @@
 #define CA_MAX_PACKET_SIZE            (MAX_PACKET_SIZE)
 #endif
 
+/**** CRC ****/
+
+#define CALIB_CRC_BITWISE           (0)     //!< Bit serial - no tables
+#define CALIB_CRC_NIBBLE            (1)     //!< 16 entry table (32 bytes)
+#define CALIB_CRC_TABLE             (2)     //!< 256 entry table (512 bytes)
+#define CALIB_CRC_SLICE4            (3)     //!< Slice by 4 - 4x256 entry tables (2 KB)
+#define CALIB_CRC_SLICE8            (4)     //!< Slice by 8 - 8x256 entry tables (4 KB)
+
+/** \def CALIB_CRC_ENGINE
+ *
+ * Selects the implementation of the packet CRC (atCRC, atCalcCrc, atCheckCrc)
+ * from one of the CALIB_CRC_ options which trade code size against speed
+ *
+ * Supported API's: atCRC, atCRC_update, atCRC_final
+ **/
+#ifndef CALIB_CRC_ENGINE
+#define CALIB_CRC_ENGINE            CALIB_CRC_TABLE
+#endif
+
 /**** AES command ****/
 
 /** \def CALIB_AES
@@ -140,6 +159,23 @@
 #define CALIB_AES_GCM_EN            (ATCAB_AES_GCM_EN && CALIB_AES_EN && CALIB_ECC608_EN)
 #endif
 
+#define CALIB_GHASH_DEVICE          (0)     //!< Every GHASH block is multiplied by the device (GFM)
+#define CALIB_GHASH_HOST            (1)     //!< Portable host multiply - no tables
+#define CALIB_GHASH_HOST_CLMUL      (2)     //!< Host carry-less multiply (PCLMULQDQ or PMULL) when the compiler targets it, otherwise portable
+
+/** \def CALIB_GHASH_ENGINE
+ *
+ * Selects where the GHASH field multiplies of AES-GCM run from one of the
+ * CALIB_GHASH_ options. The hash subkey is always derived on the device so
+ * the host options only move the multiply by H off the bus; the AES block
+ * encryptions stay on the device.
+ *
+ * Supported API's: calib_aes_ghash
+ **/
+#ifndef CALIB_GHASH_ENGINE
+#define CALIB_GHASH_ENGINE          CALIB_GHASH_DEVICE
+#endif
+
 /**** CHECKMAC command ****/
 
 /** \def CALIB_CHECKMAC
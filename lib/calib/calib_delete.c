@@ -85,6 +85,11 @@ ATCA_STATUS calib_delete_base(ATCADevice device, uint8_t mode, uint16_t key_id,
 
         (void)atDelete(atcab_get_device_type_ext(device), packet);
 
+#if ATCA_SLOT_GENERATION_EN
+        // Delete erases every slot
+        calib_pubkey_cache_invalidate(device);
+#endif
+
         if ((status = atca_execute_command((void*)packet, device)) != ATCA_SUCCESS)
         {
             (void)ATCA_TRACE(status, "calib_delete - execution failed");
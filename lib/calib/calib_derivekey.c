@@ -102,6 +102,10 @@ ATCA_STATUS calib_derivekey(ATCADevice device, uint8_t mode, uint16_t target_key
             break;
         }
 
+#if ATCA_SLOT_GENERATION_EN
+        calib_slot_modified(device, ATCA_ZONE_DATA, target_key);
+#endif
+
         if ((status = atca_execute_command(packet, device)) != ATCA_SUCCESS)
         {
             (void)ATCA_TRACE(status, "calib_derivekey - execution failed");
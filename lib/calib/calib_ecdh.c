@@ -92,6 +92,23 @@ ATCA_STATUS calib_ecdh_base(ATCADevice device, uint8_t mode, uint16_t key_id, co
             break;
         }
 
+#if ATCA_SLOT_GENERATION_EN
+        if (ECDH_MODE_COPY_COMPATIBLE == (mode & ECDH_MODE_COPY_MASK))
+        {
+            // Depending on the slot configuration the result is written to the next slot
+            calib_slot_modified(device, ATCA_ZONE_DATA, key_id | 0x0001u);
+        }
+        else if (ECDH_MODE_COPY_EEPROM_SLOT == (mode & ECDH_MODE_COPY_MASK))
+        {
+            calib_slot_modified(device, ATCA_ZONE_DATA, (ECDH_MODE_SOURCE_TEMPKEY == (mode & ECDH_MODE_SOURCE_MASK)) ?
+                                key_id : (key_id | 0x0001u));
+        }
+        else
+        {
+            // Result goes to TempKey or the output buffer
+        }
+#endif
+
         if ((status = atca_execute_command(packet, device)) != ATCA_SUCCESS)
         {
             (void)ATCA_TRACE(status, "calib_ecdh_base - execution failed");
@@ -6,7 +6,11 @@
  * This implementation wraps Polling and No polling (simple wait) schemes into
  * a single method and use it across the library. Polling is used by default,
  * however, by defining the ATCA_NO_POLL symbol the code will instead wait an
- * estimated max execution time before requesting the result.
+ * estimated max execution time before requesting the result. When
+ * ATCA_ADAPTIVE_POLL_EN is set the polling schedule is derived from the
+ * execution times observed on each device instead of fixed intervals. While a
+ * keep awake session is open (ATCA_KEEP_AWAKE_EN) the device is left active
+ * between commands and only cycled through idle ahead of its watchdog.
  *
  * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
  *
@@ -39,7 +43,7 @@
 #endif
 
 
-#ifdef ATCA_NO_POLL
+#if defined(ATCA_NO_POLL) || ATCA_ADAPTIVE_POLL_EN || ATCA_KEEP_AWAKE_EN
 // *INDENT-OFF* - Preserve time formatting from the code formatter
 /*Execution times for ATSHA204A supported commands...*/
 static const device_execution_time_t device_execution_time_204[] = {
@@ -240,7 +244,7 @@ ATCA_STATUS calib_get_execution_time(uint8_t opcode, ATCADevice device)
 
     switch (device->mIface.mIfaceCFG->devtype)
     {
-#ifdef ATCA_NO_POLL
+#if defined(ATCA_NO_POLL) || ATCA_ADAPTIVE_POLL_EN || ATCA_KEEP_AWAKE_EN
     case ATSHA204A:
         execution_times = device_execution_time_204;
         no_of_commands = sizeof(device_execution_time_204) / sizeof(device_execution_time_t);
@@ -455,8 +459,363 @@ ATCA_STATUS calib_execute_receive(ATCADevice device, uint8_t device_address, uin
     return status;
 }
 
+#if ATCA_ADAPTIVE_POLL_EN && !defined(ATCA_NO_POLL)
+/* Estimates are kept in 1/16 msec units */
+#define CALIB_POLL_TIME_SHIFT       (4u)
+/* Weight of a new observation in the moving average once warmed up (1/8) */
+#define CALIB_POLL_AVG_SHIFT        (3u)
+
+/** \brief Find (or allocate) the execution time estimate for an opcode. New
+ *         entries are seeded from the device execution time tables.
+ *  \param[in] device  Device the command is executed on
+ *  \param[in] opcode  Opcode of the command
+ *  \return Pointer to the estimate for the opcode
+ */
+atca_poll_stats_t* calib_poll_stats_get(ATCADevice device, uint8_t opcode)
+{
+    atca_poll_stats_t* stats = NULL;
+    uint32_t seed;
+    uint8_t i;
+
+    for (i = 0u; i < ATCA_ADAPTIVE_POLL_ENTRIES; i++)
+    {
+        if (opcode == device->poll_stats[i].opcode)
+        {
+            return &device->poll_stats[i];
+        }
+        if ((NULL == stats) && (0u == device->poll_stats[i].opcode))
+        {
+            stats = &device->poll_stats[i];
+        }
+    }
+
+    if (NULL == stats)
+    {
+        /* Table is full so replace entries in round robin order */
+        stats = &device->poll_stats[device->poll_stats_next];
+        device->poll_stats_next = (uint8_t)((device->poll_stats_next + 1u) % ATCA_ADAPTIVE_POLL_ENTRIES);
+    }
+
+    if (ATCA_SUCCESS == calib_get_execution_time(opcode, device))
+    {
+        /* The tables hold the maximum time - typical completion is well under that */
+        stats->max_time = device->execution_time_msec;
+        seed = (uint32_t)device->execution_time_msec << CALIB_POLL_TIME_SHIFT;
+        stats->avg_time = seed / 2u;
+    }
+    else
+    {
+        stats->max_time = (uint16_t)ATCA_POLLING_MAX_TIME_MSEC;
+        seed = (uint32_t)ATCA_POLLING_INIT_TIME_MSEC << CALIB_POLL_TIME_SHIFT;
+        stats->avg_time = seed;
+    }
+    stats->p90_time = seed;
+    stats->opcode = opcode;
+    stats->samples = 0u;
+
+    return stats;
+}
+
+/** \brief Time to wait after sending the command before the first poll. Polling
+ *         starts just ahead of the average so faster completions are observed.
+ */
+uint32_t calib_poll_first_delay(const atca_poll_stats_t* stats)
+{
+    uint32_t delay = ((stats->avg_time - (stats->avg_time >> 3u)) >> CALIB_POLL_TIME_SHIFT);
+
+    return (delay > ATCA_POLLING_INIT_TIME_MSEC) ? delay : ATCA_POLLING_INIT_TIME_MSEC;
+}
+
+/** \brief Time to wait before the next poll. Inside the expected completion
+ *         window the window is covered in a fixed number of polls, past the
+ *         90th percentile the interval grows with the overrun.
+ */
+uint32_t calib_poll_interval(const atca_poll_stats_t* stats, uint32_t elapsed)
+{
+    uint32_t avg = stats->avg_time >> CALIB_POLL_TIME_SHIFT;
+    uint32_t p90 = stats->p90_time >> CALIB_POLL_TIME_SHIFT;
+    uint32_t interval;
+
+    if (elapsed < p90)
+    {
+        interval = (p90 - calib_poll_first_delay(stats)) / 8u;
+    }
+    else
+    {
+        interval = (elapsed - p90) / 2u;
+        if (interval > (avg / 4u))
+        {
+            interval = avg / 4u;
+        }
+    }
+
+    return (interval > ATCA_POLLING_FREQUENCY_TIME_MSEC) ? interval : ATCA_POLLING_FREQUENCY_TIME_MSEC;
+}
+
+/** \brief Update the estimate with the time it took for the device to respond
+ *  \param[in,out] stats    Estimate to update
+ *  \param[in]     elapsed  Time from sending the command to a response (msec)
+ */
+void calib_poll_record(atca_poll_stats_t* stats, uint32_t elapsed)
+{
+    uint32_t sample = elapsed << CALIB_POLL_TIME_SHIFT;
+    uint32_t step;
+    bool warming_up = (stats->samples < (1u << CALIB_POLL_AVG_SHIFT));
+
+    if (elapsed > stats->max_time)
+    {
+        sample = (uint32_t)stats->max_time << CALIB_POLL_TIME_SHIFT;
+    }
+
+    /* Plain average while warming up so the seed is replaced quickly */
+    if (warming_up)
+    {
+        stats->samples++;
+        if (sample >= stats->avg_time)
+        {
+            stats->avg_time += (sample - stats->avg_time) / stats->samples;
+        }
+        else
+        {
+            stats->avg_time -= (stats->avg_time - sample) / stats->samples;
+        }
+    }
+    else
+    {
+        stats->avg_time = stats->avg_time - (stats->avg_time >> CALIB_POLL_AVG_SHIFT) + (sample >> CALIB_POLL_AVG_SHIFT);
+    }
+
+    /* Stochastic quantile estimate: moving up by step on samples above and down by
+       step/9 on samples below settles where 1 in 10 samples are above. The steps
+       are too small to walk down from the seed so while warming up the estimate
+       is the slowest completion seen */
+    step = stats->avg_time >> CALIB_POLL_AVG_SHIFT;
+    if (step < (1u << CALIB_POLL_TIME_SHIFT))
+    {
+        step = (1u << CALIB_POLL_TIME_SHIFT);
+    }
+
+    if (warming_up)
+    {
+        if ((1u == stats->samples) || (sample > stats->p90_time))
+        {
+            stats->p90_time = sample;
+        }
+    }
+    else if (sample > stats->p90_time)
+    {
+        stats->p90_time += step;
+    }
+    else if (stats->p90_time > (step / 9u))
+    {
+        stats->p90_time -= step / 9u;
+    }
+    else
+    {
+        stats->p90_time = 0u;
+    }
+
+    if (stats->p90_time < stats->avg_time)
+    {
+        stats->p90_time = stats->avg_time;
+    }
+}
+#endif
+
+#if ATCA_KEEP_AWAKE_EN
+/** \brief Millisecond clock used to track how long the device has been awake.
+ *         Without a timestamp source only the time waited on the device is
+ *         accounted for.
+ */
+static uint32_t calib_clock_ms(ATCADevice device)
+{
+#if ATCA_HAL_TIMESTAMP_EN
+    ((void)device);
+    return hal_get_timestamp_ms();
+#else
+    return device->wait_time_msec;
+#endif
+}
+
+/** \brief Mark the start of the device watchdog period after a wake */
+static void calib_keep_awake_start(ATCADevice device)
+{
+    device->awake_time_msec = calib_clock_ms(device);
+}
+
+/** \brief Idle a device kept awake by a session if the command might not
+ *         complete before the watchdog expires. The following wake restarts
+ *         the watchdog and idle preserves TempKey so this is transparent.
+ *  \param[in] device  Device the command is executed on
+ *  \param[in] opcode  Opcode of the command
+ */
+static void calib_keep_awake_check(ATCADevice device, uint8_t opcode)
+{
+    uint32_t awake_time;
+    uint32_t command_time = ATCA_KEEP_AWAKE_BUDGET_MSEC;
+
+    if ((0u == device->keep_awake) || ((uint8_t)ATCA_DEVICE_STATE_ACTIVE != device->device_state))
+    {
+        return;
+    }
+
+    awake_time = calib_clock_ms(device) - device->awake_time_msec;
+
+    /* Commands without a known execution time always start on a fresh watchdog */
+    if (ATCA_SUCCESS == calib_get_execution_time(opcode, device))
+    {
+        command_time = device->execution_time_msec;
+    }
+
+    if ((awake_time + command_time) >= ATCA_KEEP_AWAKE_BUDGET_MSEC)
+    {
+        (void)calib_idle(device);
+        device->device_state = (uint8_t)ATCA_DEVICE_STATE_IDLE;
+    }
+}
+#endif
+
+/** \brief Wait on the device. Without a timestamp source the time is also
+ *         accounted against the keep awake budget. With deadline delays the
+ *         wait ends msec after the previous deadline, so oversleep and the time
+ *         spent polling the device do not push back the schedule.
+ */
+static void calib_execute_delay(ATCADevice device, uint64_t* deadline, uint32_t msec)
+{
+#if ATCA_KEEP_AWAKE_EN && !ATCA_HAL_TIMESTAMP_EN
+    device->wait_time_msec += msec;
+#else
+    ((void)device);
+#endif
+#if ATCA_HAL_DEADLINE_EN
+    *deadline += (uint64_t)msec * 1000U;
+    hal_delay_until_us(*deadline);
+#else
+    ((void)deadline);
+    atca_delay_ms(msec);
+#endif
+}
+
+/** \brief Wakes up the device if required and sends the command packet,
+ *         retrying as configured for the interface.
+ *
+ * \param[in]     device  CryptoAuthentication device to send the command to.
+ * \param[in,out] packet  Packet to be sent
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+static ATCA_STATUS calib_execute_issue(ATCADevice device, ATCAPacket* packet)
+{
+    ATCA_STATUS status = ATCA_COMM_FAIL;
+    int32_t retries;
+
+#if ATCA_KEEP_AWAKE_EN
+    calib_keep_awake_check(device, packet->opcode);
+#endif
+    retries = atca_iface_get_retries(&device->mIface);
+    do
+    {
+        if ((uint8_t)ATCA_DEVICE_STATE_ACTIVE != device->device_state)
+        {
+            if (ATCA_SUCCESS == (status = calib_wakeup(device)))
+            {
+                device->device_state = (uint8_t)ATCA_DEVICE_STATE_ACTIVE;
+#if ATCA_KEEP_AWAKE_EN
+                calib_keep_awake_start(device);
+#endif
+            }
+        }
+
+        /* Send the command packet to the device */
+        if ((ATCA_I2C_IFACE == device->mIface.mIfaceCFG->iface_type) || (ATCA_CUSTOM_IFACE == device->mIface.mIfaceCFG->iface_type))
+        {
+            packet->reserved = 0x03;
+        }
+        if (ATCA_SWI_IFACE == device->mIface.mIfaceCFG->iface_type)
+        {
+            packet->reserved = CALIB_SWI_FLAG_CMD;
+        }
+#if ATCA_CA2_SUPPORT
+        if ((ATCA_SWI_GPIO_IFACE == device->mIface.mIfaceCFG->iface_type) && (atcab_is_ca2_device(device->mIface.mIfaceCFG->devtype)))
+        {
+            packet->reserved = 0x03;
+        }
+#endif
+        /* coverity[misra_c_2012_rule_18_1_violation]  calib_execute_send will not update the members of the packet structure */
+        if (ATCA_RX_NO_RESPONSE == (status = calib_execute_send(device, packet->reserved, (uint8_t*)&packet->txsize, (uint16_t)packet->txsize)))
+        {
+            device->device_state = (uint8_t)ATCA_DEVICE_STATE_UNKNOWN;
+        }
+        else
+        {
+            if ((uint8_t)ATCA_DEVICE_STATE_ACTIVE != device->device_state)
+            {
+                device->device_state = (uint8_t)ATCA_DEVICE_STATE_ACTIVE;
+            }
+            retries = 0;
+        }
+
+    }
+    /* coverity[cert_int32_c_violation:FALSE]  No overflow possible */
+    while (0 < retries--);
+
+    return status;
+}
+
+/** \brief Validates a received response (size, CRC and device error code)
+ *
+ * \param[in] packet  Packet holding the response in its data buffer
+ * \param[in] rxsize  Number of bytes received
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+static ATCA_STATUS calib_execute_check_response(ATCAPacket* packet, uint16_t rxsize)
+{
+    ATCA_STATUS status;
+
+    // Check response size
+    if (rxsize < 4u)
+    {
+        return (rxsize > 0u) ? ATCA_RX_FAIL : ATCA_RX_NO_RESPONSE;
+    }
+
+    /* coverity[misra_c_2012_directive_4_14_violation:FALSE] Packet data is handled properly */
+    if ((status = atCheckCrc(packet->data)) != ATCA_SUCCESS)
+    {
+        return status;
+    }
+
+    return isATCAError(packet->data);
+}
+
+/** \brief Puts the device into the idle state after a command unless a keep
+ *         awake session is open or the device does not support idle.
+ */
+static void calib_execute_finish(ATCADevice device, ATCA_STATUS status)
+{
+    // Skip Idle for ECC204 device
+    bool idle = !atcab_is_ca2_device(device->mIface.mIfaceCFG->devtype);
+
+#if ATCA_KEEP_AWAKE_EN
+    // Leave the device active for the next command of the session
+    if ((0u != device->keep_awake) && (ATCA_SUCCESS == status))
+    {
+        idle = false;
+    }
+#else
+    ((void)status);
+#endif
+
+    if (idle)
+    {
+        (void)calib_idle(device);
+        device->device_state = (uint8_t)ATCA_DEVICE_STATE_IDLE;
+    }
+}
+
 /** \brief Wakes up device, sends the packet, waits for command completion,
- *         receives response, and puts the device into the idle state.
+ *         receives response, and puts the device into the idle state unless a
+ *         keep awake session is open.
  *
  * \param[in,out] packet  As input, the packet to be sent. As output, the
  *                       data buffer in the packet structure will contain the
@@ -470,9 +829,14 @@ ATCA_STATUS calib_execute_command(ATCAPacket* packet, ATCADevice device)
     ATCA_STATUS status;
     uint32_t execution_or_wait_time;
     uint32_t max_delay_count;
-    uint16_t rxsize;
+    uint16_t rxsize = 0;
     uint8_t device_address = atcab_get_device_address(device);
-    int32_t retries;
+    uint64_t deadline = 0;
+#if ATCA_ADAPTIVE_POLL_EN && !defined(ATCA_NO_POLL)
+    atca_poll_stats_t* poll_stats = NULL;
+    uint32_t poll_interval;
+    uint32_t elapsed_time;
+#endif
 
     do
     {
@@ -487,6 +851,11 @@ ATCA_STATUS calib_execute_command(ATCAPacket* packet, ATCADevice device)
         execution_or_wait_time = ATCA_POLLING_INIT_TIME_MSEC;
         max_delay_count = ATCA_POLLING_MAX_TIME_MSEC / ATCA_POLLING_FREQUENCY_TIME_MSEC;
 
+    #if ATCA_ADAPTIVE_POLL_EN
+        poll_stats = calib_poll_stats_get(device, packet->opcode);
+        execution_or_wait_time = calib_poll_first_delay(poll_stats);
+    #endif
+
     #if ATCA_CA2_SUPPORT
         if ((ATCA_SWI_GPIO_IFACE == device->mIface.mIfaceCFG->iface_type) && (atcab_is_ca2_device(device->mIface.mIfaceCFG->devtype)))
         {
@@ -496,60 +865,27 @@ ATCA_STATUS calib_execute_command(ATCAPacket* packet, ATCADevice device)
             }
             execution_or_wait_time = device->execution_time_msec;
             max_delay_count = 0;
+        #if ATCA_ADAPTIVE_POLL_EN
+            poll_stats = NULL;
+        #endif
         }
     #endif
 #endif
-        retries = atca_iface_get_retries(&device->mIface);
-        do
-        {
-            if ((uint8_t)ATCA_DEVICE_STATE_ACTIVE != device->device_state)
-            {
-                if (ATCA_SUCCESS == (status = calib_wakeup(device)))
-                {
-                    device->device_state = (uint8_t)ATCA_DEVICE_STATE_ACTIVE;
-                }
-            }
-
-            /* Send the command packet to the device */
-            if ((ATCA_I2C_IFACE == device->mIface.mIfaceCFG->iface_type) || (ATCA_CUSTOM_IFACE == device->mIface.mIfaceCFG->iface_type))
-            {
-                packet->reserved = 0x03;
-            }
-            if (ATCA_SWI_IFACE == device->mIface.mIfaceCFG->iface_type)
-            {
-                packet->reserved = CALIB_SWI_FLAG_CMD;
-            }
-    #if ATCA_CA2_SUPPORT
-            if ((ATCA_SWI_GPIO_IFACE == device->mIface.mIfaceCFG->iface_type) && (atcab_is_ca2_device(device->mIface.mIfaceCFG->devtype)))
-            {
-                packet->reserved = 0x03;
-            }
-    #endif
-            /* coverity[misra_c_2012_rule_18_1_violation]  calib_execute_send will not update the members of the packet structure */
-            if (ATCA_RX_NO_RESPONSE == (status = calib_execute_send(device, packet->reserved, (uint8_t*)&packet->txsize, (uint16_t)packet->txsize)))
-            {
-                device->device_state = (uint8_t)ATCA_DEVICE_STATE_UNKNOWN;
-            }
-            else
-            {
-                if ((uint8_t)ATCA_DEVICE_STATE_ACTIVE != device->device_state)
-                {
-                    device->device_state = (uint8_t)ATCA_DEVICE_STATE_ACTIVE;
-                }
-                retries = 0;
-            }
-
-        }
-        /* coverity[cert_int32_c_violation:FALSE]  No overflow possible */
-        while (0 < retries--);
-
-        if (ATCA_SUCCESS != status)
+        if (ATCA_SUCCESS != (status = calib_execute_issue(device, packet)))
         {
             break;
         }
 
+#if ATCA_HAL_DEADLINE_EN
+        // Waits are scheduled from the end of the send
+        deadline = hal_get_timestamp_us();
+#endif
+
         // Delay for execution time or initial wait before polling
-        atca_delay_ms(execution_or_wait_time);
+        calib_execute_delay(device, &deadline, execution_or_wait_time);
+#if ATCA_ADAPTIVE_POLL_EN && !defined(ATCA_NO_POLL)
+        elapsed_time = execution_or_wait_time;
+#endif
 
         do
         {
@@ -559,12 +895,32 @@ ATCA_STATUS calib_execute_command(ATCAPacket* packet, ATCADevice device)
 
             if (ATCA_SUCCESS == (status = calib_execute_receive(device, device_address, packet->data, &rxsize)))
             {
+#if ATCA_ADAPTIVE_POLL_EN && !defined(ATCA_NO_POLL)
+                if (NULL != poll_stats)
+                {
+                    calib_poll_record(poll_stats, elapsed_time);
+                }
+#endif
                 break;
             }
 
 #ifndef ATCA_NO_POLL
+    #if ATCA_ADAPTIVE_POLL_EN
+            if (NULL != poll_stats)
+            {
+                if (elapsed_time >= ATCA_POLLING_MAX_TIME_MSEC)
+                {
+                    break;
+                }
+                // delay until the next poll based on the learned execution time
+                poll_interval = calib_poll_interval(poll_stats, elapsed_time);
+                calib_execute_delay(device, &deadline, poll_interval);
+                elapsed_time += poll_interval;
+                continue;
+            }
+    #endif
             // delay for polling frequency time
-            atca_delay_ms(ATCA_POLLING_FREQUENCY_TIME_MSEC);
+            calib_execute_delay(device, &deadline, ATCA_POLLING_FREQUENCY_TIME_MSEC);
 #endif
         }
         /* coverity[cert_int30_c_violation:FALSE]  No overflow possible */
@@ -575,38 +931,404 @@ ATCA_STATUS calib_execute_command(ATCAPacket* packet, ATCADevice device)
             break;
         }
 
-        // Check response size
-        if (rxsize < 4u)
+        status = calib_execute_check_response(packet, rxsize);
+    } while (false);
+
+    calib_execute_finish(device, status);
+
+    return status;
+}
+
+#if ATCA_KEEP_AWAKE_EN
+/** \brief Executes a sequence of command packets back to back. The device is
+ *         woken once, kept awake for the whole batch and idled at the end.
+ *
+ * Each packet must be fully built by its command builder (atRead, atNonce,
+ * ...) and receives its response in its data buffer just as with
+ * calib_execute_command. Execution stops at the first command that fails so
+ * that dependent commands (e.g. GenDig after Nonce) are not run against an
+ * unexpected device state.
+ *
+ * \param[in]     device   CryptoAuthentication device to send the commands to.
+ * \param[in,out] packets  Array of count command packets. As output each
+ *                         packet holds the response of its command.
+ * \param[in]     count    Number of packets in the batch
+ * \param[out]    results  Optional array of count entries which receives the
+ *                         status and execution time of every command.
+ *
+ * \return ATCA_SUCCESS if every command succeeded, otherwise the status of the
+ *         first command that failed.
+ */
+ATCA_STATUS calib_execute_batch(ATCADevice device, ATCAPacket* packets, size_t count, calib_batch_result_t* results)
+{
+    ATCA_STATUS status;
+    ATCA_STATUS end_status;
+    uint32_t start_time;
+    size_t i;
+
+    if ((NULL == device) || ((NULL == packets) && (0u < count)))
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
+
+    if (ATCA_SUCCESS != (status = calib_session_begin(device)))
+    {
+        return status;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        if (ATCA_SUCCESS == status)
         {
-            if (rxsize > 0u)
-            {
-                status = ATCA_RX_FAIL;
-            }
-            else
+            start_time = calib_clock_ms(device);
+            status = calib_execute_command(&packets[i], device);
+
+            if (NULL != results)
             {
-                status = ATCA_RX_NO_RESPONSE;
+                results[i].status = status;
+                results[i].execution_msec = calib_clock_ms(device) - start_time;
             }
+        }
+        else if (NULL != results)
+        {
+            results[i].status = ATCA_FUNC_FAIL;
+            results[i].execution_msec = 0u;
+        }
+        else
+        {
             break;
         }
+    }
 
-        /* coverity[misra_c_2012_directive_4_14_violation:FALSE] Packet data is handled properly */
-        if ((status = atCheckCrc(packet->data)) != ATCA_SUCCESS)
+    end_status = calib_session_end(device);
+
+    return (ATCA_SUCCESS == status) ? end_status : status;
+}
+#endif
+
+#if ATCA_ASYNC_EN
+/** \brief Clock of a non-blocking operation. Without a timestamp source the
+ *         caller is trusted to wait calib_async_wait_time between polls so
+ *         time advances to the scheduled attempt.
+ */
+static uint32_t calib_async_clock(const calib_async_t* ctx)
+{
+#if ATCA_HAL_TIMESTAMP_EN
+    ((void)ctx);
+    return hal_get_timestamp_ms();
+#else
+    return ctx->next_time;
+#endif
+}
+
+/** \brief Schedule the next receive attempt msec after now */
+static void calib_async_schedule(calib_async_t* ctx, uint32_t now, uint32_t msec)
+{
+#if ATCA_KEEP_AWAKE_EN && !ATCA_HAL_TIMESTAMP_EN
+    ctx->device->wait_time_msec += msec;
+#endif
+    ctx->poll_time = now;
+    ctx->next_time = now + msec;
+#if ATCA_HAL_TIMER_FD_EN
+    if (0 <= ctx->fd)
+    {
+        (void)hal_timer_fd_arm(ctx->fd, msec);
+    }
+#endif
+}
+
+/** \brief Send the packet of the current step and schedule the first receive */
+static ATCA_STATUS calib_async_send(calib_async_t* ctx)
+{
+    ATCA_STATUS status;
+    uint32_t wait_time = ATCA_POLLING_INIT_TIME_MSEC;
+
+    if (ATCA_SUCCESS != (status = calib_execute_issue(ctx->device, &ctx->packet)))
+    {
+        return status;
+    }
+
+#if ATCA_ADAPTIVE_POLL_EN && !defined(ATCA_NO_POLL)
+    ctx->poll_stats = calib_poll_stats_get(ctx->device, ctx->packet.opcode);
+    wait_time = calib_poll_first_delay(ctx->poll_stats);
+#endif
+
+    ctx->start_time = calib_async_clock(ctx);
+    ctx->state = (uint8_t)CALIB_ASYNC_WAIT;
+    calib_async_schedule(ctx, ctx->start_time, wait_time);
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief Finish the operation - idles the device as calib_execute_command
+ *         would and records the result
+ */
+static ATCA_STATUS calib_async_complete(calib_async_t* ctx, ATCA_STATUS status)
+{
+    /* ATCA_RX_NO_RESPONSE is reserved for an operation in progress */
+    if (ATCA_RX_NO_RESPONSE == status)
+    {
+        status = ATCA_RX_TIMEOUT;
+    }
+
+    calib_execute_finish(ctx->device, status);
+
+    ctx->state = (uint8_t)CALIB_ASYNC_DONE;
+    ctx->status = status;
+
+#if ATCA_HAL_TIMER_FD_EN
+    /* Wake anyone waiting on the descriptor to collect the result */
+    if (0 <= ctx->fd)
+    {
+        (void)hal_timer_fd_arm(ctx->fd, 0u);
+    }
+#endif
+    return status;
+}
+
+/** \brief Initialize a handle for non-blocking operations. Must be called once
+ *         before the first operation is started on it.
+ *
+ * \param[out] ctx  Handle to initialize
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS calib_async_init(calib_async_t* ctx)
+{
+    if (NULL == ctx)
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
+
+    (void)memset(ctx, 0, sizeof(*ctx));
+    ctx->state = (uint8_t)CALIB_ASYNC_IDLE;
+    ctx->status = ATCA_NOT_INITIALIZED;
+#if ATCA_HAL_TIMER_FD_EN
+    ctx->fd = -1;
+#endif
+    return ATCA_SUCCESS;
+}
+
+/** \brief Release the resources held by a handle. An operation still in
+ *         progress is abandoned and the device is idled.
+ */
+void calib_async_release(calib_async_t* ctx)
+{
+    if (NULL == ctx)
+    {
+        return;
+    }
+
+    if ((uint8_t)CALIB_ASYNC_WAIT == ctx->state)
+    {
+        (void)calib_async_complete(ctx, ATCA_FUNC_FAIL);
+    }
+
+#if ATCA_HAL_TIMER_FD_EN
+    if (0 <= ctx->fd)
+    {
+        hal_timer_fd_close(ctx->fd);
+        ctx->fd = -1;
+    }
+#endif
+    ctx->state = (uint8_t)CALIB_ASYNC_IDLE;
+}
+
+/** \brief Start a non-blocking operation. The step handler builds the first
+ *         command which is sent before returning. Used by the *_async command
+ *         functions after they stored their parameters in the handle.
+ *
+ * \param[in,out] ctx         Initialized handle that is not in use
+ * \param[in]     device      Device to run the operation on
+ * \param[in]     step_fn     Operation step handler
+ * \param[in]     step_count  Number of commands the operation consists of
+ *
+ * \return ATCA_SUCCESS if the first command was sent, otherwise an error code.
+ */
+ATCA_STATUS calib_async_start(calib_async_t* ctx, ATCADevice device, calib_async_step_t step_fn, uint8_t step_count)
+{
+    ATCA_STATUS status;
+
+    if ((NULL == ctx) || (NULL == device) || (NULL == step_fn) || (0u == step_count))
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
+
+    if ((uint8_t)CALIB_ASYNC_WAIT == ctx->state)
+    {
+        return ATCA_TRACE(ATCA_FUNC_FAIL, "Operation already in progress");
+    }
+
+#if ATCA_CA2_SUPPORT
+    /* SWI over GPIO has to read the response exactly at the end of execution */
+    if ((ATCA_SWI_GPIO_IFACE == device->mIface.mIfaceCFG->iface_type) && (atcab_is_ca2_device(device->mIface.mIfaceCFG->devtype)))
+    {
+        return ATCA_TRACE(ATCA_UNIMPLEMENTED, "Interface can not be polled");
+    }
+#endif
+
+    ctx->device = device;
+    ctx->step_fn = step_fn;
+    ctx->step = 0u;
+    ctx->step_count = step_count;
+    ctx->state = (uint8_t)CALIB_ASYNC_DONE;
+
+    (void)memset(&ctx->packet, 0, sizeof(ctx->packet));
+    if (ATCA_SUCCESS != (status = step_fn(ctx, ATCA_SUCCESS)))
+    {
+        ctx->status = status;
+        return status;
+    }
+
+    if (ATCA_SUCCESS != (status = calib_async_send(ctx)))
+    {
+        (void)calib_async_complete(ctx, status);
+        return status;
+    }
+
+    ctx->status = ATCA_RX_NO_RESPONSE;
+    return ATCA_SUCCESS;
+}
+
+/** \brief Advance a non-blocking operation. Attempts to receive the response
+ *         once it may be available and moves on to the next command of the
+ *         operation. Never waits on the device.
+ *
+ * \param[in,out] ctx  Handle of a started operation
+ *
+ * \return ATCA_RX_NO_RESPONSE while the operation is in progress, otherwise
+ *         the result of the operation.
+ */
+ATCA_STATUS calib_async_poll(calib_async_t* ctx)
+{
+    ATCA_STATUS status;
+    uint32_t now;
+    uint32_t elapsed;
+    uint32_t interval = ATCA_POLLING_FREQUENCY_TIME_MSEC;
+    uint16_t rxsize;
+
+    if (NULL == ctx)
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
+
+    if ((uint8_t)CALIB_ASYNC_WAIT != ctx->state)
+    {
+        return ctx->status;
+    }
+
+#if ATCA_HAL_TIMER_FD_EN
+    if (0 <= ctx->fd)
+    {
+        hal_timer_fd_clear(ctx->fd);
+    }
+#endif
+
+    now = calib_async_clock(ctx);
+    /* coverity[cert_int31_c_violation] Wrapping difference of the free running clock */
+    if (0 < (int32_t)(ctx->next_time - now))
+    {
+        return ATCA_RX_NO_RESPONSE;
+    }
+    elapsed = now - ctx->start_time;
+
+    (void)memset(ctx->packet.data, 0, sizeof(ctx->packet.data));
+    rxsize = (uint16_t)sizeof(ctx->packet.data);
+
+    status = calib_execute_receive(ctx->device, atcab_get_device_address(ctx->device), ctx->packet.data, &rxsize);
+    if (ATCA_SUCCESS != status)
+    {
+        if (elapsed >= ATCA_POLLING_MAX_TIME_MSEC)
         {
-            break;
+            return calib_async_complete(ctx, status);
         }
+#if ATCA_ADAPTIVE_POLL_EN && !defined(ATCA_NO_POLL)
+        interval = calib_poll_interval(ctx->poll_stats, elapsed);
+#endif
+        calib_async_schedule(ctx, now, interval);
+        return ATCA_RX_NO_RESPONSE;
+    }
+
+#if ATCA_ADAPTIVE_POLL_EN && !defined(ATCA_NO_POLL)
+    calib_poll_record(ctx->poll_stats, elapsed);
+#endif
+
+    status = calib_execute_check_response(&ctx->packet, rxsize);
 
-        if ((status = isATCAError(packet->data)) != ATCA_SUCCESS)
+    ctx->step++;
+    status = ctx->step_fn(ctx, status);
+
+    if ((ATCA_SUCCESS == status) && (ctx->step < ctx->step_count))
+    {
+        /* The device stays awake between the commands of an operation */
+        if (ATCA_SUCCESS == (status = calib_async_send(ctx)))
         {
-            break;
+            return ATCA_RX_NO_RESPONSE;
         }
-    } while (false);
+    }
 
-    // Skip Idle for ECC204 device
-    if (!atcab_is_ca2_device(device->mIface.mIfaceCFG->devtype))
+    return calib_async_complete(ctx, status);
+}
+
+/** \brief Time until calib_async_poll will next attempt to make progress
+ *
+ * \return Milliseconds to wait before the next poll, 0 if the operation is not
+ *         in progress or is already due.
+ */
+uint32_t calib_async_wait_time(const calib_async_t* ctx)
+{
+#if ATCA_HAL_TIMESTAMP_EN
+    int32_t remaining;
+
+    if ((NULL == ctx) || ((uint8_t)CALIB_ASYNC_WAIT != ctx->state))
     {
-        (void)calib_idle(device);
-        device->device_state = (uint8_t)ATCA_DEVICE_STATE_IDLE;
+        return 0u;
     }
 
-    return status;
+    /* coverity[cert_int31_c_violation] Wrapping difference of the free running clock */
+    remaining = (int32_t)(ctx->next_time - hal_get_timestamp_ms());
+
+    return (0 < remaining) ? (uint32_t)remaining : 0u;
+#else
+    if ((NULL == ctx) || ((uint8_t)CALIB_ASYNC_WAIT != ctx->state))
+    {
+        return 0u;
+    }
+
+    /* The clock only advances on a poll so the full interval is due */
+    return ctx->next_time - ctx->poll_time;
+#endif
 }
+
+#if ATCA_HAL_TIMER_FD_EN
+/** \brief Get a descriptor that becomes readable when calib_async_poll should
+ *         be called next, for use in poll/select/epoll based event loops. The
+ *         descriptor belongs to the handle and is closed by calib_async_release.
+ *
+ * \return Descriptor on success, -1 on failure
+ */
+int calib_async_get_fd(calib_async_t* ctx)
+{
+    uint32_t wait_time;
+
+    if (NULL == ctx)
+    {
+        return -1;
+    }
+
+    if (0 > ctx->fd)
+    {
+        ctx->fd = hal_timer_fd_create();
+
+        /* Cover an operation started before the descriptor existed */
+        if ((0 <= ctx->fd) && ((uint8_t)CALIB_ASYNC_IDLE != ctx->state))
+        {
+            wait_time = calib_async_wait_time(ctx);
+            (void)hal_timer_fd_arm(ctx->fd, wait_time);
+        }
+    }
+
+    return ctx->fd;
+}
+#endif
+#endif
@@ -40,6 +40,7 @@
 #include "calib_command.h"
 #include "atca_device.h"
 #include "atca_config.h"
+#include "hal/atca_hal.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -71,6 +72,85 @@ ATCA_STATUS calib_execute_receive(ATCADevice device, uint8_t device_address, uin
 
 ATCA_STATUS calib_execute_command(ATCAPacket* packet, ATCADevice device);
 
+#if ATCA_ADAPTIVE_POLL_EN && !defined(ATCA_NO_POLL)
+atca_poll_stats_t* calib_poll_stats_get(ATCADevice device, uint8_t opcode);
+uint32_t calib_poll_first_delay(const atca_poll_stats_t* stats);
+uint32_t calib_poll_interval(const atca_poll_stats_t* stats, uint32_t elapsed);
+void calib_poll_record(atca_poll_stats_t* stats, uint32_t elapsed);
+#endif
+
+#if ATCA_KEEP_AWAKE_EN
+/** \brief Outcome of a single command executed by calib_execute_batch
+ */
+typedef struct
+{
+    ATCA_STATUS status;             /**< Status of the command - ATCA_FUNC_FAIL if it was not executed */
+    uint32_t    execution_msec;     /**< Time taken to execute the command */
+} calib_batch_result_t;
+
+ATCA_STATUS calib_execute_batch(ATCADevice device, ATCAPacket* packets, size_t count, calib_batch_result_t* results);
+#endif
+
+#if ATCA_ASYNC_EN
+/** \brief Progress of a non-blocking operation */
+typedef enum
+{
+    CALIB_ASYNC_IDLE,       /**< No operation has been started */
+    CALIB_ASYNC_WAIT,       /**< A command was sent and is being waited on */
+    CALIB_ASYNC_DONE        /**< The operation finished - status holds the result */
+} calib_async_state_t;
+
+struct calib_async_s;
+
+/** \brief Operation step handler. Invoked with ctx->step set to the next step
+ *         and the status of the previous command (ATCA_SUCCESS before the
+ *         first). Builds the packet for the step while step < step_count and
+ *         extracts the result from the last response once step == step_count.
+ *         Returns the status the operation continues with.
+ */
+typedef ATCA_STATUS (*calib_async_step_t)(struct calib_async_s* ctx, ATCA_STATUS status);
+
+/** \brief Handle of a non-blocking operation made of one or more commands.
+ *
+ * Initialize once with calib_async_init, start an operation with one of the
+ * *_async functions then call calib_async_poll until it no longer returns
+ * ATCA_RX_NO_RESPONSE. Buffers passed to the start function must stay valid
+ * until the operation is done.
+ */
+typedef struct calib_async_s
+{
+    ATCADevice          device;
+    ATCAPacket          packet;
+    calib_async_step_t  step_fn;
+    uint8_t             step;           /**< Index of the command in progress */
+    uint8_t             step_count;     /**< Number of commands of the operation */
+    uint8_t             state;          /**< calib_async_state_t */
+    ATCA_STATUS         status;         /**< Result once the operation is done */
+    uint32_t            start_time;     /**< Time the current command was sent */
+    uint32_t            next_time;      /**< Earliest time of the next receive attempt */
+    uint32_t            poll_time;      /**< Time the next attempt was scheduled at */
+#if ATCA_ADAPTIVE_POLL_EN
+    atca_poll_stats_t*  poll_stats;
+#endif
+    uint16_t            key_id;
+    const uint8_t*      input[3];       /**< Operation inputs */
+    uint8_t*            output;         /**< Operation output */
+    bool*               is_verified;
+#if ATCA_HAL_TIMER_FD_EN
+    int                 fd;             /**< Timer descriptor or -1 if not requested */
+#endif
+} calib_async_t;
+
+ATCA_STATUS calib_async_init(calib_async_t* ctx);
+void calib_async_release(calib_async_t* ctx);
+ATCA_STATUS calib_async_start(calib_async_t* ctx, ATCADevice device, calib_async_step_t step_fn, uint8_t step_count);
+ATCA_STATUS calib_async_poll(calib_async_t* ctx);
+uint32_t calib_async_wait_time(const calib_async_t* ctx);
+#if ATCA_HAL_TIMER_FD_EN
+int calib_async_get_fd(calib_async_t* ctx);
+#endif
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -38,6 +38,149 @@
 #error "CA_MAX_PACKET_SIZE cannot hold response packet with public key"
 #endif
 
+#if ATCA_SLOT_GENERATION_EN
+/** \brief Index of the generation counter tracking a zone and slot or
+ *         ATCA_SLOT_GENERATION_COUNT if the location isn't tracked
+ */
+static uint8_t calib_slot_generation_index(uint8_t zone, uint16_t slot)
+{
+    uint8_t index = (uint8_t)(ATCA_SLOT_GENERATION_COUNT - 1u);
+
+    if (ATCA_ZONE_DATA == (zone & ATCA_ZONE_MASK))
+    {
+        index = (slot < (ATCA_SLOT_GENERATION_COUNT - 1u)) ? (uint8_t)slot : (uint8_t)ATCA_SLOT_GENERATION_COUNT;
+    }
+    return index;
+}
+
+/** \brief Records that the contents of a slot may have changed. Drops any
+ *         public key cached for the slot and bumps its generation so results
+ *         derived from it (e.g. rebuilt certificates) are recomputed.
+ *
+ *  \param[in] device  Device context pointer
+ *  \param[in] zone    Zone that was changed
+ *  \param[in] slot    Slot that was changed for the data zone
+ */
+void calib_slot_modified(ATCADevice device, uint8_t zone, uint16_t slot)
+{
+    uint8_t index = calib_slot_generation_index(zone, slot);
+#if ATCA_PUBKEY_CACHE_EN
+    size_t i;
+#endif
+
+    if ((NULL == device) || (index >= ATCA_SLOT_GENERATION_COUNT))
+    {
+        return;
+    }
+
+    device->slot_generation[index]++;
+
+#if ATCA_PUBKEY_CACHE_EN
+    for (i = 0; i < ATCA_PUBKEY_CACHE_ENTRIES; i++)
+    {
+        if ((index < (ATCA_SLOT_GENERATION_COUNT - 1u)) && (device->pubkey_cache[i].slot == slot))
+        {
+            device->pubkey_cache[i].valid = 0u;
+        }
+    }
+#endif
+}
+
+/** \brief Returns the generation of a slot which changes every time
+ *         calib_slot_modified is called for it
+ *
+ *  \param[in] device  Device context pointer
+ *  \param[in] zone    Zone of the location
+ *  \param[in] slot    Slot of the location for the data zone
+ *
+ *  \return the generation counter or 0 for locations which aren't tracked
+ */
+uint32_t calib_slot_generation(ATCADevice device, uint8_t zone, uint16_t slot)
+{
+    uint8_t index = calib_slot_generation_index(zone, slot);
+
+    if ((NULL == device) || (index >= ATCA_SLOT_GENERATION_COUNT))
+    {
+        return 0u;
+    }
+    return device->slot_generation[index];
+}
+
+/** \brief Drops all cached public keys and bumps every slot generation. For
+ *         applications that share the device with another host or process.
+ *
+ *  \param[in] device  Device context pointer
+ */
+void calib_pubkey_cache_invalidate(ATCADevice device)
+{
+    size_t i;
+
+    if (NULL != device)
+    {
+#if ATCA_PUBKEY_CACHE_EN
+        for (i = 0; i < ATCA_PUBKEY_CACHE_ENTRIES; i++)
+        {
+            device->pubkey_cache[i].valid = 0u;
+        }
+#endif
+        for (i = 0; i < ATCA_SLOT_GENERATION_COUNT; i++)
+        {
+            device->slot_generation[i]++;
+        }
+    }
+}
+#endif
+
+#if ATCA_PUBKEY_CACHE_EN && CALIB_GENKEY_EN
+/** \brief Copies the cached public key of a slot if there is one */
+static bool calib_pubkey_cache_read(ATCADevice device, uint16_t key_id, uint8_t* public_key)
+{
+    size_t i;
+
+    for (i = 0; i < ATCA_PUBKEY_CACHE_ENTRIES; i++)
+    {
+        if ((0u != device->pubkey_cache[i].valid) && (device->pubkey_cache[i].slot == key_id))
+        {
+            (void)memcpy(public_key, device->pubkey_cache[i].public_key, ATCA_PUB_KEY_SIZE);
+            return true;
+        }
+    }
+    return false;
+}
+
+/** \brief Stores the public key of a slot replacing its previous entry or the
+ *         oldest one
+ */
+static void calib_pubkey_cache_store(ATCADevice device, uint16_t key_id, const uint8_t* public_key)
+{
+    atca_pubkey_cache_t* entry = NULL;
+    size_t i;
+
+    if (key_id >= (ATCA_SLOT_GENERATION_COUNT - 1u))
+    {
+        return;
+    }
+
+    for (i = 0; i < ATCA_PUBKEY_CACHE_ENTRIES; i++)
+    {
+        if (device->pubkey_cache[i].slot == key_id)
+        {
+            entry = &device->pubkey_cache[i];
+            break;
+        }
+    }
+    if (NULL == entry)
+    {
+        entry = &device->pubkey_cache[device->pubkey_cache_next];
+        device->pubkey_cache_next = (uint8_t)((device->pubkey_cache_next + 1u) % ATCA_PUBKEY_CACHE_ENTRIES);
+    }
+
+    entry->slot = key_id;
+    (void)memcpy(entry->public_key, public_key, ATCA_PUB_KEY_SIZE);
+    entry->valid = 1u;
+}
+#endif
+
 #if CALIB_GENKEY_EN
 /** \brief Issues GenKey command, which can generate a private key, compute a
  *          public key, nd/or compute a digest of a public key.
@@ -94,6 +237,13 @@ ATCA_STATUS calib_genkey_base(ATCADevice device, uint8_t mode, uint16_t key_id,
             break;
         }
 
+#if ATCA_SLOT_GENERATION_EN
+        if (GENKEY_MODE_PRIVATE == (mode & GENKEY_MODE_PRIVATE))
+        {
+            calib_slot_modified(device, ATCA_ZONE_DATA, key_id);
+        }
+#endif
+
         if ((status = atca_execute_command(packet, device)) != ATCA_SUCCESS)
         {
             (void)ATCA_TRACE(status, "calib_genkey_base - execution failed");
@@ -105,6 +255,12 @@ ATCA_STATUS calib_genkey_base(ATCADevice device, uint8_t mode, uint16_t key_id,
             if (packet->data[ATCA_COUNT_IDX] == (ATCA_PUB_KEY_SIZE + ATCA_PACKET_OVERHEAD))
             {
                 (void)memcpy(public_key, &packet->data[ATCA_RSP_DATA_IDX], ATCA_PUB_KEY_SIZE);
+#if ATCA_PUBKEY_CACHE_EN
+                if (0u == (mode & (GENKEY_MODE_PUBKEY_DIGEST | GENKEY_MODE_MAC)))
+                {
+                    calib_pubkey_cache_store(device, key_id, public_key);
+                }
+#endif
             }
             else
             {
@@ -150,6 +306,12 @@ ATCA_STATUS calib_genkey(ATCADevice device, uint16_t key_id, uint8_t *public_key
  */
 ATCA_STATUS calib_get_pubkey(ATCADevice device, uint16_t key_id, uint8_t *public_key)
 {
+#if ATCA_PUBKEY_CACHE_EN
+    if ((NULL != device) && (NULL != public_key) && calib_pubkey_cache_read(device, key_id, public_key))
+    {
+        return ATCA_SUCCESS;
+    }
+#endif
     return calib_genkey_base(device, GENKEY_MODE_PUBLIC, key_id, NULL, public_key);
 }
 #endif /* CALIB_GENKEY_EN */
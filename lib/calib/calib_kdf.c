@@ -131,6 +131,14 @@ ATCA_STATUS calib_kdf(ATCADevice device, uint8_t mode, uint16_t key_id, const ui
             break;
         }
 
+#if ATCA_SLOT_GENERATION_EN
+        if (KDF_MODE_TARGET_SLOT == (mode & KDF_MODE_TARGET_MASK))
+        {
+            // Target slot is in the upper byte of the key id
+            calib_slot_modified(device, ATCA_ZONE_DATA, (key_id >> 8u) & 0xFFu);
+        }
+#endif
+
         // Run command
         if ((status = atca_execute_command(packet, device)) != ATCA_SUCCESS)
         {
@@ -87,6 +87,14 @@ ATCA_STATUS calib_lock(ATCADevice device, uint8_t mode, uint16_t summary_crc)
             break;
         }
 
+#if ATCA_CONFIG_CACHE_EN
+        // Lock state is part of the configuration zone
+        calib_config_cache_invalidate(device);
+#endif
+#if ATCA_SLOT_GENERATION_EN
+        calib_slot_modified(device, ATCA_ZONE_CONFIG, 0);
+#endif
+
         if ((status = atca_execute_command(packet, device)) != ATCA_SUCCESS)
         {
             (void)ATCA_TRACE(status, "calib_lock - execution failed");
@@ -199,6 +199,10 @@ ATCA_STATUS calib_priv_write(ATCADevice device, uint16_t key_id, const uint8_t p
             break;
         }
 
+#if ATCA_SLOT_GENERATION_EN
+        calib_slot_modified(device, ATCA_ZONE_DATA, key_id);
+#endif
+
         if ((status = atca_execute_command(packet, device)) != ATCA_SUCCESS)
         {
             (void)ATCA_TRACE(status, "calib_priv_write - execution failed");
@@ -103,4 +103,56 @@ ATCA_STATUS calib_random(ATCADevice device, uint8_t *rand_out)
     calib_packet_free(packet);
     return status;
 }
+
+#if ATCA_ASYNC_EN
+/** \brief Step handler of calib_random_async */
+static ATCA_STATUS calib_random_async_step(calib_async_t* ctx, ATCA_STATUS status)
+{
+    if (ATCA_SUCCESS != status)
+    {
+        return status;
+    }
+
+    if (0u == ctx->step)
+    {
+        // build an random command
+        ctx->packet.param1 = RANDOM_SEED_UPDATE;
+        ctx->packet.param2 = 0x0000;
+        return atRandom(atcab_get_device_type_ext(ctx->device), &ctx->packet);
+    }
+
+    if (ctx->packet.data[ATCA_COUNT_IDX] != RANDOM_RSP_SIZE)
+    {
+        return ATCA_TRACE(ATCA_RX_FAIL, "Unexpected response size");
+    }
+
+    if (NULL != ctx->output)
+    {
+        (void)memcpy(ctx->output, &ctx->packet.data[ATCA_RSP_DATA_IDX], RANDOM_NUM_SIZE);
+    }
+    return ATCA_SUCCESS;
+}
+
+/** \brief Starts a Random command without waiting for it to complete. Poll the
+ *          handle with calib_async_poll for the result.
+ *
+ * \param[in]     device    Device context pointer
+ * \param[in,out] ctx       Initialized handle that is not in use
+ * \param[out]    rand_out  32 bytes of random data is returned here once the
+ *                          operation completes.
+ *
+ * \return ATCA_SUCCESS if the command was started, otherwise an error code.
+ */
+ATCA_STATUS calib_random_async(ATCADevice device, calib_async_t* ctx, uint8_t* rand_out)
+{
+    if ((NULL == ctx) || ((uint8_t)CALIB_ASYNC_WAIT == ctx->state))
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "Invalid handle received");
+    }
+
+    ctx->output = rand_out;
+
+    return calib_async_start(ctx, device, calib_random_async_step, 1u);
+}
+#endif
 #endif  /* CALIB_RANDOM_EN */
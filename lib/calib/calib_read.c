@@ -39,7 +39,162 @@
 #include "host/atca_host.h"
 #endif
 
+#if ATCA_CONFIG_CACHE_EN
+/* Configuration bytes that change without a Write or Lock command (counters on
+   the ECC608, UseFlag/UpdateCount/LastKeyUse on the others) are always read
+   from the device */
+#define CALIB_CONFIG_CACHE_VOLATILE_START   (52u)
+#define CALIB_CONFIG_CACHE_VOLATILE_END     (84u)
+#define CALIB_CONFIG_CACHE_LOCK_CONFIG      (87u)
+
+/** \brief Drop the cached configuration zone. Called after a lock or a failed
+ *         configuration write and may be called by applications when another
+ *         process shares the device.
+ *
+ *  \param[in] device  Device context pointer
+ */
+void calib_config_cache_invalidate(ATCADevice device)
+{
+    if (NULL != device)
+    {
+        device->config_cache_state = (uint8_t)CALIB_CONFIG_CACHE_EMPTY;
+    }
+}
+
+/** \brief Apply a successful write of the configuration zone to the cache so
+ *         the zone doesn't have to be read again
+ *
+ *  \param[in] device  Device context pointer
+ *  \param[in] offset  Byte offset of the write in the configuration zone
+ *  \param[in] data    Bytes written
+ *  \param[in] len     Number of bytes written
+ */
+void calib_config_cache_update(ATCADevice device, size_t offset, const uint8_t* data, size_t len)
+{
+    if (NULL != device)
+    {
+        if ((((uint8_t)CALIB_CONFIG_CACHE_VALID == device->config_cache_state) ||
+             ((uint8_t)CALIB_CONFIG_CACHE_UNLOCKED == device->config_cache_state)) &&
+            (NULL != data) && ((offset + len) <= sizeof(device->config_cache)))
+        {
+            (void)memcpy(&device->config_cache[offset], data, len);
+        }
+        else
+        {
+            device->config_cache_state = (uint8_t)CALIB_CONFIG_CACHE_EMPTY;
+        }
+    }
+}
+#endif
+
 #if CALIB_READ_EN
+#if ATCA_CONFIG_CACHE_EN
+/** \brief Size of the configuration zone for devices whose configuration can
+ *         be cached, otherwise 0
+ */
+static size_t calib_config_cache_size(ATCADevice device)
+{
+    size_t size;
+
+    switch (atcab_get_device_type_ext(device))
+    {
+    case ATSHA204A:
+        size = ATCA_SHA_CONFIG_SIZE;
+        break;
+    case ATECC108A:
+    /* fallthrough */
+    case ATECC508A:
+    /* fallthrough */
+    case ATECC608:
+        size = ATCA_ECC_CONFIG_SIZE;
+        break;
+    default:
+        size = 0u;
+        break;
+    }
+
+    return size;
+}
+
+/** \brief Read the whole configuration zone into the cache. The cache is only
+ *         used when the configuration zone turns out to be locked.
+ */
+static void calib_config_cache_fill(ATCADevice device, size_t size)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    uint8_t block = 0u;
+    uint8_t offset = 0u;
+
+    device->config_cache_state = (uint8_t)CALIB_CONFIG_CACHE_FILLING;
+
+#if ATCA_KEEP_AWAKE_EN
+    (void)calib_session_begin(device);
+#endif
+    for (; (ATCA_SUCCESS == status) && ((((size_t)block + 1u) * ATCA_BLOCK_SIZE) <= size); block++)
+    {
+        status = calib_read_zone(device, ATCA_ZONE_CONFIG, 0, block, 0, &device->config_cache[block * ATCA_BLOCK_SIZE], ATCA_BLOCK_SIZE);
+    }
+    // Remainder of a zone that is not a whole number of blocks (ATSHA204A)
+    for (; (ATCA_SUCCESS == status) && ((((size_t)block * ATCA_BLOCK_SIZE) + (((size_t)offset + 1u) * ATCA_WORD_SIZE)) <= size); offset++)
+    {
+        status = calib_read_zone(device, ATCA_ZONE_CONFIG, 0, block, offset,
+                                 &device->config_cache[(block * ATCA_BLOCK_SIZE) + (offset * ATCA_WORD_SIZE)], ATCA_WORD_SIZE);
+    }
+#if ATCA_KEEP_AWAKE_EN
+    (void)calib_session_end(device);
+#endif
+
+    if (ATCA_SUCCESS != status)
+    {
+        device->config_cache_state = (uint8_t)CALIB_CONFIG_CACHE_EMPTY;
+    }
+    else if (0x55u == device->config_cache[CALIB_CONFIG_CACHE_LOCK_CONFIG])
+    {
+        device->config_cache_state = (uint8_t)CALIB_CONFIG_CACHE_UNLOCKED;
+    }
+    else
+    {
+        device->config_cache_state = (uint8_t)CALIB_CONFIG_CACHE_VALID;
+    }
+}
+
+/** \brief Answer a configuration zone read from the cache, filling it first
+ *         if required
+ *
+ *  \return ATCA_SUCCESS if the data was returned from the cache
+ */
+static ATCA_STATUS calib_config_cache_read(ATCADevice device, uint8_t block, uint8_t offset, uint8_t *data, uint8_t len)
+{
+    size_t size = calib_config_cache_size(device);
+    size_t start = (size_t)block * ATCA_BLOCK_SIZE;
+
+    if (ATCA_WORD_SIZE == len)
+    {
+        start += (size_t)offset * ATCA_WORD_SIZE;
+    }
+
+    if ((((uint8_t)CALIB_CONFIG_CACHE_EMPTY != device->config_cache_state) &&
+         ((uint8_t)CALIB_CONFIG_CACHE_VALID != device->config_cache_state)) ||
+        ((start + len) > size) ||
+        ((start < CALIB_CONFIG_CACHE_VOLATILE_END) && ((start + len) > CALIB_CONFIG_CACHE_VOLATILE_START)))
+    {
+        return ATCA_FUNC_FAIL;
+    }
+
+    if ((uint8_t)CALIB_CONFIG_CACHE_EMPTY == device->config_cache_state)
+    {
+        calib_config_cache_fill(device, size);
+        if ((uint8_t)CALIB_CONFIG_CACHE_VALID != device->config_cache_state)
+        {
+            return ATCA_FUNC_FAIL;
+        }
+    }
+
+    (void)memcpy(data, &device->config_cache[start], len);
+    return ATCA_SUCCESS;
+}
+#endif
+
 /** \brief Executes Read command, which reads either 4 or 32 bytes of data from
  *          a given slot, configuration zone, or the OTP zone.
  *
@@ -71,6 +226,14 @@ ATCA_STATUS calib_read_zone(ATCADevice device, uint8_t zone, uint16_t slot, uint
         ATCA_CHECK_INVALID_MSG((len != 4u && len != 32u), ATCA_BAD_PARAM, "NULL pointer received");
         ATCA_CHECK_INVALID_MSG((CA_MAX_PACKET_SIZE < (ATCA_PACKET_OVERHEAD + len)), ATCA_INVALID_SIZE, "Invalid size received");
 
+#if ATCA_CONFIG_CACHE_EN
+        if ((ATCA_ZONE_CONFIG == (zone & ATCA_ZONE_MASK)) && (ATCA_SUCCESS == calib_config_cache_read(device, block, offset, data, len)))
+        {
+            status = ATCA_SUCCESS;
+            break;
+        }
+#endif
+
         packet = calib_packet_alloc();
         if(NULL == packet)
         {
@@ -102,6 +102,14 @@ ATCA_STATUS calib_secureboot(ATCADevice device, uint8_t mode, uint16_t param2, c
             break;
         }
 
+#if ATCA_SLOT_GENERATION_EN
+        if ((SECUREBOOT_MODE_FULL_STORE == (mode & SECUREBOOT_MODE_MASK)) || (SECUREBOOT_MODE_FULL_COPY == (mode & SECUREBOOT_MODE_MASK)))
+        {
+            // The digest slot is set in the configuration zone so treat every slot as changed
+            calib_pubkey_cache_invalidate(device);
+        }
+#endif
+
         if ((status = atca_execute_command(packet, device)) != ATCA_SUCCESS)
         {
             (void)ATCA_TRACE(status, "calib_secureboot - execution failed");
@@ -491,6 +491,31 @@ ATCA_STATUS calib_sha_hmac_update(ATCADevice device, atca_hmac_sha256_ctx_t* ctx
     return ATCA_SUCCESS;
 }
 
+/** \brief Mode of the SHA command completing an HMAC on the given device type */
+static uint8_t calib_sha_hmac_end_mode(ATCADeviceType dev_type)
+{
+    uint8_t mode;
+
+    switch (dev_type)
+    {
+        case ATECC608:
+            mode = SHA_MODE_608_HMAC_END;
+            break;
+#if ATCA_CA2_SUPPORT
+        case ECC204:
+        /* fallthrough */
+        case TA010:
+            mode = SHA_MODE_ECC204_HMAC_END;
+            break;
+#endif
+        default:
+            mode = SHA_MODE_HMAC_END;
+            break;
+    }
+
+    return mode;
+}
+
 /** \brief Executes SHA command to complete a HMAC/SHA-256 operation.
  *
  * \param[in]  device  Device context pointer
@@ -509,7 +534,6 @@ ATCA_STATUS calib_sha_hmac_finish(ATCADevice device, atca_hmac_sha256_ctx_t *ctx
 {
     uint8_t mode;
     uint16_t digest_size = 32;
-    ATCADeviceType dev_type = device->mIface.mIfaceCFG->devtype;
 
 #if ATCA_CHECK_PARAMS_EN
     if (device == NULL)
@@ -518,24 +542,7 @@ ATCA_STATUS calib_sha_hmac_finish(ATCADevice device, atca_hmac_sha256_ctx_t *ctx
     }
 #endif
 
-    switch (dev_type)
-    {
-        case ATECC608:
-            mode = SHA_MODE_608_HMAC_END;
-            break;
-#if ATCA_CA2_SUPPORT
-        case ECC204:
-        /* fallthrough */
-        case TA010:
-            mode = SHA_MODE_ECC204_HMAC_END;
-            break;
-#endif
-        default:
-            mode = SHA_MODE_HMAC_END;
-            break;
-    }
-
-    mode |= target;
+    mode = calib_sha_hmac_end_mode(device->mIface.mIfaceCFG->devtype) | target;
 
     /* coverity[misra_c_2012_rule_10_1_violation:FALSE] The cast ensures size arithmetic is correctly promoted for subtraction */
     /* coverity[misra_c_2012_rule_10_4_violation:FALSE] The final result is explicitly masked with UINT16_MAX to ensure predictable behavior across compilers */
@@ -579,4 +586,117 @@ ATCA_STATUS calib_sha_hmac(ATCADevice device, const uint8_t * data, size_t data_
 
     return ATCA_SUCCESS;
 }
+
+/** \brief Repeatedly replaces a 32 byte message with its HMAC and xors every
+ *          result into an accumulator - the inner loop of PBKDF2.
+ *
+ * The HMAC start and end commands are built once; each iteration only puts
+ * the new message and CRC into the end command. With ATCA_KEEP_AWAKE_EN the
+ * device stays awake for the whole loop instead of being idled after every
+ * command.
+ *
+ * \param[in]     device      Device context pointer
+ * \param[in]     key_slot    Slot key id to use for the HMAC calculation
+ * \param[in,out] message     Message of the first HMAC as input, result of the
+ *                            last one as output (32 bytes)
+ * \param[in,out] accumulator Every HMAC result is xored into this (32 bytes)
+ * \param[in]     iterations  Number of HMACs to compute
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS calib_sha_hmac_iterate(ATCADevice device, uint16_t key_slot, uint8_t* message, uint8_t* accumulator,
+                                   uint32_t iterations)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    ATCAPacket* start_packet;
+    ATCAPacket* end_packet;
+    ATCADeviceType dev_type;
+    uint8_t start_crc[ATCA_CRC_SIZE];
+    uint32_t i;
+    size_t j;
+#if ATCA_KEEP_AWAKE_EN
+    bool session;
+#endif
+
+    if ((NULL == device) || (NULL == message) || (NULL == accumulator))
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
+
+    if (0u == iterations)
+    {
+        return ATCA_SUCCESS;
+    }
+
+    start_packet = calib_packet_alloc();
+    end_packet = calib_packet_alloc();
+    if ((NULL == start_packet) || (NULL == end_packet))
+    {
+        calib_packet_free(start_packet);
+        calib_packet_free(end_packet);
+        return ATCA_TRACE(ATCA_ALLOC_FAILURE, "calib_packet_alloc - failed");
+    }
+
+    dev_type = device->mIface.mIfaceCFG->devtype;
+
+    (void)memset(start_packet, 0x00, sizeof(ATCAPacket));
+    start_packet->param1 = atcab_is_ca2_device(dev_type) ? SHA_MODE_ECC204_HMAC_START : SHA_MODE_HMAC_START;
+    start_packet->param2 = (SHA_MODE_ECC204_HMAC_START != start_packet->param1) ? key_slot : 0u;
+    (void)atSHA(dev_type, start_packet, 0);
+    (void)memcpy(start_crc, start_packet->data, ATCA_CRC_SIZE);
+
+    (void)memset(end_packet, 0x00, sizeof(ATCAPacket));
+    end_packet->param1 = calib_sha_hmac_end_mode(dev_type);
+    end_packet->param2 = ATCA_SHA256_DIGEST_SIZE;
+    (void)atSHA(dev_type, end_packet, 0);
+
+#if ATCA_KEEP_AWAKE_EN
+    status = calib_session_begin(device);
+    session = (ATCA_SUCCESS == status);
+#endif
+
+    for (i = 0; (i < iterations) && (ATCA_SUCCESS == status); i++)
+    {
+        /* The responses overwrite the data of the packets */
+        (void)memcpy(start_packet->data, start_crc, ATCA_CRC_SIZE);
+        if (ATCA_SUCCESS != (status = atca_execute_command(start_packet, device)))
+        {
+            (void)ATCA_TRACE(status, "HMAC start - execution failed");
+            break;
+        }
+
+        (void)memcpy(end_packet->data, message, ATCA_SHA256_DIGEST_SIZE);
+        atCRC((size_t)end_packet->txsize - ATCA_CRC_SIZE, &end_packet->txsize, &end_packet->data[ATCA_SHA256_DIGEST_SIZE]);
+        if (ATCA_SUCCESS != (status = atca_execute_command(end_packet, device)))
+        {
+            (void)ATCA_TRACE(status, "HMAC end - execution failed");
+            break;
+        }
+
+        if ((ATCA_SHA256_DIGEST_SIZE + ATCA_PACKET_OVERHEAD) != end_packet->data[ATCA_COUNT_IDX])
+        {
+            status = ATCA_TRACE(ATCA_RX_FAIL, "Unexpected HMAC response size");
+            break;
+        }
+
+        (void)memcpy(message, &end_packet->data[ATCA_RSP_DATA_IDX], ATCA_SHA256_DIGEST_SIZE);
+        for (j = 0; j < ATCA_SHA256_DIGEST_SIZE; j++)
+        {
+            accumulator[j] ^= message[j];
+        }
+    }
+
+#if ATCA_KEEP_AWAKE_EN
+    if (session)
+    {
+        ATCA_STATUS end_status = calib_session_end(device);
+        status = (ATCA_SUCCESS == status) ? end_status : status;
+    }
+#endif
+
+    calib_packet_free(start_packet);
+    calib_packet_free(end_packet);
+
+    return status;
+}
 #endif  /* CALIB_SHA_HMAC_EN */
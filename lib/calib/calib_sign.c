@@ -164,6 +164,102 @@ ATCA_STATUS calib_sign(ATCADevice device, uint16_t key_id, const uint8_t *msg, u
 
     return status;
 }
+
+#if ATCA_ASYNC_EN
+/** \brief Step handler of calib_sign_async. Steps are counted down to the
+ *         result since the seed update is optional.
+ */
+static ATCA_STATUS calib_sign_async_step(calib_async_t* ctx, ATCA_STATUS status)
+{
+    ATCADeviceType devtype = atcab_get_device_type_ext(ctx->device);
+    uint8_t nonce_target = NONCE_MODE_TARGET_TEMPKEY;
+    uint8_t sign_source = SIGN_MODE_SOURCE_TEMPKEY;
+
+    if (ATCA_SUCCESS != status)
+    {
+        return status;
+    }
+
+#ifdef ATCA_ATECC608_SUPPORT
+    if (ATECC608 == devtype)
+    {
+        // Use the Message Digest Buffer for the ATECC608
+        nonce_target = NONCE_MODE_TARGET_MSGDIGBUF;
+        sign_source = SIGN_MODE_SOURCE_MSGDIGBUF;
+    }
+#endif
+
+    switch (ctx->step_count - ctx->step)
+    {
+#if CALIB_RANDOM_EN
+    case 3:
+        // Make sure RNG has updated its seed
+        ctx->packet.param1 = RANDOM_SEED_UPDATE;
+        ctx->packet.param2 = 0x0000;
+        status = atRandom(devtype, &ctx->packet);
+        break;
+#endif
+    case 2:
+        // Load message into device
+        ctx->packet.param1 = NONCE_MODE_PASSTHROUGH | NONCE_MODE_INPUT_LEN_32 | nonce_target;
+        ctx->packet.param2 = 0x0000;
+        (void)memcpy(ctx->packet.data, ctx->input[0], 32);
+        status = atNonce(devtype, &ctx->packet);
+        break;
+    case 1:
+        // Sign the message
+        ctx->packet.param1 = SIGN_MODE_EXTERNAL | sign_source;
+        ctx->packet.param2 = ctx->key_id;
+        status = atSign(devtype, &ctx->packet);
+        break;
+    default:
+        if (ctx->packet.data[ATCA_COUNT_IDX] == (ATCA_SIG_SIZE + ATCA_PACKET_OVERHEAD))
+        {
+            (void)memcpy(ctx->output, &ctx->packet.data[ATCA_RSP_DATA_IDX], ATCA_SIG_SIZE);
+        }
+        else
+        {
+            status = ATCA_RX_FAIL;
+        }
+        break;
+    }
+
+    return status;
+}
+
+/** \brief Starts signing a 32-byte external message (see calib_sign) without
+ *          waiting for the commands to complete. Poll the handle with
+ *          calib_async_poll for the result.
+ *
+ *  \param[in]     device     Device context pointer
+ *  \param[in,out] ctx        Initialized handle that is not in use
+ *  \param[in]     key_id     Slot of the private key to be used to sign the
+ *                            message.
+ *  \param[in]     msg        32-byte message to be signed. Must remain valid
+ *                            until the operation completes.
+ *  \param[out]    signature  Signature is returned here once the operation
+ *                            completes.
+ *
+ * \return ATCA_SUCCESS if the operation was started, otherwise an error code.
+ */
+ATCA_STATUS calib_sign_async(ATCADevice device, calib_async_t* ctx, uint16_t key_id, const uint8_t *msg, uint8_t *signature)
+{
+    if ((NULL == ctx) || ((uint8_t)CALIB_ASYNC_WAIT == ctx->state) || (NULL == msg) || (NULL == signature))
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
+
+    ctx->key_id = key_id;
+    ctx->input[0] = msg;
+    ctx->output = signature;
+
+#if CALIB_RANDOM_EN
+    return calib_async_start(ctx, device, calib_sign_async_step, 3u);
+#else
+    return calib_async_start(ctx, device, calib_sign_async_step, 2u);
+#endif
+}
+#endif
 #endif
 
 #if CALIB_SIGN_EN || CALIB_SIGN_CA2_EN
@@ -87,12 +87,28 @@ ATCA_STATUS calib_updateextra(ATCADevice device, uint8_t mode, uint16_t new_valu
             break;
         }
 
+#if ATCA_SLOT_GENERATION_EN
+        calib_slot_modified(device, ATCA_ZONE_CONFIG, 0);
+#endif
+
         if ((status = atca_execute_command(packet, device)) != ATCA_SUCCESS)
         {
+#if ATCA_CONFIG_CACHE_EN
+            calib_config_cache_invalidate(device);
+#endif
             (void)ATCA_TRACE(status, "calib_updateextra - execution failed");
             break;
         }
 
+#if ATCA_CONFIG_CACHE_EN
+        // UserExtra and Selector are part of the configuration zone
+        if ((UPDATE_MODE_USER_EXTRA == mode) || (UPDATE_MODE_SELECTOR == mode))
+        {
+            uint8_t value = (uint8_t)(new_value & 0xFFu);
+            calib_config_cache_update(device, 84u + mode, &value, 1u);
+        }
+#endif
+
     } while (false);
 
     calib_packet_free(packet);
@@ -368,6 +368,92 @@ ATCA_STATUS calib_verify_extern(ATCADevice device, const uint8_t *message, const
 
     return status;
 }
+
+#if ATCA_ASYNC_EN
+/** \brief Step handler of calib_verify_extern_async */
+static ATCA_STATUS calib_verify_extern_async_step(calib_async_t* ctx, ATCA_STATUS status)
+{
+    ATCADeviceType devtype = atcab_get_device_type_ext(ctx->device);
+    uint8_t nonce_target = NONCE_MODE_TARGET_TEMPKEY;
+    uint8_t verify_source = VERIFY_MODE_SOURCE_TEMPKEY;
+
+    if (ctx->step == ctx->step_count)
+    {
+        *ctx->is_verified = (status == ATCA_SUCCESS);
+        if (status == ATCA_CHECKMAC_VERIFY_FAILED)
+        {
+            status = ATCA_SUCCESS;  // Verify failed, but command succeeded
+        }
+        return status;
+    }
+
+    if (ATCA_SUCCESS != status)
+    {
+        return status;
+    }
+
+    if (ATECC608 == devtype)
+    {
+        // Use the Message Digest Buffer for the ATECC608
+        nonce_target = NONCE_MODE_TARGET_MSGDIGBUF;
+        verify_source = VERIFY_MODE_SOURCE_MSGDIGBUF;
+    }
+
+    if (0u == ctx->step)
+    {
+        // Load message into device
+        ctx->packet.param1 = NONCE_MODE_PASSTHROUGH | NONCE_MODE_INPUT_LEN_32 | nonce_target;
+        ctx->packet.param2 = 0x0000;
+        (void)memcpy(ctx->packet.data, ctx->input[0], 32);
+        return atNonce(devtype, &ctx->packet);
+    }
+
+    // Build the verify command
+    ctx->packet.param1 = VERIFY_MODE_EXTERNAL | verify_source;
+    ctx->packet.param2 = VERIFY_KEY_P256;
+    (void)memcpy(&ctx->packet.data[0], ctx->input[1], ATCA_SIG_SIZE);
+    (void)memcpy(&ctx->packet.data[ATCA_SIG_SIZE], ctx->input[2], ATCA_PUB_KEY_SIZE);
+    return atVerify(devtype, &ctx->packet);
+}
+
+/** \brief Starts verifying a signature with an external public key (see
+ *          calib_verify_extern) without waiting for the commands to complete.
+ *          Poll the handle with calib_async_poll for the result.
+ *
+ * \param[in]     device       Device context pointer
+ * \param[in,out] ctx          Initialized handle that is not in use
+ * \param[in]     message      32 byte message to be verified.
+ * \param[in]     signature    Signature to be verified. R and S integers in
+ *                             big-endian format. 64 bytes for P256 curve.
+ * \param[in]     public_key   The public key to be used for verification. X and
+ *                             Y integers in big-endian format. 64 bytes for
+ *                             P256 curve.
+ * \param[out]    is_verified  Boolean whether or not the message, signature,
+ *                             public key verified. Set once the operation
+ *                             completes.
+ *
+ * All inputs must remain valid until the operation completes.
+ *
+ * \return ATCA_SUCCESS if the operation was started, otherwise an error code.
+ */
+ATCA_STATUS calib_verify_extern_async(ATCADevice device, calib_async_t* ctx, const uint8_t *message, const uint8_t *signature,
+                                      const uint8_t *public_key, bool *is_verified)
+{
+    if ((NULL == ctx) || ((uint8_t)CALIB_ASYNC_WAIT == ctx->state) || (is_verified == NULL) || (signature == NULL) ||
+        (message == NULL) || (public_key == NULL))
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
+
+    *is_verified = false;
+    ctx->input[0] = message;
+    ctx->input[1] = signature;
+    ctx->input[2] = public_key;
+    ctx->is_verified = is_verified;
+
+    return calib_async_start(ctx, device, calib_verify_extern_async_step, 2u);
+}
+#endif
 #endif  /* CALIB_VERIFY_EXTERN */
 
 #if CALIB_VERIFY_STORED_EN
@@ -119,12 +119,31 @@ ATCA_STATUS calib_write(ATCADevice device, uint8_t zone, uint16_t address, const
             break;
         }
 
+#if ATCA_SLOT_GENERATION_EN
+        calib_slot_modified(device, zone, (uint16_t)((address >> 3u) & 0x0Fu));
+#endif
+
         if ((status = atca_execute_command(packet, device)) != ATCA_SUCCESS)
         {
+#if ATCA_CONFIG_CACHE_EN
+            if (ATCA_ZONE_CONFIG == (zone & ATCA_ZONE_MASK))
+            {
+                // The write may have reached the device before the failure
+                calib_config_cache_invalidate(device);
+            }
+#endif
             (void)ATCA_TRACE(status, "calib_write - execution failed");
             break;
         }
 
+#if ATCA_CONFIG_CACHE_EN
+        if (ATCA_ZONE_CONFIG == (zone & ATCA_ZONE_MASK))
+        {
+            calib_config_cache_update(device, (((size_t)address >> 3u) & 0x1Fu) * ATCA_BLOCK_SIZE + ((size_t)address & 0x07u) * ATCA_WORD_SIZE,
+                                      value, ((zone & ATCA_ZONE_READWRITE_32) == ATCA_ZONE_READWRITE_32) ? ATCA_BLOCK_SIZE : ATCA_WORD_SIZE);
+        }
+#endif
+
     } while (false);
 
     calib_packet_free(packet);
@@ -637,6 +656,10 @@ ATCA_STATUS calib_ca2_write(ATCADevice device, uint8_t zone, uint16_t address, c
         }
 
         (void)atWrite(atcab_get_device_type_ext(device), packet, require_mac);
+
+#if ATCA_SLOT_GENERATION_EN
+        calib_slot_modified(device, zone, (uint16_t)((address >> 3u) & 0x1Fu));
+#endif
     }
 
     if (ATCA_SUCCESS == status)
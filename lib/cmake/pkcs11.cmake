@@ -24,6 +24,13 @@ set(PKCS11_MAX_LABEL_SIZE       30  CACHE STRING "Maximum label size in characte
 set(PKCS11_MAX_CONFIG_ALLOWED 7 CACHE STRING "Maximum depth to configuration options")
 set(PKCS11_PIN_PBKDF2_ITERATIONS  2 CACHE STRING "Define how many iterations PBKDF2 will use for PIN KDF")
 set(PKCS11_SEARCH_CACHE_SIZE    250 CACHE STRING "Static Search Attribute Cache in bytes")
+set(PKCS11_DEV_QUEUE_SIZE       16  CACHE STRING "Maximum number of waiters queued for a device across processes")
+set(PKCS11_DEV_HOLD_TIMEOUT_MS  500 CACHE STRING "Milliseconds a device may be held before the owning process is checked")
+
+# The test application checks that slots are locked independently of each other
+if(BUILD_TESTS AND PKCS11_MAX_SLOTS_ALLOWED LESS 2)
+set(PKCS11_MAX_SLOTS_ALLOWED 2)
+endif()
 
 file(GLOB PKCS11_SRC RELATIVE ${CMAKE_CURRENT_SOURCE_DIR} "pkcs11/*.c")
 file(GLOB PKCS11_INC RELATIVE ${CMAKE_CURRENT_SOURCE_DIR} "pkcs11/*.h")
@@ -29,7 +29,106 @@
 #include "cryptoauthlib.h"
 #include "cal_internal.h"
 
+#if ATCAC_PBKDF2_SHA256_EN && ATCA_CRYPTO_SHA2_HMAC_EN
+#include "hashes/sha2_routines.h"
+#endif
+
 #if ATCAC_PBKDF2_SHA256_EN
+#if ATCA_CRYPTO_SHA2_HMAC_EN
+/** \brief Calculate a PBKDF2 hash of a given password and salt
+ *
+ * The software HMAC keeps the key midstates between messages, so the
+ * iterations run directly on the compression function and several output
+ * blocks are derived together (see ATCAC_PBKDF2_SHA256_BATCH).
+ *
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcac_pbkdf2_sha256(
+    const uint32_t  iter,           /**< [in] Number of iterations of the algorithm to perform */
+    const uint8_t * password,       /**< [in] Password to hash */
+    const size_t    password_len,   /**< [in] Length of the password bytes buffer */
+    const uint8_t * salt,           /**< [in] Salt bytes to use */
+    const size_t    salt_len,       /**< [in] Length of the salt bytes buffer */
+    uint8_t *       result,         /**< [out] Output buffer to hold the derived key */
+    size_t          result_len      /**< [in] Length of the key to derive */
+    )
+{
+    ATCA_STATUS status = ATCA_BAD_PARAM;
+    atcac_hmac_ctx_t ctx;
+    atcac_sha2_256_ctx_t sha256_ctx;
+    uint32_t counter = 1;
+    uint32_t count;
+    uint32_t i;
+    uint8_t u_digest[ATCAC_PBKDF2_SHA256_BATCH][ATCA_SHA256_DIGEST_SIZE];
+    uint8_t t_digest[ATCAC_PBKDF2_SHA256_BATCH][ATCA_SHA256_DIGEST_SIZE];
+
+    if ((0U >= result_len))
+    {
+        return status;
+    }
+
+    if (ATCA_SUCCESS != (status = atcac_sha256_hmac_init(&ctx, &sha256_ctx, password, (uint8_t)(password_len & 0xFFu))))
+    {
+        return status;
+    }
+
+    do
+    {
+        size_t temp_size = ATCA_SHA256_DIGEST_SIZE;
+        uint32_t temp_u32;
+
+        /* U1 of every block in the batch */
+        for (count = 0u; (count < ATCAC_PBKDF2_SHA256_BATCH) && (count * ATCA_SHA256_DIGEST_SIZE < result_len); count++)
+        {
+            if (ATCA_SUCCESS != (status = atcac_sha256_hmac_update(&ctx, salt, salt_len)))
+            {
+                break;
+            }
+
+            /* coverity[cert_int30_c_violation:FALSE] counter can't wrap as result_len is checked to be less than SIZE_MAX */
+            temp_u32 = ATCA_UINT32_HOST_TO_BE(counter + count);
+            if (ATCA_SUCCESS != (status = atcac_sha256_hmac_update(&ctx, (uint8_t*)&temp_u32, 4)))
+            {
+                break;
+            }
+
+            if (ATCA_SUCCESS != (status = atcac_sha256_hmac_finish(&ctx, u_digest[count], &temp_size)))
+            {
+                break;
+            }
+            (void)memcpy(t_digest[count], u_digest[count], ATCA_SHA256_DIGEST_SIZE);
+        }
+
+        if (ATCA_SUCCESS != status)
+        {
+            break;
+        }
+
+        if (ATCA_SUCCESS != (status = sw_sha256_hmac_iterate((const sw_sha256_ctx*)&ctx.inner, (const sw_sha256_ctx*)&ctx.outer,
+                                                             u_digest, t_digest, count, (1u < iter) ? (iter - 1u) : 0u)))
+        {
+            break;
+        }
+
+        for (i = 0u; i < count; i++)
+        {
+            size_t copy_len = (result_len < ATCA_SHA256_DIGEST_SIZE) ? result_len : ATCA_SHA256_DIGEST_SIZE;
+            (void)memcpy(result, t_digest[i], copy_len);
+
+            result_len -= copy_len;
+            result += copy_len;
+        }
+
+        counter += count;
+    }
+    while (0u < result_len);
+
+    (void)memset(&ctx, 0, sizeof(ctx));
+    (void)memset(&sha256_ctx, 0, sizeof(sha256_ctx));
+
+    return status;
+}
+#else /* ATCA_CRYPTO_SHA2_HMAC_EN */
 /** \brief Calculate a PBKDF2 hash of a given password and salt
  *
  *  \return ATCA_SUCCESS on success, otherwise an error code.
@@ -123,71 +222,170 @@ ATCA_STATUS atcac_pbkdf2_sha256(
     while (0u < result_len);
     return status;
 }
+#endif /* ATCA_CRYPTO_SHA2_HMAC_EN */
 #endif /* ATCAC_PBKDF2_SHA256 */
 
 #if ATCAB_PBKDF2_SHA256_EN
-/** \brief Calculate a PBKDF2 password hash using a stored key inside a device. The key length is
- *  determined by the device being used. ECCx08: 32 bytes, TA100: 16-64 bytes
+/** \brief Run the remaining iterations of an output block: U = HMAC(U), T ^= U */
+static ATCA_STATUS atcab_pbkdf2_sha256_iterate(
+    ATCADevice     device,              /**< [in] Device context pointer */
+    const uint16_t slot,                /**< [in] Slot/handle with a stored key (password) */
+    uint8_t*       u_digest,            /**< [inout] Last HMAC of the block */
+    uint8_t*       t_digest,            /**< [inout] Running xor of the HMACs of the block */
+    uint32_t       count                /**< [in] Number of iterations to run */
+    )
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    uint32_t i, j;
+
+#if CALIB_SHA_HMAC_EN
+    if (atcab_is_ca_device(atcab_get_device_type_ext(device)))
+    {
+        return calib_sha_hmac_iterate(device, slot, u_digest, t_digest, count);
+    }
+#endif
+
+    for (i = 0u; (i < count) && (ATCA_SUCCESS == status); i++)
+    {
+        if (ATCA_SUCCESS == (status = ATCA_TRACE(atcab_sha_hmac_ext(device, u_digest, ATCA_SHA256_DIGEST_SIZE, slot, u_digest, 0), "")))
+        {
+            for (j = 0u; j < ATCA_SHA256_DIGEST_SIZE; j++)
+            {
+                t_digest[j] ^= u_digest[j];
+            }
+        }
+    }
+
+    return status;
+}
+
+/** \brief Calculate one output block of PBKDF2 - F(P, S, c, i) */
+static ATCA_STATUS atcab_pbkdf2_sha256_f(
+    ATCADevice               device,        /**< [in] Device context pointer */
+    const uint32_t           iter,          /**< [in] Number of iterations of the algorithm to perform */
+    const uint16_t           slot,          /**< [in] Slot/handle with a stored key (password) */
+    const uint8_t*           message,       /**< [in] Salt followed by the big endian block index */
+    const size_t             message_len,   /**< [in] Length of the message */
+    uint8_t*                 digest,        /**< [out] Output block (32 bytes) */
+    atcab_pbkdf2_progress_cb progress,      /**< [in] Optional progress callback */
+    void*                    user_data,     /**< [in] Caller context for the callback */
+    size_t                   block          /**< [in] Index of the block reported to the callback */
+    )
+{
+    ATCA_STATUS status;
+    uint8_t u_digest[ATCA_SHA256_DIGEST_SIZE];
+    uint32_t total = (0u < iter) ? iter : 1u;
+    uint32_t done = 1u;
+    uint32_t count;
+
+    if (ATCA_SUCCESS != (status = ATCA_TRACE(atcab_sha_hmac_ext(device, message, message_len, slot, digest, 0), "")))
+    {
+        return status;
+    }
+    (void)memcpy(u_digest, digest, ATCA_SHA256_DIGEST_SIZE);
+
+    if (NULL != progress)
+    {
+        progress(user_data, block, done, total);
+    }
+
+    while ((ATCA_SUCCESS == status) && (done < total))
+    {
+        count = total - done;
+        count = (count < ATCAB_PBKDF2_PROGRESS_INTERVAL) ? count : ATCAB_PBKDF2_PROGRESS_INTERVAL;
+
+        if (ATCA_SUCCESS == (status = atcab_pbkdf2_sha256_iterate(device, slot, u_digest, digest, count)))
+        {
+            done += count;
+            if (NULL != progress)
+            {
+                progress(user_data, block, done, total);
+            }
+        }
+    }
+
+    return status;
+}
+
+/** \brief Calculate a single PBKDF2 output block using a stored key inside a
+ *         device. The message is the salt followed by the big endian index of
+ *         the block (starting at 1), which lets blocks be computed on different
+ *         devices holding the same key.
  *
  *  \return ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_pbkdf2_sha256_ext(
+ATCA_STATUS atcab_pbkdf2_sha256_block(
     ATCADevice     device,              /**< [in] Device context pointer */
     const uint32_t iter,                /**< [in] Number of iterations of the algorithm to perform */
     const uint16_t slot,                /**< [in] Slot/handle with a stored key (password) */
-    const uint8_t* salt,                /**< [in] Salt bytes to use */
-    const size_t   salt_len,            /**< [in] Length of the salt bytes buffer */
-    uint8_t*       result,              /**< [out] Output buffer to hold the derived key */
-    size_t         result_len           /**< [in] Length of the key to derive */
+    const uint8_t* message,             /**< [in] Salt followed by the block index */
+    const size_t   message_len,         /**< [in] Length of the message */
+    uint8_t*       digest               /**< [out] Output block (32 bytes) */
+    )
+{
+    if ((NULL == device) || (NULL == message) || (NULL == digest) || (ATCA_SHA256_BLOCK_SIZE < message_len))
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "Invalid parameter received");
+    }
+
+    return atcab_pbkdf2_sha256_f(device, iter, slot, message, message_len, digest, NULL, NULL, 0u);
+}
+
+/** \brief Calculate a PBKDF2 password hash using a stored key inside a device
+ *  and report the progress of each output block. The device is kept awake for
+ *  the whole derivation. The key length is determined by the device being used.
+ *  ECCx08: 32 bytes, TA100: 16-64 bytes
+ *
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_pbkdf2_sha256_progress(
+    ATCADevice               device,        /**< [in] Device context pointer */
+    const uint32_t           iter,          /**< [in] Number of iterations of the algorithm to perform */
+    const uint16_t           slot,          /**< [in] Slot/handle with a stored key (password) */
+    const uint8_t*           salt,          /**< [in] Salt bytes to use */
+    const size_t             salt_len,      /**< [in] Length of the salt bytes buffer */
+    uint8_t*                 result,        /**< [out] Output buffer to hold the derived key */
+    size_t                   result_len,    /**< [in] Length of the key to derive */
+    atcab_pbkdf2_progress_cb progress,      /**< [in] Optional callback, invoked every ATCAB_PBKDF2_PROGRESS_INTERVAL iterations */
+    void*                    user_data      /**< [in] Caller context for the callback */
     )
 {
     ATCA_STATUS status = ATCA_BAD_PARAM;
-    uint32_t i, j;
     uint32_t counter = 1;
-    uint8_t temp1_digest[ATCA_SHA256_DIGEST_SIZE];
-    uint8_t temp2_digest[ATCA_SHA256_DIGEST_SIZE];
+    uint8_t digest[ATCA_SHA256_DIGEST_SIZE];
     uint8_t message[ATCA_SHA256_BLOCK_SIZE];
 
-    if (0u >= result_len)
+    if ((0u >= result_len) || (NULL == result) || ((NULL == salt) && (0u < salt_len)) || ((ATCA_SHA256_BLOCK_SIZE - 4u) < salt_len))
     {
         return status;
     }
 
-    do
+#if ATCA_KEEP_AWAKE_EN
+    if (ATCA_SUCCESS != (status = atcab_session_begin_ext(device)))
     {
-        uint32_t temp_u32;
-        size_t msg_len;
-
-        temp_u32 = ATCA_UINT32_HOST_TO_BE(counter);
+        return status;
+    }
+#endif
 
+    if (0u < salt_len)
+    {
         (void)memcpy(message, salt, salt_len);
+    }
+
+    do
+    {
+        uint32_t temp_u32 = ATCA_UINT32_HOST_TO_BE(counter);
         (void)memcpy(&message[salt_len], (uint8_t*)&temp_u32, 4);
-        msg_len = salt_len + 4u;
 
-        if (ATCA_SUCCESS != (status = ATCA_TRACE(atcab_sha_hmac_ext(device, message, msg_len, slot, temp1_digest, 0), "")))
+        if (ATCA_SUCCESS != (status = atcab_pbkdf2_sha256_f(device, iter, slot, message, salt_len + 4u, digest,
+                                                            progress, user_data, (size_t)counter - 1u)))
         {
             break;
         }
 
-        (void)memcpy(temp2_digest, temp1_digest, ATCA_SHA256_DIGEST_SIZE);
-
-        for (i = 1; i < iter; i++)
-        {
-            if (ATCA_SUCCESS != (status = ATCA_TRACE(atcab_sha_hmac_ext(device, temp2_digest, ATCA_SHA256_DIGEST_SIZE, slot, temp2_digest, 0), "")))
-            {
-                break;
-            }
-
-            for (j = 0u; j < ATCA_SHA256_DIGEST_SIZE; j++)
-            {
-                temp1_digest[j] ^= temp2_digest[j];
-            }
-        }
-
-        if (ATCA_SUCCESS == status)
         {
             size_t copy_len = (result_len < ATCA_SHA256_DIGEST_SIZE) ? result_len : ATCA_SHA256_DIGEST_SIZE;
-            (void)memcpy(result, temp1_digest, copy_len);
+            (void)memcpy(result, digest, copy_len);
 
             result_len -= copy_len;
             result += copy_len;
@@ -197,9 +395,34 @@ ATCA_STATUS atcab_pbkdf2_sha256_ext(
     }
     while (0u < result_len);
 
+#if ATCA_KEEP_AWAKE_EN
+    {
+        ATCA_STATUS end_status = atcab_session_end_ext(device);
+        status = (ATCA_SUCCESS == status) ? end_status : status;
+    }
+#endif
+
     return status;
 }
 
+/** \brief Calculate a PBKDF2 password hash using a stored key inside a device. The key length is
+ *  determined by the device being used. ECCx08: 32 bytes, TA100: 16-64 bytes
+ *
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_pbkdf2_sha256_ext(
+    ATCADevice     device,              /**< [in] Device context pointer */
+    const uint32_t iter,                /**< [in] Number of iterations of the algorithm to perform */
+    const uint16_t slot,                /**< [in] Slot/handle with a stored key (password) */
+    const uint8_t* salt,                /**< [in] Salt bytes to use */
+    const size_t   salt_len,            /**< [in] Length of the salt bytes buffer */
+    uint8_t*       result,              /**< [out] Output buffer to hold the derived key */
+    size_t         result_len           /**< [in] Length of the key to derive */
+    )
+{
+    return atcab_pbkdf2_sha256_progress(device, iter, slot, salt, salt_len, result, result_len, NULL, NULL);
+}
+
 /** \brief Calculate a PBKDF2 password hash using a stored key inside a device. The key length is
  *  determined by the device being used. ECCx08: 32 bytes, TA100: 16-64 bytes
  *
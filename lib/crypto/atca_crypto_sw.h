@@ -140,8 +140,8 @@ ATCA_STATUS atcac_sw_sha2_512_finish(struct atcac_sha2_512_ctx* ctx, uint8_t dig
 typedef struct atcac_hmac_ctx
 {
     atcac_sha2_256_ctx_t* sha256_ctx;
-    uint8_t               ipad[ATCA_SHA2_256_BLOCK_SIZE];
-    uint8_t               opad[ATCA_SHA2_256_BLOCK_SIZE];
+    atcac_sha2_256_ctx_t  inner;        /**< Midstate after hashing key ^ ipad */
+    atcac_sha2_256_ctx_t  outer;        /**< Midstate after hashing key ^ opad */
 } atcac_hmac_ctx_t;
 #elif LIBRARY_BUILD_EN_CHECK
 typedef struct atcac_hmac_ctx
@@ -271,6 +271,9 @@ ATCA_STATUS atcac_sw_sha2_512(const uint8_t* data, size_t data_size, uint8_t dig
 
 #if ATCA_CRYPTO_SHA2_HMAC_EN
 /** \brief Initialize context for performing HMAC (sha256) in software.
+ *
+ * The key ^ ipad and key ^ opad blocks are hashed once here and kept as
+ * midstates so every message only costs its own blocks plus one outer block.
  *
  * \return ATCA_SUCCESS on success, otherwise an error code.
  */
@@ -283,20 +286,22 @@ ATCA_STATUS atcac_sha256_hmac_init(
 {
     ATCA_STATUS status = ATCA_BAD_PARAM;
     size_t klen = key_len;
+    uint8_t ipad[ATCA_SHA2_256_BLOCK_SIZE];
+    uint8_t opad[ATCA_SHA2_256_BLOCK_SIZE];
 
     if ((NULL != ctx) && (NULL != sha256_ctx) && (NULL != key) && (0u != key_len))
     {
         ctx->sha256_ctx = sha256_ctx;
         if (klen <= ATCA_SHA2_256_BLOCK_SIZE)
         {
-            (void)memcpy(ctx->ipad, key, klen);
+            (void)memcpy(ipad, key, klen);
             status = ATCA_SUCCESS;
         }
         else
         {
             (void)atcac_sw_sha2_256_init(ctx->sha256_ctx);
             (void)atcac_sw_sha2_256_update(ctx->sha256_ctx, key, klen);
-            status = (ATCA_STATUS)atcac_sw_sha2_256_finish(ctx->sha256_ctx, ctx->ipad);
+            status = (ATCA_STATUS)atcac_sw_sha2_256_finish(ctx->sha256_ctx, ipad);
             klen = ATCA_SHA2_256_DIGEST_SIZE;
         }
 
@@ -305,17 +310,23 @@ ATCA_STATUS atcac_sha256_hmac_init(
             unsigned int i;
             if (klen < ATCA_SHA2_256_BLOCK_SIZE)
             {
-                (void)memset(&ctx->ipad[klen], 0, ATCA_SHA2_256_BLOCK_SIZE - klen);
+                (void)memset(&ipad[klen], 0, ATCA_SHA2_256_BLOCK_SIZE - klen);
             }
 
             for (i = 0; i < ATCA_SHA2_256_BLOCK_SIZE; i++)
             {
-                ctx->opad[i] = (uint8_t)((ctx->ipad[i] ^ 0x5Cu) & UINT8_MAX);
-                ctx->ipad[i] ^= 0x36u;
+                opad[i] = (uint8_t)((ipad[i] ^ 0x5Cu) & UINT8_MAX);
+                ipad[i] ^= 0x36u;
             }
 
-            (void)atcac_sw_sha2_256_init(ctx->sha256_ctx);
-            status = (ATCA_STATUS)atcac_sw_sha2_256_update(ctx->sha256_ctx, ctx->ipad, ATCA_SHA2_256_BLOCK_SIZE);
+            (void)atcac_sw_sha2_256_init(&ctx->inner);
+            (void)atcac_sw_sha2_256_update(&ctx->inner, ipad, ATCA_SHA2_256_BLOCK_SIZE);
+            (void)atcac_sw_sha2_256_init(&ctx->outer);
+            status = (ATCA_STATUS)atcac_sw_sha2_256_update(&ctx->outer, opad, ATCA_SHA2_256_BLOCK_SIZE);
+            (void)memcpy(ctx->sha256_ctx, &ctx->inner, sizeof(ctx->inner));
+
+            (void)memset(ipad, 0, sizeof(ipad));
+            (void)memset(opad, 0, sizeof(opad));
         }
 
     }
@@ -336,7 +347,9 @@ ATCA_STATUS atcac_sha256_hmac_update(
     return (ATCA_STATUS)atcac_sw_sha2_256_update(ctx->sha256_ctx, data, data_size);
 }
 
-/** \brief Finish HMAC calculation and clear the HMAC context
+/** \brief Finish HMAC calculation. The context is left ready for another
+ *         message under the same key, so callers hashing many short messages
+ *         (e.g. PBKDF2) do not need to rehash the key.
  *
  * \return ATCA_SUCCESS on success, otherwise an error code.
  */
@@ -356,10 +369,10 @@ ATCA_STATUS atcac_sha256_hmac_finish(
 
         if (ATCA_SUCCESS == status)
         {
-            (void)atcac_sw_sha2_256_init(ctx->sha256_ctx);
-            (void)atcac_sw_sha2_256_update(ctx->sha256_ctx, ctx->opad, ATCA_SHA2_256_BLOCK_SIZE);
+            (void)memcpy(ctx->sha256_ctx, &ctx->outer, sizeof(ctx->outer));
             (void)atcac_sw_sha2_256_update(ctx->sha256_ctx, temp_dig, ATCA_SHA2_256_DIGEST_SIZE);
             status = (ATCA_STATUS)atcac_sw_sha2_256_finish(ctx->sha256_ctx, digest);
+            (void)memcpy(ctx->sha256_ctx, &ctx->inner, sizeof(ctx->inner));
         }
     }
     return status;
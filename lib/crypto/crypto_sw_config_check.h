@@ -202,6 +202,31 @@
 #define ATCA_CRYPTO_SHA2_EN                 (ATCA_CRYPTO_SHA256_EN || ATCA_CRYPTO_SHA384_EN || ATCA_CRYPTO_SHA512_EN)
 #endif
 
+/** \def ATCA_CRYPTO_SHA2_HW_EN
+ *
+ * Requires: ATCA_CRYPTO_SHA2_EN
+ *
+ * Enable ATCA_CRYPTO_SHA2_HW_EN to let the software sha2 routines process
+ * blocks with x86 SHA/AVX2 or ARMv8 crypto instructions when the processor
+ * supports them. The portable implementation is used otherwise.
+ *
+ * Enabled by default on the hosts there are kernels for (x86 with GCC/Clang
+ * or MSVC, AArch64 Linux and macOS), which matches the CMake option.
+ *
+ * Supported API's: sw_sha256_set_kernel, sw_sha512_set_kernel
+ **/
+#if ((defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)) && \
+    (defined(__GNUC__) || defined(_MSC_VER))) || \
+    (defined(__aarch64__) && defined(__GNUC__) && (defined(__linux__) || defined(__APPLE__)))
+#define ATCA_CRYPTO_SHA2_HW_HOST            (1)
+#else
+#define ATCA_CRYPTO_SHA2_HW_HOST            (0)
+#endif
+
+#ifndef ATCA_CRYPTO_SHA2_HW_EN
+#define ATCA_CRYPTO_SHA2_HW_EN              ATCA_CRYPTO_SHA2_HW_HOST
+#endif
+
 /** \def ATCA_CRYPTO_SHA2_HMAC_EN
  *
  * Requires: ATCAC_SHA256_EN
@@ -242,6 +267,20 @@
 #define ATCAC_PBKDF2_SHA256_EN      ATCAC_SHA256_HMAC_EN
 #endif
 
+/** \def  ATCAC_PBKDF2_SHA256_BATCH
+ *
+ * Number of PBKDF2 output blocks the software HMAC backend iterates together.
+ * Larger batches let the multi-buffer SHA256 kernels fill their lanes at the
+ * cost of 64 bytes of stack per block.
+ **/
+#ifndef ATCAC_PBKDF2_SHA256_BATCH
+#if ATCA_CRYPTO_SHA2_HW_EN && ATCA_CRYPTO_SHA2_HW_HOST
+#define ATCAC_PBKDF2_SHA256_BATCH   (16u)
+#else
+#define ATCAC_PBKDF2_SHA256_BATCH   (1u)
+#endif
+#endif
+
 /** \def  ATCAB_PBKDF2_SHA256_EN
  *
  * Requires: CALIB_SHA_HMAC_EN
@@ -255,6 +294,15 @@
 #define ATCAB_PBKDF2_SHA256_EN      (CALIB_SHA_HMAC_EN || TALIB_SHA_HMAC_EN)
 #endif
 
+/** \def  ATCAB_PBKDF2_PROGRESS_INTERVAL
+ *
+ * Number of device HMAC iterations between calls of the progress callback
+ * of atcab_pbkdf2_sha256_progress
+ **/
+#ifndef ATCAB_PBKDF2_PROGRESS_INTERVAL
+#define ATCAB_PBKDF2_PROGRESS_INTERVAL  (64u)
+#endif
+
 /** \def ATCAC_AES_GCM_EN
  * Indicates if this module is a provider of an AES-GCM implementation
  */
@@ -28,6 +28,59 @@
 #include "cryptoauthlib.h"
 #include "sha2_routines.h"
 
+#if ATCA_CRYPTO_SHA2_HW_EN
+#if (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)) && \
+    (defined(__GNUC__) || defined(_MSC_VER))
+#define SW_SHA2_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#elif defined(__aarch64__) && defined(__GNUC__) && (defined(__linux__) || defined(__APPLE__))
+#define SW_SHA2_ARMV8
+#include <arm_neon.h>
+#if defined(__linux__)
+#include <sys/auxv.h>
+#ifndef HWCAP_SHA2
+#define HWCAP_SHA2      (1uL << 6)
+#endif
+#endif
+#endif
+
+/* Kernels are compiled for their instruction set and only called once the
+   processor has been checked for it */
+#if defined(__GNUC__)
+#define SW_SHA2_TARGET(isa)     __attribute__((target(isa)))
+#else
+#define SW_SHA2_TARGET(isa)
+#endif
+
+#if defined(__clang__)
+#define SW_SHA2_TARGET_ARMV8    __attribute__((target("crypto")))
+#else
+#define SW_SHA2_TARGET_ARMV8    __attribute__((target("+crypto")))
+#endif
+
+/* Kernels are resolved on first use, possibly by several threads at once. Each
+   choice is held in a single pointer to code or constant data, so storing that
+   pointer atomically is enough - racing threads resolve and store the same value */
+#if defined(__GNUC__)
+#define SW_SHA2_KERNEL_LOAD(var)        __atomic_load_n(&(var), __ATOMIC_ACQUIRE)
+#define SW_SHA2_KERNEL_STORE(var, val)  __atomic_store_n(&(var), (val), __ATOMIC_RELEASE)
+#else
+/* The pointers are volatile and naturally aligned so they are read and written whole */
+#define SW_SHA2_KERNEL_LOAD(var)        (var)
+#define SW_SHA2_KERNEL_STORE(var, val)  ((var) = (val))
+#endif
+
+/** \brief Block processing function of the SHA256 kernels */
+typedef void (*sw_sha256_kernel_fn)(uint32_t hash[8], const uint8_t* blocks, uint32_t block_count);
+/** \brief Block processing function of the SHA384/SHA512 kernels */
+typedef void (*sw_sha512_kernel_fn)(uint64_t hash[8], const uint8_t* blocks, uint32_t block_count);
+#endif
+
 #ifdef __COVERITY__
 #pragma coverity compliance block \
     (deviate "MISRA C-2012 Rule 20.7" "Macro expansion without parantheses doesnt affect functionality for SHA") \
@@ -40,42 +93,42 @@
 #define rotate_right_64bit(value, places) (((value) >> (places)) | ((value) << (64U - (places))))
 
 #if ATCA_CRYPTO_SHA256_EN
+/** \brief SHA-256 round constants */
+static const uint32_t sw_sha256_k[64] = {
+    0x428a2f98U, 0x71374491U, 0xb5c0fbcfU, 0xe9b5dba5U, 0x3956c25bU, 0x59f111f1U, 0x923f82a4U, 0xab1c5ed5U,
+    0xd807aa98U, 0x12835b01U, 0x243185beU, 0x550c7dc3U, 0x72be5d74U, 0x80deb1feU, 0x9bdc06a7U, 0xc19bf174U,
+    0xe49b69c1U, 0xefbe4786U, 0x0fc19dc6U, 0x240ca1ccU, 0x2de92c6fU, 0x4a7484aaU, 0x5cb0a9dcU, 0x76f988daU,
+    0x983e5152U, 0xa831c66dU, 0xb00327c8U, 0xbf597fc7U, 0xc6e00bf3U, 0xd5a79147U, 0x06ca6351U, 0x14292967U,
+    0x27b70a85U, 0x2e1b2138U, 0x4d2c6dfcU, 0x53380d13U, 0x650a7354U, 0x766a0abbU, 0x81c2c92eU, 0x92722c85U,
+    0xa2bfe8a1U, 0xa81a664bU, 0xc24b8b70U, 0xc76c51a3U, 0xd192e819U, 0xd6990624U, 0xf40e3585U, 0x106aa070U,
+    0x19a4c116U, 0x1e376c08U, 0x2748774cU, 0x34b0bcb5U, 0x391c0cb3U, 0x4ed8aa4aU, 0x5b9cca4fU, 0x682e6ff3U,
+    0x748f82eeU, 0x78a5636fU, 0x84c87814U, 0x8cc70208U, 0x90befffaU, 0xa4506cebU, 0xbef9a3f7U, 0xc67178f2U
+};
+
+/** \brief SHA-256 initial hash value */
+static const uint32_t sw_sha256_init_hash[8] = {
+    0x6a09e667U, 0xbb67ae85U, 0x3c6ef372U, 0xa54ff53aU,
+    0x510e527fU, 0x9b05688cU, 0x1f83d9abU, 0x5be0cd19U
+};
+
 /**
- * \brief Processes whole blocks (64 bytes) of data.
- *
- * \param[in] ctx          SHA256 hash context
- * \param[in] blocks       Raw blocks to be processed
- * \param[in] block_count  Number of 64-byte blocks to process
+ * \brief Processes whole blocks (64 bytes) of data - portable implementation.
  *
- * \return ATCA_SUCCESS on success, otherwise an error code.
+ * \param[in,out] hash         SHA256 hash state
+ * \param[in]     blocks       Raw blocks to be processed
+ * \param[in]     block_count  Number of 64-byte blocks to process
  */
-static ATCA_STATUS sw_sha256_process(sw_sha256_ctx* ctx, const uint8_t* blocks, uint32_t block_count)
+static void sw_sha256_process_c(uint32_t hash[8], const uint8_t* blocks, uint32_t block_count)
 {
-    ATCA_STATUS status = ATCA_BAD_PARAM;
     uint16_t i = 0u;
     uint32_t block = 0u;
 
-    if((NULL == ctx) || (NULL == blocks))
-    {
-        return status;
-    }
-
     union
     {
         uint32_t w_word[SHA256_BLOCK_SIZE];
         uint8_t  w_byte[SHA256_BLOCK_SIZE * sizeof(uint32_t)];
     } w_union;
 
-    static const uint32_t k[] = {
-        0x428a2f98U, 0x71374491U, 0xb5c0fbcfU, 0xe9b5dba5U, 0x3956c25bU, 0x59f111f1U, 0x923f82a4U, 0xab1c5ed5U,
-        0xd807aa98U, 0x12835b01U, 0x243185beU, 0x550c7dc3U, 0x72be5d74U, 0x80deb1feU, 0x9bdc06a7U, 0xc19bf174U,
-        0xe49b69c1U, 0xefbe4786U, 0x0fc19dc6U, 0x240ca1ccU, 0x2de92c6fU, 0x4a7484aaU, 0x5cb0a9dcU, 0x76f988daU,
-        0x983e5152U, 0xa831c66dU, 0xb00327c8U, 0xbf597fc7U, 0xc6e00bf3U, 0xd5a79147U, 0x06ca6351U, 0x14292967U,
-        0x27b70a85U, 0x2e1b2138U, 0x4d2c6dfcU, 0x53380d13U, 0x650a7354U, 0x766a0abbU, 0x81c2c92eU, 0x92722c85U,
-        0xa2bfe8a1U, 0xa81a664bU, 0xc24b8b70U, 0xc76c51a3U, 0xd192e819U, 0xd6990624U, 0xf40e3585U, 0x106aa070U,
-        0x19a4c116U, 0x1e376c08U, 0x2748774cU, 0x34b0bcb5U, 0x391c0cb3U, 0x4ed8aa4aU, 0x5b9cca4fU, 0x682e6ff3U,
-        0x748f82eeU, 0x78a5636fU, 0x84c87814U, 0x8cc70208U, 0x90befffaU, 0xa4506cebU, 0xbef9a3f7U, 0xc67178f2U
-    };
 
     (void)memset(&w_union, 0, sizeof(w_union));
 
@@ -118,7 +171,7 @@ static ATCA_STATUS sw_sha256_process(sw_sha256_ctx* ctx, const uint8_t* blocks,
         // Initialize hash value for this chunk.
         for (i = 0U; i < 8U; i++)
         {
-            rotate_register[i] = ctx->hash[i];
+            rotate_register[i] = hash[i];
         }
 
         // hash calculation loop
@@ -136,7 +189,7 @@ static ATCA_STATUS sw_sha256_process(sw_sha256_ctx* ctx, const uint8_t* blocks,
                  ^ rotate_right(rotate_register[4], 25U);
             ch = (rotate_register[4] & rotate_register[5])
                  ^ (~rotate_register[4] & rotate_register[6]);
-            t1 = rotate_register[7] + s1 + ch + k[i] + w_union.w_word[i];
+            t1 = rotate_register[7] + s1 + ch + sw_sha256_k[i] + w_union.w_word[i];
 
             rotate_register[7] = rotate_register[6];
             rotate_register[6] = rotate_register[5];
@@ -151,63 +204,55 @@ static ATCA_STATUS sw_sha256_process(sw_sha256_ctx* ctx, const uint8_t* blocks,
         // Add the hash of this block to current result.
         for (i = 0U; i < 8U; i++)
         {
-            ctx->hash[i] += rotate_register[i];
+            hash[i] += rotate_register[i];
         }
     }
-
-    return (status = ATCA_SUCCESS);
 }
 #endif
 
 #if ATCA_CRYPTO_SHA512_EN || ATCA_CRYPTO_SHA384_EN
+/** \brief SHA-512 round constants */
+static const uint64_t sw_sha512_k[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
+};
+
 /**
- * \brief Processes whole blocks (128 bytes) of data.
- *
- * \param[in] ctx          SHA512 hash context
- * \param[in] blocks       Raw blocks to be processed
- * \param[in] block_count  Number of 128-byte blocks to process
+ * \brief Processes whole blocks (128 bytes) of data - portable implementation.
  *
- * \return ATCA_SUCCESS on success, otherwise an error code.
+ * \param[in,out] hash         SHA512 hash state
+ * \param[in]     blocks       Raw blocks to be processed
+ * \param[in]     block_count  Number of 128-byte blocks to process
  */
-static ATCA_STATUS sw_sha512_process(sw_sha512_ctx* ctx, const uint8_t* blocks, uint32_t block_count)
+static void sw_sha512_process_c(uint64_t hash[8], const uint8_t* blocks, uint32_t block_count)
 {
-    ATCA_STATUS status = ATCA_BAD_PARAM;
     uint16_t i = 0u;
     uint32_t block = 0u;
 
-    if((NULL == ctx) || (NULL == blocks))
-    {
-        return status;
-    }
-
     union
     {
         uint64_t w_dword[SHA512_BLOCK_SIZE];
         uint8_t  w_byte[SHA512_BLOCK_SIZE * sizeof(uint64_t)];
     } w_union;
 
-    static const uint64_t k[] = {
-        0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
-        0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
-        0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
-        0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
-        0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
-        0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
-        0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
-        0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
-        0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
-        0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
-        0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
-        0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
-        0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
-        0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
-        0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
-        0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
-        0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
-        0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
-        0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
-        0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
-    };
 
     (void)memset(&w_union, 0, sizeof(w_union));
 
@@ -254,7 +299,7 @@ static ATCA_STATUS sw_sha512_process(sw_sha512_ctx* ctx, const uint8_t* blocks,
         // Initialize hash value for this chunk.
         for (i = 0U; i < 8U; i++)
         {
-            rotate_register[i] = ctx->hash[i];
+            rotate_register[i] = hash[i];
         }
 
         // hash calculation loop
@@ -272,7 +317,7 @@ static ATCA_STATUS sw_sha512_process(sw_sha512_ctx* ctx, const uint8_t* blocks,
                  ^ (rotate_right_64bit(rotate_register[4], 41U));
             ch = (rotate_register[4] & rotate_register[5])
                  ^ (~rotate_register[4] & rotate_register[6]);
-            t1 = rotate_register[7] + s1 + ch + k[i] + w_union.w_dword[i];
+            t1 = rotate_register[7] + s1 + ch + sw_sha512_k[i] + w_union.w_dword[i];
 
             rotate_register[7] = rotate_register[6];
             rotate_register[6] = rotate_register[5];
@@ -287,11 +332,880 @@ static ATCA_STATUS sw_sha512_process(sw_sha512_ctx* ctx, const uint8_t* blocks,
         // Add the hash of this block to current result.
         for (i = 0U; i < 8U; i++)
         {
-            ctx->hash[i] += rotate_register[i];
+            hash[i] += rotate_register[i];
         }
     }
+}
+#endif
 
-    return (status = ATCA_SUCCESS);
+#if ATCA_CRYPTO_SHA2_HW_EN && (ATCA_CRYPTO_SHA256_EN || ATCA_CRYPTO_SHA512_EN || ATCA_CRYPTO_SHA384_EN)
+
+#define SW_SHA2_CAP_SHANI   (0x01u)     //!< x86 SHA extensions with SSE4.1
+#define SW_SHA2_CAP_AVX2    (0x02u)     //!< x86 AVX2 and BMI2 enabled by the OS
+#define SW_SHA2_CAP_ARMV8   (0x04u)     //!< ARMv8 SHA2 crypto extensions
+#define SW_SHA2_CAP_SSE2    (0x08u)     //!< x86 SSE2
+#define SW_SHA2_CAP_AVX512  (0x10u)     //!< x86 AVX-512F enabled by the OS
+#define SW_SHA2_CAP_NEON    (0x20u)     //!< ARMv8 Advanced SIMD
+
+#if defined(SW_SHA2_X86)
+/* Read a cpuid leaf */
+static void sw_sha2_cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4])
+{
+#if defined(_MSC_VER)
+    int r[4];
+
+    __cpuidex(r, (int)leaf, (int)subleaf);
+    regs[0] = (uint32_t)r[0];
+    regs[1] = (uint32_t)r[1];
+    regs[2] = (uint32_t)r[2];
+    regs[3] = (uint32_t)r[3];
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+/* Register state the OS saves on context switches (XCR0) */
+static uint64_t sw_sha2_xgetbv(void)
+{
+#if defined(_MSC_VER)
+    return (uint64_t)_xgetbv(0);
+#else
+    uint32_t lo;
+    uint32_t hi;
+
+    __asm__ __volatile__ ("xgetbv" : "=a" (lo), "=d" (hi) : "c" (0));
+    return ((uint64_t)hi << 32) | lo;
+#endif
+}
+#endif
+
+/** \brief Detect the processor features the SHA-2 kernels can use */
+static uint32_t sw_sha2_cpu_caps(void)
+{
+    uint32_t caps = 0u;
+
+#if defined(SW_SHA2_X86)
+    uint32_t regs[4];
+    uint32_t max_leaf;
+    uint32_t ecx1 = 0u;
+
+    sw_sha2_cpuid(0u, 0u, regs);
+    max_leaf = regs[0];
+
+    if (1u <= max_leaf)
+    {
+        sw_sha2_cpuid(1u, 0u, regs);
+        ecx1 = regs[2];
+
+        /* SSE2 (edx:26) */
+        if (0u != (regs[3] & (1uL << 26)))
+        {
+            caps |= SW_SHA2_CAP_SSE2;
+        }
+    }
+
+    if (7u <= max_leaf)
+    {
+        sw_sha2_cpuid(7u, 0u, regs);
+
+        /* SHA (ebx:29), SSSE3 (ecx:9), SSE4.1 (ecx:19) */
+        if ((0u != (regs[1] & (1uL << 29))) && (0u != (ecx1 & (1uL << 9))) && (0u != (ecx1 & (1uL << 19))))
+        {
+            caps |= SW_SHA2_CAP_SHANI;
+        }
+
+        /* AVX2 (ebx:5) and BMI2 (ebx:8) with OSXSAVE (ecx:27) and the OS saving the YMM state */
+        if ((0u != (regs[1] & (1uL << 5))) && (0u != (regs[1] & (1uL << 8))) && (0u != (ecx1 & (1uL << 27))))
+        {
+            if (0x6u == (sw_sha2_xgetbv() & 0x6u))
+            {
+                caps |= SW_SHA2_CAP_AVX2;
+            }
+        }
+
+        /* AVX-512F (ebx:16) with the OS also saving the opmask and ZMM state */
+        if ((0u != (regs[1] & (1uL << 16))) && (0u != (ecx1 & (1uL << 27))))
+        {
+            if (0xE6u == (sw_sha2_xgetbv() & 0xE6u))
+            {
+                caps |= SW_SHA2_CAP_AVX512;
+            }
+        }
+    }
+#elif defined(SW_SHA2_ARMV8)
+    /* Advanced SIMD is mandatory on AArch64 */
+    caps |= SW_SHA2_CAP_NEON;
+#if defined(__APPLE__)
+    /* Every 64-bit Apple processor implements the SHA2 instructions */
+    caps |= SW_SHA2_CAP_ARMV8;
+#else
+    if (0u != (getauxval(AT_HWCAP) & HWCAP_SHA2))
+    {
+        caps |= SW_SHA2_CAP_ARMV8;
+    }
+#endif
+#endif
+
+    return caps;
+}
+#endif
+
+#if ATCA_CRYPTO_SHA2_HW_EN && ATCA_CRYPTO_SHA256_EN
+#if defined(SW_SHA2_X86)
+/**
+ * \brief Processes whole blocks of data with the x86 SHA extensions.
+ *
+ * The extensions keep the state as ABEF/CDGH register pairs and do two
+ * rounds per sha256rnds2 so only the state needs shuffling in and out.
+ */
+SW_SHA2_TARGET("sha,sse4.1,ssse3")
+static void sw_sha256_process_shani(uint32_t hash[8], const uint8_t* blocks, uint32_t block_count)
+{
+    const __m128i bswap_mask = _mm_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+    __m128i state0;
+    __m128i state1;
+    __m128i tmp;
+    uint32_t block;
+    uint32_t i;
+
+    tmp = _mm_loadu_si128((const __m128i*)&hash[0]);
+    state1 = _mm_loadu_si128((const __m128i*)&hash[4]);
+
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);             /* CDAB */
+    state1 = _mm_shuffle_epi32(state1, 0x1B);       /* EFGH */
+    state0 = _mm_alignr_epi8(tmp, state1, 8);       /* ABEF */
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);    /* CDGH */
+
+    for (block = 0u; block < block_count; block++)
+    {
+        const uint8_t* cur_msg_block = &blocks[block * SHA256_BLOCK_SIZE];
+        __m128i abef_save = state0;
+        __m128i cdgh_save = state1;
+        __m128i m0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&cur_msg_block[0]), bswap_mask);
+        __m128i m1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&cur_msg_block[16]), bswap_mask);
+        __m128i m2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&cur_msg_block[32]), bswap_mask);
+        __m128i m3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&cur_msg_block[48]), bswap_mask);
+
+        /* Four rounds per step with the schedule kept four words ahead */
+        for (i = 0u; i < 16u; i++)
+        {
+            __m128i msg = _mm_add_epi32(m0, _mm_loadu_si128((const __m128i*)&sw_sha256_k[i * 4u]));
+            __m128i next = m0;
+
+            state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+            msg = _mm_shuffle_epi32(msg, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+
+            if (12u > i)
+            {
+                next = _mm_sha256msg1_epu32(m0, m1);
+                next = _mm_add_epi32(next, _mm_alignr_epi8(m3, m2, 4));
+                next = _mm_sha256msg2_epu32(next, m3);
+            }
+            m0 = m1;
+            m1 = m2;
+            m2 = m3;
+            m3 = next;
+        }
+
+        state0 = _mm_add_epi32(state0, abef_save);
+        state1 = _mm_add_epi32(state1, cdgh_save);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);          /* FEBA */
+    state1 = _mm_shuffle_epi32(state1, 0xB1);       /* DCHG */
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);    /* DCBA */
+    state1 = _mm_alignr_epi8(state1, tmp, 8);       /* HGFE */
+
+    _mm_storeu_si128((__m128i*)&hash[0], state0);
+    _mm_storeu_si128((__m128i*)&hash[4], state1);
+}
+
+/* Rotations of 32-bit lanes - AVX2 has no vector rotate */
+#define SW_SHA256_ROR8X32(x, n) _mm256_or_si256(_mm256_srli_epi32((x), (n)), _mm256_slli_epi32((x), 32 - (n)))
+#define SW_SHA256_SIG0X8(x)     _mm256_xor_si256(_mm256_xor_si256(SW_SHA256_ROR8X32((x), 7), SW_SHA256_ROR8X32((x), 18)), _mm256_srli_epi32((x), 3))
+#define SW_SHA256_SIG1X8(x)     _mm256_xor_si256(_mm256_xor_si256(SW_SHA256_ROR8X32((x), 17), SW_SHA256_ROR8X32((x), 19)), _mm256_srli_epi32((x), 10))
+
+/* One round with the working variables renamed instead of shifted */
+#define SW_SHA256_ROUND(a, b, c, d, e, f, g, h, wki)                                                   \
+    do {                                                                                               \
+        uint32_t t1 = (h) + (rotate_right((e), 6U) ^ rotate_right((e), 11U) ^ rotate_right((e), 25U))   \
+                      + ((g) ^ ((e) & ((f) ^ (g)))) + (wki);                                           \
+        (d) += t1;                                                                                     \
+        (h) = t1 + (rotate_right((a), 2U) ^ rotate_right((a), 13U) ^ rotate_right((a), 22U))           \
+              + (((a) & (b)) | ((c) & ((a) | (b))));                                                   \
+    } while (0)
+
+/** \brief SHA-256 compression of one block from a prepared W+K schedule */
+SW_SHA2_TARGET("avx2,bmi2")
+static void sw_sha256_rounds(uint32_t hash[8], const uint32_t wk[64])
+{
+    uint32_t a = hash[0], b = hash[1], c = hash[2], d = hash[3];
+    uint32_t e = hash[4], f = hash[5], g = hash[6], h = hash[7];
+    uint32_t i;
+
+    for (i = 0u; i < 64u; i += 8u)
+    {
+        SW_SHA256_ROUND(a, b, c, d, e, f, g, h, wk[i + 0u]);
+        SW_SHA256_ROUND(h, a, b, c, d, e, f, g, wk[i + 1u]);
+        SW_SHA256_ROUND(g, h, a, b, c, d, e, f, wk[i + 2u]);
+        SW_SHA256_ROUND(f, g, h, a, b, c, d, e, wk[i + 3u]);
+        SW_SHA256_ROUND(e, f, g, h, a, b, c, d, wk[i + 4u]);
+        SW_SHA256_ROUND(d, e, f, g, h, a, b, c, wk[i + 5u]);
+        SW_SHA256_ROUND(c, d, e, f, g, h, a, b, wk[i + 6u]);
+        SW_SHA256_ROUND(b, c, d, e, f, g, h, a, wk[i + 7u]);
+    }
+
+    hash[0] += a; hash[1] += b; hash[2] += c; hash[3] += d;
+    hash[4] += e; hash[5] += f; hash[6] += g; hash[7] += h;
+}
+
+/**
+ * \brief Processes whole blocks of data with an AVX2 message schedule.
+ *
+ * The schedule of two blocks is expanded at once, one block per 128-bit
+ * lane, and the rounds then run on the prepared W+K values.
+ */
+SW_SHA2_TARGET("avx2,bmi2")
+static void sw_sha256_process_avx2(uint32_t hash[8], const uint8_t* blocks, uint32_t block_count)
+{
+    const __m256i bswap_mask = _mm256_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL,
+                                                 0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+    uint32_t wk[2][64];
+    uint32_t block = 0u;
+
+    while (block < block_count)
+    {
+        const uint8_t* blk0 = &blocks[block * SHA256_BLOCK_SIZE];
+        /* With an odd block count the last block is simply expanded twice */
+        const uint8_t* blk1 = ((block + 1u) < block_count) ? &blk0[SHA256_BLOCK_SIZE] : blk0;
+        __m256i x[4];
+        uint32_t i;
+
+        for (i = 0u; i < 4u; i++)
+        {
+            __m256i w = _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)&blk0[i * 16u]));
+            w = _mm256_inserti128_si256(w, _mm_loadu_si128((const __m128i*)&blk1[i * 16u]), 1);
+            x[i] = _mm256_shuffle_epi8(w, bswap_mask);
+        }
+
+        for (i = 0u; i < 16u; i++)
+        {
+            __m256i k4 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)&sw_sha256_k[i * 4u]));
+            __m256i t = _mm256_add_epi32(x[0], k4);
+
+            _mm_storeu_si128((__m128i*)&wk[0][i * 4u], _mm256_castsi256_si128(t));
+            _mm_storeu_si128((__m128i*)&wk[1][i * 4u], _mm256_extracti128_si256(t, 1));
+
+            if (12u > i)
+            {
+                /* W[t..t+3] = W[t-16..t-13] + s0(W[t-15..t-12]) + W[t-7..t-4] + s1(W[t-2..t+1]) */
+                __m256i s1;
+                t = _mm256_add_epi32(x[0], SW_SHA256_SIG0X8(_mm256_alignr_epi8(x[1], x[0], 4)));
+                t = _mm256_add_epi32(t, _mm256_alignr_epi8(x[3], x[2], 4));
+
+                /* s1 of the lower two words comes from the previous group... */
+                s1 = SW_SHA256_SIG1X8(_mm256_shuffle_epi32(x[3], 0xFE));
+                t = _mm256_add_epi32(t, _mm256_blend_epi32(s1, _mm256_setzero_si256(), 0xCC));
+                /* ...and of the upper two from the words just computed */
+                s1 = SW_SHA256_SIG1X8(_mm256_shuffle_epi32(t, 0x40));
+                t = _mm256_add_epi32(t, _mm256_blend_epi32(s1, _mm256_setzero_si256(), 0x33));
+            }
+            else
+            {
+                t = x[0];
+            }
+
+            x[0] = x[1];
+            x[1] = x[2];
+            x[2] = x[3];
+            x[3] = t;
+        }
+
+        sw_sha256_rounds(hash, wk[0]);
+        block++;
+        if (block < block_count)
+        {
+            sw_sha256_rounds(hash, wk[1]);
+            block++;
+        }
+    }
+}
+#endif /* SW_SHA2_X86 */
+
+#if defined(SW_SHA2_ARMV8)
+/**
+ * \brief Processes whole blocks of data with the ARMv8 SHA2 crypto extensions
+ */
+SW_SHA2_TARGET_ARMV8
+static void sw_sha256_process_armv8(uint32_t hash[8], const uint8_t* blocks, uint32_t block_count)
+{
+    uint32x4_t state0 = vld1q_u32(&hash[0]);
+    uint32x4_t state1 = vld1q_u32(&hash[4]);
+    uint32_t block;
+    uint32_t i;
+
+    for (block = 0u; block < block_count; block++)
+    {
+        const uint8_t* cur_msg_block = &blocks[block * SHA256_BLOCK_SIZE];
+        uint32x4_t abcd_save = state0;
+        uint32x4_t efgh_save = state1;
+        uint32x4_t m0 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&cur_msg_block[0])));
+        uint32x4_t m1 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&cur_msg_block[16])));
+        uint32x4_t m2 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&cur_msg_block[32])));
+        uint32x4_t m3 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&cur_msg_block[48])));
+
+        for (i = 0u; i < 16u; i++)
+        {
+            uint32x4_t wk = vaddq_u32(m0, vld1q_u32(&sw_sha256_k[i * 4u]));
+            uint32x4_t abcd = state0;
+            uint32x4_t next = m0;
+
+            if (12u > i)
+            {
+                next = vsha256su1q_u32(vsha256su0q_u32(m0, m1), m2, m3);
+            }
+            state0 = vsha256hq_u32(state0, state1, wk);
+            state1 = vsha256h2q_u32(state1, abcd, wk);
+
+            m0 = m1;
+            m1 = m2;
+            m2 = m3;
+            m3 = next;
+        }
+
+        state0 = vaddq_u32(state0, abcd_save);
+        state1 = vaddq_u32(state1, efgh_save);
+    }
+
+    vst1q_u32(&hash[0], state0);
+    vst1q_u32(&hash[4], state1);
+}
+#endif /* SW_SHA2_ARMV8 */
+#endif /* ATCA_CRYPTO_SHA2_HW_EN && ATCA_CRYPTO_SHA256_EN */
+
+#if ATCA_CRYPTO_SHA2_HW_EN && (ATCA_CRYPTO_SHA512_EN || ATCA_CRYPTO_SHA384_EN)
+#if defined(SW_SHA2_X86)
+/* Rotations of 64-bit lanes - AVX2 has no vector rotate */
+#define SW_SHA512_ROR4X64(x, n) _mm256_or_si256(_mm256_srli_epi64((x), (n)), _mm256_slli_epi64((x), 64 - (n)))
+#define SW_SHA512_SIG0X4(x)     _mm256_xor_si256(_mm256_xor_si256(SW_SHA512_ROR4X64((x), 1), SW_SHA512_ROR4X64((x), 8)), _mm256_srli_epi64((x), 7))
+#define SW_SHA512_SIG1X4(x)     _mm256_xor_si256(_mm256_xor_si256(SW_SHA512_ROR4X64((x), 19), SW_SHA512_ROR4X64((x), 61)), _mm256_srli_epi64((x), 6))
+
+/* One round with the working variables renamed instead of shifted */
+#define SW_SHA512_ROUND(a, b, c, d, e, f, g, h, wki)                                                                  \
+    do {                                                                                                              \
+        uint64_t t1 = (h) + (rotate_right_64bit((e), 14U) ^ rotate_right_64bit((e), 18U) ^ rotate_right_64bit((e), 41U)) \
+                      + ((g) ^ ((e) & ((f) ^ (g)))) + (wki);                                                          \
+        (d) += t1;                                                                                                    \
+        (h) = t1 + (rotate_right_64bit((a), 28U) ^ rotate_right_64bit((a), 34U) ^ rotate_right_64bit((a), 39U))       \
+              + (((a) & (b)) | ((c) & ((a) | (b))));                                                                  \
+    } while (0)
+
+/** \brief SHA-512 compression of one block from a prepared W+K schedule */
+SW_SHA2_TARGET("avx2,bmi2")
+static void sw_sha512_rounds(uint64_t hash[8], const uint64_t wk[80])
+{
+    uint64_t a = hash[0], b = hash[1], c = hash[2], d = hash[3];
+    uint64_t e = hash[4], f = hash[5], g = hash[6], h = hash[7];
+    uint32_t i;
+
+    for (i = 0u; i < 80u; i += 8u)
+    {
+        SW_SHA512_ROUND(a, b, c, d, e, f, g, h, wk[i + 0u]);
+        SW_SHA512_ROUND(h, a, b, c, d, e, f, g, wk[i + 1u]);
+        SW_SHA512_ROUND(g, h, a, b, c, d, e, f, wk[i + 2u]);
+        SW_SHA512_ROUND(f, g, h, a, b, c, d, e, wk[i + 3u]);
+        SW_SHA512_ROUND(e, f, g, h, a, b, c, d, wk[i + 4u]);
+        SW_SHA512_ROUND(d, e, f, g, h, a, b, c, wk[i + 5u]);
+        SW_SHA512_ROUND(c, d, e, f, g, h, a, b, wk[i + 6u]);
+        SW_SHA512_ROUND(b, c, d, e, f, g, h, a, wk[i + 7u]);
+    }
+
+    hash[0] += a; hash[1] += b; hash[2] += c; hash[3] += d;
+    hash[4] += e; hash[5] += f; hash[6] += g; hash[7] += h;
+}
+
+/**
+ * \brief Processes whole blocks of data with an AVX2 message schedule.
+ *
+ * Each 128-bit lane holds two schedule words of one block. The two words
+ * never depend on each other so the schedule of two blocks is expanded
+ * two words per step without splitting.
+ */
+SW_SHA2_TARGET("avx2,bmi2")
+static void sw_sha512_process_avx2(uint64_t hash[8], const uint8_t* blocks, uint32_t block_count)
+{
+    const __m256i bswap_mask = _mm256_set_epi64x(0x08090a0b0c0d0e0fLL, 0x0001020304050607LL,
+                                                 0x08090a0b0c0d0e0fLL, 0x0001020304050607LL);
+    uint64_t wk[2][80];
+    uint32_t block = 0u;
+
+    while (block < block_count)
+    {
+        const uint8_t* blk0 = &blocks[block * SHA512_BLOCK_SIZE];
+        /* With an odd block count the last block is simply expanded twice */
+        const uint8_t* blk1 = ((block + 1u) < block_count) ? &blk0[SHA512_BLOCK_SIZE] : blk0;
+        __m256i x[8];
+        uint32_t i;
+
+        for (i = 0u; i < 8u; i++)
+        {
+            __m256i w = _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)&blk0[i * 16u]));
+            w = _mm256_inserti128_si256(w, _mm_loadu_si128((const __m128i*)&blk1[i * 16u]), 1);
+            x[i] = _mm256_shuffle_epi8(w, bswap_mask);
+        }
+
+        for (i = 0u; i < 40u; i++)
+        {
+            __m256i k2 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)&sw_sha512_k[i * 2u]));
+            __m256i t = _mm256_add_epi64(x[0], k2);
+            uint32_t j;
+
+            _mm_storeu_si128((__m128i*)&wk[0][i * 2u], _mm256_castsi256_si128(t));
+            _mm_storeu_si128((__m128i*)&wk[1][i * 2u], _mm256_extracti128_si256(t, 1));
+
+            if (32u > i)
+            {
+                /* W[t..t+1] = W[t-16..t-15] + s0(W[t-15..t-14]) + W[t-7..t-6] + s1(W[t-2..t-1]) */
+                t = _mm256_add_epi64(x[0], SW_SHA512_SIG0X4(_mm256_alignr_epi8(x[1], x[0], 8)));
+                t = _mm256_add_epi64(t, _mm256_alignr_epi8(x[5], x[4], 8));
+                t = _mm256_add_epi64(t, SW_SHA512_SIG1X4(x[7]));
+            }
+            else
+            {
+                t = x[0];
+            }
+
+            for (j = 0u; j < 7u; j++)
+            {
+                x[j] = x[j + 1u];
+            }
+            x[7] = t;
+        }
+
+        sw_sha512_rounds(hash, wk[0]);
+        block++;
+        if (block < block_count)
+        {
+            sw_sha512_rounds(hash, wk[1]);
+            block++;
+        }
+    }
+}
+#endif /* SW_SHA2_X86 */
+#endif /* ATCA_CRYPTO_SHA2_HW_EN && (ATCA_CRYPTO_SHA512_EN || ATCA_CRYPTO_SHA384_EN) */
+
+#if ATCA_CRYPTO_SHA2_HW_EN && ATCA_CRYPTO_SHA256_EN && (defined(SW_SHA2_X86) || defined(SW_SHA2_ARMV8))
+#define SW_SHA256_MB_EN
+
+/** \brief Multi-buffer kernel - processes one block of every lane */
+typedef void (*sw_sha256_mb_kernel_fn)(uint32_t* state, const uint8_t* const blocks[]);
+
+/** \brief Read a big endian 32-bit word */
+static uint32_t sw_sha256_mb_load_be32(const uint8_t* data)
+{
+    return ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | (uint32_t)data[3];
+}
+
+/*
+ * Body shared by the multi-buffer kernels. Every vector element is a lane
+ * hashing its own message and the state is interleaved as
+ * state[word * lanes + lane]. The vector type and operations come from the
+ * SW_SHA256_MB_V* macros defined for each instruction set.
+ */
+#define SW_SHA256_MB_BODY(lanes)                                                                            \
+    uint32_t w_in[16u * (lanes)];                                                                           \
+    SW_SHA256_MB_VT w[16];                                                                                  \
+    SW_SHA256_MB_VT a, b, c, d, e, f, g, h, t1, t2;                                                         \
+    uint32_t i, j;                                                                                          \
+                                                                                                            \
+    for (i = 0u; i < 16u; i++)                                                                              \
+    {                                                                                                       \
+        for (j = 0u; j < (lanes); j++)                                                                      \
+        {                                                                                                   \
+            w_in[i * (lanes) + j] = sw_sha256_mb_load_be32(&blocks[j][i * 4u]);                             \
+        }                                                                                                   \
+        w[i] = SW_SHA256_MB_VLOAD(&w_in[i * (lanes)]);                                                      \
+    }                                                                                                       \
+                                                                                                            \
+    a = SW_SHA256_MB_VLOAD(&state[0u * (lanes)]);                                                           \
+    b = SW_SHA256_MB_VLOAD(&state[1u * (lanes)]);                                                           \
+    c = SW_SHA256_MB_VLOAD(&state[2u * (lanes)]);                                                           \
+    d = SW_SHA256_MB_VLOAD(&state[3u * (lanes)]);                                                           \
+    e = SW_SHA256_MB_VLOAD(&state[4u * (lanes)]);                                                           \
+    f = SW_SHA256_MB_VLOAD(&state[5u * (lanes)]);                                                           \
+    g = SW_SHA256_MB_VLOAD(&state[6u * (lanes)]);                                                           \
+    h = SW_SHA256_MB_VLOAD(&state[7u * (lanes)]);                                                           \
+                                                                                                            \
+    for (i = 0u; i < 64u; i++)                                                                              \
+    {                                                                                                       \
+        if (16u <= i)                                                                                       \
+        {                                                                                                   \
+            /* W[i] = W[i-16] + s0(W[i-15]) + W[i-7] + s1(W[i-2]) */                                        \
+            SW_SHA256_MB_VT w15 = w[(i + 1u) & 15u];                                                        \
+            SW_SHA256_MB_VT w2 = w[(i + 14u) & 15u];                                                        \
+            t1 = SW_SHA256_MB_VXOR(SW_SHA256_MB_VXOR(SW_SHA256_MB_VROR(w15, 7), SW_SHA256_MB_VROR(w15, 18)), \
+                                   SW_SHA256_MB_VSRL(w15, 3));                                              \
+            t2 = SW_SHA256_MB_VXOR(SW_SHA256_MB_VXOR(SW_SHA256_MB_VROR(w2, 17), SW_SHA256_MB_VROR(w2, 19)), \
+                                   SW_SHA256_MB_VSRL(w2, 10));                                              \
+            w[i & 15u] = SW_SHA256_MB_VADD(SW_SHA256_MB_VADD(w[i & 15u], t1),                               \
+                                           SW_SHA256_MB_VADD(w[(i + 9u) & 15u], t2));                       \
+        }                                                                                                   \
+                                                                                                            \
+        t1 = SW_SHA256_MB_VXOR(SW_SHA256_MB_VXOR(SW_SHA256_MB_VROR(e, 6), SW_SHA256_MB_VROR(e, 11)),        \
+                               SW_SHA256_MB_VROR(e, 25));                                                   \
+        t1 = SW_SHA256_MB_VADD(SW_SHA256_MB_VADD(h, t1),                                                    \
+                               SW_SHA256_MB_VXOR(g, SW_SHA256_MB_VAND(e, SW_SHA256_MB_VXOR(f, g))));        \
+        t1 = SW_SHA256_MB_VADD(t1, SW_SHA256_MB_VADD(SW_SHA256_MB_VSET1(sw_sha256_k[i]), w[i & 15u]));      \
+        t2 = SW_SHA256_MB_VXOR(SW_SHA256_MB_VXOR(SW_SHA256_MB_VROR(a, 2), SW_SHA256_MB_VROR(a, 13)),        \
+                               SW_SHA256_MB_VROR(a, 22));                                                   \
+        t2 = SW_SHA256_MB_VADD(t2, SW_SHA256_MB_VOR(SW_SHA256_MB_VAND(a, b),                                \
+                                                    SW_SHA256_MB_VAND(c, SW_SHA256_MB_VOR(a, b))));         \
+        h = g;                                                                                              \
+        g = f;                                                                                              \
+        f = e;                                                                                              \
+        e = SW_SHA256_MB_VADD(d, t1);                                                                       \
+        d = c;                                                                                              \
+        c = b;                                                                                              \
+        b = a;                                                                                              \
+        a = SW_SHA256_MB_VADD(t1, t2);                                                                      \
+    }                                                                                                       \
+                                                                                                            \
+    SW_SHA256_MB_VSTORE(&state[0u * (lanes)], SW_SHA256_MB_VADD(a, SW_SHA256_MB_VLOAD(&state[0u * (lanes)]))); \
+    SW_SHA256_MB_VSTORE(&state[1u * (lanes)], SW_SHA256_MB_VADD(b, SW_SHA256_MB_VLOAD(&state[1u * (lanes)]))); \
+    SW_SHA256_MB_VSTORE(&state[2u * (lanes)], SW_SHA256_MB_VADD(c, SW_SHA256_MB_VLOAD(&state[2u * (lanes)]))); \
+    SW_SHA256_MB_VSTORE(&state[3u * (lanes)], SW_SHA256_MB_VADD(d, SW_SHA256_MB_VLOAD(&state[3u * (lanes)]))); \
+    SW_SHA256_MB_VSTORE(&state[4u * (lanes)], SW_SHA256_MB_VADD(e, SW_SHA256_MB_VLOAD(&state[4u * (lanes)]))); \
+    SW_SHA256_MB_VSTORE(&state[5u * (lanes)], SW_SHA256_MB_VADD(f, SW_SHA256_MB_VLOAD(&state[5u * (lanes)]))); \
+    SW_SHA256_MB_VSTORE(&state[6u * (lanes)], SW_SHA256_MB_VADD(g, SW_SHA256_MB_VLOAD(&state[6u * (lanes)]))); \
+    SW_SHA256_MB_VSTORE(&state[7u * (lanes)], SW_SHA256_MB_VADD(h, SW_SHA256_MB_VLOAD(&state[7u * (lanes)])));
+
+#if defined(SW_SHA2_X86)
+#define SW_SHA256_MB_VT             __m128i
+#define SW_SHA256_MB_VLOAD(p)       _mm_loadu_si128((const __m128i*)(const void*)(p))
+#define SW_SHA256_MB_VSTORE(p, v)   _mm_storeu_si128((__m128i*)(void*)(p), (v))
+#define SW_SHA256_MB_VSET1(x)       _mm_set1_epi32((int)(x))
+#define SW_SHA256_MB_VADD(x, y)     _mm_add_epi32((x), (y))
+#define SW_SHA256_MB_VXOR(x, y)     _mm_xor_si128((x), (y))
+#define SW_SHA256_MB_VAND(x, y)     _mm_and_si128((x), (y))
+#define SW_SHA256_MB_VOR(x, y)      _mm_or_si128((x), (y))
+#define SW_SHA256_MB_VSRL(x, n)     _mm_srli_epi32((x), (n))
+#define SW_SHA256_MB_VROR(x, n)     _mm_or_si128(_mm_srli_epi32((x), (n)), _mm_slli_epi32((x), 32 - (n)))
+
+/** \brief Multi-buffer SHA256 of 4 lanes with SSE2 */
+SW_SHA2_TARGET("sse2")
+static void sw_sha256_mb_sse2(uint32_t* state, const uint8_t* const blocks[])
+{
+    SW_SHA256_MB_BODY(4u)
+}
+
+#undef SW_SHA256_MB_VT
+#undef SW_SHA256_MB_VLOAD
+#undef SW_SHA256_MB_VSTORE
+#undef SW_SHA256_MB_VSET1
+#undef SW_SHA256_MB_VADD
+#undef SW_SHA256_MB_VXOR
+#undef SW_SHA256_MB_VAND
+#undef SW_SHA256_MB_VOR
+#undef SW_SHA256_MB_VSRL
+#undef SW_SHA256_MB_VROR
+
+#define SW_SHA256_MB_VT             __m256i
+#define SW_SHA256_MB_VLOAD(p)       _mm256_loadu_si256((const __m256i*)(const void*)(p))
+#define SW_SHA256_MB_VSTORE(p, v)   _mm256_storeu_si256((__m256i*)(void*)(p), (v))
+#define SW_SHA256_MB_VSET1(x)       _mm256_set1_epi32((int)(x))
+#define SW_SHA256_MB_VADD(x, y)     _mm256_add_epi32((x), (y))
+#define SW_SHA256_MB_VXOR(x, y)     _mm256_xor_si256((x), (y))
+#define SW_SHA256_MB_VAND(x, y)     _mm256_and_si256((x), (y))
+#define SW_SHA256_MB_VOR(x, y)      _mm256_or_si256((x), (y))
+#define SW_SHA256_MB_VSRL(x, n)     _mm256_srli_epi32((x), (n))
+#define SW_SHA256_MB_VROR(x, n)     _mm256_or_si256(_mm256_srli_epi32((x), (n)), _mm256_slli_epi32((x), 32 - (n)))
+
+/** \brief Multi-buffer SHA256 of 8 lanes with AVX2 */
+SW_SHA2_TARGET("avx2,bmi2")
+static void sw_sha256_mb_avx2(uint32_t* state, const uint8_t* const blocks[])
+{
+    SW_SHA256_MB_BODY(8u)
+}
+
+#undef SW_SHA256_MB_VT
+#undef SW_SHA256_MB_VLOAD
+#undef SW_SHA256_MB_VSTORE
+#undef SW_SHA256_MB_VSET1
+#undef SW_SHA256_MB_VADD
+#undef SW_SHA256_MB_VXOR
+#undef SW_SHA256_MB_VAND
+#undef SW_SHA256_MB_VOR
+#undef SW_SHA256_MB_VSRL
+#undef SW_SHA256_MB_VROR
+
+#define SW_SHA256_MB_VT             __m512i
+#define SW_SHA256_MB_VLOAD(p)       _mm512_loadu_si512((const void*)(p))
+#define SW_SHA256_MB_VSTORE(p, v)   _mm512_storeu_si512((void*)(p), (v))
+#define SW_SHA256_MB_VSET1(x)       _mm512_set1_epi32((int)(x))
+#define SW_SHA256_MB_VADD(x, y)     _mm512_add_epi32((x), (y))
+#define SW_SHA256_MB_VXOR(x, y)     _mm512_xor_si512((x), (y))
+#define SW_SHA256_MB_VAND(x, y)     _mm512_and_si512((x), (y))
+#define SW_SHA256_MB_VOR(x, y)      _mm512_or_si512((x), (y))
+#define SW_SHA256_MB_VSRL(x, n)     _mm512_srli_epi32((x), (n))
+#define SW_SHA256_MB_VROR(x, n)     _mm512_ror_epi32((x), (n))
+
+/** \brief Multi-buffer SHA256 of 16 lanes with AVX-512F */
+SW_SHA2_TARGET("avx512f")
+static void sw_sha256_mb_avx512(uint32_t* state, const uint8_t* const blocks[])
+{
+    SW_SHA256_MB_BODY(16u)
+}
+#endif /* SW_SHA2_X86 */
+
+#if defined(SW_SHA2_ARMV8)
+#define SW_SHA256_MB_VT             uint32x4_t
+#define SW_SHA256_MB_VLOAD(p)       vld1q_u32(p)
+#define SW_SHA256_MB_VSTORE(p, v)   vst1q_u32((p), (v))
+#define SW_SHA256_MB_VSET1(x)       vdupq_n_u32(x)
+#define SW_SHA256_MB_VADD(x, y)     vaddq_u32((x), (y))
+#define SW_SHA256_MB_VXOR(x, y)     veorq_u32((x), (y))
+#define SW_SHA256_MB_VAND(x, y)     vandq_u32((x), (y))
+#define SW_SHA256_MB_VOR(x, y)      vorrq_u32((x), (y))
+#define SW_SHA256_MB_VSRL(x, n)     vshrq_n_u32((x), (n))
+#define SW_SHA256_MB_VROR(x, n)     vorrq_u32(vshrq_n_u32((x), (n)), vshlq_n_u32((x), 32 - (n)))
+
+/** \brief Multi-buffer SHA256 of 4 lanes with Advanced SIMD */
+static void sw_sha256_mb_neon(uint32_t* state, const uint8_t* const blocks[])
+{
+    SW_SHA256_MB_BODY(4u)
+}
+#endif /* SW_SHA2_ARMV8 */
+
+#undef SW_SHA256_MB_VT
+#undef SW_SHA256_MB_VLOAD
+#undef SW_SHA256_MB_VSTORE
+#undef SW_SHA256_MB_VSET1
+#undef SW_SHA256_MB_VADD
+#undef SW_SHA256_MB_VXOR
+#undef SW_SHA256_MB_VAND
+#undef SW_SHA256_MB_VOR
+#undef SW_SHA256_MB_VSRL
+#undef SW_SHA256_MB_VROR
+#undef SW_SHA256_MB_BODY
+#endif /* ATCA_CRYPTO_SHA2_HW_EN && ATCA_CRYPTO_SHA256_EN */
+
+#if ATCA_CRYPTO_SHA256_EN
+#if ATCA_CRYPTO_SHA2_HW_EN
+/** \brief Block processing function used by the software SHA256 - resolved on first use */
+static sw_sha256_kernel_fn volatile sw_sha256_kernel = NULL;
+
+/** \brief Look up a SHA256 kernel, NULL if the processor does not support it */
+static sw_sha256_kernel_fn sw_sha256_kernel_lookup(sw_sha2_kernel_t kernel)
+{
+    sw_sha256_kernel_fn fn = NULL;
+    uint32_t caps = sw_sha2_cpu_caps();
+
+    switch (kernel)
+    {
+    case SW_SHA2_KERNEL_AUTO:
+#if defined(SW_SHA2_X86)
+        if (0u != (caps & SW_SHA2_CAP_SHANI))
+        {
+            fn = &sw_sha256_process_shani;
+        }
+        else if (0u != (caps & SW_SHA2_CAP_AVX2))
+        {
+            fn = &sw_sha256_process_avx2;
+        }
+        else
+#elif defined(SW_SHA2_ARMV8)
+        if (0u != (caps & SW_SHA2_CAP_ARMV8))
+        {
+            fn = &sw_sha256_process_armv8;
+        }
+        else
+#endif
+        {
+            fn = &sw_sha256_process_c;
+        }
+        break;
+    case SW_SHA2_KERNEL_C:
+        fn = &sw_sha256_process_c;
+        break;
+#if defined(SW_SHA2_X86)
+    case SW_SHA2_KERNEL_SHANI:
+        fn = (0u != (caps & SW_SHA2_CAP_SHANI)) ? &sw_sha256_process_shani : NULL;
+        break;
+    case SW_SHA2_KERNEL_AVX2:
+        fn = (0u != (caps & SW_SHA2_CAP_AVX2)) ? &sw_sha256_process_avx2 : NULL;
+        break;
+#endif
+#if defined(SW_SHA2_ARMV8)
+    case SW_SHA2_KERNEL_ARMV8:
+        fn = (0u != (caps & SW_SHA2_CAP_ARMV8)) ? &sw_sha256_process_armv8 : NULL;
+        break;
+#endif
+    default:
+        fn = NULL;
+        break;
+    }
+
+    return fn;
+}
+
+/**
+ * \brief Select the implementation the software SHA256 uses to process
+ * blocks. By default the fastest one the processor supports is used.
+ *
+ * \param[in] kernel  Implementation to use
+ *
+ * \return ATCA_SUCCESS on success, ATCA_UNIMPLEMENTED if the kernel is not
+ *         available on this processor
+ */
+ATCA_STATUS sw_sha256_set_kernel(sw_sha2_kernel_t kernel)
+{
+    sw_sha256_kernel_fn fn = sw_sha256_kernel_lookup(kernel);
+
+    if (NULL == fn)
+    {
+        return ATCA_UNIMPLEMENTED;
+    }
+
+    SW_SHA2_KERNEL_STORE(sw_sha256_kernel, fn);
+    return ATCA_SUCCESS;
+}
+#endif
+
+/** \brief Processes whole blocks into a hash state with the selected kernel */
+static void sw_sha256_blocks(uint32_t hash[8], const uint8_t* blocks, uint32_t block_count)
+{
+#if ATCA_CRYPTO_SHA2_HW_EN
+    sw_sha256_kernel_fn fn = SW_SHA2_KERNEL_LOAD(sw_sha256_kernel);
+
+    if (NULL == fn)
+    {
+        fn = sw_sha256_kernel_lookup(SW_SHA2_KERNEL_AUTO);
+        SW_SHA2_KERNEL_STORE(sw_sha256_kernel, fn);
+    }
+    fn(hash, blocks, block_count);
+#else
+    sw_sha256_process_c(hash, blocks, block_count);
+#endif
+}
+
+/**
+ * \brief Processes whole blocks (64 bytes) of data.
+ *
+ * \param[in] ctx          SHA256 hash context
+ * \param[in] blocks       Raw blocks to be processed
+ * \param[in] block_count  Number of 64-byte blocks to process
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+static ATCA_STATUS sw_sha256_process(sw_sha256_ctx* ctx, const uint8_t* blocks, uint32_t block_count)
+{
+    if ((NULL == ctx) || (NULL == blocks))
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    sw_sha256_blocks(ctx->hash, blocks, block_count);
+
+    return ATCA_SUCCESS;
+}
+#endif
+
+#if ATCA_CRYPTO_SHA512_EN || ATCA_CRYPTO_SHA384_EN
+#if ATCA_CRYPTO_SHA2_HW_EN
+/** \brief Block processing function used by the software SHA512 - resolved on first use */
+static sw_sha512_kernel_fn volatile sw_sha512_kernel = NULL;
+
+/** \brief Look up a SHA512 kernel, NULL if the processor does not support it */
+static sw_sha512_kernel_fn sw_sha512_kernel_lookup(sw_sha2_kernel_t kernel)
+{
+    sw_sha512_kernel_fn fn = NULL;
+    uint32_t caps = sw_sha2_cpu_caps();
+
+    switch (kernel)
+    {
+    case SW_SHA2_KERNEL_AUTO:
+#if defined(SW_SHA2_X86)
+        if (0u != (caps & SW_SHA2_CAP_AVX2))
+        {
+            fn = &sw_sha512_process_avx2;
+        }
+        else
+#endif
+        {
+            fn = &sw_sha512_process_c;
+        }
+        break;
+    case SW_SHA2_KERNEL_C:
+        fn = &sw_sha512_process_c;
+        break;
+#if defined(SW_SHA2_X86)
+    case SW_SHA2_KERNEL_AVX2:
+        fn = (0u != (caps & SW_SHA2_CAP_AVX2)) ? &sw_sha512_process_avx2 : NULL;
+        break;
+#endif
+    default:
+        fn = NULL;
+        break;
+    }
+
+    ((void)caps);
+    return fn;
+}
+
+/**
+ * \brief Select the implementation the software SHA384/SHA512 use to
+ * process blocks. By default the fastest one the processor supports is used.
+ *
+ * \param[in] kernel  Implementation to use
+ *
+ * \return ATCA_SUCCESS on success, ATCA_UNIMPLEMENTED if the kernel is not
+ *         available on this processor
+ */
+ATCA_STATUS sw_sha512_set_kernel(sw_sha2_kernel_t kernel)
+{
+    sw_sha512_kernel_fn fn = sw_sha512_kernel_lookup(kernel);
+
+    if (NULL == fn)
+    {
+        return ATCA_UNIMPLEMENTED;
+    }
+
+    SW_SHA2_KERNEL_STORE(sw_sha512_kernel, fn);
+    return ATCA_SUCCESS;
+}
+#endif
+
+/**
+ * \brief Processes whole blocks (128 bytes) of data.
+ *
+ * \param[in] ctx          SHA512 hash context
+ * \param[in] blocks       Raw blocks to be processed
+ * \param[in] block_count  Number of 128-byte blocks to process
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+static ATCA_STATUS sw_sha512_process(sw_sha512_ctx* ctx, const uint8_t* blocks, uint32_t block_count)
+{
+    if ((NULL == ctx) || (NULL == blocks))
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+#if ATCA_CRYPTO_SHA2_HW_EN
+    sw_sha512_kernel_fn fn = SW_SHA2_KERNEL_LOAD(sw_sha512_kernel);
+
+    if (NULL == fn)
+    {
+        fn = sw_sha512_kernel_lookup(SW_SHA2_KERNEL_AUTO);
+        SW_SHA2_KERNEL_STORE(sw_sha512_kernel, fn);
+    }
+    fn(ctx->hash, blocks, block_count);
+#else
+    sw_sha512_process_c(ctx->hash, blocks, block_count);
+#endif
+
+    return ATCA_SUCCESS;
 }
 #endif
 
@@ -306,10 +1220,6 @@ static ATCA_STATUS sw_sha512_process(sw_sha512_ctx* ctx, const uint8_t* blocks,
 ATCA_STATUS sw_sha256_init(sw_sha256_ctx* ctx)
 {
     ATCA_STATUS status = ATCA_BAD_PARAM;
-    static const uint32_t hash_init[] = {
-        0x6a09e667U, 0xbb67ae85U, 0x3c6ef372U, 0xa54ff53aU,
-        0x510e527fU, 0x9b05688cU, 0x1f83d9abU, 0x5be0cd19U
-    };
     int i;
 
     if(NULL == ctx)
@@ -320,7 +1230,7 @@ ATCA_STATUS sw_sha256_init(sw_sha256_ctx* ctx)
     (void)memset(ctx, 0, sizeof(*ctx));
     for (i = 0; i < 8; i++)
     {
-        ctx->hash[i] = hash_init[i];
+        ctx->hash[i] = sw_sha256_init_hash[i];
     }
 
     return (status = ATCA_SUCCESS);
@@ -485,6 +1395,493 @@ ATCA_STATUS sw_sha256(const uint8_t* message, unsigned int len, uint8_t digest[S
 
     return status;
 }
+
+#if defined(SW_SHA256_MB_EN)
+/** \brief Most messages sw_sha256_multi hashes side by side */
+#define SW_SHA256_MB_MAX_LANES  (16u)
+
+/** \brief Message currently hashed in a multi-buffer lane */
+typedef struct
+{
+    bool           active;                          //!< Lane is hashing a message
+    uint32_t       index;                           //!< Index of the message being hashed
+    const uint8_t* msg;                             //!< Message being hashed
+    uint32_t       full_blocks;                     //!< Number of whole blocks read directly from the message
+    uint32_t       block_count;                     //!< Total number of blocks including the padded tail
+    uint32_t       block;                           //!< Next block to process
+    uint8_t        tail[SHA256_BLOCK_SIZE * 2u];    //!< Padded final block(s)
+} sw_sha256_mb_lane;
+
+/** \brief Multi-buffer kernel used by sw_sha256_multi */
+typedef struct
+{
+    sw_sha256_mb_kernel_fn fn;      //!< Kernel, NULL to hash the messages one after another
+    uint32_t               lanes;   //!< Number of lanes the kernel processes
+} sw_sha256_mb_kernel_t;
+
+/* Kernels sw_sha256_multi can be set to */
+static const sw_sha256_mb_kernel_t sw_sha256_mb_kernel_serial = { NULL, 1u };
+#if defined(SW_SHA2_X86)
+static const sw_sha256_mb_kernel_t sw_sha256_mb_kernel_sse2 = { &sw_sha256_mb_sse2, 4u };
+static const sw_sha256_mb_kernel_t sw_sha256_mb_kernel_avx2 = { &sw_sha256_mb_avx2, 8u };
+static const sw_sha256_mb_kernel_t sw_sha256_mb_kernel_avx512 = { &sw_sha256_mb_avx512, 16u };
+#elif defined(SW_SHA2_ARMV8)
+static const sw_sha256_mb_kernel_t sw_sha256_mb_kernel_neon = { &sw_sha256_mb_neon, 4u };
+#endif
+
+/** \brief Kernel used by sw_sha256_multi - resolved on first use */
+static const sw_sha256_mb_kernel_t* volatile sw_sha256_mb_kernel = NULL;
+
+/** \brief Look up a multi-buffer SHA256 kernel, NULL if the processor does not support it */
+static const sw_sha256_mb_kernel_t* sw_sha256_mb_kernel_lookup(sw_sha2_kernel_t kernel)
+{
+    const sw_sha256_mb_kernel_t* mb = NULL;
+    uint32_t caps = sw_sha2_cpu_caps();
+
+    switch (kernel)
+    {
+    case SW_SHA2_KERNEL_AUTO:
+        mb = &sw_sha256_mb_kernel_serial;
+#if defined(SW_SHA2_X86)
+        /* The SHA extensions outrun 4 and 8 lanes of plain SIMD */
+        if (0u != (caps & SW_SHA2_CAP_AVX512))
+        {
+            mb = &sw_sha256_mb_kernel_avx512;
+        }
+        else if (0u != (caps & SW_SHA2_CAP_SHANI))
+        {
+            mb = &sw_sha256_mb_kernel_serial;
+        }
+        else if (0u != (caps & SW_SHA2_CAP_AVX2))
+        {
+            mb = &sw_sha256_mb_kernel_avx2;
+        }
+        else if (0u != (caps & SW_SHA2_CAP_SSE2))
+        {
+            mb = &sw_sha256_mb_kernel_sse2;
+        }
+        else
+        {
+            mb = &sw_sha256_mb_kernel_serial;
+        }
+#elif defined(SW_SHA2_ARMV8)
+        /* The SHA2 instructions outrun 4 lanes of plain SIMD */
+        if ((0u == (caps & SW_SHA2_CAP_ARMV8)) && (0u != (caps & SW_SHA2_CAP_NEON)))
+        {
+            mb = &sw_sha256_mb_kernel_neon;
+        }
+#endif
+        break;
+    case SW_SHA2_KERNEL_C:
+        mb = &sw_sha256_mb_kernel_serial;
+        break;
+#if defined(SW_SHA2_X86)
+    case SW_SHA2_KERNEL_SSE2:
+        mb = (0u != (caps & SW_SHA2_CAP_SSE2)) ? &sw_sha256_mb_kernel_sse2 : NULL;
+        break;
+    case SW_SHA2_KERNEL_AVX2:
+        mb = (0u != (caps & SW_SHA2_CAP_AVX2)) ? &sw_sha256_mb_kernel_avx2 : NULL;
+        break;
+    case SW_SHA2_KERNEL_AVX512:
+        mb = (0u != (caps & SW_SHA2_CAP_AVX512)) ? &sw_sha256_mb_kernel_avx512 : NULL;
+        break;
+#endif
+#if defined(SW_SHA2_ARMV8)
+    case SW_SHA2_KERNEL_NEON:
+        mb = (0u != (caps & SW_SHA2_CAP_NEON)) ? &sw_sha256_mb_kernel_neon : NULL;
+        break;
+#endif
+    default:
+        mb = NULL;
+        break;
+    }
+
+    return mb;
+}
+
+/** \brief Kernel sw_sha256_multi uses, resolving the fastest one on first use */
+static const sw_sha256_mb_kernel_t* sw_sha256_mb_kernel_get(void)
+{
+    const sw_sha256_mb_kernel_t* mb = SW_SHA2_KERNEL_LOAD(sw_sha256_mb_kernel);
+
+    if (NULL == mb)
+    {
+        mb = sw_sha256_mb_kernel_lookup(SW_SHA2_KERNEL_AUTO);
+        SW_SHA2_KERNEL_STORE(sw_sha256_mb_kernel, mb);
+    }
+
+    return mb;
+}
+
+/** \brief Load the next message into a lane and reset the lane's hash state */
+static void sw_sha256_mb_start(sw_sha256_mb_lane* lane, uint32_t* state, uint32_t lanes, uint32_t lane_idx,
+                               const uint8_t* msg, uint32_t msg_size, uint32_t index)
+{
+    uint32_t rem_size = msg_size % SHA256_BLOCK_SIZE;
+    uint64_t msg_size_bits = (uint64_t)msg_size * 8u;
+    uint32_t tail_size;
+    uint32_t i;
+
+    lane->active = true;
+    lane->index = index;
+    lane->msg = msg;
+    lane->full_blocks = msg_size / SHA256_BLOCK_SIZE;
+    lane->block_count = lane->full_blocks + (((rem_size + 9u) > SHA256_BLOCK_SIZE) ? 2u : 1u);
+    lane->block = 0u;
+
+    // Padding: a single 1 bit, zeros and the message size in bits
+    tail_size = (lane->block_count - lane->full_blocks) * SHA256_BLOCK_SIZE;
+    (void)memset(lane->tail, 0, sizeof(lane->tail));
+    if (0u < rem_size)
+    {
+        (void)memcpy(lane->tail, &msg[lane->full_blocks * SHA256_BLOCK_SIZE], (size_t)rem_size);
+    }
+    lane->tail[rem_size] = 0x80;
+    for (i = 0u; i < 8u; i++)
+    {
+        lane->tail[tail_size - 1u - i] = (uint8_t)((msg_size_bits >> (i * 8u)) & UINT8_MAX);
+    }
+
+    for (i = 0u; i < 8u; i++)
+    {
+        state[i * lanes + lane_idx] = sw_sha256_init_hash[i];
+    }
+}
+
+/** \brief Hash the messages with a multi-buffer kernel, refilling lanes as their messages complete */
+static void sw_sha256_mb_run(const sw_sha256_mb_kernel_t* mb, const uint8_t* const messages[],
+                             const uint32_t message_sizes[], uint32_t count, uint8_t digests[][SHA256_DIGEST_SIZE])
+{
+    static const uint8_t idle_block[SHA256_BLOCK_SIZE] = { 0u };
+    sw_sha256_mb_lane lane[SW_SHA256_MB_MAX_LANES];
+    const uint8_t* blocks[SW_SHA256_MB_MAX_LANES];
+    uint32_t state[8u * SW_SHA256_MB_MAX_LANES];
+    uint32_t next = 0u;
+    uint32_t active = 0u;
+    uint32_t i;
+    uint32_t j;
+
+    (void)memset(state, 0, sizeof(state));
+    for (j = 0u; j < mb->lanes; j++)
+    {
+        lane[j].active = false;
+        if (next < count)
+        {
+            sw_sha256_mb_start(&lane[j], state, mb->lanes, j, messages[next], message_sizes[next], next);
+            next++;
+            active++;
+        }
+    }
+
+    while (0u < active)
+    {
+        for (j = 0u; j < mb->lanes; j++)
+        {
+            if (!lane[j].active)
+            {
+                blocks[j] = idle_block;
+            }
+            else if (lane[j].block < lane[j].full_blocks)
+            {
+                blocks[j] = &lane[j].msg[lane[j].block * SHA256_BLOCK_SIZE];
+            }
+            else
+            {
+                blocks[j] = &lane[j].tail[(lane[j].block - lane[j].full_blocks) * SHA256_BLOCK_SIZE];
+            }
+        }
+
+        mb->fn(state, blocks);
+
+        for (j = 0u; j < mb->lanes; j++)
+        {
+            if (!lane[j].active || (++lane[j].block < lane[j].block_count))
+            {
+                continue;
+            }
+
+            for (i = 0u; i < 8u; i++)
+            {
+                uint32_t word = state[i * mb->lanes + j];
+                digests[lane[j].index][i * 4u + 0u] = (uint8_t)((word >> 24) & UINT8_MAX);
+                digests[lane[j].index][i * 4u + 1u] = (uint8_t)((word >> 16) & UINT8_MAX);
+                digests[lane[j].index][i * 4u + 2u] = (uint8_t)((word >> 8) & UINT8_MAX);
+                digests[lane[j].index][i * 4u + 3u] = (uint8_t)(word & UINT8_MAX);
+            }
+
+            if (next < count)
+            {
+                sw_sha256_mb_start(&lane[j], state, mb->lanes, j, messages[next], message_sizes[next], next);
+                next++;
+            }
+            else
+            {
+                lane[j].active = false;
+                active--;
+            }
+        }
+    }
+}
+
+/**
+ * \brief Select the implementation sw_sha256_multi uses. By default the
+ * widest SIMD kernel is used unless hashing the messages one after another
+ * with the SHA instructions is faster.
+ *
+ * \param[in] kernel  SW_SHA2_KERNEL_SSE2, _AVX2, _AVX512 or _NEON for the
+ *                    4, 8, 16 and 4 lane kernels, SW_SHA2_KERNEL_C to hash
+ *                    the messages one after another or SW_SHA2_KERNEL_AUTO
+ *
+ * \return ATCA_SUCCESS on success, ATCA_UNIMPLEMENTED if the kernel is not
+ *         available on this processor
+ */
+ATCA_STATUS sw_sha256_multi_set_kernel(sw_sha2_kernel_t kernel)
+{
+    const sw_sha256_mb_kernel_t* mb = sw_sha256_mb_kernel_lookup(kernel);
+
+    if (NULL == mb)
+    {
+        return ATCA_UNIMPLEMENTED;
+    }
+
+    SW_SHA2_KERNEL_STORE(sw_sha256_mb_kernel, mb);
+    return ATCA_SUCCESS;
+}
+#elif ATCA_CRYPTO_SHA2_HW_EN
+ATCA_STATUS sw_sha256_multi_set_kernel(sw_sha2_kernel_t kernel)
+{
+    return ((SW_SHA2_KERNEL_AUTO == kernel) || (SW_SHA2_KERNEL_C == kernel)) ? ATCA_SUCCESS : ATCA_UNIMPLEMENTED;
+}
+#endif /* SW_SHA256_MB_EN */
+
+/** \brief Computes the SHA256 digests of several independent messages. With
+ *         ATCA_CRYPTO_SHA2_HW_EN the messages are hashed side by side in
+ *         SIMD lanes, otherwise one after another.
+ * \param[in]  messages       Messages to hash. May be NULL for empty messages.
+ * \param[in]  message_sizes  Size of each message in bytes
+ * \param[in]  count          Number of messages
+ * \param[out] digests        Receives the digest of each message
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS sw_sha256_multi(const uint8_t* const messages[], const uint32_t message_sizes[], uint32_t count,
+                            uint8_t digests[][SHA256_DIGEST_SIZE])
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    uint32_t i;
+#if defined(SW_SHA256_MB_EN)
+    const sw_sha256_mb_kernel_t* mb;
+#endif
+
+    if (0u == count)
+    {
+        return ATCA_SUCCESS;
+    }
+
+    if ((NULL == messages) || (NULL == message_sizes) || (NULL == digests))
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    for (i = 0u; i < count; i++)
+    {
+        if ((NULL == messages[i]) && (0u < message_sizes[i]))
+        {
+            return ATCA_BAD_PARAM;
+        }
+    }
+
+#if defined(SW_SHA256_MB_EN)
+    mb = sw_sha256_mb_kernel_get();
+
+    if ((NULL != mb->fn) && (1u < count))
+    {
+        sw_sha256_mb_run(mb, messages, message_sizes, count, digests);
+        return ATCA_SUCCESS;
+    }
+#endif
+
+    for (i = 0u; (i < count) && (ATCA_SUCCESS == status); i++)
+    {
+        status = sw_sha256(messages[i], message_sizes[i], digests[i]);
+    }
+
+    return status;
+}
+
+/** \brief Write a 32-bit word big endian */
+static void sw_sha256_store_be32(uint8_t* data, uint32_t word)
+{
+    data[0] = (uint8_t)((word >> 24) & UINT8_MAX);
+    data[1] = (uint8_t)((word >> 16) & UINT8_MAX);
+    data[2] = (uint8_t)((word >> 8) & UINT8_MAX);
+    data[3] = (uint8_t)(word & UINT8_MAX);
+}
+
+/** \brief Pad a block holding a 32 byte message that follows one key block */
+static void sw_sha256_hmac_pad(uint8_t block[SHA256_BLOCK_SIZE])
+{
+    (void)memset(block, 0, SHA256_BLOCK_SIZE);
+    block[SHA256_DIGEST_SIZE] = 0x80;
+    sw_sha256_store_be32(&block[SHA256_BLOCK_SIZE - 4u], (SHA256_BLOCK_SIZE + SHA256_DIGEST_SIZE) * 8u);
+}
+
+#if defined(SW_SHA256_MB_EN)
+/** \brief Run the HMAC iterations of up to one lane per output block with a multi-buffer kernel */
+static void sw_sha256_mb_hmac_iterate(const sw_sha256_mb_kernel_t* mb, const uint32_t inner[8], const uint32_t outer[8],
+                                      uint8_t u[][SHA256_DIGEST_SIZE], uint8_t t[][SHA256_DIGEST_SIZE],
+                                      uint32_t count, uint32_t iterations)
+{
+    uint8_t block[SW_SHA256_MB_MAX_LANES][SHA256_BLOCK_SIZE];
+    const uint8_t* blocks[SW_SHA256_MB_MAX_LANES];
+    uint32_t state[8u * SW_SHA256_MB_MAX_LANES];
+    uint32_t n;
+    uint32_t i;
+    uint32_t j;
+    uint32_t k;
+
+    // Idle lanes hash a padded block of zeros
+    for (j = 0u; j < mb->lanes; j++)
+    {
+        sw_sha256_hmac_pad(block[j]);
+        if (j < count)
+        {
+            (void)memcpy(block[j], u[j], SHA256_DIGEST_SIZE);
+        }
+        blocks[j] = block[j];
+    }
+
+    for (n = 0u; n < iterations; n++)
+    {
+        for (i = 0u; i < 8u; i++)
+        {
+            for (j = 0u; j < mb->lanes; j++)
+            {
+                state[i * mb->lanes + j] = inner[i];
+            }
+        }
+        mb->fn(state, blocks);
+
+        for (i = 0u; i < 8u; i++)
+        {
+            for (j = 0u; j < mb->lanes; j++)
+            {
+                sw_sha256_store_be32(&block[j][i * 4u], state[i * mb->lanes + j]);
+                state[i * mb->lanes + j] = outer[i];
+            }
+        }
+        mb->fn(state, blocks);
+
+        for (i = 0u; i < 8u; i++)
+        {
+            for (j = 0u; j < mb->lanes; j++)
+            {
+                sw_sha256_store_be32(&block[j][i * 4u], state[i * mb->lanes + j]);
+            }
+        }
+
+        for (j = 0u; j < count; j++)
+        {
+            for (k = 0u; k < SHA256_DIGEST_SIZE; k++)
+            {
+                t[j][k] ^= block[j][k];
+            }
+        }
+    }
+
+    for (j = 0u; j < count; j++)
+    {
+        (void)memcpy(u[j], block[j], SHA256_DIGEST_SIZE);
+    }
+}
+#endif
+
+/**
+ * \brief Runs the HMAC-SHA256 iterations of PBKDF2 for several output blocks.
+ *
+ * Every iteration computes U = HMAC(key, U) and T ^= U. The HMAC is started
+ * from the inner (key ^ ipad) and outer (key ^ opad) midstates, so it costs
+ * two block compressions per iteration. With ATCA_CRYPTO_SHA2_HW_EN the
+ * output blocks are processed side by side in the lanes of the multi-buffer
+ * kernel picked for sw_sha256_multi.
+ *
+ * \param[in]     inner       Context which has hashed only the key ^ ipad block
+ * \param[in]     outer       Context which has hashed only the key ^ opad block
+ * \param[in,out] u           U of each output block, updated to the last one
+ * \param[in,out] t           Running xor of each output block
+ * \param[in]     count       Number of output blocks
+ * \param[in]     iterations  Number of iterations to run
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS sw_sha256_hmac_iterate(const sw_sha256_ctx* inner, const sw_sha256_ctx* outer,
+                                   uint8_t u[][SHA256_DIGEST_SIZE], uint8_t t[][SHA256_DIGEST_SIZE],
+                                   uint32_t count, uint32_t iterations)
+{
+    uint8_t block[SHA256_BLOCK_SIZE];
+    uint32_t hash[8];
+    uint32_t n = 0u;
+    uint32_t i;
+    uint32_t k;
+#if defined(SW_SHA256_MB_EN)
+    const sw_sha256_mb_kernel_t* mb;
+#endif
+
+    if ((NULL == inner) || (NULL == outer) || (NULL == u) || (NULL == t))
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    // Both contexts must hold exactly one processed block
+    if ((SHA256_BLOCK_SIZE != inner->total_msg_size) || (0u != inner->block_size) ||
+        (SHA256_BLOCK_SIZE != outer->total_msg_size) || (0u != outer->block_size))
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+#if defined(SW_SHA256_MB_EN)
+    mb = sw_sha256_mb_kernel_get();
+
+    /* A group that fills less than a quarter of the lanes is faster one block at a time */
+    while ((NULL != mb->fn) && (mb->lanes < 4u * (count - n)))
+    {
+        k = count - n;
+        k = (k < mb->lanes) ? k : mb->lanes;
+        sw_sha256_mb_hmac_iterate(mb, inner->hash, outer->hash, &u[n], &t[n], k, iterations);
+        n += k;
+    }
+#endif
+
+    sw_sha256_hmac_pad(block);
+    for (; n < count; n++)
+    {
+        (void)memcpy(block, u[n], SHA256_DIGEST_SIZE);
+        for (i = 0u; i < iterations; i++)
+        {
+            (void)memcpy(hash, inner->hash, sizeof(hash));
+            sw_sha256_blocks(hash, block, 1u);
+            for (k = 0u; k < 8u; k++)
+            {
+                sw_sha256_store_be32(&block[k * 4u], hash[k]);
+            }
+
+            (void)memcpy(hash, outer->hash, sizeof(hash));
+            sw_sha256_blocks(hash, block, 1u);
+            for (k = 0u; k < 8u; k++)
+            {
+                sw_sha256_store_be32(&block[k * 4u], hash[k]);
+            }
+
+            for (k = 0u; k < SHA256_DIGEST_SIZE; k++)
+            {
+                t[n][k] ^= block[k];
+            }
+        }
+        (void)memcpy(u[n], block, SHA256_DIGEST_SIZE);
+    }
+
+    return ATCA_SUCCESS;
+}
 #endif
 
 #if ATCA_CRYPTO_SHA512_EN || ATCA_CRYPTO_SHA384_EN
@@ -79,12 +79,36 @@ typedef struct
 } sw_sha512_ctx;
 #endif
 
+#if ATCA_CRYPTO_SHA2_HW_EN
+/** \brief Block processing implementations of the software SHA-2 routines */
+typedef enum
+{
+    SW_SHA2_KERNEL_AUTO,    //!< Fastest implementation the processor supports
+    SW_SHA2_KERNEL_C,       //!< Portable C
+    SW_SHA2_KERNEL_SHANI,   //!< x86 SHA extensions (SHA256 only)
+    SW_SHA2_KERNEL_AVX2,    //!< x86 AVX2 message schedule, 8 lanes for sw_sha256_multi
+    SW_SHA2_KERNEL_ARMV8,   //!< ARMv8 SHA2 crypto extensions (SHA256 only)
+    SW_SHA2_KERNEL_SSE2,    //!< x86 SSE2, 4 lanes (sw_sha256_multi only)
+    SW_SHA2_KERNEL_AVX512,  //!< x86 AVX-512F, 16 lanes (sw_sha256_multi only)
+    SW_SHA2_KERNEL_NEON     //!< ARMv8 Advanced SIMD, 4 lanes (sw_sha256_multi only)
+} sw_sha2_kernel_t;
+#endif
+
 #if ATCA_CRYPTO_SHA256_EN
 // SHA256
 ATCA_STATUS sw_sha256_init(sw_sha256_ctx* ctx);
 ATCA_STATUS sw_sha256_update(sw_sha256_ctx* ctx, const uint8_t* msg, uint32_t msg_size);
 ATCA_STATUS sw_sha256_final(sw_sha256_ctx* ctx, uint8_t digest[SHA256_DIGEST_SIZE]);
 ATCA_STATUS sw_sha256(const uint8_t * message, unsigned int len, uint8_t digest[SHA256_DIGEST_SIZE]);
+ATCA_STATUS sw_sha256_multi(const uint8_t* const messages[], const uint32_t message_sizes[], uint32_t count,
+                            uint8_t digests[][SHA256_DIGEST_SIZE]);
+ATCA_STATUS sw_sha256_hmac_iterate(const sw_sha256_ctx* inner, const sw_sha256_ctx* outer,
+                                   uint8_t u[][SHA256_DIGEST_SIZE], uint8_t t[][SHA256_DIGEST_SIZE],
+                                   uint32_t count, uint32_t iterations);
+#if ATCA_CRYPTO_SHA2_HW_EN
+ATCA_STATUS sw_sha256_set_kernel(sw_sha2_kernel_t kernel);
+ATCA_STATUS sw_sha256_multi_set_kernel(sw_sha2_kernel_t kernel);
+#endif
 #endif
 
 #if ATCA_CRYPTO_SHA384_EN
@@ -102,6 +126,9 @@ ATCA_STATUS sw_sha512_init(sw_sha512_ctx* ctx);
 ATCA_STATUS sw_sha512_update(sw_sha512_ctx* ctx, const uint8_t* msg, uint32_t msg_size);
 ATCA_STATUS sw_sha512_final(sw_sha512_ctx * ctx, uint8_t digest[SHA512_DIGEST_SIZE]);
 ATCA_STATUS sw_sha512(const uint8_t * message, unsigned int len, uint8_t digest[SHA512_DIGEST_SIZE]);
+#if ATCA_CRYPTO_SHA2_HW_EN
+ATCA_STATUS sw_sha512_set_kernel(sw_sha2_kernel_t kernel);
+#endif
 #endif
 
 #ifdef __cplusplus
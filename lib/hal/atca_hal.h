@@ -208,6 +208,10 @@ ATCA_STATUS hal_custom_control(ATCAIface iface, uint8_t option, void* param, siz
 #define ATCA_HAL_FLUSH_BUFFER       (7U)
 /** \brief Set the PIN mode (in vs out) */
 #define ATCA_HAL_CONTROL_DIRECTION  (8U)
+/** \brief Record the kit protocol framing (uint8_t, non-zero for binary) of the link */
+#define ATCA_HAL_SET_KIT_FRAMING    (9U)
+/** \brief Report the kit protocol framing (uint8_t, non-zero for binary) of the link */
+#define ATCA_HAL_GET_KIT_FRAMING    (10U)
 
 /** \brief Timer API for legacy implementations */
 #ifndef atca_delay_ms
@@ -252,6 +256,12 @@ ATCA_STATUS hal_lock_mutex(void * pMutex);
 ATCA_STATUS hal_unlock_mutex(void * pMutex);
 ATCA_STATUS hal_alloc_shared(void ** pShared, size_t size, const char* pName, bool* initialized);
 ATCA_STATUS hal_free_shared(void * pShared, size_t size);
+ATCA_STATUS hal_create_thread(void ** ppThread, void (*fn)(void* arg), void* arg);
+ATCA_STATUS hal_join_thread(void * pThread);
+ATCA_STATUS hal_create_semaphore(void ** ppSem);
+ATCA_STATUS hal_destroy_semaphore(void * pSem);
+ATCA_STATUS hal_post_semaphore(void * pSem);
+ATCA_STATUS hal_wait_semaphore(void * pSem);
 
 #if  defined(__linux__) || defined(__APPLE__)
 #include <unistd.h>
@@ -270,6 +280,74 @@ typedef DWORD hal_pid_t;
 ATCA_STATUS hal_check_pid(hal_pid_t pid);
 #endif
 
+/** \def ATCA_HAL_TIMESTAMP_EN
+ * The platform provides hal_get_timestamp_ms - a free running millisecond counter
+ */
+#ifndef ATCA_HAL_TIMESTAMP_EN
+#if defined(_WIN32) || defined(__linux__) || defined(__APPLE__)
+#define ATCA_HAL_TIMESTAMP_EN   (1)
+#else
+#define ATCA_HAL_TIMESTAMP_EN   (0)
+#endif
+#endif
+
+#if ATCA_HAL_TIMESTAMP_EN
+uint32_t hal_get_timestamp_ms(void);
+#endif
+
+/** \def ATCA_HAL_TIMER_FD_EN
+ * The platform provides hal_timer_fd_ - a one shot timer exposed as a file
+ * descriptor which becomes readable when it expires so it can be waited on
+ * with poll/select/epoll
+ */
+#ifndef ATCA_HAL_TIMER_FD_EN
+#if defined(__linux__)
+#define ATCA_HAL_TIMER_FD_EN    (1)
+#else
+#define ATCA_HAL_TIMER_FD_EN    (0)
+#endif
+#endif
+
+#if ATCA_HAL_TIMER_FD_EN
+int hal_timer_fd_create(void);
+ATCA_STATUS hal_timer_fd_arm(int fd, uint32_t msec);
+void hal_timer_fd_clear(int fd);
+void hal_timer_fd_close(int fd);
+#endif
+
+/** \def ATCA_HAL_DEADLINE_EN
+ * The platform provides hal_get_timestamp_us and hal_delay_until_us - delays
+ * to an absolute deadline so oversleep is not added to the following delays
+ */
+#ifndef ATCA_HAL_DEADLINE_EN
+#if defined(__linux__)
+#define ATCA_HAL_DEADLINE_EN    (1)
+#else
+#define ATCA_HAL_DEADLINE_EN    (0)
+#endif
+#endif
+
+#if ATCA_HAL_DEADLINE_EN
+/** \def ATCA_HAL_DELAY_SPIN_US
+ * Sleep until this many microseconds before a deadline and busy wait for the
+ * rest. 0 sleeps all the way to the deadline.
+ */
+#ifndef ATCA_HAL_DELAY_SPIN_US
+#define ATCA_HAL_DELAY_SPIN_US  (0)
+#endif
+
+/** \def ATCA_HAL_TIMER_SLACK_NS
+ * Timer slack (PR_SET_TIMERSLACK) of the threads delaying in the library. 0
+ * leaves the slack the thread already has.
+ */
+#ifndef ATCA_HAL_TIMER_SLACK_NS
+#define ATCA_HAL_TIMER_SLACK_NS (0)
+#endif
+
+uint64_t hal_get_timestamp_us(void);
+void hal_delay_until_us(uint64_t deadline);
+#endif
+
 #if defined(ATCA_HEAP) && defined(ATCA_TESTS_ENABLED)
 void hal_test_set_memory_f(void* (*malloc_func)(size_t size), void (*free_func)(void* ptr));
 #endif
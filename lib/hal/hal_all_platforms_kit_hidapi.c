@@ -40,6 +40,12 @@
  *
    @{ */
 
+typedef struct atca_hid_host_s
+{
+    hid_device* pHid;
+    uint8_t     kit_framing;    /**< Framing negotiated by the kit protocol */
+} atca_hid_host_t;
+
 /** \brief HAL implementation of Kit USB HID init
  *  \param[in] hal pointer to HAL specific data that is maintained by this HAL
  *  \param[in] cfg pointer to HAL specific configuration data that is used to initialize this HAL
@@ -47,6 +53,8 @@
  */
 ATCA_STATUS hal_kit_hid_init(ATCAIface iface, ATCAIfaceCfg* cfg)
 {
+    atca_hid_host_t* hal_data;
+
     // Check the input variables
     if ((cfg == NULL) || (iface == NULL))
     {
@@ -59,9 +67,21 @@ ATCA_STATUS hal_kit_hid_init(ATCAIface iface, ATCAIfaceCfg* cfg)
 #endif
     (void)hid_init();
 
-    iface->hal_data = hid_open((uint16_t)(ATCA_IFACECFG_VALUE(cfg, atcahid.vid) & UINT16_MAX), (uint16_t)(ATCA_IFACECFG_VALUE(cfg, atcahid.pid) & UINT16_MAX), NULL);
+    if (NULL == (hal_data = malloc(sizeof(atca_hid_host_t))))
+    {
+        return ATCA_ALLOC_FAILURE;
+    }
+    (void)memset(hal_data, 0, sizeof(atca_hid_host_t));
 
-    return (NULL != iface->hal_data) ? ATCA_SUCCESS : ATCA_COMM_FAIL;
+    hal_data->pHid = hid_open((uint16_t)(ATCA_IFACECFG_VALUE(cfg, atcahid.vid) & UINT16_MAX), (uint16_t)(ATCA_IFACECFG_VALUE(cfg, atcahid.pid) & UINT16_MAX), NULL);
+    if (NULL == hal_data->pHid)
+    {
+        free(hal_data);
+        return ATCA_COMM_FAIL;
+    }
+
+    iface->hal_data = hal_data;
+    return ATCA_SUCCESS;
 }
 
 /** \brief HAL implementation of Kit HID post init
@@ -84,7 +104,8 @@ ATCA_STATUS hal_kit_hid_post_init(ATCAIface iface)
 ATCA_STATUS hal_kit_hid_send(ATCAIface iface, uint8_t word_address, uint8_t* txdata, int txlength)
 {
     ATCAIfaceCfg *cfg = atgetifacecfg(iface);
-    hid_device* pHid = (hid_device*)atgetifacehaldat(iface);
+    atca_hid_host_t* hal_data = (atca_hid_host_t*)atgetifacehaldat(iface);
+    hid_device* pHid = (NULL != hal_data) ? hal_data->pHid : NULL;
     int bytes_written;
 
     ((void)word_address);
@@ -121,7 +142,8 @@ ATCA_STATUS hal_kit_hid_send(ATCAIface iface, uint8_t word_address, uint8_t* txd
  */
 ATCA_STATUS hal_kit_hid_receive(ATCAIface iface, uint8_t word_address, uint8_t* rxdata, uint16_t* rxlength)
 {
-    hid_device* pHid = (hid_device*)atgetifacehaldat(iface);
+    atca_hid_host_t* hal_data = (atca_hid_host_t*)atgetifacehaldat(iface);
+    hid_device* pHid = (NULL != hal_data) ? hal_data->pHid : NULL;
     int ret;
 
     ((void)word_address);
@@ -157,13 +179,28 @@ ATCA_STATUS hal_kit_hid_receive(ATCAIface iface, uint8_t word_address, uint8_t*
  */
 ATCA_STATUS hal_kit_hid_control(ATCAIface iface, uint8_t option, void* param, size_t paramlen)
 {
-    ((void)option);
-    ((void)param);
-    ((void)paramlen);
+    atca_hid_host_t* hal_data;
 
     if ((NULL != iface) && (NULL != iface->mIfaceCFG))
     {
-        return ATCA_UNIMPLEMENTED;
+        if ((ATCA_HAL_SET_KIT_FRAMING != option) && (ATCA_HAL_GET_KIT_FRAMING != option))
+        {
+            return ATCA_UNIMPLEMENTED;
+        }
+
+        hal_data = (atca_hid_host_t*)atgetifacehaldat(iface);
+        if ((NULL != hal_data) && (NULL != param) && (sizeof(uint8_t) == paramlen))
+        {
+            if (ATCA_HAL_SET_KIT_FRAMING == option)
+            {
+                hal_data->kit_framing = *(uint8_t*)param;
+            }
+            else
+            {
+                *(uint8_t*)param = hal_data->kit_framing;
+            }
+            return ATCA_SUCCESS;
+        }
     }
     return ATCA_BAD_PARAM;
 }
@@ -175,14 +212,15 @@ ATCA_STATUS hal_kit_hid_control(ATCAIface iface, uint8_t option, void* param, si
  */
 ATCA_STATUS hal_kit_hid_release(void* hal_data)
 {
-    hid_device* pHid = (hid_device*)hal_data;
+    atca_hid_host_t* hal = (atca_hid_host_t*)hal_data;
 
-    if (pHid == NULL)
+    if (hal == NULL)
     {
         return ATCA_BAD_PARAM;
     }
 
-    hid_close(pHid);
+    hid_close(hal->pHid);
+    free(hal);
 
     return ATCA_SUCCESS;
 }
@@ -33,8 +33,15 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <pthread.h>
+#if defined(__linux__)
+#include <sys/timerfd.h>
+#endif
 
 #include "atca_hal.h"
+#include "atca_platform.h"
 
 
 /** \defgroup hal_ Hardware abstraction layer (hal_)
@@ -44,13 +51,76 @@
  *
    @{ */
 
+#if ATCA_HAL_DEADLINE_EN
+#if ATCA_HAL_TIMER_SLACK_NS
+#include <sys/prctl.h>
+
+/** \brief Set once the timer slack of the calling thread has been applied */
+static __thread bool hal_timer_slack_set = false;
+#endif
+
+/** \brief Monotonic microsecond counter - the clock of hal_delay_until_us
+ * \return current timestamp in microseconds
+ */
+uint64_t hal_get_timestamp_us(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000U) + ((uint64_t)ts.tv_nsec / 1000U);
+}
+
+/** \brief Delay until an absolute deadline. Sleeping to a deadline rather than
+ *         for a duration keeps a late wakeup from pushing back the deadlines
+ *         that are derived from it.
+ *
+ * \param[in] deadline  hal_get_timestamp_us value to return at
+ */
+void hal_delay_until_us(uint64_t deadline)
+{
+    struct timespec ts;
+    uint64_t wake = deadline;
+
+#if ATCA_HAL_TIMER_SLACK_NS
+    if (!hal_timer_slack_set)
+    {
+        (void)prctl(PR_SET_TIMERSLACK, (unsigned long)ATCA_HAL_TIMER_SLACK_NS, 0UL, 0UL, 0UL);
+        hal_timer_slack_set = true;
+    }
+#endif
+
+#if ATCA_HAL_DELAY_SPIN_US
+    wake = (deadline > (uint64_t)ATCA_HAL_DELAY_SPIN_US) ? (deadline - (uint64_t)ATCA_HAL_DELAY_SPIN_US) : 0U;
+#endif
+
+    ts.tv_sec = (time_t)(wake / 1000000U);
+    ts.tv_nsec = (long)(wake % 1000000U) * 1000L;
+
+    /* Restarting after a signal keeps the same deadline */
+    while (EINTR == clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL))
+    {
+    }
+
+#if ATCA_HAL_DELAY_SPIN_US
+    while (hal_get_timestamp_us() < deadline)
+    {
+    }
+#endif
+}
+#endif
+
 /** \brief This function delays for a number of microseconds.
  *
  * \param[in] delay number of microseconds to delay
  */
 void hal_delay_us(uint32_t delay)
 {
+#if ATCA_HAL_DEADLINE_EN
+    hal_delay_until_us(hal_get_timestamp_us() + delay);
+#else
     (void)usleep(delay);
+#endif
 }
 
 /** \brief This function delays for a number of milliseconds.
@@ -70,6 +140,63 @@ void hal_delay_ms(uint32_t delay)
     }
 }
 
+/** \brief Monotonic millisecond counter. Only differences between two values
+ *         are meaningful and the counter wraps after ~49 days.
+ * \return current timestamp in milliseconds
+ */
+uint32_t hal_get_timestamp_ms(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint32_t)(((uint64_t)ts.tv_sec * 1000U) + ((uint64_t)ts.tv_nsec / 1000000U));
+}
+
+#if ATCA_HAL_TIMER_FD_EN && defined(__linux__)
+/** \brief Create a disarmed one shot timer descriptor
+ * \return non-negative descriptor on success, -1 on failure
+ */
+int hal_timer_fd_create(void)
+{
+    return timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+}
+
+/** \brief Arm the timer to expire (become readable) after msec milliseconds.
+ *         A delay of 0 makes the descriptor readable immediately.
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS hal_timer_fd_arm(int fd, uint32_t msec)
+{
+    struct itimerspec spec;
+
+    (void)memset(&spec, 0, sizeof(spec));
+    spec.it_value.tv_sec = (time_t)(msec / 1000U);
+    spec.it_value.tv_nsec = (long)(msec % 1000U) * 1000000L;
+    if (0U == msec)
+    {
+        /* An all zero value disarms the timer so expire as soon as possible instead */
+        spec.it_value.tv_nsec = 1;
+    }
+
+    return (0 == timerfd_settime(fd, 0, &spec, NULL)) ? ATCA_SUCCESS : ATCA_GEN_FAIL;
+}
+
+/** \brief Consume a pending expiration so the descriptor is no longer readable */
+void hal_timer_fd_clear(int fd)
+{
+    uint64_t expirations;
+
+    (void)read(fd, &expirations, sizeof(expirations));
+}
+
+/** \brief Close a timer descriptor */
+void hal_timer_fd_close(int fd)
+{
+    (void)close(fd);
+}
+#endif
+
 #ifndef ATCA_USE_RTOS_TIMER
 
 #ifdef ATCA_USE_SHARED_MUTEX
@@ -195,14 +322,32 @@ ATCA_STATUS hal_init_mutex(void * pMutex, bool shared)
 /**
  * \brief Application callback for creating a mutex object
  * \param[IN/OUT] ppMutex location to receive ptr to mutex
- * \param[IN/OUT] name String used to identify the mutex
+ * \param[IN/OUT] name String used to identify the mutex - NULL creates a
+ *                     mutex private to the process
  */
 ATCA_STATUS hal_create_mutex(void ** ppMutex, const char* pName)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
     bool created = false;
 
-    if ((NULL != ppMutex) && (NULL != pName))
+    if ((NULL != ppMutex) && (NULL == pName))
+    {
+        /* coverity[misra_c_2012_rule_21_3_violation] Required for the linux environment */
+        if (NULL != (*ppMutex = calloc(1, sizeof(hal_mutex_t))))
+        {
+            if (ATCA_SUCCESS != (status = hal_init_mutex(*ppMutex, false)))
+            {
+                /* coverity[misra_c_2012_rule_21_3_violation] Required for the linux environment */
+                free(*ppMutex);
+                *ppMutex = NULL;
+            }
+        }
+        else
+        {
+            status = ATCA_ALLOC_FAILURE;
+        }
+    }
+    else if (NULL != ppMutex)
     {
         if (ATCA_SUCCESS == (status = hal_alloc_shared(ppMutex, sizeof(hal_mutex_t), pName, &created)))
         {
@@ -292,18 +437,31 @@ ATCA_STATUS hal_unlock_mutex(void *pMutex)
 ATCA_STATUS hal_create_mutex(void ** ppMutex, const char* pName)
 {
     sem_t * sem;
+    char name[32];
 
-    if (ppMutex)
+    if (!ppMutex)
     {
         return ATCA_BAD_PARAM;
     }
 
     if (!pName)
     {
-        pName = "atca_mutex";
+        /* Named semaphores are the only kind available everywhere (macOS) so a
+           private one gets a unique name which is removed straight away */
+        static uint32_t private_count = 0;
+        (void)snprintf(name, sizeof(name), "/atca_mutex_%d_%u", (int)getpid(),
+                       (unsigned)__atomic_fetch_add(&private_count, 1U, __ATOMIC_RELAXED));
+        sem = sem_open(name, (O_CREAT | O_EXCL | O_RDWR), (S_IRUSR | S_IWUSR), 1);
+        if (SEM_FAILED != sem)
+        {
+            (void)sem_unlink(name);
+        }
+    }
+    else
+    {
+        sem = sem_open(pName, (O_CREAT | O_RDWR), (S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP), 1);
     }
 
-    sem = sem_open(pName, (O_CREAT | O_RDWR), (S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP), 0);
     if (SEM_FAILED == sem)
     {
         return ATCA_GEN_FAIL;
@@ -384,17 +542,194 @@ ATCA_STATUS hal_unlock_mutex(void *pMutex)
 }
 #endif
 
-/** \brief Check if the pid exists in the system
+/** \brief Thread object - carries the entry point through the pthread start routine */
+typedef struct
+{
+    pthread_t tid;
+    void (*   fn)(void* arg);
+    void*     arg;
+} hal_thread_t;
+
+/** \brief Counting semaphore built from a mutex and condition variable */
+typedef struct
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t  cond;
+    uint32_t        count;
+} hal_semaphore_t;
+
+static void* hal_thread_start(void* arg)
+{
+    hal_thread_t* thread = (hal_thread_t*)arg;
+
+    thread->fn(thread->arg);
+
+    return NULL;
+}
+
+/**
+ * \brief Application callback for starting a thread
+ * \param[in,out] ppThread location to receive ptr to the thread
+ * \param[in] fn Thread entry point
+ * \param[in] arg Argument passed to the entry point
  */
-ATCA_STATUS hal_check_pid(hal_pid_t pid)
+ATCA_STATUS hal_create_thread(void ** ppThread, void (*fn)(void* arg), void* arg)
 {
-    char buf[64];
-    struct stat sb;
+    hal_thread_t* thread;
 
-    /* coverity[misra_c_2012_rule_21_6_violation] snprintf is approved for formatted string writes to buffers */
-    (void)snprintf(buf, sizeof(buf) - 1U, "/proc/%d", pid);
+    if ((NULL == ppThread) || (NULL == fn))
+    {
+        return ATCA_BAD_PARAM;
+    }
 
-    return (0 == stat(buf, &sb)) ? 0 : -1;
+    if (NULL == (thread = (hal_thread_t*)hal_malloc(sizeof(hal_thread_t))))
+    {
+        return ATCA_ALLOC_FAILURE;
+    }
+
+    thread->fn = fn;
+    thread->arg = arg;
+
+    if (0 != pthread_create(&thread->tid, NULL, hal_thread_start, thread))
+    {
+        hal_free(thread);
+        return ATCA_GEN_FAIL;
+    }
+
+    *ppThread = thread;
+
+    return ATCA_SUCCESS;
+}
+
+/**
+ * \brief Application callback for waiting on a thread to exit and releasing it
+ * \param[in] pThread pointer to thread
+ */
+ATCA_STATUS hal_join_thread(void * pThread)
+{
+    hal_thread_t* thread = (hal_thread_t*)pThread;
+    ATCA_STATUS status;
+
+    if (NULL == thread)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    status = (0 != pthread_join(thread->tid, NULL)) ? ATCA_GEN_FAIL : ATCA_SUCCESS;
+    hal_free(thread);
+
+    return status;
+}
+
+/**
+ * \brief Application callback for creating a counting semaphore with a count of zero
+ * \param[in,out] ppSem location to receive ptr to the semaphore
+ */
+ATCA_STATUS hal_create_semaphore(void ** ppSem)
+{
+    hal_semaphore_t* sem;
+
+    if (NULL == ppSem)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    if (NULL == (sem = (hal_semaphore_t*)hal_malloc(sizeof(hal_semaphore_t))))
+    {
+        return ATCA_ALLOC_FAILURE;
+    }
+
+    sem->count = 0;
+    if (0 != pthread_mutex_init(&sem->mutex, NULL))
+    {
+        hal_free(sem);
+        return ATCA_GEN_FAIL;
+    }
+    if (0 != pthread_cond_init(&sem->cond, NULL))
+    {
+        (void)pthread_mutex_destroy(&sem->mutex);
+        hal_free(sem);
+        return ATCA_GEN_FAIL;
+    }
+
+    *ppSem = sem;
+
+    return ATCA_SUCCESS;
+}
+
+/**
+ * \brief Application callback for destroying a semaphore
+ * \param[in] pSem pointer to semaphore
+ */
+ATCA_STATUS hal_destroy_semaphore(void * pSem)
+{
+    hal_semaphore_t* sem = (hal_semaphore_t*)pSem;
+
+    if (NULL == sem)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    (void)pthread_cond_destroy(&sem->cond);
+    (void)pthread_mutex_destroy(&sem->mutex);
+    hal_free(sem);
+
+    return ATCA_SUCCESS;
+}
+
+/**
+ * \brief Application callback for incrementing a semaphore, waking a waiter
+ * \param[in] pSem pointer to semaphore
+ */
+ATCA_STATUS hal_post_semaphore(void * pSem)
+{
+    hal_semaphore_t* sem = (hal_semaphore_t*)pSem;
+
+    if (NULL == sem)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    (void)pthread_mutex_lock(&sem->mutex);
+    sem->count++;
+    (void)pthread_cond_signal(&sem->cond);
+    (void)pthread_mutex_unlock(&sem->mutex);
+
+    return ATCA_SUCCESS;
+}
+
+/**
+ * \brief Application callback for waiting until a semaphore can be decremented
+ * \param[in] pSem pointer to semaphore
+ */
+ATCA_STATUS hal_wait_semaphore(void * pSem)
+{
+    hal_semaphore_t* sem = (hal_semaphore_t*)pSem;
+
+    if (NULL == sem)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    (void)pthread_mutex_lock(&sem->mutex);
+    while (0u == sem->count)
+    {
+        (void)pthread_cond_wait(&sem->cond, &sem->mutex);
+    }
+    sem->count--;
+    (void)pthread_mutex_unlock(&sem->mutex);
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief Check if the pid exists in the system. A null signal is used rather
+ *         than looking in /proc which macOS does not have and which may not
+ *         match the caller's pid namespace
+ */
+ATCA_STATUS hal_check_pid(hal_pid_t pid)
+{
+    /* EPERM means the process exists but belongs to someone else */
+    return ((-1 == kill(pid, 0)) && (ESRCH == errno)) ? -1 : 0;
 }
 
 #endif
@@ -27,6 +27,7 @@
 
 #include <cryptoauthlib.h>
 
+#include <linux/i2c.h>
 #include <linux/i2c-dev.h>
 #include <unistd.h>
 #include <sys/ioctl.h>
@@ -49,12 +50,103 @@
  *
    @{ */
 
+/** \brief Packets up to this size (including the word address) are assembled
+ *         on the stack when the adapter can't concatenate messages
+ */
+#define HAL_I2C_TX_STACK_SIZE   (256u)
+
 typedef struct atca_i2c_host_s
 {
-    char i2c_file[16];
-    int  ref_ct;
+    char          i2c_file[16];
+    int           ref_ct;
+    int           fd;               /**< Bus file descriptor kept open between transfers, -1 when closed */
+    unsigned long funcs;            /**< Adapter functionality (I2C_FUNCS) */
+    int           slave_address;    /**< Address last set with I2C_SLAVE for adapters without I2C_RDWR, -1 if none */
 } atca_i2c_host_t;
 
+/** \brief Opens the bus on first use and keeps it open until it is released
+ *         or the adapter goes away
+ */
+static ATCA_STATUS hal_i2c_open(atca_i2c_host_t* hal_data)
+{
+    if (0 <= hal_data->fd)
+    {
+        return ATCA_SUCCESS;
+    }
+
+    /* coverity[cert_fio32_c_violation] It is the system owner's responsibility ensure configuration provides a valid i2c device */
+    if ((hal_data->fd = open(hal_data->i2c_file, O_RDWR)) < 0)
+    {
+        return ATCA_COMM_FAIL;
+    }
+
+    if (ioctl(hal_data->fd, I2C_FUNCS, &hal_data->funcs) < 0)
+    {
+        hal_data->funcs = 0;
+    }
+    hal_data->slave_address = -1;
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief Closes the bus so the next transfer reopens it (e.g. after a USB
+ *         adapter was reconnected)
+ */
+static void hal_i2c_close(atca_i2c_host_t* hal_data)
+{
+    if (0 <= hal_data->fd)
+    {
+        (void)close(hal_data->fd);
+        hal_data->fd = -1;
+    }
+}
+
+/** \brief Handles a failed transfer. NACKs (EREMOTEIO, ENXIO, EIO) are part of
+ *         normal operation - the wake pulse and completion polling - so the bus
+ *         is only closed when the adapter itself is gone or unusable
+ */
+static ATCA_STATUS hal_i2c_fail(atca_i2c_host_t* hal_data)
+{
+    int err = errno;
+
+    if ((ENODEV == err) || (EBADF == err) || (ENOTTY == err))
+    {
+        hal_i2c_close(hal_data);
+    }
+    return ATCA_COMM_FAIL;
+}
+
+/** \brief Runs messages as one combined transfer */
+static ATCA_STATUS hal_i2c_rdwr(atca_i2c_host_t* hal_data, struct i2c_msg* msgs, uint32_t count)
+{
+    struct i2c_rdwr_ioctl_data xfer;
+
+    xfer.msgs = msgs;
+    xfer.nmsgs = count;
+
+    errno = 0;
+    if (ioctl(hal_data->fd, I2C_RDWR, &xfer) != (int)count)
+    {
+        return hal_i2c_fail(hal_data);
+    }
+    return ATCA_SUCCESS;
+}
+
+/** \brief Selects the device for read()/write() on adapters without I2C_RDWR */
+static ATCA_STATUS hal_i2c_select(atca_i2c_host_t* hal_data, int address)
+{
+    if (hal_data->slave_address != address)
+    {
+        errno = 0;
+        if (ioctl(hal_data->fd, I2C_SLAVE, address) < 0)
+        {
+            return hal_i2c_fail(hal_data);
+        }
+        hal_data->slave_address = address;
+    }
+    return ATCA_SUCCESS;
+}
+
 /** \brief HAL implementation of I2C init
  *
  * this implementation assumes I2C peripheral has been enabled by user. It only initialize an
@@ -93,6 +185,9 @@ ATCA_STATUS hal_i2c_init(ATCAIface iface, ATCAIfaceCfg* cfg)
             int bus = (int)ATCA_IFACECFG_VALUE(cfg, atcai2c.bus); // 0-based logical bus number
 
             hal_data->ref_ct = 1;                                 // buses are shared, this is the first instance
+            hal_data->fd = -1;                                    // opened on the first transfer
+            hal_data->funcs = 0;
+            hal_data->slave_address = -1;
 
             /* coverity[misra_c_2012_rule_21_6_violation] snprintf is approved for formatted string writes to buffers */
             (void)snprintf(hal_data->i2c_file, sizeof(hal_data->i2c_file) - 1U, "/dev/i2c-%d", bus);
@@ -129,9 +224,11 @@ ATCA_STATUS hal_i2c_post_init(ATCAIface iface)
 ATCA_STATUS hal_i2c_send(ATCAIface iface, uint8_t word_address, uint8_t *txdata, int txlength)
 {
     atca_i2c_host_t * hal_data = (atca_i2c_host_t*)atgetifacehaldat(iface);
-    int f_i2c;  // I2C file descriptor
     uint8_t device_address = 0xFFu;
-    uint8_t* temp_buf = NULL;
+    uint8_t stack_buf[HAL_I2C_TX_STACK_SIZE];
+    uint8_t* temp_buf = stack_buf;
+    struct i2c_msg msgs[2];
+    ATCA_STATUS status;
 
     if (NULL == hal_data)
     {
@@ -144,51 +241,68 @@ ATCA_STATUS hal_i2c_send(ATCAIface iface, uint8_t word_address, uint8_t *txdata,
     device_address = ATCA_IFACECFG_VALUE(iface->mIfaceCFG, atcai2c.address);
 #endif
 
-    //! Add 1 byte for word address
-    if (INT_MAX > txlength)
+    if ((NULL == txdata) || (0 > txlength))
+    {
+        txlength = 0;
+    }
+    if (txlength >= (int)UINT16_MAX)
     {
-        txlength += 1;
+        return ATCA_BAD_PARAM;
     }
 
-    if (NULL == (temp_buf = hal_malloc((size_t)txlength)))
+    if (ATCA_SUCCESS != (status = hal_i2c_open(hal_data)))
     {
-        return ATCA_ALLOC_FAILURE;
+        return status;
     }
 
-    temp_buf[0] = word_address;
-    if ((NULL != txdata) && (1 < txlength))
+    msgs[0].addr = (uint16_t)(device_address >> 1);
+    msgs[0].flags = 0;
+    msgs[0].len = 1;
+    msgs[0].buf = &word_address;
+
+    if ((0 < txlength) && (0u != (hal_data->funcs & I2C_FUNC_I2C)) && (0u != (hal_data->funcs & I2C_FUNC_NOSTART)))
     {
-        /* coverity[misra_c_2012_rule_10_8_violation] */
-        (void)memcpy(&temp_buf[1], txdata, (size_t)(txlength - 1));
+        // Word address and payload go out as one write without copying
+        msgs[1].addr = msgs[0].addr;
+        msgs[1].flags = I2C_M_NOSTART;
+        msgs[1].len = (uint16_t)txlength;
+        msgs[1].buf = txdata;
+        return hal_i2c_rdwr(hal_data, msgs, 2u);
     }
 
-    // Initiate I2C communication
-    /* coverity[cert_fio32_c_violation] It is the system owner's responsibility ensure configuration provides a valid i2c device */
-    if ((f_i2c = open(hal_data->i2c_file, O_RDWR)) < 0)
+    if (0 < txlength)
     {
-        hal_free(temp_buf);
-        return ATCA_COMM_FAIL;
+        if ((size_t)txlength + 1u > sizeof(stack_buf))
+        {
+            if (NULL == (temp_buf = hal_malloc((size_t)txlength + 1u)))
+            {
+                return ATCA_ALLOC_FAILURE;
+            }
+        }
+        temp_buf[0] = word_address;
+        (void)memcpy(&temp_buf[1], txdata, (size_t)txlength);
+        msgs[0].len = (uint16_t)(txlength + 1);
+        msgs[0].buf = temp_buf;
     }
 
-    // Set Device Address
-    if (ioctl(f_i2c, I2C_SLAVE, device_address >> 1) < 0)
+    if (0u != (hal_data->funcs & I2C_FUNC_I2C))
     {
-        hal_free(temp_buf);
-        (void)close(f_i2c);
-        return ATCA_COMM_FAIL;
+        status = hal_i2c_rdwr(hal_data, msgs, 1u);
+    }
+    else if (ATCA_SUCCESS == (status = hal_i2c_select(hal_data, (int)msgs[0].addr)))
+    {
+        errno = 0;
+        if (write(hal_data->fd, msgs[0].buf, (size_t)msgs[0].len) != (ssize_t)msgs[0].len)
+        {
+            status = hal_i2c_fail(hal_data);
+        }
     }
 
-    // Send data
-    if (write(f_i2c, temp_buf, (size_t)txlength) != txlength)
+    if (temp_buf != stack_buf)
     {
         hal_free(temp_buf);
-        (void)close(f_i2c);
-        return ATCA_COMM_FAIL;
     }
-
-    hal_free(temp_buf);
-    (void)close(f_i2c);
-    return ATCA_SUCCESS;
+    return status;
 }
 
 /** \brief HAL implementation of I2C receive function
@@ -202,38 +316,42 @@ ATCA_STATUS hal_i2c_send(ATCAIface iface, uint8_t word_address, uint8_t *txdata,
 ATCA_STATUS hal_i2c_receive(ATCAIface iface, uint8_t word_address, uint8_t *rxdata, uint16_t *rxlength)
 {
     atca_i2c_host_t * hal_data = (atca_i2c_host_t*)atgetifacehaldat(iface);
-    int f_i2c;  // I2C file descriptor
+    struct i2c_msg msg;
+    ATCA_STATUS status;
 
     if (NULL == hal_data)
     {
         return ATCA_NOT_INITIALIZED;
     }
 
-    // Initiate I2C communication
-    /* coverity[cert_fio32_c_violation] It is the system owner's responsibility ensure configuration provides a valid i2c device */
-    if ((f_i2c = open(hal_data->i2c_file, O_RDWR)) < 0)
+    if (ATCA_SUCCESS != (status = hal_i2c_open(hal_data)))
     {
-        return ATCA_COMM_FAIL;
+        return status;
     }
 
-    // Set Device Address
-    if (ioctl(f_i2c, I2C_SLAVE, word_address >> 1) < 0)
+    if ((NULL == rxdata) || (NULL == rxlength) || (0u == *rxlength))
     {
-        (void)close(f_i2c);
-        return ATCA_COMM_FAIL;
+        return ATCA_SUCCESS;
     }
 
-    if ((NULL != rxdata) && (NULL != rxlength))
+    if (0u != (hal_data->funcs & I2C_FUNC_I2C))
+    {
+        msg.addr = (uint16_t)(word_address >> 1);
+        msg.flags = I2C_M_RD;
+        msg.len = *rxlength;
+        msg.buf = rxdata;
+        status = hal_i2c_rdwr(hal_data, &msg, 1u);
+    }
+    else if (ATCA_SUCCESS == (status = hal_i2c_select(hal_data, (int)(word_address >> 1))))
     {
-        if (read(f_i2c, rxdata, (size_t)*rxlength) != (int)*rxlength)
+        errno = 0;
+        if (read(hal_data->fd, rxdata, (size_t)*rxlength) != (ssize_t)*rxlength)
         {
-            (void)close(f_i2c);
-            return ATCA_COMM_FAIL;
+            status = hal_i2c_fail(hal_data);
         }
     }
 
-    (void)close(f_i2c);
-    return ATCA_SUCCESS;
+    return status;
 }
 
 /** \brief Perform control operations for the kit protocol
@@ -275,6 +393,7 @@ ATCA_STATUS hal_i2c_release(void *hal_data)
 
         if (0 == hal->ref_ct)
         {
+            hal_i2c_close(hal);
             /* coverity[misra_c_2012_rule_21_3_violation] Intentional as it is required for the linux environment */
             free(hal);
         }
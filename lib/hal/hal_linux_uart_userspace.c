@@ -28,6 +28,7 @@
 #include "cryptoauthlib.h"
 #include "atca_hal.h"
 
+#include <errno.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <sys/ioctl.h>
@@ -35,9 +36,10 @@
 
 typedef struct atca_uart_host_s
 {
-    char uart_file[20];
-    int  fd_uart;
-    int  ref_ct;
+    char    uart_file[20];
+    int     fd_uart;
+    int     ref_ct;
+    uint8_t kit_framing;    /**< Framing negotiated by the kit protocol */
 } atca_uart_host_t;
 
 #ifdef __COVERITY__
@@ -168,10 +170,14 @@ static ATCA_STATUS hal_uart_open_file(atca_uart_host_t * hal_data, ATCAIfaceCfg
             /* No flow control */
             tty.c_iflag &= ~(IXON | IXOFF | IXANY);
 
+            /* No input translation so binary kit frames pass unchanged */
+            tty.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL);
+
             /* No output translation */
             tty.c_oflag &= ~OPOST;
 
-            /* Enable read timeout */
+            /* Reads return as soon as any data has arrived, or after the timeout */
+            tty.c_cc[VMIN] = 0;
             tty.c_cc[VTIME] = 5;
 
             /* Convert baudrate to posix/linux format */
@@ -219,8 +225,9 @@ static ATCA_STATUS hal_uart_open_file(atca_uart_host_t * hal_data, ATCAIfaceCfg
                 return ATCA_COMM_FAIL;
             }
 
+            /* Ports without modem control lines (e.g. a pty) can't assert DTR */
             flags = TIOCM_DTR;
-            if (-1 == ioctl(hal_data->fd_uart, TIOCMBIS, &flags))
+            if ((-1 == ioctl(hal_data->fd_uart, TIOCMBIS, &flags)) && (ENOTTY != errno))
             {
                 (void)close(hal_data->fd_uart);
                 return ATCA_COMM_FAIL;
@@ -380,7 +387,8 @@ ATCA_STATUS hal_uart_send(ATCAIface iface, uint8_t word_address, uint8_t *txdata
  * \param[in]      word_address   device transaction type
  * \param[out]     rxdata         Data received will be returned here.
  * \param[in,out]  rxlength       As input, the size of the rxdata buffer.
- *                                As output, the number of bytes received.
+ *                                As output, the number of bytes received which
+ *                                may be fewer than requested.
  * \return ATCA_SUCCESS on success, otherwise an error code.
  */
 ATCA_STATUS hal_uart_receive(ATCAIface iface, uint8_t word_address, uint8_t *rxdata, uint16_t *rxlength)
@@ -394,17 +402,15 @@ ATCA_STATUS hal_uart_receive(ATCAIface iface, uint8_t word_address, uint8_t *rxd
 
         if ((NULL != hal_data) && (0 < hal_data->fd_uart))
         {
-            if (1U < *rxlength)
-            {
-                *rxlength = 1U; // packetsize to read
-            }
+            ssize_t bytes_read = read(hal_data->fd_uart, rxdata, (size_t)*rxlength);
 
-            if (read(hal_data->fd_uart, rxdata, (size_t)*rxlength) !=  (int)*rxlength)
+            if (0 >= bytes_read)
             {
                 status = ATCA_COMM_FAIL;
             }
             else
             {
+                *rxlength = (uint16_t)bytes_read;
                 status = ATCA_SUCCESS;
             }
 
@@ -419,6 +425,27 @@ ATCA_STATUS hal_uart_receive(ATCAIface iface, uint8_t word_address, uint8_t *rxd
     return status;
 }
 
+/** \brief Record or report the kit protocol framing of the port */
+static ATCA_STATUS hal_uart_kit_framing(ATCAIface iface, uint8_t option, void* param, size_t paramlen)
+{
+    atca_uart_host_t * hal_data = (atca_uart_host_t*)atgetifacehaldat(iface);
+
+    if ((NULL == hal_data) || (NULL == param) || (sizeof(uint8_t) != paramlen))
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    if (ATCA_HAL_SET_KIT_FRAMING == option)
+    {
+        hal_data->kit_framing = *(uint8_t*)param;
+    }
+    else
+    {
+        *(uint8_t*)param = hal_data->kit_framing;
+    }
+    return ATCA_SUCCESS;
+}
+
 /** \brief Perform control operations for the UART
  * \param[in]     iface          Interface to interact with.
  * \param[in]     option         Control parameter identifier
@@ -449,6 +476,11 @@ ATCA_STATUS hal_uart_control(ATCAIface iface, uint8_t option, void* param, size_
         case ATCA_HAL_CONTROL_DESELECT:
             status = ATCA_SUCCESS;
             break;
+        case ATCA_HAL_SET_KIT_FRAMING:
+        /* fallthrough */
+        case ATCA_HAL_GET_KIT_FRAMING:
+            status = hal_uart_kit_framing(iface, option, param, paramlen);
+            break;
         default:
             status = ATCA_UNIMPLEMENTED;
             break;
@@ -97,7 +97,68 @@ static ATCA_STATUS hal_swi_uart_send_bit(ATCAIface iface, uint8_t data)
     return status;
 }
 
+/** \brief UART bytes which make up the SWI bits of each nibble, LSB first.
+ *         0x7F signals a one and 0x7D a zero */
+static const uint8_t hal_swi_uart_symbols[16][4] = {
+    { 0x7DU, 0x7DU, 0x7DU, 0x7DU }, { 0x7FU, 0x7DU, 0x7DU, 0x7DU }, { 0x7DU, 0x7FU, 0x7DU, 0x7DU }, { 0x7FU, 0x7FU, 0x7DU, 0x7DU },
+    { 0x7DU, 0x7DU, 0x7FU, 0x7DU }, { 0x7FU, 0x7DU, 0x7FU, 0x7DU }, { 0x7DU, 0x7FU, 0x7FU, 0x7DU }, { 0x7FU, 0x7FU, 0x7FU, 0x7DU },
+    { 0x7DU, 0x7DU, 0x7DU, 0x7FU }, { 0x7FU, 0x7DU, 0x7DU, 0x7FU }, { 0x7DU, 0x7FU, 0x7DU, 0x7FU }, { 0x7FU, 0x7FU, 0x7DU, 0x7FU },
+    { 0x7DU, 0x7DU, 0x7FU, 0x7FU }, { 0x7FU, 0x7DU, 0x7FU, 0x7FU }, { 0x7DU, 0x7FU, 0x7FU, 0x7FU }, { 0x7FU, 0x7FU, 0x7FU, 0x7FU }
+};
+
+/**
+ * \brief Expand bytes into the UART bytes representing their SWI bits
+ * \param[in]  data     bytes to expand
+ * \param[in]  length   number of bytes
+ * \param[out] symbols  receives length * 8 bytes
+ */
+static void hal_swi_uart_expand(const uint8_t *data, size_t length, uint8_t *symbols)
+{
+    size_t i;
+
+    for (i = 0; i < length; i++)
+    {
+        (void)memcpy(&symbols[i * 8u], hal_swi_uart_symbols[data[i] & 0x0FU], 4);
+        (void)memcpy(&symbols[i * 8u + 4u], hal_swi_uart_symbols[data[i] >> 4U], 4);
+    }
+}
+
+/**
+ * \brief Read a number of bit bytes from the uart, the phy may return fewer
+ *        bytes than requested on each call.
+ * \param[in]  iface    instance
+ * \param[out] symbols  bytes received
+ * \param[in]  count    number of bytes to receive
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+static ATCA_STATUS hal_swi_uart_receive_bits(ATCAIface iface, uint8_t *symbols, size_t count)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    size_t offset = 0;
+
+    while ((ATCA_SUCCESS == status) && (offset < count))
+    {
+        uint16_t rxlen = (uint16_t)(count - offset);
+
+        if (ATCA_SUCCESS == (status = iface->phy->halreceive(iface, 0, &symbols[offset], &rxlen)))
+        {
+            if (0U == rxlen)
+            {
+                status = ATCA_TRACE(ATCA_RX_NO_RESPONSE, "No bits received");
+            }
+            offset += rxlen;
+        }
+    }
+
+    return status;
+}
+
 /** \brief HAL implementation of SWI send command over UART
+ *
+ * The word address and data are expanded to one UART byte per bit and written
+ * up to ATCA_SWI_UART_CHUNK_SIZE bytes at a time. Since Tx and Rx share the
+ * wire each chunk is then read back as one stream and compared to what was sent.
+ *
  * \param[in] iface         instance
  * \param[in] word_address  device transaction type
  * \param[in] txdata        pointer to space to bytes to send
@@ -107,43 +168,56 @@ static ATCA_STATUS hal_swi_uart_send_bit(ATCAIface iface, uint8_t data)
 
 ATCA_STATUS hal_swi_send(ATCAIface iface, uint8_t word_address, uint8_t *txdata, int txlength)
 {
-    ATCA_STATUS status = ATCA_SUCCESS;
-    uint8_t bit_mask, bit_data;
-    int i;
+    uint8_t symbols[ATCA_SWI_UART_CHUNK_SIZE * 8u];
+    uint8_t chunk[ATCA_SWI_UART_CHUNK_SIZE];
+    size_t total = 1;
+    size_t sent = 0;
+    size_t length;
+    size_t i;
+
+    if ((NULL != txdata) && (0 < txlength))
+    {
+        total += (size_t)txlength;
+    }
 
     (void)iface->phy->halcontrol(iface, ATCA_HAL_FLUSH_BUFFER, NULL, 0);
 
-    //!Send word address
-    for (bit_mask = 1U; bit_mask > 0U; bit_mask <<= 1U)
+    while (sent < total)
     {
-        // Send one byte that represent one bit, 0x7F for one or 0x7D for zero
-        // The LSB (least significant bit) is sent first.
-        bit_data = ((bit_mask & word_address) != 0U) ? 0x7FU : 0x7DU;
-        status = hal_swi_uart_send_bit(iface, bit_data);
-        if (status != ATCA_SUCCESS)
+        // The word address leads the first chunk
+        length = 0;
+        if (0u == sent)
+        {
+            chunk[length++] = word_address;
+        }
+        while ((length < ATCA_SWI_UART_CHUNK_SIZE) && ((sent + length) < total))
+        {
+            chunk[length] = txdata[sent + length - 1u];
+            length++;
+        }
+
+        hal_swi_uart_expand(chunk, length, symbols);
+        if (ATCA_SUCCESS != iface->phy->halsend(iface, 0xFF, symbols, (int)(length * 8u)))
         {
             return ATCA_COMM_FAIL;
         }
-    }
 
-    if((NULL != txdata) && (0 < txlength))
-    {
-        //!Send data
-        for (i = 0; i < txlength; i++)
+        // Nothing to process... Reading the echo to ensure the write is complete
+        if (ATCA_SUCCESS != hal_swi_uart_receive_bits(iface, symbols, length * 8u))
+        {
+            return ATCA_COMM_FAIL;
+        }
+        for (i = 0; i < length; i++)
         {
-            for (bit_mask = 1U; bit_mask > 0U; bit_mask <<= 1U)
+            if ((0 != memcmp(&symbols[i * 8u], hal_swi_uart_symbols[chunk[i] & 0x0FU], 4)) ||
+                (0 != memcmp(&symbols[i * 8u + 4u], hal_swi_uart_symbols[chunk[i] >> 4U], 4)))
             {
-                // Send one byte that represent one bit, 0x7F for one or 0x7D for zero
-                // The LSB (least significant bit) is sent first.
-                bit_data = ((bit_mask & *txdata) != 0U) ? 0x7FU : 0x7DU;
-                status = hal_swi_uart_send_bit(iface, bit_data);
-                if (status != ATCA_SUCCESS)
-                {
+                (void)ATCA_TRACE(ATCA_TX_FAIL, "Tx send failed");
                 return ATCA_COMM_FAIL;
-                }
             }
-            txdata++;
         }
+
+        sent += length;
     }
 
     return ATCA_SUCCESS;
@@ -160,8 +234,12 @@ ATCA_STATUS hal_swi_send(ATCAIface iface, uint8_t word_address, uint8_t *txdata,
 ATCA_STATUS hal_swi_receive(ATCAIface iface, uint8_t word_address, uint8_t *rxdata, uint16_t *rxlength)
 {
     ATCAIfaceCfg *cfg = atgetifacecfg(iface);
-    ATCA_STATUS status = ATCA_COMM_FAIL;
-    uint8_t bit_mask, bit_data = 0;
+    ATCA_STATUS status = ATCA_SUCCESS;
+    uint8_t symbols[ATCA_SWI_UART_CHUNK_SIZE * 8u];
+    size_t received = 0;
+    size_t length;
+    size_t i;
+    uint8_t bit;
 
     if ((cfg == NULL) || (rxlength == NULL) || (rxdata == NULL) || (*rxlength < 1u))
     {
@@ -170,22 +248,30 @@ ATCA_STATUS hal_swi_receive(ATCAIface iface, uint8_t word_address, uint8_t *rxda
 
     (void)word_address;
 
-    for (unsigned int i = 0u; i < *rxlength; i++)
+    while ((ATCA_SUCCESS == status) && (received < *rxlength))
     {
-        for (bit_mask = 1u; bit_mask > 0u; bit_mask <<= 1)
+        length = (size_t)*rxlength - received;
+        if (length > ATCA_SWI_UART_CHUNK_SIZE)
         {
-            bit_data = 0u;
-            status = hal_swi_uart_receive_bit(iface, &bit_data);
-            if (status != ATCA_SUCCESS)
-            {
-                break;
-            }
-            if ((bit_data ^ 0x7Fu) < 2u)
+            length = ATCA_SWI_UART_CHUNK_SIZE;
+        }
+
+        if (ATCA_SUCCESS == (status = hal_swi_uart_receive_bits(iface, symbols, length * 8u)))
+        {
+            // A one is sampled as 0x7F or 0x7E, the LSB arrives first
+            for (i = 0; i < length; i++)
             {
-                *rxdata |= bit_mask;
+                rxdata[received + i] = 0u;
+                for (bit = 0u; bit < 8u; bit++)
+                {
+                    if ((symbols[i * 8u + bit] ^ 0x7Fu) < 2u)
+                    {
+                        rxdata[received + i] |= (uint8_t)(1u << bit);
+                    }
+                }
             }
+            received += length;
         }
-        rxdata++;
     }
 
     return status;
@@ -171,12 +171,15 @@ ATCA_STATUS hal_uart_receive(ATCAIface iface, uint8_t word_address, uint8_t *rxd
     ATCAIfaceCfg *cfg = atgetifacecfg(iface);
     atca_plib_uart_api_t* plib;
     ATCA_STATUS status = ATCA_BAD_PARAM;
-    int16_t timeout = 300;
+    int32_t timeout;
 
     if (cfg && cfg->cfg_data && rxdata && rxlength)
     {
         plib = (atca_plib_uart_api_t*)cfg->cfg_data;
 
+        // Allow for a byte time per requested byte at 115200 baud
+        timeout = 300 + (100 * (int32_t)*rxlength);
+
         while ((plib->readcount_get() < *rxlength) && (timeout > 0))
         {
             atca_delay_us(25);
@@ -26,6 +26,7 @@
  */
 
 #include "atca_hal.h"
+#include "atca_platform.h"
 #include <windows.h>
 #include <math.h>
 
@@ -67,6 +68,15 @@ void hal_delay_ms(uint32_t delay)
     Sleep(delay);
 }
 
+/** \brief Monotonic millisecond counter. Only differences between two values
+ *         are meaningful and the counter wraps after ~49 days.
+ * \return current timestamp in milliseconds
+ */
+uint32_t hal_get_timestamp_ms(void)
+{
+    return (uint32_t)GetTickCount();
+}
+
 #ifndef ATCA_USE_RTOS_TIMER
 /**
  * \brief Application callback for creating a mutex object
@@ -162,11 +172,170 @@ ATCA_STATUS hal_unlock_mutex(void* pMutex)
     return rv;
 }
 
+/** \brief Thread object - carries the entry point through the Win32 start routine */
+typedef struct
+{
+    HANDLE handle;
+    void (* fn)(void* arg);
+    void*  arg;
+} hal_thread_t;
+
+static DWORD WINAPI hal_thread_start(LPVOID arg)
+{
+    hal_thread_t* thread = (hal_thread_t*)arg;
+
+    thread->fn(thread->arg);
+
+    return 0;
+}
+
+/**
+ * \brief Application callback for starting a thread
+ * \param[IN/OUT] ppThread location to receive ptr to the thread
+ * \param[IN] fn Thread entry point
+ * \param[IN] arg Argument passed to the entry point
+ */
+ATCA_STATUS hal_create_thread(void** ppThread, void (*fn)(void* arg), void* arg)
+{
+    hal_thread_t* thread;
+
+    if ((NULL == ppThread) || (NULL == fn))
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    if (NULL == (thread = (hal_thread_t*)hal_malloc(sizeof(hal_thread_t))))
+    {
+        return ATCA_ALLOC_FAILURE;
+    }
+
+    thread->fn = fn;
+    thread->arg = arg;
+    thread->handle = CreateThread(NULL, 0, hal_thread_start, thread, 0, NULL);
+
+    if (NULL == thread->handle)
+    {
+        hal_free(thread);
+        return ATCA_GEN_FAIL;
+    }
+
+    *ppThread = thread;
+
+    return ATCA_SUCCESS;
+}
+
+/**
+ * \brief Application callback for waiting on a thread to exit and releasing it
+ * \param[IN] pThread pointer to thread
+ */
+ATCA_STATUS hal_join_thread(void* pThread)
+{
+    hal_thread_t* thread = (hal_thread_t*)pThread;
+    ATCA_STATUS status = ATCA_SUCCESS;
+
+    if (NULL == thread)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    /* coverity[misra_c_2012_rule_10_4_violation:SUPPRESS] Win32 API */
+    if (WAIT_OBJECT_0 != WaitForSingleObject(thread->handle, INFINITE))
+    {
+        status = ATCA_GEN_FAIL;
+    }
+    (void)CloseHandle(thread->handle);
+    hal_free(thread);
+
+    return status;
+}
+
+/**
+ * \brief Application callback for creating a counting semaphore with a count of zero
+ * \param[IN/OUT] ppSem location to receive ptr to the semaphore
+ */
+ATCA_STATUS hal_create_semaphore(void** ppSem)
+{
+    if (NULL == ppSem)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    *ppSem = CreateSemaphore(NULL, 0, LONG_MAX, NULL);
+
+    return (NULL == *ppSem) ? ATCA_GEN_FAIL : ATCA_SUCCESS;
+}
+
+/**
+ * \brief Application callback for destroying a semaphore
+ * \param[IN] pSem pointer to semaphore
+ */
+ATCA_STATUS hal_destroy_semaphore(void* pSem)
+{
+    if (NULL == pSem)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    (void)CloseHandle(pSem);
+
+    return ATCA_SUCCESS;
+}
+
+/**
+ * \brief Application callback for incrementing a semaphore, waking a waiter
+ * \param[IN] pSem pointer to semaphore
+ */
+ATCA_STATUS hal_post_semaphore(void* pSem)
+{
+    if (NULL == pSem)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    return ReleaseSemaphore((HANDLE)pSem, 1, NULL) ? ATCA_SUCCESS : ATCA_GEN_FAIL;
+}
+
+/**
+ * \brief Application callback for waiting until a semaphore can be decremented
+ * \param[IN] pSem pointer to semaphore
+ */
+ATCA_STATUS hal_wait_semaphore(void* pSem)
+{
+    if (NULL == pSem)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    /* coverity[misra_c_2012_rule_10_4_violation:SUPPRESS] Win32 API */
+    return (WAIT_OBJECT_0 == WaitForSingleObject((HANDLE)pSem, INFINITE)) ? ATCA_SUCCESS : ATCA_GEN_FAIL;
+}
+
 /** \brief Check if the pid exists in the system
  */
 ATCA_STATUS hal_check_pid(hal_pid_t pid)
 {
-    return ATCA_UNIMPLEMENTED;
+    ATCA_STATUS status = ATCA_SUCCESS;
+    HANDLE hProcess = OpenProcess(SYNCHRONIZE, FALSE, pid);
+
+    if (NULL == hProcess)
+    {
+        /* Access can be denied to a process that exists */
+        if (ERROR_INVALID_PARAMETER == GetLastError())
+        {
+            status = ATCA_GEN_FAIL;
+        }
+    }
+    else
+    {
+        /* The handle of a terminated process is signaled */
+        if (WAIT_OBJECT_0 == WaitForSingleObject(hProcess, 0))
+        {
+            status = ATCA_GEN_FAIL;
+        }
+        (void)CloseHandle(hProcess);
+    }
+
+    return status;
 }
 
 #endif
@@ -36,9 +36,10 @@
 
 typedef struct atca_uart_host_s
 {
-    char   uart_file[20];
-    HANDLE hSerial;
-    int    ref_ct;
+    char    uart_file[20];
+    HANDLE  hSerial;
+    int     ref_ct;
+    uint8_t kit_framing;    /**< Framing negotiated by the kit protocol */
 } atca_uart_host_t;
 
 /** \brief Open and configure serial COM Uart
@@ -113,9 +114,10 @@ static ATCA_STATUS hal_uart_open_file(ATCAIface iface)
             return ATCA_COMM_FAIL;
         }
 
-        timeouts.ReadIntervalTimeout = 50;
-        timeouts.ReadTotalTimeoutConstant = 50;
-        timeouts.ReadTotalTimeoutMultiplier = 10;
+        /* Reads return as soon as any data has arrived, or after the timeout */
+        timeouts.ReadIntervalTimeout = MAXDWORD;
+        timeouts.ReadTotalTimeoutConstant = 60;
+        timeouts.ReadTotalTimeoutMultiplier = MAXDWORD;
         timeouts.WriteTotalTimeoutConstant = 50;
         timeouts.WriteTotalTimeoutMultiplier = 10;
 
@@ -258,7 +260,8 @@ ATCA_STATUS hal_uart_send(ATCAIface iface, uint8_t word_address, uint8_t *txdata
  * \param[in]      word_address   device transaction type
  * \param[out]     rxdata         Data received will be returned here.
  * \param[in,out]  rxlength       As input, the size of the rxdata buffer.
- *                                As output, the number of bytes received.
+ *                                As output, the number of bytes received which
+ *                                may be fewer than requested.
  * \return ATCA_SUCCESS on success, otherwise an error code.
  */
 ATCA_STATUS hal_uart_receive(ATCAIface iface, uint8_t word_address, uint8_t *rxdata, uint16_t *rxlength)
@@ -275,11 +278,6 @@ ATCA_STATUS hal_uart_receive(ATCAIface iface, uint8_t word_address, uint8_t *rxd
         /* coverity[cert_int36_c_violation:SUPPRESS] Win32 API */
         if ((NULL != hal_data) && (INVALID_HANDLE_VALUE != hal_data->hSerial))
         {
-            if (*rxlength > 1U)
-            {
-                *rxlength = 1U; // packetsize to read
-            }
-
             if (!ReadFile(hal_data->hSerial, rxdata, *rxlength, &bytes_read, NULL))
             {
                 status = ATCA_COMM_FAIL;
@@ -324,14 +322,29 @@ ATCA_STATUS hal_uart_receive(ATCAIface iface, uint8_t word_address, uint8_t *rxd
  */
 ATCA_STATUS hal_uart_control(ATCAIface iface, uint8_t option, void* param, size_t paramlen)
 {
-    (void)option;
-    (void)param;
-    (void)paramlen;
+    atca_uart_host_t* hal_data;
 
     if ((NULL != iface) && (NULL != iface->mIfaceCFG))
     {
-        /* This HAL does not support any of the control functions */
-        return ATCA_UNIMPLEMENTED;
+        if ((ATCA_HAL_SET_KIT_FRAMING != option) && (ATCA_HAL_GET_KIT_FRAMING != option))
+        {
+            /* The kit framing is the only control function this HAL supports */
+            return ATCA_UNIMPLEMENTED;
+        }
+
+        hal_data = (atca_uart_host_t*)atgetifacehaldat(iface);
+        if ((NULL != hal_data) && (NULL != param) && (sizeof(uint8_t) == paramlen))
+        {
+            if (ATCA_HAL_SET_KIT_FRAMING == option)
+            {
+                hal_data->kit_framing = *(uint8_t*)param;
+            }
+            else
+            {
+                *(uint8_t*)param = hal_data->kit_framing;
+            }
+            return ATCA_SUCCESS;
+        }
     }
     return ATCA_BAD_PARAM;
 }
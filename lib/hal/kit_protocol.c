@@ -178,8 +178,130 @@ const char* kit_interface(ATCAKitType kittype)
     return interface_type;
 }
 
+/** \brief Wrap bytes in a binary kit frame
+ * \param[in]     code   Frame code (command to the kit or status from the kit)
+ * \param[in]     data   Bytes to carry in the frame
+ * \param[in]     dlen   Number of bytes to carry
+ * \param[out]    frame  Frame is returned here
+ * \param[in,out] flen   As input, the size of the frame buffer.
+ *                       As output, the number of bytes in the frame.
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS kit_wrap_frame(uint8_t code, const uint8_t* data, size_t dlen, uint8_t* frame, size_t* flen)
+{
+    if ((NULL == frame) || (NULL == flen) || ((NULL == data) && (0u < dlen)) || (UINT16_MAX < dlen))
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    if (*flen < (dlen + KIT_FRAME_OVERHEAD))
+    {
+        return ATCA_SMALL_BUFFER;
+    }
+
+    frame[0] = KIT_FRAME_SYNC;
+    frame[1] = (uint8_t)(dlen & 0xFFu);
+    frame[2] = (uint8_t)((dlen >> 8) & 0xFFu);
+    frame[3] = code;
+    if (0u < dlen)
+    {
+        (void)memmove(&frame[KIT_FRAME_HEADER_SIZE], data, dlen);
+    }
+    atCRC(dlen + KIT_FRAME_HEADER_SIZE - 1u, &frame[1], &frame[dlen + KIT_FRAME_HEADER_SIZE]);
+
+    *flen = dlen + KIT_FRAME_OVERHEAD;
+    return ATCA_SUCCESS;
+}
+
+/** \brief Total size of a binary kit frame from its first bytes
+ * \param[in] header  At least the first three bytes of the frame
+ * \return Size of the frame including header and crc
+ */
+size_t kit_frame_size(const uint8_t* header)
+{
+    return (size_t)header[1] + ((size_t)header[2] << 8) + KIT_FRAME_OVERHEAD;
+}
+
+/** \brief Locate the contents of a binary kit frame, optionally checking its
+ *         crc (the receive loop folds the crc in as the bytes arrive)
+ */
+static ATCA_STATUS kit_unwrap_frame(const uint8_t* frame, size_t flen, bool check_crc, uint8_t* code, const uint8_t** data, size_t* dlen)
+{
+    uint8_t crc[KIT_FRAME_CRC_SIZE];
+    size_t size;
+
+    if ((NULL == frame) || (NULL == code) || (NULL == data) || (NULL == dlen))
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    if ((KIT_FRAME_OVERHEAD > flen) || (KIT_FRAME_SYNC != frame[0]))
+    {
+        return ATCA_RX_FAIL;
+    }
+
+    if (flen < (size = kit_frame_size(frame)))
+    {
+        return ATCA_RX_FAIL;
+    }
+
+    if (check_crc)
+    {
+        atCRC(size - KIT_FRAME_CRC_SIZE - 1u, &frame[1], crc);
+        if (0 != memcmp(crc, &frame[size - KIT_FRAME_CRC_SIZE], sizeof(crc)))
+        {
+            return ATCA_RX_CRC_ERROR;
+        }
+    }
+
+    *code = frame[3];
+    *data = &frame[KIT_FRAME_HEADER_SIZE];
+    *dlen = size - KIT_FRAME_OVERHEAD;
+    return ATCA_SUCCESS;
+}
+
+/** \brief Check a binary kit frame and locate its contents
+ * \param[in]  frame  Received frame
+ * \param[in]  flen   Number of bytes received
+ * \param[out] code   Frame code is returned here
+ * \param[out] data   Points to the data in the frame
+ * \param[out] dlen   Number of data bytes in the frame
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS kit_parse_frame(const uint8_t* frame, size_t flen, uint8_t* code, const uint8_t** data, size_t* dlen)
+{
+    return kit_unwrap_frame(frame, flen, true, code, data, dlen);
+}
+
 #if defined(ATCA_HAL_KIT_HID) || defined(ATCA_HAL_KIT_UART)
 
+#ifdef ATCA_HAL_KIT_BINARY
+/** \brief Check if the interface negotiated binary framing. The physical layer
+ *         keeps the mode with the rest of its per interface data
+ */
+static bool kit_is_binary(ATCAIface iface)
+{
+    uint8_t framing = 0;
+
+    return (ATCA_SUCCESS == iface->phy->halcontrol(iface, ATCA_HAL_GET_KIT_FRAMING, &framing, sizeof(framing))) &&
+           (0u != framing);
+}
+
+/** \brief Record the framing negotiated for the interface
+ *  \return ATCA_SUCCESS if the physical layer recorded it, otherwise an error code
+ */
+static ATCA_STATUS kit_set_binary(ATCAIface iface, bool binary)
+{
+    uint8_t framing = binary ? 1u : 0u;
+
+    if ((NULL == iface->phy) || (NULL == iface->phy->halcontrol))
+    {
+        return ATCA_BAD_PARAM;
+    }
+    return iface->phy->halcontrol(iface, ATCA_HAL_SET_KIT_FRAMING, &framing, sizeof(framing));
+}
+#endif
+
 /** \brief HAL implementation of send over USB HID
  *  \param[in] iface     instance
  *  \param[in] txdata    pointer to bytes to send
@@ -211,7 +333,17 @@ ATCA_STATUS kit_phy_send(ATCAIface iface, uint8_t* txdata, int txlength)
     else if (ATCA_UART_IFACE == iface->mIfaceCFG->iface_type)
     {
 #ifdef ATCA_HAL_KIT_UART
-        packetsize = 1;
+        /* The frame ends at the first newline - send it straight from the caller's buffer */
+        const uint8_t* eol = memchr(txdata, (int)'\n', (txlength > 0) ? (size_t)txlength : 0u);
+
+#ifdef KIT_DEBUG
+        printf("Kit Send (%d): %s", txlength, txdata);
+#endif
+        if (NULL != eol)
+        {
+            txlength = (int)(eol - txdata) + 1;
+        }
+        return (0 < txlength) ? iface->phy->halsend(iface, 0xFF, txdata, txlength) : ATCA_SUCCESS;
 #endif
     }
     else
@@ -242,13 +374,6 @@ ATCA_STATUS kit_phy_send(ATCAIface iface, uint8_t* txdata, int txlength)
 #ifdef ATCA_HAL_KIT_HID
             /* coverity[cert_int32_c_violation:FALSE] */
             (void)memcpy(&buffer[1], &txdata[(txlength - bytes_left)], (size_t)bytes_to_send);
-#endif
-        }
-        else if (ATCA_UART_IFACE == iface->mIfaceCFG->iface_type)
-        {
-#ifdef ATCA_HAL_KIT_UART
-            /* coverity[cert_int32_c_violation:FALSE] */
-            (void)memcpy(&buffer[0], &txdata[(txlength - bytes_left)], bytes_to_send);
 #endif
         }
         else
@@ -262,13 +387,6 @@ ATCA_STATUS kit_phy_send(ATCAIface iface, uint8_t* txdata, int txlength)
             break;
         }
 
-#ifdef ATCA_HAL_KIT_UART
-        if (buffer[0] == '\n')   // sizeof will include \0 and count will increase
-        {
-            break;
-        }
-#endif
-
         bytes_left -= bytes_to_send;
     }
 
@@ -300,18 +418,42 @@ ATCA_STATUS kit_phy_receive(ATCAIface iface, uint8_t* rxdata, int* rxsize)
 #ifdef ATCA_HAL_KIT_UART
     if (ATCA_UART_IFACE == iface->mIfaceCFG->iface_type)
     {
-        rxlen = 1;
-        do
+        /* The uart hal returns whatever has arrived, so read in bulk and
+           scan only the new bytes for the end of the frame. The last byte
+           of the buffer is kept back so the caller can terminate the string */
+        bytes_to_read = *rxsize > 1 ? (size_t)*rxsize - 1U : 0U;
+
+        while (ATCA_SUCCESS == status && (NULL == location) && (0u < bytes_to_read))
         {
-            /* Clear out nulls if they are in the buffer */
-            status = iface->phy->halreceive(iface, 0x00, rxdata, &rxlen);
+            size_t skip = 0;
+
+            rxlen = (bytes_to_read > UINT16_MAX) ? UINT16_MAX : (uint16_t)bytes_to_read;
+            status = iface->phy->halreceive(iface, 0x00, &rxdata[total_bytes_read], &rxlen);
+
+            if (ATCA_SUCCESS == status)
+            {
+                /* Clear out nulls if they lead the frame */
+                while ((0u == total_bytes_read) && (skip < rxlen) && ('\0' == rxdata[skip]))
+                {
+                    skip++;
+                }
+                if (0u < skip)
+                {
+                    (void)memmove(rxdata, &rxdata[skip], (size_t)rxlen - skip);
+                }
+
+                location = memchr(&rxdata[total_bytes_read], (int)'\n', (size_t)rxlen - skip);
+                total_bytes_read += (size_t)rxlen - skip;
+                bytes_to_read -= (size_t)rxlen - skip;
+            }
         }
-        while (ATCA_SUCCESS == status && *rxdata == '\0');
-        total_bytes_read = 1;
+        bytes_to_read = 0u;
     }
+    else
 #endif
-
-    bytes_to_read = *rxsize > 0 ? (size_t)*rxsize : 0U;
+    {
+        bytes_to_read = *rxsize > 0 ? (size_t)*rxsize : 0U;
+    }
     rxlen = (bytes_to_read > 0U) ? (uint16_t)bytes_to_read-- : 0U;
 
     while (ATCA_SUCCESS == status && (NULL == location) && (0u < bytes_to_read))
@@ -350,6 +492,217 @@ ATCA_STATUS kit_phy_receive(ATCAIface iface, uint8_t* rxdata, int* rxsize)
     return ATCA_SUCCESS;
 }
 
+#ifdef ATCA_HAL_KIT_BINARY
+/** \brief Send a complete binary frame over the physical interface */
+static ATCA_STATUS kit_phy_send_frame(ATCAIface iface, uint8_t* frame, size_t flen)
+{
+    if (ATCA_UART_IFACE == iface->mIfaceCFG->iface_type)
+    {
+        /* No newline framing - the whole frame goes out in one write */
+        return iface->phy->halsend(iface, 0xFF, frame, (int)flen);
+    }
+    return kit_phy_send(iface, frame, (int)flen);
+}
+
+/** \brief Receive a complete binary frame over the physical interface
+ * \param[in]     iface   instance
+ * \param[out]    frame   pointer to space to receive the frame
+ * \param[in,out] flen    As input, the size of the frame buffer.
+ *                        As output, the number of bytes received.
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+static ATCA_STATUS kit_phy_receive_frame(ATCAIface iface, uint8_t* frame, size_t* flen)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    size_t total = 0;
+    size_t needed = KIT_FRAME_HEADER_SIZE;
+    size_t folded = 1;
+    size_t limit;
+    uint16_t crc = ATCA_CRC_INIT;
+    uint8_t crc_le[KIT_FRAME_CRC_SIZE];
+    uint16_t rxlen;
+
+    while ((ATCA_SUCCESS == status) && (total < needed))
+    {
+        if (*flen <= total)
+        {
+            status = ATCA_SMALL_BUFFER;
+            break;
+        }
+
+        rxlen = ((*flen - total) > UINT16_MAX) ? UINT16_MAX : (uint16_t)(*flen - total);
+        if (ATCA_SUCCESS == (status = iface->phy->halreceive(iface, 0x00, &frame[total], &rxlen)))
+        {
+            if (0u == total)
+            {
+                /* Discard anything (nulls, report padding) ahead of the sync byte */
+                const uint8_t* sync = memchr(frame, (int)KIT_FRAME_SYNC, rxlen);
+
+                if (NULL == sync)
+                {
+                    continue;
+                }
+                rxlen -= (uint16_t)(sync - frame);
+                (void)memmove(frame, sync, rxlen);
+            }
+
+            total += rxlen;
+            if (KIT_FRAME_HEADER_SIZE <= total)
+            {
+                needed = kit_frame_size(frame);
+            }
+
+            /* Fold the crc over everything after the sync byte up to the crc itself */
+            limit = (KIT_FRAME_HEADER_SIZE <= total) ? (needed - KIT_FRAME_CRC_SIZE) : total;
+            if (limit > total)
+            {
+                limit = total;
+            }
+            if (limit > folded)
+            {
+                crc = atCRC_update(crc, &frame[folded], limit - folded);
+                folded = limit;
+            }
+        }
+    }
+
+    if ((ATCA_SUCCESS == status) && (needed <= total))
+    {
+        atCRC_final(crc, crc_le);
+        if (0 != memcmp(crc_le, &frame[needed - KIT_FRAME_CRC_SIZE], sizeof(crc_le)))
+        {
+            status = ATCA_RX_CRC_ERROR;
+        }
+    }
+
+    *flen = total;
+    return status;
+}
+
+/** \brief Wrap bytes in a binary frame and send it to the kit
+ * \param[in] iface     instance
+ * \param[in] code      frame code to send
+ * \param[in] txdata    bytes to send
+ * \param[in] txlength  number of bytes to send
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+static ATCA_STATUS kit_frame_send(ATCAIface iface, uint8_t code, const uint8_t* txdata, size_t txlength)
+{
+    ATCA_STATUS status;
+    size_t flen = txlength + KIT_FRAME_OVERHEAD;
+    uint8_t* frame;
+
+    if (NULL == (frame = hal_malloc(flen)))
+    {
+        return ATCA_ALLOC_FAILURE;
+    }
+
+    if (ATCA_SUCCESS == (status = kit_wrap_frame(code, txdata, txlength, frame, &flen)))
+    {
+        status = kit_phy_send_frame(iface, frame, flen);
+    }
+
+    hal_free(frame);
+
+    return status;
+}
+
+/** \brief Receive a binary frame from the kit and unwrap it
+ * \param[in]     iface      instance
+ * \param[out]    kitstatus  status reported by the kit
+ * \param[out]    rxdata     response data is returned here
+ * \param[in,out] rxsize     As input, the size of the rxdata buffer.
+ *                           As output, the number of bytes returned.
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+static ATCA_STATUS kit_frame_receive(ATCAIface iface, uint8_t* kitstatus, uint8_t* rxdata, size_t* rxsize)
+{
+    ATCA_STATUS status;
+    /* Aligned to 64 bytes with a spare report for USB HID */
+    size_t nframe = (((*rxsize + KIT_FRAME_OVERHEAD) / 64u) + 2u) * 64u;
+    size_t flen = nframe;
+    uint8_t* frame;
+    const uint8_t* data;
+    size_t dlen;
+
+    if (NULL == (frame = hal_malloc(nframe)))
+    {
+        return ATCA_ALLOC_FAILURE;
+    }
+
+    if (ATCA_SUCCESS == (status = kit_phy_receive_frame(iface, frame, &flen)))
+    {
+        if (ATCA_SUCCESS == (status = kit_unwrap_frame(frame, flen, false, kitstatus, &data, &dlen)))
+        {
+            if (dlen > *rxsize)
+            {
+                status = ATCA_SMALL_BUFFER;
+            }
+            else
+            {
+                (void)memcpy(rxdata, data, dlen);
+                *rxsize = dlen;
+            }
+        }
+    }
+
+    hal_free(frame);
+
+    return status;
+}
+
+/** \brief Send a wake, idle or sleep frame and receive the kit's reply */
+static ATCA_STATUS kit_frame_control(ATCAIface iface, uint8_t code, uint8_t* rxdata, int* rxsize)
+{
+    ATCA_STATUS status;
+    uint8_t kitstatus = 0;
+    size_t rxlen = (size_t)*rxsize;
+
+    *rxsize = 0;
+    if (ATCA_SUCCESS == (status = kit_frame_send(iface, code, NULL, 0)))
+    {
+        if (ATCA_SUCCESS == (status = kit_frame_receive(iface, &kitstatus, rxdata, &rxlen)))
+        {
+            *rxsize = (int)rxlen;
+        }
+    }
+    return status;
+}
+
+/** \brief Ask the kit to switch to binary framing. Kits that do not know the
+ *         command, and physical layers that can not record the mode, stay in
+ *         ascii mode
+ */
+static void kit_negotiate_binary(ATCAIface iface)
+{
+    const char binary_select[] = "board:binary(%02X)\n";
+    char txbuf[KIT_MAX_TX_BUF];
+    char rxbuf[KIT_RX_WRAP_SIZE];
+    int rxlen = (int)sizeof(rxbuf);
+    uint8_t kitstatus = 0xFF;
+    uint8_t version[1];
+    int version_size = (int)sizeof(version);
+    int txlen;
+
+    if (ATCA_SUCCESS != kit_set_binary(iface, false))
+    {
+        return;
+    }
+
+    txlen = snprintf(txbuf, sizeof(txbuf), binary_select, KIT_FRAME_VERSION);
+    if ((0 < txlen) && (ATCA_SUCCESS == kit_phy_send(iface, (uint8_t*)txbuf, txlen)))
+    {
+        (void)memset(rxbuf, 0, sizeof(rxbuf));
+        if ((ATCA_SUCCESS == kit_phy_receive(iface, (uint8_t*)rxbuf, &rxlen)) &&
+            (ATCA_SUCCESS == kit_parse_rsp(rxbuf, rxlen, &kitstatus, version, &version_size)) &&
+            (0u == kitstatus))
+        {
+            (void)kit_set_binary(iface, true);
+        }
+    }
+}
+#endif
+
 /** \brief HAL implementation of kit protocol init.  This function calls back to the physical protocol to send the bytes
  *  \param[in] iface  instance
  *  \return ATCA_SUCCESS on success, otherwise an error code.
@@ -375,6 +728,11 @@ ATCA_STATUS kit_init(ATCAIface iface, ATCAIfaceCfg* cfg)
 
     ((void)cfg);
 
+#ifdef ATCA_HAL_KIT_BINARY
+    /* Every (re)initialization starts with ascii framing */
+    (void)kit_set_binary(iface, false);
+#endif
+
     device_match = kit_id_from_devtype(iface->mIfaceCFG->devtype);
 
     switch (iface->mIfaceCFG->iface_type)
@@ -522,6 +880,13 @@ ATCA_STATUS kit_init(ATCAIface iface, ATCAIfaceCfg* cfg)
         status = ATCA_NO_DEVICES;
     }
 
+#ifdef ATCA_HAL_KIT_BINARY
+    if ((ATCA_SUCCESS == status) && !atcab_is_ta_device(iface->mIfaceCFG->devtype))
+    {
+        kit_negotiate_binary(iface);
+    }
+#endif
+
     return status;
 }
 
@@ -612,6 +977,14 @@ ATCA_STATUS kit_send(ATCAIface iface, uint8_t word_address, uint8_t* txdata, int
     int nkitbuf;
     char* pkitbuf = NULL;
 
+#ifdef ATCA_HAL_KIT_BINARY
+    if (kit_is_binary(iface))
+    {
+        (void)word_address;
+        return kit_frame_send(iface, KIT_FRAME_TALK, txdata, (0 < txlength) ? (size_t)txlength : 0u);
+    }
+#endif
+
     do
     {
         // Wrap in kit protocol
@@ -690,6 +1063,20 @@ ATCA_STATUS kit_receive(ATCAIface iface, uint8_t word_address, uint8_t* rxdata,
             break;
         }
 
+#ifdef ATCA_HAL_KIT_BINARY
+        if (kit_is_binary(iface))
+        {
+            size_t rxlen = *rxsize;
+
+            *rxsize = 0;
+            if (ATCA_SUCCESS == (status = kit_frame_receive(iface, kitstatus, rxdata, &rxlen)))
+            {
+                *rxsize = (uint16_t)rxlen;
+            }
+            break;
+        }
+#endif
+
         if (true == atcab_is_ta_device(iface->mIfaceCFG->devtype))
         {
             // Send word address byte to kit protocol to receive a response from device
@@ -758,6 +1145,17 @@ ATCA_STATUS kit_wake(ATCAIface iface)
     int rxsize = (int)sizeof(rxdata);
     const char *target;
 
+#ifdef ATCA_HAL_KIT_BINARY
+    if (kit_is_binary(iface))
+    {
+        if (ATCA_SUCCESS != (status = kit_frame_control(iface, KIT_FRAME_WAKE, rxdata, &rxsize)))
+        {
+            return ATCA_GEN_FAIL;
+        }
+        return hal_check_wake(rxdata, rxsize);
+    }
+#endif
+
     target = kit_id_from_devtype(iface->mIfaceCFG->devtype);
     wake[0] = target[0];
 
@@ -804,6 +1202,17 @@ ATCA_STATUS kit_idle(ATCAIface iface)
     int rxsize = (int)sizeof(rxdata);
     const char *target;
 
+#ifdef ATCA_HAL_KIT_BINARY
+    if (kit_is_binary(iface))
+    {
+        if (ATCA_SUCCESS != (status = kit_frame_control(iface, KIT_FRAME_IDLE, rxdata, &rxsize)))
+        {
+            return ATCA_GEN_FAIL;
+        }
+        return status;
+    }
+#endif
+
     target = kit_id_from_devtype(iface->mIfaceCFG->devtype);
     idle[0] = target[0];
 
@@ -851,6 +1260,17 @@ ATCA_STATUS kit_sleep(ATCAIface iface)
     int rxsize = (int)sizeof(rxdata);
     const char* target;
 
+#ifdef ATCA_HAL_KIT_BINARY
+    if (kit_is_binary(iface))
+    {
+        if (ATCA_SUCCESS != (status = kit_frame_control(iface, KIT_FRAME_SLEEP, rxdata, &rxsize)))
+        {
+            return ATCA_GEN_FAIL;
+        }
+        return status;
+    }
+#endif
+
     target = kit_id_from_devtype(iface->mIfaceCFG->devtype);
     sleep[0] = target[0];
 
@@ -48,6 +48,20 @@
 #define KIT_MSG_SIZE        (32u)
 #define KIT_RX_WRAP_SIZE    (KIT_MSG_SIZE + 6u)
 
+/* Binary framing: <sync><length lsb><length msb><code><data...><crc lsb><crc msb>
+   where length counts the data bytes and the crc covers length, code and data */
+#define KIT_FRAME_SYNC          (0xA5u)
+#define KIT_FRAME_HEADER_SIZE   (4u)
+#define KIT_FRAME_CRC_SIZE      (2u)
+#define KIT_FRAME_OVERHEAD      (KIT_FRAME_HEADER_SIZE + KIT_FRAME_CRC_SIZE)
+#define KIT_FRAME_VERSION       (1u)
+
+/* Binary frame codes sent to the kit - responses carry the status instead */
+#define KIT_FRAME_WAKE          ((uint8_t)'w')
+#define KIT_FRAME_IDLE          ((uint8_t)'i')
+#define KIT_FRAME_SLEEP         ((uint8_t)'s')
+#define KIT_FRAME_TALK          ((uint8_t)'t')
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -69,6 +83,10 @@ ATCA_STATUS kit_sleep(ATCAIface iface);
 ATCA_STATUS kit_phy_send(ATCAIface iface, uint8_t* txdata, int txlength);
 ATCA_STATUS kit_phy_receive(ATCAIface iface, uint8_t* rxdata, int* rxsize);
 
+ATCA_STATUS kit_wrap_frame(uint8_t code, const uint8_t* data, size_t dlen, uint8_t* frame, size_t* flen);
+ATCA_STATUS kit_parse_frame(const uint8_t* frame, size_t flen, uint8_t* code, const uint8_t** data, size_t* dlen);
+size_t kit_frame_size(const uint8_t* header);
+
 const char* kit_id_from_devtype(ATCADeviceType devtype);
 const char* kit_interface_from_kittype(ATCAKitType kittype);
 const char * kit_interface(ATCAKitType kittype);
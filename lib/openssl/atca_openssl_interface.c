@@ -1048,14 +1048,15 @@ ATCA_STATUS atcac_pk_verify(
             }
             else
             {
-                EC_KEY* tmp_key_ptr = EC_KEY_dup(EVP_PKEY_get0_EC_KEY((EVP_PKEY*)ctx->ptr));
+                /* Verification only reads the key so the context's copy is used in place rather
+                   than duplicated on every call */
+                const EC_KEY* ec_key = EVP_PKEY_get0_EC_KEY((EVP_PKEY*)ctx->ptr);
 
-                if (NULL != tmp_key_ptr)
+                if (NULL != ec_key)
                 {
-                    ret = ECDSA_do_verify(digest, (int)dig_len, ec_sig, tmp_key_ptr);
-                    EC_KEY_free(tmp_key_ptr);
-                    ECDSA_SIG_free(ec_sig);
+                    ret = ECDSA_do_verify(digest, (int)dig_len, ec_sig, (EC_KEY*)ec_key);
                 }
+                ECDSA_SIG_free(ec_sig);
             }
         }
         else
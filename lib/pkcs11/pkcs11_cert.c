@@ -104,15 +104,21 @@ static CK_RV pkcs11_cert_load_cache(const pkcs11_session_ctx_ptr pSession, const
 #if defined(ATCA_HEAP) && (FEATURE_ENABLED == ATCACERT_INTEGRATION_EN)
         if (NULL == pObject->data)
         {
-            /* Find free cert cache slot*/
+            /* Find and claim a free cert cache slot - the list is shared by all slots */
             CK_ULONG i;
+            if (CKR_OK != pkcs11_lock_cache(NULL))
+            {
+                return CKR_CANT_LOCK;
+            }
             for (i = 0; i < PKCS11_MAX_CERTS_CACHED; i++)
             {
                 if (FALSE == pkcs11_cert_cache_list[i].in_use)
                 {
+                    pkcs11_cert_cache_list[i].in_use = TRUE;
                     break;
                 }
             }
+            (void)pkcs11_unlock_cache(NULL);
 
             if (i < PKCS11_MAX_CERTS_CACHED)
             {
@@ -141,9 +147,14 @@ static CK_RV pkcs11_cert_load_cache(const pkcs11_session_ctx_ptr pSession, const
                         pkcs11_cert_cache_list[i].pObject_cert = pObject;
                         pkcs11_cert_cache_list[i].pSession_cert_def = cert_def;
                     }
+                    else
+                    {
+                        pkcs11_cert_cache_list[i].in_use = FALSE;
+                    }
                 }
                 else
                 {
+                    pkcs11_cert_cache_list[i].in_use = FALSE;
                     rv = CKR_HOST_MEMORY;
                 }
             }
@@ -12,10 +12,9 @@
 CK_RV pkcs11_digest_init(CK_SESSION_HANDLE hSession, CK_MECHANISM_PTR pMechanism)
 {
     pkcs11_session_ctx_ptr pSession;
-    pkcs11_lib_ctx_ptr pLibCtx;
     CK_RV rv;
 
-    rv = pkcs11_init_check(&pLibCtx, FALSE);
+    rv = pkcs11_init_check(NULL, FALSE);
     if (CKR_OK != rv)
     {
         return rv;
@@ -48,56 +47,54 @@ CK_RV pkcs11_digest_init(CK_SESSION_HANDLE hSession, CK_MECHANISM_PTR pMechanism
 #ifdef PKCS11_HARDWARE_SHA256
     return CKR_FUNCTION_NOT_SUPPORTED;
 #else
-    if (CKR_OK == (rv = pkcs11_lock_context(pLibCtx)))
+    /* Software digests only touch the session state so they run without
+       taking the library or device locks */
+    switch (pMechanism->mechanism)
     {
-        switch (pMechanism->mechanism)
-        {
-        case CKM_SHA256:
+    case CKM_SHA256:
 #if (ATCAC_SHA256_EN)
-            rv = pkcs11_util_convert_rv(atcac_sw_sha2_256_init(&pSession->active_mech_data.sha256));
+        rv = pkcs11_util_convert_rv(atcac_sw_sha2_256_init(&pSession->active_mech_data.sha256));
 
-            if (CKR_OK == rv)
-            {
-                pSession->active_mech = CKM_SHA256;
-            }
+        if (CKR_OK == rv)
+        {
+            pSession->active_mech = CKM_SHA256;
+        }
 #else
-            rv = CKR_FUNCTION_NOT_SUPPORTED;
+        rv = CKR_FUNCTION_NOT_SUPPORTED;
 #endif            
-            break;
+        break;
 
-        case CKM_SHA384:
+    case CKM_SHA384:
 #if (ATCAC_SHA384_EN)
-            rv = pkcs11_util_convert_rv(atcac_sw_sha2_384_init(&pSession->active_mech_data.sha384));
+        rv = pkcs11_util_convert_rv(atcac_sw_sha2_384_init(&pSession->active_mech_data.sha384));
 
-            if (CKR_OK == rv)
-            {
-                pSession->active_mech = CKM_SHA384;
-            }
+        if (CKR_OK == rv)
+        {
+            pSession->active_mech = CKM_SHA384;
+        }
 #else
-            rv = CKR_FUNCTION_NOT_SUPPORTED;
+        rv = CKR_FUNCTION_NOT_SUPPORTED;
 #endif
-            break;
+        break;
 
-        case CKM_SHA512:
+    case CKM_SHA512:
 #if (ATCAC_SHA512_EN)
-            rv = pkcs11_util_convert_rv(atcac_sw_sha2_512_init(&pSession->active_mech_data.sha512));
+        rv = pkcs11_util_convert_rv(atcac_sw_sha2_512_init(&pSession->active_mech_data.sha512));
 
-            if (CKR_OK == rv)
-            {
-                pSession->active_mech = CKM_SHA512;
-            }
+        if (CKR_OK == rv)
+        {
+            pSession->active_mech = CKM_SHA512;
+        }
 #else
-            rv = CKR_FUNCTION_NOT_SUPPORTED;
+        rv = CKR_FUNCTION_NOT_SUPPORTED;
 #endif
-            break;
+        break;
 
-        default:
-            rv = CKR_OPERATION_NOT_INITIALIZED;
-            break;
-        } 
-        
-        (void)pkcs11_unlock_context(pLibCtx);
-    }
+    default:
+        rv = CKR_OPERATION_NOT_INITIALIZED;
+        break;
+    } 
+    
 
     return rv;
 #endif
@@ -109,10 +106,9 @@ CK_RV pkcs11_digest_init(CK_SESSION_HANDLE hSession, CK_MECHANISM_PTR pMechanism
 CK_RV pkcs11_digest(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_ULONG ulDataLen, CK_BYTE_PTR pDigest, CK_ULONG_PTR pulDigestLen)
 {
     pkcs11_session_ctx_ptr pSession;
-    pkcs11_lib_ctx_ptr pLibCtx;
     CK_RV rv;
 
-    rv = pkcs11_init_check(&pLibCtx, FALSE);
+    rv = pkcs11_init_check(NULL, FALSE);
     if (CKR_OK != rv)
     {
         return rv;
@@ -157,16 +153,12 @@ CK_RV pkcs11_digest(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_ULONG ulDa
             /* do nothing */
         }
 #if (ATCAC_SHA256_EN)
-        if (CKR_OK == (rv = pkcs11_lock_context(pLibCtx)))
+        rv = pkcs11_util_convert_rv(atcac_sw_sha2_256_update(&pSession->active_mech_data.sha256, pData, ulDataLen));
+        if (CKR_OK == rv)
         {
-            rv = pkcs11_util_convert_rv(atcac_sw_sha2_256_update(&pSession->active_mech_data.sha256, pData, ulDataLen));
-            if (CKR_OK == rv)
-            {
-                rv = pkcs11_util_convert_rv(atcac_sw_sha2_256_finish(&pSession->active_mech_data.sha256, pDigest));
-            }
+            rv = pkcs11_util_convert_rv(atcac_sw_sha2_256_finish(&pSession->active_mech_data.sha256, pDigest));
         }
         pSession->active_mech = CKM_VENDOR_DEFINED;
-        (void)pkcs11_unlock_context(pLibCtx);
 #endif
         break;
 
@@ -187,16 +179,12 @@ CK_RV pkcs11_digest(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_ULONG ulDa
             /* do nothing */
         }
 #if (ATCAC_SHA384_EN)
-        if (CKR_OK == (rv = pkcs11_lock_context(pLibCtx)))
+        rv = pkcs11_util_convert_rv(atcac_sw_sha2_384_update(&pSession->active_mech_data.sha384, pData, ulDataLen));
+        if (CKR_OK == rv)
         {
-            rv = pkcs11_util_convert_rv(atcac_sw_sha2_384_update(&pSession->active_mech_data.sha384, pData, ulDataLen));
-            if (CKR_OK == rv)
-            {
-                rv = pkcs11_util_convert_rv(atcac_sw_sha2_384_finish(&pSession->active_mech_data.sha384, pDigest));
-            }
+            rv = pkcs11_util_convert_rv(atcac_sw_sha2_384_finish(&pSession->active_mech_data.sha384, pDigest));
         }
         pSession->active_mech = CKM_VENDOR_DEFINED;
-        (void)pkcs11_unlock_context(pLibCtx);
 #endif
         break; 
 
@@ -217,16 +205,12 @@ CK_RV pkcs11_digest(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_ULONG ulDa
             /* do nothing */
         }
 #if (ATCAC_SHA512_EN)
-        if (CKR_OK == (rv = pkcs11_lock_context(pLibCtx)))
+        rv = pkcs11_util_convert_rv(atcac_sw_sha2_512_update(&pSession->active_mech_data.sha512, pData, ulDataLen));
+        if (CKR_OK == rv)
         {
-            rv = pkcs11_util_convert_rv(atcac_sw_sha2_512_update(&pSession->active_mech_data.sha512, pData, ulDataLen));
-            if (CKR_OK == rv)
-            {
-                rv = pkcs11_util_convert_rv(atcac_sw_sha2_512_finish(&pSession->active_mech_data.sha512, pDigest));
-            }
-        }    
+            rv = pkcs11_util_convert_rv(atcac_sw_sha2_512_finish(&pSession->active_mech_data.sha512, pDigest));
+        }
         pSession->active_mech = CKM_VENDOR_DEFINED;
-        (void)pkcs11_unlock_context(pLibCtx);
 #endif
         break;     
         
@@ -245,10 +229,9 @@ CK_RV pkcs11_digest(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_ULONG ulDa
 CK_RV pkcs11_digest_update(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pPart, CK_ULONG ulPartLen)
 {
     pkcs11_session_ctx_ptr pSession;
-    pkcs11_lib_ctx_ptr pLibCtx;
     CK_RV rv;
 
-    rv = pkcs11_init_check(&pLibCtx, FALSE);
+    rv = pkcs11_init_check(NULL, FALSE);
     if (CKR_OK != rv)
     {
         return rv;
@@ -272,35 +255,31 @@ CK_RV pkcs11_digest_update(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pPart, CK_ULO
 
     return CKR_FUNCTION_NOT_SUPPORTED;
 #else
-    if (CKR_OK == (rv = pkcs11_lock_context(pLibCtx)))
+    switch (pSession->active_mech)
     {
-        switch (pSession->active_mech)
-        {
-        case CKM_SHA256:
+    case CKM_SHA256:
 #if (ATCAC_SHA256_EN)
-            rv = pkcs11_util_convert_rv(atcac_sw_sha2_256_update(&pSession->active_mech_data.sha256, pPart, ulPartLen));
+        rv = pkcs11_util_convert_rv(atcac_sw_sha2_256_update(&pSession->active_mech_data.sha256, pPart, ulPartLen));
 #endif
-            break;
+        break;
 
-        case CKM_SHA384:
+    case CKM_SHA384:
 #if (ATCAC_SHA384_EN)
-            rv = pkcs11_util_convert_rv(atcac_sw_sha2_384_update(&pSession->active_mech_data.sha384, pPart, ulPartLen));
+        rv = pkcs11_util_convert_rv(atcac_sw_sha2_384_update(&pSession->active_mech_data.sha384, pPart, ulPartLen));
 #endif
-            break;    
+        break;    
 
-        case CKM_SHA512:
+    case CKM_SHA512:
 #if (ATCAC_SHA512_EN)
-            rv = pkcs11_util_convert_rv(atcac_sw_sha2_512_update(&pSession->active_mech_data.sha512, pPart, ulPartLen));
+        rv = pkcs11_util_convert_rv(atcac_sw_sha2_512_update(&pSession->active_mech_data.sha512, pPart, ulPartLen));
 #endif
-            break;    
-        
-        default:
-            rv = CKR_OPERATION_NOT_INITIALIZED;
-            break;
-        }
-
-        (void)pkcs11_unlock_context(pLibCtx);
+        break;    
+    
+    default:
+        rv = CKR_OPERATION_NOT_INITIALIZED;
+        break;
     }
+
     return rv;
 #endif
 }
@@ -311,10 +290,9 @@ CK_RV pkcs11_digest_update(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pPart, CK_ULO
 CK_RV pkcs11_digest_final(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pDigest, CK_ULONG_PTR pulDigestLen)
 {
     pkcs11_session_ctx_ptr pSession;
-    pkcs11_lib_ctx_ptr pLibCtx;
     CK_RV rv;
 
-    rv = pkcs11_init_check(&pLibCtx, FALSE);
+    rv = pkcs11_init_check(NULL, FALSE);
     if (CKR_OK != rv)
     {
         return rv;
@@ -357,12 +335,8 @@ CK_RV pkcs11_digest_final(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pDigest, CK_UL
             /* do nothing */
         }
 #if (ATCAC_SHA256_EN)
-        if (CKR_OK == (rv = pkcs11_lock_context(pLibCtx)))
-        {
-            rv = pkcs11_util_convert_rv(atcac_sw_sha2_256_finish(&pSession->active_mech_data.sha256, pDigest));
-        }
+        rv = pkcs11_util_convert_rv(atcac_sw_sha2_256_finish(&pSession->active_mech_data.sha256, pDigest));
         pSession->active_mech = CKM_VENDOR_DEFINED;
-        (void)pkcs11_unlock_context(pLibCtx);
 #endif
         break;
 
@@ -383,12 +357,8 @@ CK_RV pkcs11_digest_final(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pDigest, CK_UL
             /* do nothing */
         }
 #if (ATCAC_SHA384_EN)
-        if (CKR_OK == (rv = pkcs11_lock_context(pLibCtx)))
-        {
-            rv = pkcs11_util_convert_rv(atcac_sw_sha2_384_finish(&pSession->active_mech_data.sha384, pDigest));
-        }
+        rv = pkcs11_util_convert_rv(atcac_sw_sha2_384_finish(&pSession->active_mech_data.sha384, pDigest));
         pSession->active_mech = CKM_VENDOR_DEFINED;
-        (void)pkcs11_unlock_context(pLibCtx);
 #endif
         break;   
 
@@ -409,12 +379,8 @@ CK_RV pkcs11_digest_final(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pDigest, CK_UL
             /* do nothing */
         }
 #if (ATCAC_SHA512_EN)
-        if (CKR_OK == (rv = pkcs11_lock_context(pLibCtx)))
-        {
-            rv = pkcs11_util_convert_rv(atcac_sw_sha2_512_finish(&pSession->active_mech_data.sha512, pDigest));
-        }
+        rv = pkcs11_util_convert_rv(atcac_sw_sha2_512_finish(&pSession->active_mech_data.sha512, pDigest));
         pSession->active_mech = CKM_VENDOR_DEFINED;
-        (void)pkcs11_unlock_context(pLibCtx);
 #endif
         break;     
     
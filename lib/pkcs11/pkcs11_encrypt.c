@@ -109,7 +109,7 @@ CK_RV pkcs11_encrypt_init(CK_SESSION_HANDLE hSession, CK_MECHANISM_PTR pMechanis
 #ifdef ATCA_ATECC608_SUPPORT
                             /* coverity[misra_c_2012_rule_10_1_violation] False positive - coverity bug with stdint.h definitions */
                             pSession->active_mech_data.gcm.tag_len = (CK_BYTE)((pParams->ulTagBits / 8u) & UINT8_MAX);
-                            if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+                            if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
                             {
                                 if (CKR_OK == (rv = pkcs11_util_convert_rv(atcab_aes_gcm_init_ext(pSession->slot->device_ctx, &pSession->active_mech_data.gcm.context,
                                                                                                   pObject->slot, 0, pParams->pIv, pParams->ulIvLen))))
@@ -117,7 +117,7 @@ CK_RV pkcs11_encrypt_init(CK_SESSION_HANDLE hSession, CK_MECHANISM_PTR pMechanis
                                     /* coverity[misra_c_2012_rule_10_1_violation] False positive - coverity bug with stdint.h definitions */
                                     rv = pkcs11_util_convert_rv(atcab_aes_gcm_aad_update_ext(pSession->slot->device_ctx, &pSession->active_mech_data.gcm.context, pParams->pAAD, (uint32_t)(pParams->ulAADLen) & UINT32_MAX));
                                 }
-                                (void)pkcs11_unlock_device(pLibCtx);
+                                (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
                             }
 #else
                             rv = CKR_MECHANISM_INVALID;
@@ -238,10 +238,10 @@ CK_RV pkcs11_encrypt(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_ULONG ulD
         case CKM_AES_ECB:
             if (ulDataLen == ATCA_AES128_BLOCK_SIZE && *pulEncryptedDataLen >= ATCA_AES128_BLOCK_SIZE)
             {
-                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
                 {
                     status = atcab_aes_encrypt_ext(pSession->slot->device_ctx, pKey->slot, 0, pData, pEncryptedData);
-                    (void)pkcs11_unlock_device(pLibCtx);
+                    (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
                 }
                 *pulEncryptedDataLen = ATCA_AES128_BLOCK_SIZE;
             }
@@ -257,7 +257,7 @@ CK_RV pkcs11_encrypt(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_ULONG ulD
             size_t length = *pulEncryptedDataLen;
             size_t final = 0;
 
-            if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+            if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
             {
                 if (ATCA_SUCCESS == (status = atcab_aes_cbc_encrypt_update(&pSession->active_mech_data.cbc, pData, ulDataLen, pEncryptedData, &length)))
                 {
@@ -265,7 +265,7 @@ CK_RV pkcs11_encrypt(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_ULONG ulD
                     final = *pulEncryptedDataLen - length;
                     status = atcab_aes_cbc_encrypt_finish(&pSession->active_mech_data.cbc, pEncryptedData, &final);
                 }
-                (void)pkcs11_unlock_device(pLibCtx);
+                (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
             }
             /* coverity[misra_c_2012_rule_10_1_violation] False positive - coverity bug with stdint.h definitions */
             if (length <= UINT32_MAX)
@@ -281,7 +281,7 @@ CK_RV pkcs11_encrypt(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_ULONG ulD
             if (atcab_is_ca_device(atcab_get_device_type_ext(pSession->slot->device_ctx)))
             {
 #ifdef ATCA_ATECC608_SUPPORT
-                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
                 {
                     /* coverity[misra_c_2012_rule_10_1_violation] False positive - coverity bug with stdint.h definitions */
                     if (ATCA_SUCCESS == (status = atcab_aes_gcm_encrypt_update_ext(pSession->slot->device_ctx, &pSession->active_mech_data.gcm.context, pData, (uint32_t)(ulDataLen & UINT32_MAX), pEncryptedData)))
@@ -290,7 +290,7 @@ CK_RV pkcs11_encrypt(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_ULONG ulD
                                                                   pSession->active_mech_data.gcm.tag_len);
                         *pulEncryptedDataLen = ulDataLen + pSession->active_mech_data.gcm.tag_len;
                     }
-                    (void)pkcs11_unlock_device(pLibCtx);
+                    (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
                 }
 #else
                 rv = CKR_GENERAL_ERROR;
@@ -299,7 +299,7 @@ CK_RV pkcs11_encrypt(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_ULONG ulD
 #if ATCA_TA_SUPPORT
             if (atcab_is_ta_device(atcab_get_device_type()))
             {
-                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
                 {
                     if (ATCA_SUCCESS == (status = talib_aes128_gcm_keyload(pSession->slot->device_ctx, pKey->slot, 0)))
                     {
@@ -318,7 +318,7 @@ CK_RV pkcs11_encrypt(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_ULONG ulD
                             rv = CKR_DATA_LEN_RANGE;
                         }
                     }
-                    (void)pkcs11_unlock_device(pLibCtx);
+                    (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
                 }
             }
 #endif
@@ -327,7 +327,7 @@ CK_RV pkcs11_encrypt(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_ULONG ulD
         case CKM_RSA_PKCS_OAEP:
             if (CKR_OK == (rv = pkcs11_object_is_private(pKey, &is_private, pSession)))
             {
-                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
                 {
                     ATCADeviceType dev_type = atcab_get_device_type_ext(pSession->slot->device_ctx);
                     if (atcab_is_ta_device(dev_type))
@@ -357,7 +357,7 @@ CK_RV pkcs11_encrypt(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_ULONG ulD
                             }
                         }
                     }
-                    (void)pkcs11_unlock_device(pLibCtx);
+                    (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
                 }
             }
             break;
@@ -425,10 +425,10 @@ CK_RV pkcs11_encrypt_update(
         case CKM_AES_ECB:
             if (ulDataLen == ATCA_AES128_BLOCK_SIZE && *pulEncryptedDataLen >= ATCA_AES128_BLOCK_SIZE)
             {
-                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
                 {
                     status = atcab_aes_encrypt_ext(pSession->slot->device_ctx, pKey->slot, 0, pData, pEncryptedData);
-                    (void)pkcs11_unlock_device(pLibCtx);
+                    (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
                 }
                 *pulEncryptedDataLen = ATCA_AES128_BLOCK_SIZE;
             }
@@ -442,10 +442,10 @@ CK_RV pkcs11_encrypt_update(
         case CKM_AES_CBC:
         {
             size_t length = *pulEncryptedDataLen;
-            if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+            if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
             {
                 status = atcab_aes_cbc_encrypt_update(&pSession->active_mech_data.cbc, pData, ulDataLen, pEncryptedData, &length);
-                (void)pkcs11_unlock_device(pLibCtx);
+                (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
             }
 
             *pulEncryptedDataLen = (CK_ULONG)(length & UINT32_MAX);
@@ -455,11 +455,11 @@ CK_RV pkcs11_encrypt_update(
             if (atcab_is_ca_device(atcab_get_device_type_ext(pSession->slot->device_ctx)))
             {
 #ifdef ATCA_ATECC608_SUPPORT
-                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
                 {
                     /* coverity[misra_c_2012_rule_10_1_violation] False positive - coverity bug with stdint.h definitions */
                     status = atcab_aes_gcm_encrypt_update_ext(pSession->slot->device_ctx, &pSession->active_mech_data.gcm.context, pData, (uint32_t)(ulDataLen & UINT32_MAX), pEncryptedData);
-                    (void)pkcs11_unlock_device(pLibCtx);
+                    (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
                 }
 #endif
             }
@@ -531,10 +531,10 @@ CK_RV pkcs11_encrypt_final(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pEncryptedDat
         {
             size_t length = *pulEncryptedDataLen;
 
-            if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+            if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
             {
                 status = atcab_aes_cbc_encrypt_finish(&pSession->active_mech_data.cbc, pEncryptedData, &length);
-                (void)pkcs11_unlock_device(pLibCtx);
+                (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
             }
 
             *pulEncryptedDataLen = (CK_ULONG)(length & UINT32_MAX);
@@ -544,11 +544,11 @@ CK_RV pkcs11_encrypt_final(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pEncryptedDat
             if (atcab_is_ca_device(atcab_get_device_type_ext(pSession->slot->device_ctx)))
             {
 #ifdef ATCA_ATECC608_SUPPORT
-                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
                 {
                     status = atcab_aes_gcm_encrypt_finish_ext(pSession->slot->device_ctx, &pSession->active_mech_data.gcm.context, pEncryptedData,
                                                               pSession->active_mech_data.gcm.tag_len);
-                    (void)pkcs11_unlock_device(pLibCtx);
+                    (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
                 }
                 *pulEncryptedDataLen = pSession->active_mech_data.gcm.tag_len;
 #endif
@@ -644,14 +644,14 @@ CK_RV pkcs11_decrypt_init(CK_SESSION_HANDLE hSession, CK_MECHANISM_PTR pMechanis
                             /* coverity[misra_c_2012_rule_10_1_violation] False positive - coverity bug with stdint.h definitions */
                             pSession->active_mech_data.gcm.tag_len = (CK_BYTE)((pParams->ulTagBits / 8u) & UINT8_MAX);
 
-                            if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+                            if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
                             {
                                 if (CKR_OK == (rv = pkcs11_util_convert_rv(atcab_aes_gcm_init_ext(pSession->slot->device_ctx, &pSession->active_mech_data.gcm.context,
                                                                                                   pObject->slot, 0, pParams->pIv, pParams->ulIvLen))))
                                 {
                                     rv = pkcs11_util_convert_rv(atcab_aes_gcm_aad_update_ext(pSession->slot->device_ctx, &pSession->active_mech_data.gcm.context, pParams->pAAD, (uint32_t)(pParams->ulAADLen)));
                                 }
-                                (void)pkcs11_unlock_device(pLibCtx);
+                                (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
                             }
 #else
                             rv = CKR_MECHANISM_INVALID;
@@ -774,10 +774,10 @@ CK_RV pkcs11_decrypt(
         case CKM_AES_ECB:
             if (ulEncryptedDataLen == ATCA_AES128_BLOCK_SIZE && *pulDataLen >= ATCA_AES128_BLOCK_SIZE)
             {
-                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
                 {
                     status = atcab_aes_decrypt_ext(pSession->slot->device_ctx, pKey->slot, 0, pEncryptedData, pData);
-                    (void)pkcs11_unlock_device(pLibCtx);
+                    (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
                 }
                 *pulDataLen = ATCA_AES128_BLOCK_SIZE;
             }
@@ -792,7 +792,7 @@ CK_RV pkcs11_decrypt(
         {
             size_t length = *pulDataLen;
             size_t final = 0;
-            if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+            if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
             {
                 if (ATCA_SUCCESS == (status = atcab_aes_cbc_decrypt_update(&pSession->active_mech_data.cbc, pEncryptedData, ulEncryptedDataLen, pData, &length)))
                 {
@@ -800,7 +800,7 @@ CK_RV pkcs11_decrypt(
                     final = *pulDataLen - length;
                     status = atcab_aes_cbc_decrypt_finish(&pSession->active_mech_data.cbc, pData, &final);
                 }
-                (void)pkcs11_unlock_device(pLibCtx);
+                (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
             }
 
             /* coverity[misra_c_2012_rule_10_1_violation] False positive - coverity bug with stdint.h definitions */
@@ -815,7 +815,7 @@ CK_RV pkcs11_decrypt(
             {
 #ifdef ATCA_ATECC608_SUPPORT
                 *pulDataLen = ulEncryptedDataLen - pSession->active_mech_data.gcm.tag_len;
-                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
                 {
                     if (ATCA_SUCCESS == (status = atcab_aes_gcm_decrypt_update_ext(pSession->slot->device_ctx, &pSession->active_mech_data.gcm.context, pEncryptedData,
                                                                                    (uint32_t)(*pulDataLen & UINT32_MAX), pData)))
@@ -828,14 +828,14 @@ CK_RV pkcs11_decrypt(
                             rv = CKR_ENCRYPTED_DATA_INVALID;
                         }
                     }
-                    (void)pkcs11_unlock_device(pLibCtx);
+                    (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
                 }
 #endif
             }
 #if ATCA_TA_SUPPORT
             if (atcab_is_ta_device(atcab_get_device_type()))
             {
-                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
                 {
                     if (ATCA_SUCCESS == (status = talib_aes128_gcm_keyload(pSession->slot->device_ctx, pKey->slot, 0)))
                     {
@@ -852,7 +852,7 @@ CK_RV pkcs11_decrypt(
                         }
                     }
                 }
-                (void)pkcs11_unlock_device(pLibCtx);
+                (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
             }
 #endif
             break;
@@ -860,7 +860,7 @@ CK_RV pkcs11_decrypt(
         case CKM_RSA_PKCS_OAEP:
             if (atcab_is_ta_device(atcab_get_device_type_ext(pSession->slot->device_ctx)))
             {   
-                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
                 {
                     cal_buffer ciphertext_buf = CAL_BUF_INIT(ulEncryptedDataLen, pEncryptedData);
                     cal_buffer plaintext_buf = CAL_BUF_INIT(*pulDataLen, pData);
@@ -871,7 +871,7 @@ CK_RV pkcs11_decrypt(
                         rv = pkcs11_util_convert_rv(talib_rsaenc_decrypt(pSession->slot->device_ctx, key_data->rsa_key_info->rsa_decrypt_mode, pKey->slot,
                                                                          &ciphertext_buf, &plaintext_buf));
                     }
-                    (void)pkcs11_unlock_device(pLibCtx);
+                    (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
                 }
             }
             break;  
@@ -945,10 +945,10 @@ CK_RV pkcs11_decrypt_update(
         case CKM_AES_ECB:
             if (ulEncryptedDataLen == ATCA_AES128_BLOCK_SIZE && *pulDataLen >= ATCA_AES128_BLOCK_SIZE)
             {
-                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
                 {
                     status = atcab_aes_decrypt_ext(pSession->slot->device_ctx, pKey->slot, 0, pEncryptedData, pData);
-                    (void)pkcs11_unlock_device(pLibCtx);
+                    (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
                 }
                 *pulDataLen = ATCA_AES128_BLOCK_SIZE;
             }
@@ -962,10 +962,10 @@ CK_RV pkcs11_decrypt_update(
         case CKM_AES_CBC:
         {
             size_t length = *pulDataLen;
-            if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+            if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
             {
                 status = atcab_aes_cbc_decrypt_update(&pSession->active_mech_data.cbc, pEncryptedData, ulEncryptedDataLen, pData, &length);
-                (void)pkcs11_unlock_device(pLibCtx);
+                (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
             }
             *pulDataLen = (CK_ULONG)(length & UINT32_MAX);
         }
@@ -974,11 +974,11 @@ CK_RV pkcs11_decrypt_update(
             if (atcab_is_ca_device(atcab_get_device_type_ext(pSession->slot->device_ctx)))
             {
 #ifdef ATCA_ATECC608_SUPPORT
-                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
                 {
                     status = atcab_aes_gcm_decrypt_update_ext(pSession->slot->device_ctx, &pSession->active_mech_data.gcm.context, pEncryptedData,
                                                               (uint32_t)*pulDataLen, pData);
-                    (void)pkcs11_unlock_device(pLibCtx);
+                    (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
                 }
 #endif
             }
@@ -1049,10 +1049,10 @@ CK_RV pkcs11_decrypt_final(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_ULO
         case CKM_AES_CBC:
         {
             size_t length = *pulDataLen;
-            if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+            if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
             {
                 status = atcab_aes_cbc_decrypt_finish(&pSession->active_mech_data.cbc, pData, &length);
-                (void)pkcs11_unlock_device(pLibCtx);
+                (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
             }
             /* coverity[misra_c_2012_rule_10_1_violation] False positive - coverity bug with stdint.h definitions */
             *pulDataLen = (CK_ULONG)(length & UINT32_MAX);
@@ -1064,11 +1064,11 @@ CK_RV pkcs11_decrypt_final(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_ULO
 #ifdef ATCA_ATECC608_SUPPORT
 
                 bool is_verified = FALSE;
-                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
                 {
                     status = atcab_aes_gcm_decrypt_finish_ext(pSession->slot->device_ctx, &pSession->active_mech_data.gcm.context, pData,
                                                               pSession->active_mech_data.gcm.tag_len, &is_verified);
-                    (void)pkcs11_unlock_device(pLibCtx);
+                    (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
                 }
                 if (!is_verified)
                 {
@@ -41,86 +41,24 @@
  * \defgroup pkcs11 Find (pkcs11_find_)
    @{ */
 
-// #ifdef ATCA_NO_HEAP
-static CK_BYTE pkcs11_find_template_cache[PKCS11_SEARCH_CACHE_SIZE];
-// #endif
-
-
 /**
- * \brief Copy an array of CK_ATTRIBUTE structures
+ * \brief Search template compiled by pkcs11_find_init
+ *
+ * Attributes that mirror fields cached in the object (class, key type and
+ * label) are pulled out of the template so they can be compared directly
+ * before any attribute getter - which may talk to the device - is called.
  */
-static CK_RV pkcs11_find_copy_template(CK_BYTE_PTR pBuffer, CK_ULONG ulBufSize, CK_ATTRIBUTE_PTR pTemplate, const CK_ULONG ulCount)
+typedef struct pkcs11_find_matcher_s
 {
-    CK_ULONG bytes_required;
-    CK_ATTRIBUTE_PTR pCopy;
-    CK_ULONG i;
-
-    if (NULL == pBuffer || 0u == ulBufSize || NULL == pTemplate || 0u == ulCount)
-    {
-        return CKR_ARGUMENTS_BAD;
-    }
-
-    /* Start with the amount of memory required to hold the Array */
-    bytes_required = (CK_ULONG)sizeof(CK_ATTRIBUTE) * ulCount;
-
-    /* Check the template pValue requirements */
-    for (i = 0; i < ulCount; i++)
-    {
-        if (NULL != pTemplate[i].pValue && 0u != pTemplate[i].ulValueLen)
-        {
-            if (bytes_required <= UINT32_MAX)
-            {
-                if (UINT32_MAX - bytes_required >= pTemplate[i].ulValueLen)
-                {
-                    bytes_required += pTemplate[i].ulValueLen;
-                }
-            }
-
-            /* Check for overflow */
-            if (bytes_required < pTemplate[i].ulValueLen)
-            {
-                return CKR_HOST_MEMORY;
-            }
-        }
-    }
-
-    if (ulBufSize < bytes_required)
-    {
-        return CKR_HOST_MEMORY;
-    }
-
-    /* Good to copy */
-    bytes_required = (CK_ULONG)sizeof(CK_ATTRIBUTE) * ulCount;
-
-    /* Set up the Copied Template */
-    /* coverity[misra_c_2012_rule_11_3_violation] pkcs11_find manages its own memory cache with a raw buffer */
-    pCopy = (CK_ATTRIBUTE_PTR)pBuffer;
-
-    /* Move to the data section */
-    pBuffer += bytes_required;
-
-    /* Copy the template */
-    for (i = 0; i < ulCount; i++)
-    {
-        pCopy[i].type = pTemplate[i].type;
-
-        /* Sanity check the input to see if we need to allocate any memory for this */
-        if (NULL != pTemplate[i].pValue && 0u != pTemplate[i].ulValueLen)
-        {
-            pCopy[i].pValue = pBuffer;
-            pCopy[i].ulValueLen = pTemplate[i].ulValueLen;
-            pBuffer += pTemplate[i].ulValueLen;
-            (void)memcpy(pCopy[i].pValue, pTemplate[i].pValue, pTemplate[i].ulValueLen);
-        }
-        else
-        {
-            pCopy[i].pValue = NULL;
-            pCopy[i].ulValueLen = 0;
-        }
-    }
-
-    return CKR_OK;
-}
+    CK_ATTRIBUTE_PTR pTemplate;
+    CK_ULONG         ulCount;
+    CK_ATTRIBUTE_PTR pClass;
+    CK_ATTRIBUTE_PTR pKeyType;
+    CK_ATTRIBUTE_PTR pLabel;
+    CK_BBOOL         never;
+    CK_VOID_PTR      pBuffer;
+    CK_ULONG         ulBufferLen;
+} pkcs11_find_matcher;
 
 static const pkcs11_attrib_model *pkcs11_find_attrib(const pkcs11_attrib_model *pAttributeList, const CK_ULONG ulCount, const CK_ATTRIBUTE_PTR pTemplate)
 {
@@ -143,15 +81,18 @@ static const pkcs11_attrib_model *pkcs11_find_attrib(const pkcs11_attrib_model *
 }
 
 
-static const pkcs11_attrib_model *pkcs11_find_attrib_match(pkcs11_object_ptr pObject, const pkcs11_attrib_model *pAttributeList, const CK_ULONG ulCount,
-                                                           const CK_ATTRIBUTE_PTR pTemplate, pkcs11_session_ctx_ptr pSession)
+static const pkcs11_attrib_model *pkcs11_find_attrib_match(pkcs11_object_ptr pObject, const CK_ATTRIBUTE_PTR pTemplate,
+                                                           pkcs11_find_matcher * pMatcher, pkcs11_session_ctx_ptr pSession)
 {
     CK_BBOOL found = FALSE;
     const pkcs11_attrib_model *pAttribute = NULL;
 
-    pAttribute = pkcs11_find_attrib(pAttributeList, ulCount, pTemplate);
+    if (NULL != pObject)
+    {
+        pAttribute = pkcs11_find_attrib(pObject->attributes, pObject->count, pTemplate);
+    }
 
-    if (NULL != pAttribute && NULL != pObject && NULL != pSession)
+    if (NULL != pAttribute && NULL != pSession)
     {
         CK_BBOOL must_full_match = FALSE;
 
@@ -168,14 +109,8 @@ static const pkcs11_attrib_model *pkcs11_find_attrib_match(pkcs11_object_ptr pOb
         if (NULL != pTemplate->pValue && NULL != pAttribute->func)
         {
             CK_ATTRIBUTE temp = { 0 };
-#ifdef ATCA_NO_HEAP
-            CK_UTF8CHAR buf[PKCS11_MAX_LABEL_SIZE];
-            temp.pValue = buf;
-            temp.ulValueLen = sizeof(buf);
-#else
-            temp.pValue = pkcs11_os_malloc(pTemplate->ulValueLen);
-            temp.ulValueLen = pTemplate->ulValueLen;
-#endif
+            temp.pValue = pMatcher->pBuffer;
+            temp.ulValueLen = pMatcher->ulBufferLen;
 
             /* Get the attribute */
             if (CKR_OK == pAttribute->func(pObject, &temp, pSession))
@@ -189,12 +124,6 @@ static const pkcs11_attrib_model *pkcs11_find_attrib_match(pkcs11_object_ptr pOb
                     }
                 }
             }
-#ifdef ATCA_HEAP
-            if (NULL != temp.pValue)
-            {
-                pkcs11_os_free(temp.pValue);
-            }
-#endif
         }
         else if (!must_full_match)
         {
@@ -214,68 +143,172 @@ static const pkcs11_attrib_model *pkcs11_find_attrib_match(pkcs11_object_ptr pOb
     return NULL;
 }
 
-static CK_OBJECT_HANDLE pkcs11_find_handle(const CK_SLOT_ID slotid, const CK_ATTRIBUTE_PTR pTemplate, CK_ULONG ulCount, CK_ULONG_PTR index,
-                                           pkcs11_session_ctx_ptr pSession)
+/**
+ * \brief Compare a compiled template attribute against the matching cached
+ * field of the object. Falls back to the attribute getter if the object model
+ * does not serve the attribute from that field.
+ */
+static CK_BBOOL pkcs11_find_cached_match(pkcs11_object_ptr pObject, const CK_ATTRIBUTE_PTR pTemplate, attrib_f cached,
+                                         const CK_VOID_PTR pValue, CK_ULONG ulValueLen, pkcs11_find_matcher * pMatcher,
+                                         pkcs11_session_ctx_ptr pSession)
+{
+    const pkcs11_attrib_model *pAttribute = pkcs11_find_attrib(pObject->attributes, pObject->count, pTemplate);
+
+    if (NULL == pAttribute)
+    {
+        return FALSE;
+    }
+
+    if (cached != pAttribute->func)
+    {
+        return (NULL != pkcs11_find_attrib_match(pObject, pTemplate, pMatcher, pSession)) ? TRUE : FALSE;
+    }
+
+    /* coverity[misra_c_2012_rule_21_16_violation:FALSE] CK_VOID_PTR is a pointer type */
+    return ((ulValueLen == pTemplate->ulValueLen) && (0 == memcmp(pValue, pTemplate->pValue, ulValueLen))) ? TRUE : FALSE;
+}
+
+/**
+ * \brief Check if an attribute has been folded into the compiled part of the matcher
+ */
+static CK_BBOOL pkcs11_find_is_compiled(const CK_ATTRIBUTE_PTR pTemplate)
+{
+    return ((NULL != pTemplate->pValue) && ((CKA_CLASS == pTemplate->type) || (CKA_KEY_TYPE == pTemplate->type) ||
+                                            (CKA_LABEL == pTemplate->type))) ? TRUE : FALSE;
+}
+
+/**
+ * \brief Compile a search template into a matcher
+ */
+static void pkcs11_find_compile(pkcs11_find_matcher * pMatcher, CK_ATTRIBUTE_PTR pTemplate, CK_ULONG ulCount)
 {
     CK_ULONG i;
-    CK_ULONG j;
-    CK_OBJECT_HANDLE rv = NULL_PTR;
 
-    /* Finds the first or next match - Iterate through objects */
-    for (i = (NULL != index) ? *index : 0u; i < (CK_ULONG)PKCS11_MAX_OBJECTS_ALLOWED; i++)
+    (void)memset(pMatcher, 0, sizeof(*pMatcher));
+    pMatcher->pTemplate = pTemplate;
+    pMatcher->ulCount = ulCount;
+
+    for (i = 0; i < ulCount; i++)
     {
-        pkcs11_object_ptr pObject = pkcs11_object_cache[i].object;
-        if (NULL != pObject && slotid == pkcs11_object_cache[i].slotid)
+        CK_ATTRIBUTE_PTR pAttr = &pTemplate[i];
+        CK_ATTRIBUTE_PTR *ppSlot = NULL;
+
+        /* Compiled attributes may still be read through their getter when the
+           object model doesn't serve them from the cached field */
+        if (NULL != pAttr->pValue && pAttr->ulValueLen > pMatcher->ulBufferLen)
         {
-            /* Iterate through attribute list */
-            for (j = 0; j < ulCount; j++)
+            pMatcher->ulBufferLen = pAttr->ulValueLen;
+        }
+
+        if (TRUE == pkcs11_find_is_compiled(pAttr))
+        {
+            if (CKA_CLASS == pAttr->type)
             {
-                /* See if a match failed */
-                if (NULL == pkcs11_find_attrib_match(pObject, pObject->attributes,
-                                                     pObject->count, &pTemplate[j], pSession))
-                {
-                    break;
-                }
+                ppSlot = &pMatcher->pClass;
             }
-            if (j == ulCount)
+            else if (CKA_KEY_TYPE == pAttr->type)
             {
-                /* Full match */
-                if (ulCount != 0u)
-                {
-                    rv = pkcs11_object_cache[i].handle;
-                    break;
-                }
-                else if ((CKO_HW_FEATURE != pObject->class_id) && (CKO_MECHANISM != pObject->class_id))
-                {
-                    /* Special condition where ulCount is zero we match all
-                       objects except HW Features and Mechanisms */
-                    rv = pkcs11_object_cache[i].handle;
-                    break;
-                }
-                else
-                {
-                    /* do nothing */
-                }
+                ppSlot = &pMatcher->pKeyType;
+            }
+            else
+            {
+                ppSlot = &pMatcher->pLabel;
+            }
+
+            if (NULL == *ppSlot)
+            {
+                *ppSlot = pAttr;
+            }
+            else if (((*ppSlot)->ulValueLen != pAttr->ulValueLen) ||
+                     /* coverity[misra_c_2012_rule_21_16_violation:FALSE] CK_VOID_PTR is a pointer type */
+                     (0 != memcmp((*ppSlot)->pValue, pAttr->pValue, pAttr->ulValueLen)))
+            {
+                /* The same attribute is requested with two different values */
+                pMatcher->never = TRUE;
+            }
+            else
+            {
+                /* Duplicate of an attribute already compiled */
             }
         }
     }
+}
+
+/**
+ * \brief Run a compiled matcher against an object - cheap cached fields first
+ * and only then the remaining attributes through their getters
+ */
+static CK_BBOOL pkcs11_find_match(pkcs11_object_ptr pObject, pkcs11_find_matcher * pMatcher, pkcs11_session_ctx_ptr pSession)
+{
+    CK_ULONG i;
+    CK_ULONG len;
 
-    if (NULL != index)
+    if (TRUE == pMatcher->never)
     {
-        *index = i;
+        return FALSE;
     }
 
-    return rv;
-}
+    if (0u == pMatcher->ulCount)
+    {
+        /* Special condition where ulCount is zero we match all
+           objects except HW Features and Mechanisms */
+        return ((CKO_HW_FEATURE != pObject->class_id) && (CKO_MECHANISM != pObject->class_id)) ? TRUE : FALSE;
+    }
+
+    if (NULL != pMatcher->pClass)
+    {
+        if (FALSE == pkcs11_find_cached_match(pObject, pMatcher->pClass, pkcs11_object_get_class, &pObject->class_id,
+                                              (CK_ULONG)sizeof(pObject->class_id), pMatcher, pSession))
+        {
+            return FALSE;
+        }
+    }
+
+    if (NULL != pMatcher->pKeyType)
+    {
+        if (FALSE == pkcs11_find_cached_match(pObject, pMatcher->pKeyType, pkcs11_object_get_type, &pObject->class_type,
+                                              (CK_ULONG)sizeof(pObject->class_type), pMatcher, pSession))
+        {
+            return FALSE;
+        }
+    }
 
+    if (NULL != pMatcher->pLabel)
+    {
+        len = (CK_ULONG)(strlen((char*)pObject->name) & UINT32_MAX);
+        if (FALSE == pkcs11_find_cached_match(pObject, pMatcher->pLabel, pkcs11_object_get_name, pObject->name,
+                                              len, pMatcher, pSession))
+        {
+            return FALSE;
+        }
+    }
+
+    for (i = 0; i < pMatcher->ulCount; i++)
+    {
+        if (FALSE == pkcs11_find_is_compiled(&pMatcher->pTemplate[i]))
+        {
+            if (NULL == pkcs11_find_attrib_match(pObject, &pMatcher->pTemplate[i], pMatcher, pSession))
+            {
+                return FALSE;
+            }
+        }
+    }
+
+    return TRUE;
+}
 
 CK_RV pkcs11_find_init(CK_SESSION_HANDLE hSession, CK_ATTRIBUTE_PTR pTemplate, CK_ULONG ulCount)
 {
     pkcs11_lib_ctx_ptr pLibCtx;
     pkcs11_session_ctx_ptr pSession;
-    CK_ULONG index = 0;
+    pkcs11_find_matcher matcher;
+    CK_ULONG i;
     CK_RV rv;
 
+#ifdef ATCA_NO_HEAP
+    CK_UTF8CHAR buf[PKCS11_MAX_LABEL_SIZE];
+#endif
+
     rv = pkcs11_init_check(&pLibCtx, FALSE);
     if (CKR_OK != rv)
     {
@@ -299,37 +332,48 @@ CK_RV pkcs11_find_init(CK_SESSION_HANDLE hSession, CK_ATTRIBUTE_PTR pTemplate, C
         get private unless we're using a shared key system - and that will only be
         for secured data and not key info */
 
-    if (CKR_OK == (rv = (pkcs11_lock_both(pLibCtx))))
+    pkcs11_find_compile(&matcher, pTemplate, ulCount);
+
+    /* Attribute getters share a single buffer sized for the largest template value */
+#ifdef ATCA_NO_HEAP
+    matcher.pBuffer = buf;
+    matcher.ulBufferLen = sizeof(buf);
+#else
+    if (0u < matcher.ulBufferLen)
     {
-        if (pkcs11_find_handle(pSession->slot->slot_id, pTemplate, ulCount, &index, pSession) != 0u)
+        if (NULL == (matcher.pBuffer = pkcs11_os_malloc(matcher.ulBufferLen)))
         {
-            if (ulCount != 0u)
-            {
-                if (CKR_OK == (rv = pkcs11_find_copy_template(pkcs11_find_template_cache, PKCS11_SEARCH_CACHE_SIZE, pTemplate, ulCount)))
-                {
-                    /* coverity[misra_c_2012_rule_11_3_violation] pkcs11_find manages its own memory cache with a raw buffer */
-                    pSession->attrib_list = (CK_ATTRIBUTE_PTR)pkcs11_find_template_cache;
-                }
-            }
-            else
-            {
-                pSession->attrib_list = NULL;
-            }
-            if (CKR_OK == rv)
+            return CKR_HOST_MEMORY;
+        }
+    }
+#endif
+
+    pSession->object_index = 0;
+    pSession->object_count = 0;
+
+    if (CKR_OK == (rv = (pkcs11_lock_both(pLibCtx, pSession->slot))))
+    {
+        /* Snapshot the matching handles so C_FindObjects only has to copy them out */
+        for (i = 0; i < (CK_ULONG)PKCS11_MAX_OBJECTS_ALLOWED; i++)
+        {
+            pkcs11_object_ptr pObject = pkcs11_object_cache[i].object;
+            if (NULL != pObject && pSession->slot->slot_id == pkcs11_object_cache[i].slotid)
             {
-                pSession->attrib_count = ulCount;
-                pSession->object_index = index;
-                pSession->object_count = 1;
-                index++;
-                while (pkcs11_find_handle(pSession->slot->slot_id, pSession->attrib_list, ulCount, &index, pSession) != 0u)
+                if (TRUE == pkcs11_find_match(pObject, &matcher, pSession))
                 {
-                    pSession->object_count++;
-                    index++;
+                    pSession->find_handles[pSession->object_count++] = pkcs11_object_cache[i].handle;
                 }
             }
         }
-        (void)pkcs11_unlock_both(pLibCtx);
+        (void)pkcs11_unlock_both(pLibCtx, pSession->slot);
+    }
+
+#ifdef ATCA_HEAP
+    if (NULL != matcher.pBuffer)
+    {
+        pkcs11_os_free(matcher.pBuffer);
     }
+#endif
 
     return rv;
 }
@@ -338,7 +382,8 @@ CK_RV pkcs11_find_continue(CK_SESSION_HANDLE hSession, CK_OBJECT_HANDLE_PTR phOb
 {
     pkcs11_lib_ctx_ptr pLibCtx;
     pkcs11_session_ctx_ptr pSession;
-    CK_ULONG i;
+    CK_OBJECT_HANDLE hObject;
+    CK_ULONG count = 0;
     CK_RV rv;
 
     rv = pkcs11_init_check(&pLibCtx, FALSE);
@@ -358,34 +403,23 @@ CK_RV pkcs11_find_continue(CK_SESSION_HANDLE hSession, CK_OBJECT_HANDLE_PTR phOb
         return rv;
     }
 
-    *pulObjectCount = (pSession->object_count < ulMaxObjectCount) ? pSession->object_count : ulMaxObjectCount;
+    *pulObjectCount = 0;
 
-    if (CKR_OK == (rv = (pkcs11_lock_both(pLibCtx))))
+    if (CKR_OK == (rv = pkcs11_lock_context(pLibCtx)))
     {
-        i = 0;
-
-        while (i < *pulObjectCount)
+        /* Objects destroyed since the search started are left out */
+        while ((count < ulMaxObjectCount) && (0u < pSession->object_count))
         {
-            phObject[i] = pkcs11_find_handle(pSession->slot->slot_id, pSession->attrib_list,
-                                             pSession->attrib_count, &pSession->object_index, pSession);
+            hObject = pSession->find_handles[pSession->object_index++];
+            pSession->object_count--;
 
-            if (phObject[i] == 0u)
+            if (CKR_OK == pkcs11_object_check(NULL, hObject))
             {
-                pSession->object_count = 0;
-                *pulObjectCount = i;
-                break;
+                phObject[count++] = hObject;
             }
-
-            pSession->object_index++;
-
-            if (pSession->object_count != 0u)
-            {
-                pSession->object_count--;
-            }
-
-            i++;
         }
-        (void)pkcs11_unlock_both(pLibCtx);
+        *pulObjectCount = count;
+        (void)pkcs11_unlock_context(pLibCtx);
     }
 
     return rv;
@@ -408,8 +442,7 @@ CK_RV pkcs11_find_finish(CK_SESSION_HANDLE hSession)
         return rv;
     }
 
-    pSession->attrib_list = NULL;
-    pSession->attrib_count = 0;
+    pSession->object_index = 0;
     pSession->object_count = 0;
 
     return CKR_OK;
@@ -476,12 +509,12 @@ CK_RV pkcs11_find_get_attribute(CK_SESSION_HANDLE hSession, CK_OBJECT_HANDLE hOb
         else if (NULL != pAttribute->func)
         {
             /* coverity[cert_con39_c_violation:FALSE] pkcs11_lock_both does not retain a lock for any return code other than CKR_OK */
-            if (CKR_OK == pkcs11_lock_both(pLibCtx))
+            if (CKR_OK == pkcs11_lock_both(pLibCtx, pSession->slot))
             {
                 /* Attribute function found so try to execute it */
                 CK_RV temp = pAttribute->func(pObject, &pTemplate[i], pSession);
                 rv = temp;
-                (void)pkcs11_unlock_both(pLibCtx);
+                (void)pkcs11_unlock_both(pLibCtx, pSession->slot);
             }
             else if (CKR_OK == rv)
             {
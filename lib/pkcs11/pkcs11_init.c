@@ -69,7 +69,15 @@ pkcs11_lib_ctx_ptr pkcs11_get_context(void)
     return &pkcs11_context;
 }
 
-CK_RV pkcs11_lock_context(pkcs11_lib_ctx_ptr pContext)
+/**
+ * \brief Acquire the library lock that protects the session and object tables
+ *
+ * Locks are always taken in the order: library lock, slot device locks in
+ * ascending slot order, then the cache lock. If the application supplied its
+ * own mutex callbacks the library lock is that mutex and shared holders are
+ * serialized like exclusive ones.
+ */
+static CK_RV pkcs11_lock_context_mode(pkcs11_lib_ctx_ptr pContext, CK_BBOOL exclusive)
 {
     CK_RV rv = CKR_CRYPTOKI_NOT_INITIALIZED;
 
@@ -93,9 +101,9 @@ CK_RV pkcs11_lock_context(pkcs11_lib_ctx_ptr pContext)
             }
         }
         #if defined(_WIN32) || defined(__linux__) || defined(__APPLE__)
-        else if ((NULL != pContext->dev_state) && (pContext->dev_lock_enabled))
+        else if (pContext->os_locks_init)
         {
-            rv = pkcs11_os_lock_mutex(&pContext->dev_state->dev_lock);
+            rv = pkcs11_os_lock_rwlock(&pContext->table_lock, exclusive);
         }
         #endif
         else
@@ -103,10 +111,11 @@ CK_RV pkcs11_lock_context(pkcs11_lib_ctx_ptr pContext)
             rv = CKR_OK;
         }
     }
+    ((void)exclusive);
     return rv;
 }
 
-CK_RV pkcs11_unlock_context(pkcs11_lib_ctx_ptr pContext)
+static CK_RV pkcs11_unlock_context_mode(pkcs11_lib_ctx_ptr pContext, CK_BBOOL exclusive)
 {
     CK_RV rv = CKR_CRYPTOKI_NOT_INITIALIZED;
 
@@ -129,9 +138,9 @@ CK_RV pkcs11_unlock_context(pkcs11_lib_ctx_ptr pContext)
             }
         }
         #if defined(_WIN32) || defined(__linux__) || defined(__APPLE__)
-        else if ((NULL != pContext->dev_state) && (pContext->dev_lock_enabled))
+        else if (pContext->os_locks_init)
         {
-            rv = pkcs11_os_unlock_mutex(&pContext->dev_state->dev_lock);
+            rv = pkcs11_os_unlock_rwlock(&pContext->table_lock, exclusive);
         }
         #endif
         else
@@ -139,35 +148,298 @@ CK_RV pkcs11_unlock_context(pkcs11_lib_ctx_ptr pContext)
             rv = CKR_OK;
         }
     }
+    ((void)exclusive);
+    return rv;
+}
+
+/**
+ * \brief Take the library lock shared - for operations that only look up
+ * sessions and objects
+ */
+CK_RV pkcs11_lock_context(pkcs11_lib_ctx_ptr pContext)
+{
+    return pkcs11_lock_context_mode(pContext, FALSE);
+}
+
+CK_RV pkcs11_unlock_context(pkcs11_lib_ctx_ptr pContext)
+{
+    return pkcs11_unlock_context_mode(pContext, FALSE);
+}
+
+/**
+ * \brief Take the library lock exclusively - for operations that add or
+ * remove sessions and objects
+ */
+CK_RV pkcs11_lock_context_exclusive(pkcs11_lib_ctx_ptr pContext)
+{
+    return pkcs11_lock_context_mode(pContext, TRUE);
+}
+
+CK_RV pkcs11_unlock_context_exclusive(pkcs11_lib_ctx_ptr pContext)
+{
+    return pkcs11_unlock_context_mode(pContext, TRUE);
+}
+
+#if defined(_WIN32) || defined(__linux__) || defined(__APPLE__)
+/* Shortest and longest poll interval while waiting for a ticket to come up */
+#define PKCS11_DEV_POLL_MIN_US      (50u)
+#define PKCS11_DEV_POLL_MAX_US      (1000u)
+
+/* Retire the ticket at the head of the queue - called with the slot lock held.
+   The next ticket gets the same grace to claim the device as a holder gets to
+   use it before anyone checks on its process */
+static void pkcs11_dev_sched_advance(pkcs11_dev_sched * pSched, uint32_t now)
+{
+    pSched->waiters[pSched->now_serving % PKCS11_DEV_QUEUE_SIZE] = 0;
+    pSched->holder = 0;
+    pSched->holder_tid = 0;
+    pSched->depth = 0;
+    pSched->deadline_ms = now + PKCS11_DEV_HOLD_TIMEOUT_MS;
+    pSched->now_serving++;
+}
+
+/* Reclaim the head of the queue if the process holding or waiting on it has
+   died - called with the slot lock held */
+static void pkcs11_dev_sched_recover(pkcs11_dev_sched * pSched, uint32_t now)
+{
+    if (0 != pSched->holder)
+    {
+        /* Only start checking on the owner once it has overrun its deadline */
+        if ((0 <= (int32_t)(now - pSched->deadline_ms)) && (0 != hal_check_pid(pSched->holder)))
+        {
+            PKCS11_DEBUG("Reclaiming device from terminated process %d\n", (int)pSched->holder);
+            pkcs11_dev_sched_advance(pSched, now);
+            pSched->stats.recovered++;
+        }
+    }
+    else if (pSched->now_serving != pSched->next_ticket)
+    {
+        hal_pid_t waiter = pSched->waiters[pSched->now_serving % PKCS11_DEV_QUEUE_SIZE];
+
+        /* A waiter may simply not have polled yet so give it until the deadline */
+        if ((0 != waiter) && (0 <= (int32_t)(now - pSched->deadline_ms)) && (0 != hal_check_pid(waiter)))
+        {
+            PKCS11_DEBUG("Reclaiming ticket from terminated process %d\n", (int)waiter);
+            pkcs11_dev_sched_advance(pSched, now);
+            pSched->stats.recovered++;
+        }
+    }
+    else
+    {
+        /* Nobody holds or waits for the device */
+    }
+}
+
+/**
+ * \brief Take ownership of a device
+ *
+ * Requests are served strictly in the order they were made regardless of
+ * which process made them. The slot lock only guards the scheduler state so
+ * it is never held while the device is in use.
+ */
+static CK_RV pkcs11_dev_acquire(pkcs11_dev_res * pRes)
+{
+    pkcs11_dev_sched * pSched = &pRes->sched;
+    hal_pid_t pid = hal_get_pid();
+    hal_pid_t tid = hal_get_thread_id();
+    uint32_t delay_us = PKCS11_DEV_POLL_MIN_US;
+    CK_BBOOL waited = FALSE;
+    uint32_t start;
+    uint32_t ticket;
+    uint32_t now;
+    CK_RV rv;
+
+    if (CKR_OK != (rv = pkcs11_os_lock_mutex(&pRes->dev_lock)))
+    {
+        return rv;
+    }
+
+    if ((pid == pSched->holder) && (tid == pSched->holder_tid))
+    {
+        /* Already owned by this thread */
+        pSched->depth++;
+        return pkcs11_os_unlock_mutex(&pRes->dev_lock);
+    }
+
+    start = hal_get_timestamp_ms();
+    now = start;
+
+    do
+    {
+        /* Wait for a place in the queue, then for our ticket to come up */
+        while (CKR_OK == rv)
+        {
+            pkcs11_dev_sched_recover(pSched, now);
+
+            if ((pSched->next_ticket - pSched->now_serving) < PKCS11_DEV_QUEUE_SIZE)
+            {
+                break;
+            }
+            (void)pkcs11_os_unlock_mutex(&pRes->dev_lock);
+            hal_delay_us(delay_us);
+            delay_us = (PKCS11_DEV_POLL_MAX_US > (delay_us * 2u)) ? (delay_us * 2u) : PKCS11_DEV_POLL_MAX_US;
+            waited = TRUE;
+            rv = pkcs11_os_lock_mutex(&pRes->dev_lock);
+            now = hal_get_timestamp_ms();
+        }
+
+        if (CKR_OK != rv)
+        {
+            return rv;
+        }
+
+        ticket = pSched->next_ticket++;
+        pSched->waiters[ticket % PKCS11_DEV_QUEUE_SIZE] = pid;
+
+        while (0 < (int32_t)(ticket - pSched->now_serving))
+        {
+            (void)pkcs11_os_unlock_mutex(&pRes->dev_lock);
+            hal_delay_us(delay_us);
+            delay_us = (PKCS11_DEV_POLL_MAX_US > (delay_us * 2u)) ? (delay_us * 2u) : PKCS11_DEV_POLL_MAX_US;
+            waited = TRUE;
+            if (CKR_OK != (rv = pkcs11_os_lock_mutex(&pRes->dev_lock)))
+            {
+                return rv;
+            }
+            now = hal_get_timestamp_ms();
+            pkcs11_dev_sched_recover(pSched, now);
+        }
+        /* A ticket that was passed over (its process presumed dead) will never
+           be served so get back in line with a new one */
+    } while (ticket != pSched->now_serving);
+
+    pSched->holder = pid;
+    pSched->holder_tid = tid;
+    pSched->depth = 1;
+    pSched->acquired_ms = now;
+    pSched->deadline_ms = now + PKCS11_DEV_HOLD_TIMEOUT_MS;
+
+    pSched->stats.acquired++;
+    if (waited)
+    {
+        uint32_t wait_ms = now - start;
+
+        pSched->stats.contended++;
+        pSched->stats.wait_ms_total += wait_ms;
+        if (wait_ms > pSched->stats.wait_ms_max)
+        {
+            pSched->stats.wait_ms_max = wait_ms;
+        }
+    }
+
+    return pkcs11_os_unlock_mutex(&pRes->dev_lock);
+}
+
+/**
+ * \brief Give up ownership of a device and pass it to the next ticket
+ */
+static CK_RV pkcs11_dev_release(pkcs11_dev_res * pRes)
+{
+    pkcs11_dev_sched * pSched = &pRes->sched;
+    CK_RV rv;
+
+    if (CKR_OK != (rv = pkcs11_os_lock_mutex(&pRes->dev_lock)))
+    {
+        return rv;
+    }
+
+    if ((hal_get_pid() == pSched->holder) && (hal_get_thread_id() == pSched->holder_tid))
+    {
+        if (1u < pSched->depth)
+        {
+            pSched->depth--;
+        }
+        else
+        {
+            uint32_t now = hal_get_timestamp_ms();
+            uint32_t hold_ms = now - pSched->acquired_ms;
+
+            if (hold_ms > pSched->stats.hold_ms_max)
+            {
+                pSched->stats.hold_ms_max = hold_ms;
+            }
+            if (0 < (int32_t)(now - pSched->deadline_ms))
+            {
+                pSched->stats.overruns++;
+            }
+            pkcs11_dev_sched_advance(pSched, now);
+        }
+    }
+    else
+    {
+        /* The device is not owned by this thread */
+        rv = CKR_GENERAL_ERROR;
+    }
+
+    (void)pkcs11_os_unlock_mutex(&pRes->dev_lock);
 
     return rv;
 }
+#endif
 
-CK_RV pkcs11_lock_device(pkcs11_lib_ctx_ptr pContext)
+/**
+ * \brief Lock the device of a slot, or every slot when pSlot is NULL
+ *
+ * Device ownership is tracked in the shared device state so it is arbitrated
+ * between processes as well as threads.
+ */
+CK_RV pkcs11_lock_device(pkcs11_lib_ctx_ptr pContext, pkcs11_slot_ctx_ptr pSlot)
 {
     CK_RV rv = CKR_OK;
 
 #if defined(_WIN32) || defined(__linux__) || defined(__APPLE__)
+    if (NULL == pContext)
+    {
+        pContext = pkcs11_get_context();
+    }
+
     if (NULL != pContext)
     {
         if ((NULL != pContext->dev_state) && (pContext->dev_lock_enabled))
         {
-            if (NULL != pContext->lib_lock)
+            if (NULL != pSlot)
+            {
+                if (PKCS11_MAX_SLOTS_ALLOWED > pSlot->slot_id)
+                {
+                    rv = pkcs11_dev_acquire(&pContext->dev_state->resources[pSlot->slot_id]);
+                }
+                else
+                {
+                    rv = CKR_SLOT_ID_INVALID;
+                }
+            }
+            else
             {
-                rv = pkcs11_os_lock_mutex(&pContext->dev_state->dev_lock);
+                CK_ULONG i;
+
+                for (i = 0; i < PKCS11_MAX_SLOTS_ALLOWED; i++)
+                {
+                    if (CKR_OK != (rv = pkcs11_dev_acquire(&pContext->dev_state->resources[i])))
+                    {
+                        while (0u < i)
+                        {
+                            i--;
+                            (void)pkcs11_dev_release(&pContext->dev_state->resources[i]);
+                        }
+                        break;
+                    }
+                }
             }
         }
     }
+#else
+    ((void)pContext);
+    ((void)pSlot);
 #endif
 
     return rv;
 }
 
-CK_RV pkcs11_unlock_device(pkcs11_lib_ctx_ptr pContext)
+CK_RV pkcs11_unlock_device(pkcs11_lib_ctx_ptr pContext, pkcs11_slot_ctx_ptr pSlot)
 {
     CK_RV rv = CKR_OK;
 
- #if defined(_WIN32) || defined(__linux__) || defined(__APPLE__)
+#if defined(_WIN32) || defined(__linux__) || defined(__APPLE__)
     if (NULL == pContext)
     {
         pContext = pkcs11_get_context();
@@ -177,32 +449,98 @@ CK_RV pkcs11_unlock_device(pkcs11_lib_ctx_ptr pContext)
     {
         if ((NULL != pContext->dev_state) && (pContext->dev_lock_enabled))
         {
-            if (NULL != pContext->lib_lock)
+            if (NULL != pSlot)
+            {
+                if (PKCS11_MAX_SLOTS_ALLOWED > pSlot->slot_id)
+                {
+                    rv = pkcs11_dev_release(&pContext->dev_state->resources[pSlot->slot_id]);
+                }
+                else
+                {
+                    rv = CKR_SLOT_ID_INVALID;
+                }
+            }
+            else
             {
-                rv = pkcs11_os_unlock_mutex(&pContext->dev_state->dev_lock);
+                CK_ULONG i = PKCS11_MAX_SLOTS_ALLOWED;
+
+                while (0u < i)
+                {
+                    CK_RV tmp;
+                    i--;
+                    if (CKR_OK != (tmp = pkcs11_dev_release(&pContext->dev_state->resources[i])))
+                    {
+                        rv = tmp;
+                    }
+                }
             }
         }
     }
- #endif
+#else
+    ((void)pContext);
+    ((void)pSlot);
+#endif
+
+    return rv;
+}
+
+#if defined(_WIN32) || defined(__linux__) || defined(__APPLE__)
+/**
+ * \brief Retrieve the device arbitration statistics of a slot. The counters
+ * are kept in the shared device state so they cover every process using the
+ * device.
+ */
+CK_RV pkcs11_get_device_stats(CK_SLOT_ID slotID, pkcs11_dev_stats * pStats)
+{
+    pkcs11_lib_ctx_ptr lib_ctx = pkcs11_get_context();
+    pkcs11_slot_ctx_ptr slot_ctx;
+    pkcs11_dev_res * pRes;
+    CK_RV rv;
+
+    if (NULL == pStats)
+    {
+        return CKR_ARGUMENTS_BAD;
+    }
+
+    if ((NULL == lib_ctx) || (FALSE == lib_ctx->initialized) || (NULL == lib_ctx->dev_state))
+    {
+        return CKR_CRYPTOKI_NOT_INITIALIZED;
+    }
+
+    slot_ctx = pkcs11_slot_get_context(lib_ctx, slotID);
+
+    if ((NULL == slot_ctx) || (PKCS11_MAX_SLOTS_ALLOWED <= slot_ctx->slot_id))
+    {
+        return CKR_SLOT_ID_INVALID;
+    }
+
+    pRes = &lib_ctx->dev_state->resources[slot_ctx->slot_id];
+
+    if (CKR_OK == (rv = pkcs11_os_lock_mutex(&pRes->dev_lock)))
+    {
+        *pStats = pRes->sched.stats;
+        (void)pkcs11_os_unlock_mutex(&pRes->dev_lock);
+    }
 
     return rv;
 }
+#endif
 
-CK_RV pkcs11_lock_both(pkcs11_lib_ctx_ptr pContext)
+static CK_RV pkcs11_lock_both_mode(pkcs11_lib_ctx_ptr pContext, pkcs11_slot_ctx_ptr pSlot, CK_BBOOL exclusive)
 {
     CK_RV rv = CKR_OK;
 
-    if (CKR_OK == (rv = pkcs11_lock_context(pContext)))
+    if (CKR_OK == (rv = pkcs11_lock_context_mode(pContext, exclusive)))
     {
-        if (CKR_OK != (rv = pkcs11_lock_device(pContext)))
+        if (CKR_OK != (rv = pkcs11_lock_device(pContext, pSlot)))
         {
-            (void)pkcs11_unlock_context(pContext);
+            (void)pkcs11_unlock_context_mode(pContext, exclusive);
         }
     }
     return rv;
 }
 
-CK_RV pkcs11_unlock_both(pkcs11_lib_ctx_ptr pContext)
+static CK_RV pkcs11_unlock_both_mode(pkcs11_lib_ctx_ptr pContext, pkcs11_slot_ctx_ptr pSlot, CK_BBOOL exclusive)
 {
     CK_RV rv1 = CKR_OK;
     CK_RV rv2 = CKR_OK;
@@ -212,12 +550,85 @@ CK_RV pkcs11_unlock_both(pkcs11_lib_ctx_ptr pContext)
         pContext = pkcs11_get_context();
     }
 
-    rv1 = pkcs11_unlock_device(pContext);
-    rv2 = pkcs11_unlock_context(pContext);
+    rv1 = pkcs11_unlock_device(pContext, pSlot);
+    rv2 = pkcs11_unlock_context_mode(pContext, exclusive);
 
     return CKR_OK != rv1 ? rv1 : rv2;
 }
 
+/**
+ * \brief Take the library lock shared and the device lock of the slot
+ */
+CK_RV pkcs11_lock_both(pkcs11_lib_ctx_ptr pContext, pkcs11_slot_ctx_ptr pSlot)
+{
+    return pkcs11_lock_both_mode(pContext, pSlot, FALSE);
+}
+
+CK_RV pkcs11_unlock_both(pkcs11_lib_ctx_ptr pContext, pkcs11_slot_ctx_ptr pSlot)
+{
+    return pkcs11_unlock_both_mode(pContext, pSlot, FALSE);
+}
+
+/**
+ * \brief Take the library lock exclusively and the device lock of the slot
+ */
+CK_RV pkcs11_lock_both_exclusive(pkcs11_lib_ctx_ptr pContext, pkcs11_slot_ctx_ptr pSlot)
+{
+    return pkcs11_lock_both_mode(pContext, pSlot, TRUE);
+}
+
+CK_RV pkcs11_unlock_both_exclusive(pkcs11_lib_ctx_ptr pContext, pkcs11_slot_ctx_ptr pSlot)
+{
+    return pkcs11_unlock_both_mode(pContext, pSlot, TRUE);
+}
+
+/**
+ * \brief Lock the key and certificate caches which are shared by all slots.
+ * Only needed while claiming or releasing cache entries.
+ */
+CK_RV pkcs11_lock_cache(pkcs11_lib_ctx_ptr pContext)
+{
+    CK_RV rv = CKR_OK;
+
+#if defined(_WIN32) || defined(__linux__) || defined(__APPLE__)
+    if (NULL == pContext)
+    {
+        pContext = pkcs11_get_context();
+    }
+
+    if ((NULL != pContext) && (NULL == pContext->lib_lock) && (pContext->os_locks_init))
+    {
+        rv = pkcs11_os_lock_rwlock(&pContext->cache_lock, TRUE);
+    }
+#else
+    /* The library lock serializes everything on these platforms */
+    ((void)pContext);
+#endif
+
+    return rv;
+}
+
+CK_RV pkcs11_unlock_cache(pkcs11_lib_ctx_ptr pContext)
+{
+    CK_RV rv = CKR_OK;
+
+#if defined(_WIN32) || defined(__linux__) || defined(__APPLE__)
+    if (NULL == pContext)
+    {
+        pContext = pkcs11_get_context();
+    }
+
+    if ((NULL != pContext) && (NULL == pContext->lib_lock) && (pContext->os_locks_init))
+    {
+        rv = pkcs11_os_unlock_rwlock(&pContext->cache_lock, TRUE);
+    }
+#else
+    ((void)pContext);
+#endif
+
+    return rv;
+}
+
 /**
  * \brief Check if the library is initialized properly
  */
@@ -377,8 +788,24 @@ CK_RV pkcs11_init(CK_C_INITIALIZE_ARGS const *pInitArgs)
         }
     }
 
+#if defined(_WIN32) || defined(__linux__) || defined(__APPLE__)
+    if (!lib_ctx->os_locks_init)
+    {
+        if (CKR_OK != (rv = pkcs11_os_init_rwlock(&lib_ctx->table_lock)))
+        {
+            return rv;
+        }
+        if (CKR_OK != (rv = pkcs11_os_init_rwlock(&lib_ctx->cache_lock)))
+        {
+            (void)pkcs11_os_destroy_rwlock(&lib_ctx->table_lock);
+            return rv;
+        }
+        lib_ctx->os_locks_init = TRUE;
+    }
+#endif
+
     /* Lock the library context */
-    if (CKR_OK == (rv = pkcs11_lock_context(lib_ctx)))
+    if (CKR_OK == (rv = pkcs11_lock_context_exclusive(lib_ctx)))
     {
         /* Save off the arguments passed to the library from the application for future access */
         (void)memcpy(&lib_ctx->init_args, pInitArgs, sizeof(CK_C_INITIALIZE_ARGS));
@@ -399,13 +826,13 @@ CK_RV pkcs11_init(CK_C_INITIALIZE_ARGS const *pInitArgs)
             // Get the number of slots
             if (CKR_OK == (rv = pkcs11_slot_get_list(TRUE, slotList, &slotCount)))
             {
-                if (CKR_OK == (rv = pkcs11_lock_device(lib_ctx)))
+                if (CKR_OK == (rv = pkcs11_lock_device(lib_ctx, NULL)))
                 {
                     for (CK_ULONG i = 0; i < slotCount; i++)
                     {
                         rv = pkcs11_slot_init(slotList[i]);
                     }
-                    (void)pkcs11_unlock_device(lib_ctx);
+                    (void)pkcs11_unlock_device(lib_ctx, NULL);
                 }
             }
             /* List obtained reset library context initialized*/
@@ -418,7 +845,7 @@ CK_RV pkcs11_init(CK_C_INITIALIZE_ARGS const *pInitArgs)
             lib_ctx->initialized = TRUE;
         }
 
-        (void)pkcs11_unlock_context(lib_ctx);
+        (void)pkcs11_unlock_context_exclusive(lib_ctx);
     }
 
     return rv;
@@ -442,10 +869,18 @@ CK_RV pkcs11_deinit(CK_VOID_PTR pReserved)
         return CKR_CRYPTOKI_NOT_INITIALIZED;
     }
 
+    /* Close all the sessions that might be open - closing a session takes the
+       library lock itself so this has to happen before the lock is held */
+    for (; ulSlot < pkcs11_context.slot_cnt; ulSlot++)
+    {
+        pkcs11_slot_ctx_ptr slot_ctx_ptr = &((pkcs11_slot_ctx_ptr)(pkcs11_context.slots))[ulSlot];
+        (void)pkcs11_session_closeall(slot_ctx_ptr->slot_id);
+    }
+
     /* Lock the library */
-    if (CKR_OK == (rv = pkcs11_lock_context(lib_ctx)))
+    if (CKR_OK == (rv = pkcs11_lock_context_exclusive(lib_ctx)))
     {
-        if (CKR_OK == pkcs11_lock_device(lib_ctx))
+        if (CKR_OK == pkcs11_lock_device(lib_ctx, NULL))
         {
 #if (ATCA_TA_SUPPORT && TALIB_AUTH_EN)
 
@@ -487,14 +922,7 @@ CK_RV pkcs11_deinit(CK_VOID_PTR pReserved)
             }
 
             /* No more device communciation will be occuring */
-            (void)pkcs11_unlock_device(lib_ctx);
-        }
-
-        /* Close all the sessions that might be open */
-        for (; ulSlot < pkcs11_context.slot_cnt; ulSlot++)
-        {
-            pkcs11_slot_ctx_ptr slot_ctx_ptr = &((pkcs11_slot_ctx_ptr)(pkcs11_context.slots))[ulSlot];
-            (void)pkcs11_session_closeall(slot_ctx_ptr->slot_id);
+            (void)pkcs11_unlock_device(lib_ctx, NULL);
         }
 
         /* Clear the object cache */
@@ -508,7 +936,7 @@ CK_RV pkcs11_deinit(CK_VOID_PTR pReserved)
            that is done by this simplified mutex API is yet to be determined */
 
         /* the library is now closing */
-        (void)pkcs11_unlock_context(lib_ctx);
+        (void)pkcs11_unlock_context_exclusive(lib_ctx);
 
         /* Release our shared context */
         (void)pkcs11_os_free_shared_ctx(lib_ctx->dev_state, sizeof(pkcs11_dev_state));
@@ -528,6 +956,15 @@ CK_RV pkcs11_deinit(CK_VOID_PTR pReserved)
         }
 
         pkcs11_context.initialized = FALSE;
+
+#if defined(_WIN32) || defined(__linux__) || defined(__APPLE__)
+        if (lib_ctx->os_locks_init)
+        {
+            (void)pkcs11_os_destroy_rwlock(&lib_ctx->cache_lock);
+            (void)pkcs11_os_destroy_rwlock(&lib_ctx->table_lock);
+            lib_ctx->os_locks_init = FALSE;
+        }
+#endif
     }
 
     return rv;
@@ -58,18 +58,65 @@ typedef struct
 #endif
 } pkcs11_dev_ctx;
 
+#if defined(_WIN32) || defined(__linux__) || defined(__APPLE__)
+/** Device arbitration statistics - accumulated across every process sharing the device */
+typedef struct
+{
+    /** Number of times the device was acquired */
+    uint32_t acquired;
+    /** Acquisitions that had to wait behind another holder */
+    uint32_t contended;
+    /** Total time spent waiting for the device in milliseconds */
+    uint64_t wait_ms_total;
+    /** Longest single wait in milliseconds */
+    uint32_t wait_ms_max;
+    /** Longest single hold in milliseconds */
+    uint32_t hold_ms_max;
+    /** Holds that ran past their deadline */
+    uint32_t overruns;
+    /** Tickets reclaimed from processes that died while holding or waiting */
+    uint32_t recovered;
+} pkcs11_dev_stats;
+
+/** Ticket based FIFO that hands out the device in request order across processes */
+typedef struct
+{
+    /** Next ticket to hand out */
+    uint32_t  next_ticket;
+    /** Ticket currently allowed to own the device */
+    uint32_t  now_serving;
+    /** Process that owns the device (0 when free) */
+    hal_pid_t holder;
+    /** Thread that owns the device */
+    hal_pid_t holder_tid;
+    /** Nested acquisitions by the owning thread */
+    uint32_t  depth;
+    /** Time the device was acquired */
+    uint32_t  acquired_ms;
+    /** After this time waiters start checking the owner is still alive */
+    uint32_t  deadline_ms;
+    /** Process waiting on each outstanding ticket */
+    hal_pid_t waiters[PKCS11_DEV_QUEUE_SIZE];
+    pkcs11_dev_stats stats;
+} pkcs11_dev_sched;
+#endif
+
 /** Reservable Device Resources */
 typedef struct
 {
+    /** Lock to protect the scheduler state of the device in this slot */
+    hal_mutex_t    dev_lock;
+#if defined(_WIN32) || defined(__linux__) || defined(__APPLE__)
+    /** Arbitrates ownership of the device between threads and processes */
+    pkcs11_dev_sched sched;
+#endif
     pkcs11_dev_ctx contexts[PKCS11_MAX_DEV_CTX];
 } pkcs11_dev_res;
 
 /** Device state tracker structure */
 typedef struct
 {
-    /** Lock to protect concurent access to the device */
-    hal_mutex_t dev_lock;
-    /** Track the usage of device resources*/
+    /** Track the usage of device resources - each slot has its own lock */
     pkcs11_dev_res resources[PKCS11_MAX_SLOTS_ALLOWED];
 } pkcs11_dev_state;
 
@@ -82,6 +129,15 @@ typedef struct pkcs11_lib_ctx_s
     CK_C_INITIALIZE_ARGS init_args;
     /** Application Lock for concurrent access to the library if the application will be using threads */
     CK_VOID_PTR lib_lock;
+#if defined(_WIN32) || defined(__linux__) || defined(__APPLE__)
+    /** Reader/writer lock for the session and object tables - used when the
+        application has not supplied its own mutex callbacks */
+    pkcs11_os_rwlock_t table_lock;
+    /** Lock for the key and certificate caches that are shared between slots */
+    pkcs11_os_rwlock_t cache_lock;
+    /** Flag to indicate the process local locks have been initialized */
+    CK_BBOOL os_locks_init;
+#endif
     /** Device State state and Lock (if configured) */
     pkcs11_dev_state* dev_state;
     /** Flag to indicate if a device lock is enabled and configured */
@@ -108,11 +164,22 @@ CK_RV pkcs11_init_check(pkcs11_lib_ctx_ptr * ppContext, CK_BBOOL lock);
 pkcs11_lib_ctx_ptr pkcs11_get_context(void);
 CK_RV pkcs11_lock_context(pkcs11_lib_ctx_ptr pContext);
 CK_RV pkcs11_unlock_context(pkcs11_lib_ctx_ptr pContext);
+CK_RV pkcs11_lock_context_exclusive(pkcs11_lib_ctx_ptr pContext);
+CK_RV pkcs11_unlock_context_exclusive(pkcs11_lib_ctx_ptr pContext);
+
+CK_RV pkcs11_lock_device(pkcs11_lib_ctx_ptr pContext, pkcs11_slot_ctx_ptr pSlot);
+CK_RV pkcs11_unlock_device(pkcs11_lib_ctx_ptr pContext, pkcs11_slot_ctx_ptr pSlot);
 
-CK_RV pkcs11_lock_device(pkcs11_lib_ctx_ptr pContext);
-CK_RV pkcs11_unlock_device(pkcs11_lib_ctx_ptr pContext);
+CK_RV pkcs11_lock_both(pkcs11_lib_ctx_ptr pContext, pkcs11_slot_ctx_ptr pSlot);
+CK_RV pkcs11_unlock_both(pkcs11_lib_ctx_ptr pContext, pkcs11_slot_ctx_ptr pSlot);
+CK_RV pkcs11_lock_both_exclusive(pkcs11_lib_ctx_ptr pContext, pkcs11_slot_ctx_ptr pSlot);
+CK_RV pkcs11_unlock_both_exclusive(pkcs11_lib_ctx_ptr pContext, pkcs11_slot_ctx_ptr pSlot);
 
-CK_RV pkcs11_lock_both(pkcs11_lib_ctx_ptr pContext);
-CK_RV pkcs11_unlock_both(pkcs11_lib_ctx_ptr pContext);
+CK_RV pkcs11_lock_cache(pkcs11_lib_ctx_ptr pContext);
+CK_RV pkcs11_unlock_cache(pkcs11_lib_ctx_ptr pContext);
+
+#if defined(_WIN32) || defined(__linux__) || defined(__APPLE__)
+CK_RV pkcs11_get_device_stats(CK_SLOT_ID slotID, pkcs11_dev_stats * pStats);
+#endif
 
 #endif /* PKCS11_INIT_H_ */
@@ -1292,15 +1292,21 @@ static CK_RV pkcs11_key_load_key_id_cache(const pkcs11_session_ctx_ptr pSession,
         if (NULL == pObject->data)
         {
             rv = CKR_HOST_MEMORY;
-            /* Find free key ID cache slot*/
+            /* Find and claim a free key ID cache slot - the list is shared by all slots */
+            if (CKR_OK != pkcs11_lock_cache(NULL))
+            {
+                return CKR_CANT_LOCK;
+            }
             for (i = 0U; i < PKCS11_MAX_KEYS_CACHED; i++)
             {
                 //Check for free slots
                 if (FALSE == pkcs11_key_cache_list[i].in_use)
                 {
+                    pkcs11_key_cache_list[i].in_use = TRUE;
                     break;
                 }
             }
+            (void)pkcs11_unlock_cache(NULL);
 
             if (i < PKCS11_MAX_KEYS_CACHED)
             {
@@ -1330,6 +1336,11 @@ static CK_RV pkcs11_key_load_key_id_cache(const pkcs11_session_ctx_ptr pSession,
                         pkcs11_os_free(key_id_object_ptr);
                     }
                 }
+
+                if (CKR_OK != rv)
+                {
+                    pkcs11_key_cache_list[i].in_use = FALSE;
+                }
             }
         }
         else
@@ -1854,7 +1865,9 @@ CK_RV pkcs11_key_generate
     pkcs11_object_ptr pKey = NULL;
     CK_ULONG i;
     CK_RV rv = CKR_OK;
+    CK_RV lock_rv;
     ATCA_STATUS status = ATCA_SUCCESS;
+    CK_FLAGS flags = 0;
 
     rv = pkcs11_init_check(&pLibCtx, FALSE);
     if (CKR_OK != rv)
@@ -1896,6 +1909,14 @@ CK_RV pkcs11_key_generate
         return CKR_TEMPLATE_INCONSISTENT;
     }
 
+    /* New objects change the object table so the library is held exclusively
+       while they are created. It is released for the device operation so key
+       generation on other slots only waits for the table update */
+    if (CKR_OK != (rv = pkcs11_lock_context_exclusive(pLibCtx)))
+    {
+        return rv;
+    }
+
     /* Must create object for secret key*/
 
     rv = pkcs11_object_alloc(pSession->slot->slot_id, &pKey);
@@ -1911,61 +1932,87 @@ CK_RV pkcs11_key_generate
 
     if (CKR_OK == rv)
     {
-        if (CKR_OK == (rv = pkcs11_lock_both(pLibCtx)))
+        /* The object can't be destroyed until its key has been generated */
+        flags = pKey->flags & PKCS11_OBJECT_FLAG_DESTROYABLE;
+        pKey->flags &= PKCS11_OBJECT_FLAG_DESTROYABLE_COMPLEMENT;
+    }
+    else if (NULL != pKey)
+    {
+        (void)pkcs11_object_free(pKey);
+    }
+    else
+    {
+        /* do nothing */
+    }
+
+    (void)pkcs11_unlock_context_exclusive(pLibCtx);
+
+    if (CKR_OK != rv)
+    {
+        return rv;
+    }
+
+    if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
+    {
+        if (atcab_is_ca_device(atcab_get_device_type_ext(pSession->slot->device_ctx)))
         {
-            if (atcab_is_ca_device(atcab_get_device_type_ext(pSession->slot->device_ctx)))
-            {
 #if ATCA_CA_SUPPORT
-                uint8_t buf[32] = { 0 };
-                atecc508a_config_t * pConfig = (atecc508a_config_t*)pKey->config;
+            uint8_t buf[32] = { 0 };
+            atecc508a_config_t * pConfig = (atecc508a_config_t*)pKey->config;
 
-                if ((0x0010u == (pConfig->KeyConfig[pKey->slot] & 0x0018u)) || (0x0008u == (pConfig->KeyConfig[pKey->slot] & 0x0018u)))
+            if ((0x0010u == (pConfig->KeyConfig[pKey->slot] & 0x0018u)) || (0x0008u == (pConfig->KeyConfig[pKey->slot] & 0x0018u)))
+            {
+                if (0x2000u == (pConfig->SlotConfig[pKey->slot] & 0x2000u))
                 {
-                    if (0x2000u == (pConfig->SlotConfig[pKey->slot] & 0x2000u))
+                    if (ATCA_SUCCESS == (status = atcab_nonce_rand_ext(pSession->slot->device_ctx, buf, NULL)))
                     {
-                        if (ATCA_SUCCESS == (status = atcab_nonce_rand_ext(pSession->slot->device_ctx, buf, NULL)))
-                        {
-                            status = atcab_derivekey_ext(pSession->slot->device_ctx, 0, pKey->slot, NULL);
-                        }
+                        status = atcab_derivekey_ext(pSession->slot->device_ctx, 0, pKey->slot, NULL);
                     }
-                    else
+                }
+                else
+                {
+                    if (ATCA_SUCCESS == (status = atcab_random_ext(pSession->slot->device_ctx, buf)))
                     {
-                        if (ATCA_SUCCESS == (status = atcab_random_ext(pSession->slot->device_ctx, buf)))
-                        {
-                            status = atcab_write_bytes_zone_ext(pSession->slot->device_ctx, ATCA_ZONE_DATA, pKey->slot, 0, buf, 32);
-                        }
+                        status = atcab_write_bytes_zone_ext(pSession->slot->device_ctx, ATCA_ZONE_DATA, pKey->slot, 0, buf, 32);
                     }
                 }
-#endif
             }
-            else
-            {
+#endif
+        }
+        else
+        {
 #if ATCA_TA_SUPPORT
-                status = talib_genkey_symmetric_key(pSession->slot->device_ctx, pKey->slot);
+            status = talib_genkey_symmetric_key(pSession->slot->device_ctx, pKey->slot);
 #endif
-            }
-            (void)pkcs11_unlock_both(pLibCtx);
         }
+        (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
     }
 
     if (CKR_OK == rv && ATCA_SUCCESS != status)
     {
-#if !PKCS11_USE_STATIC_CONFIG
-        (void)pkcs11_config_remove_object(pLibCtx, pSession->slot, pKey);
-#endif
         rv = pkcs11_util_convert_rv(status);
     }
 
-    if (CKR_OK == rv)
+    /* Publish the new object or drop it */
+    if (CKR_OK == (lock_rv = pkcs11_lock_context_exclusive(pLibCtx)))
     {
-        (void)pkcs11_object_get_handle(pKey, phKey);
-    }
-    else
-    {
-        if (NULL != pKey)
+        if (CKR_OK == rv)
+        {
+            pKey->flags |= flags;
+            (void)pkcs11_object_get_handle(pKey, phKey);
+        }
+        else
         {
+#if !PKCS11_USE_STATIC_CONFIG
+            (void)pkcs11_config_remove_object(pLibCtx, pSession->slot, pKey);
+#endif
             (void)pkcs11_object_free(pKey);
         }
+        (void)pkcs11_unlock_context_exclusive(pLibCtx);
+    }
+    else
+    {
+        rv = lock_rv;
     }
 
     return rv;
@@ -1992,9 +2039,11 @@ CK_RV pkcs11_key_generate_pair
     pkcs11_object_ptr pPrivate = NULL;
     CK_ULONG i;
     CK_RV rv = CKR_OK;
+    CK_RV lock_rv;
     CK_BBOOL isRsa = false;
     CK_ULONG keyTableIdx = 0;
     CK_BBOOL matched = false;
+    CK_FLAGS flags = 0;
 
     rv = pkcs11_init_check(&pLibCtx, FALSE);
     if (CKR_OK != rv)
@@ -2073,6 +2122,13 @@ CK_RV pkcs11_key_generate_pair
         return CKR_TEMPLATE_INCONSISTENT;
     }
 
+    /* New objects change the object table so the library is held exclusively
+       while they are created and released for the device operation */
+    if (CKR_OK != (rv = pkcs11_lock_context_exclusive(pLibCtx)))
+    {
+        return rv;
+    }
+
     /* Must create two new objects - a public and private key */
     rv = pkcs11_object_alloc(pSession->slot->slot_id, &pPrivate);
 
@@ -2179,42 +2235,14 @@ CK_RV pkcs11_key_generate_pair
             pPublic->class_type = CKK_EC;
             pPublic->size = ec_key_data_table[keyTableIdx].pubkey_sz;
         }
-
-        if (CKR_OK == (rv = pkcs11_lock_both(pLibCtx)))
-        {
-            ATCADeviceType dev_type = atcab_get_device_type_ext(pSession->slot->device_ctx);
-            if (atcab_is_ca_device(dev_type))
-            {
-#if ATCA_CA_SUPPORT
-                rv = pkcs11_util_convert_rv(atcab_genkey_ext(pSession->slot->device_ctx, pPrivate->slot, NULL));
-#endif
-            }
-            else if (atcab_is_ta_device(dev_type))
-            {
-#if ATCA_TA_SUPPORT
-                rv = pkcs11_util_convert_rv(talib_genkey(pSession->slot->device_ctx, pPrivate->slot, NULL));
-#endif
-            }
-            else
-            {
-                /* do nothing */
-            }
-
-            //If public key generation is success , means corresponding private key is good
-            if (CKR_OK != rv)
-            {
-#if !PKCS11_USE_STATIC_CONFIG
-                (void)pkcs11_config_remove_object(pLibCtx, pSession->slot, pPrivate);
-#endif
-            }
-            (void)pkcs11_unlock_both(pLibCtx);
-        }
     }
 
     if (CKR_OK == rv)
     {
-        (void)pkcs11_object_get_handle(pPrivate, phPrivateKey);
-        (void)pkcs11_object_get_handle(pPublic, phPublicKey);
+        /* Neither object can be destroyed until the key pair has been generated */
+        flags = pPrivate->flags & PKCS11_OBJECT_FLAG_DESTROYABLE;
+        pPrivate->flags &= PKCS11_OBJECT_FLAG_DESTROYABLE_COMPLEMENT;
+        pPublic->flags &= PKCS11_OBJECT_FLAG_DESTROYABLE_COMPLEMENT;
     }
     else
     {
@@ -2228,6 +2256,61 @@ CK_RV pkcs11_key_generate_pair
         }
     }
 
+    (void)pkcs11_unlock_context_exclusive(pLibCtx);
+
+    if (CKR_OK != rv)
+    {
+        return rv;
+    }
+
+    if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
+    {
+        ATCADeviceType dev_type = atcab_get_device_type_ext(pSession->slot->device_ctx);
+        if (atcab_is_ca_device(dev_type))
+        {
+#if ATCA_CA_SUPPORT
+            rv = pkcs11_util_convert_rv(atcab_genkey_ext(pSession->slot->device_ctx, pPrivate->slot, NULL));
+#endif
+        }
+        else if (atcab_is_ta_device(dev_type))
+        {
+#if ATCA_TA_SUPPORT
+            rv = pkcs11_util_convert_rv(talib_genkey(pSession->slot->device_ctx, pPrivate->slot, NULL));
+#endif
+        }
+        else
+        {
+            /* do nothing */
+        }
+        (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
+    }
+
+    /* Publish the new objects or drop them */
+    if (CKR_OK == (lock_rv = pkcs11_lock_context_exclusive(pLibCtx)))
+    {
+        //If public key generation is success , means corresponding private key is good
+        if (CKR_OK == rv)
+        {
+            pPrivate->flags |= flags;
+            pPublic->flags |= flags;
+            (void)pkcs11_object_get_handle(pPrivate, phPrivateKey);
+            (void)pkcs11_object_get_handle(pPublic, phPublicKey);
+        }
+        else
+        {
+#if !PKCS11_USE_STATIC_CONFIG
+            (void)pkcs11_config_remove_object(pLibCtx, pSession->slot, pPrivate);
+#endif
+            (void)pkcs11_object_free(pPrivate);
+            (void)pkcs11_object_free(pPublic);
+        }
+        (void)pkcs11_unlock_context_exclusive(pLibCtx);
+    }
+    else
+    {
+        rv = lock_rv;
+    }
+
     return rv;
 }
 
@@ -2261,7 +2344,7 @@ static CK_RV pkcs11_key_derive_ca(pkcs11_session_ctx_ptr pSession, pkcs11_object
         pSecretKey->attributes = pkcs11_key_secret_attributes;
         pSecretKey->count = pkcs11_key_secret_attributes_count;
         pSecretKey->size = 32;
-        pSecretKey->flags = PKCS11_OBJECT_FLAG_DESTROYABLE | PKCS11_OBJECT_FLAG_SENSITIVE;
+        pSecretKey->flags = PKCS11_OBJECT_FLAG_SENSITIVE;
 #ifdef ATCA_NO_HEAP
         if (!pkcs11_key_used(pkcs11_key_cache, sizeof(pkcs11_key_cache)))
         {
@@ -2284,7 +2367,7 @@ static CK_RV pkcs11_key_derive_ca(pkcs11_session_ctx_ptr pSession, pkcs11_object
                 pSecretKey->slot = ATCA_TEMPKEY_KEYID;
                 pSecretKey->config = &((pkcs11_slot_ctx_ptr)pSession->slot)->cfg_zone;
 
-                if (CKR_OK == (rv = pkcs11_lock_both(pLibCtx)))
+                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
                 {
                     /* Because of the number of ECDH options this function unfortunately has a complex bit of logic
                        to walk through to select the proper ECDH command. Normally this would be left up to the user
@@ -2332,7 +2415,7 @@ static CK_RV pkcs11_key_derive_ca(pkcs11_session_ctx_ptr pSession, pkcs11_object
                     {
                         status = ATCA_GEN_FAIL;
                     }
-                    (void)pkcs11_unlock_both(pLibCtx);
+                    (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
                 }
             }
             rv = pkcs11_util_convert_rv(status);
@@ -2354,7 +2437,7 @@ static CK_RV pkcs11_key_derive_ta(pkcs11_session_ctx_ptr pSession, pkcs11_object
         pSecretKey->attributes = pkcs11_key_secret_attributes;
         pSecretKey->count = pkcs11_key_secret_attributes_count;
         pSecretKey->size = 32;
-        pSecretKey->flags = PKCS11_OBJECT_FLAG_DESTROYABLE | PKCS11_OBJECT_FLAG_SENSITIVE;
+        pSecretKey->flags = PKCS11_OBJECT_FLAG_SENSITIVE;
 #ifdef ATCA_NO_HEAP
         if (!pkcs11_key_used(pkcs11_key_cache, sizeof(pkcs11_key_cache)))
         {
@@ -2373,10 +2456,10 @@ static CK_RV pkcs11_key_derive_ta(pkcs11_session_ctx_ptr pSession, pkcs11_object
             pkcs11_lib_ctx_ptr pLibCtx = pkcs11_get_context();
             if (atcab_is_ta_device(atcab_get_device_type_ext(pSession->slot->device_ctx)))
             {
-                if (CKR_OK == (rv = pkcs11_lock_both(pLibCtx)))
+                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
                 {
                     status = talib_ecdh_compat(pSession->slot->device_ctx, pBaseKey->slot, &pEcdhParameters->pPublicData[1], (uint8_t*)pSecretKey->data);
-                    (void)pkcs11_unlock_both(pLibCtx);
+                    (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
                 }
             }
             rv = pkcs11_util_convert_rv(status);
@@ -2401,9 +2484,12 @@ CK_RV pkcs11_key_derive
     pkcs11_lib_ctx_ptr pLibCtx;
     pkcs11_object_ptr pBaseKey = NULL;
     pkcs11_object_ptr pSecretKey = NULL;
+    pkcs11_object baseKey;
     CK_ECDH1_DERIVE_PARAMS_PTR pEcdhParameters = NULL;
+    CK_BBOOL locked = FALSE;
     CK_ULONG i;
     CK_RV rv = CKR_OK;
+    CK_RV lock_rv;
 
     rv = pkcs11_init_check(&pLibCtx, FALSE);
     if (CKR_OK != rv)
@@ -2450,6 +2536,16 @@ CK_RV pkcs11_key_derive
         rv = pkcs11_object_check(&pBaseKey, hBaseKey);
     }
 
+    if (CKR_OK == rv)
+    {
+        /* The derived key is a new object so the object table is held exclusively
+           while it is created and released for the device operation */
+        if (CKR_OK == (rv = pkcs11_lock_context_exclusive(pLibCtx)))
+        {
+            locked = TRUE;
+        }
+    }
+
     if (CKR_OK == rv)
     {
         rv = pkcs11_object_alloc(pSession->slot->slot_id, &pSecretKey);
@@ -2509,31 +2605,59 @@ CK_RV pkcs11_key_derive
 
     if (CKR_OK == rv)
     {
-        if (atcab_is_ca_device(atcab_get_device_type_ext(pSession->slot->device_ctx)))
-        {
+        /* The base key may be destroyed once the library is released */
+        baseKey = *pBaseKey;
+    }
+    else if (NULL != pSecretKey)
+    {
+        (void)pkcs11_object_free(pSecretKey);
+    }
+    else
+    {
+        /* do nothing */
+    }
+
+    if (locked)
+    {
+        (void)pkcs11_unlock_context_exclusive(pLibCtx);
+    }
+
+    if (CKR_OK != rv)
+    {
+        return rv;
+    }
+
+    /* The new object isn't destroyable until the key has been derived */
+    if (atcab_is_ca_device(atcab_get_device_type_ext(pSession->slot->device_ctx)))
+    {
 #if ATCA_CA_SUPPORT
-            rv = pkcs11_key_derive_ca(pSession, pBaseKey, pSecretKey, pEcdhParameters);
+        rv = pkcs11_key_derive_ca(pSession, &baseKey, pSecretKey, pEcdhParameters);
 #endif
-        }
-        else
-        {
+    }
+    else
+    {
 #if ATCA_TA_SUPPORT
-            rv = pkcs11_key_derive_ta(pSession, pBaseKey, pSecretKey, pEcdhParameters);
+        rv = pkcs11_key_derive_ta(pSession, &baseKey, pSecretKey, pEcdhParameters);
 #endif
-        }
     }
 
-    if (CKR_OK == rv)
+    /* Publish the new object or drop it */
+    if (CKR_OK == (lock_rv = pkcs11_lock_context_exclusive(pLibCtx)))
     {
-        (void)pkcs11_object_get_handle(pSecretKey, phKey);
-    }
-    else if (NULL != pSecretKey)
-    {
-        (void)pkcs11_object_free(pSecretKey);
+        if (CKR_OK == rv)
+        {
+            pSecretKey->flags |= PKCS11_OBJECT_FLAG_DESTROYABLE;
+            (void)pkcs11_object_get_handle(pSecretKey, phKey);
+        }
+        else
+        {
+            (void)pkcs11_object_free(pSecretKey);
+        }
+        (void)pkcs11_unlock_context_exclusive(pLibCtx);
     }
     else
     {
-        /* do nothing */
+        rv = lock_rv;
     }
 
     return rv;
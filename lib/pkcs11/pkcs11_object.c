@@ -48,19 +48,64 @@
 static pkcs11_object pkcs11_object_store[PKCS11_MAX_OBJECTS_ALLOWED];
 #endif
 
+#if PKCS11_MAX_OBJECTS_ALLOWED >= PKCS11_UTIL_HANDLE_INDEX_MASK
+#error "PKCS11_MAX_OBJECTS_ALLOWED does not fit in the object handle index"
+#endif
+
 pkcs11_object_cache_t pkcs11_object_cache[PKCS11_MAX_OBJECTS_ALLOWED];
 
+/** Label index - chains (index + 1) of cache entries by slot, class and label.
+    Objects are named while they are being created so the index is rebuilt by
+    the first lookup after an object is allocated or freed */
+static CK_ULONG pkcs11_object_index[PKCS11_MAX_OBJECTS_ALLOWED];
+static CK_BBOOL pkcs11_object_index_dirty = CK_TRUE;
+
 /** For object handle tracking */
-static CK_OBJECT_HANDLE pkcs11_object_alloc_handle(void)
+static CK_OBJECT_HANDLE pkcs11_object_alloc_handle(CK_ULONG index)
+{
+    pkcs11_object_cache[index].generation++;
+
+    return PKCS11_UTIL_HANDLE(index, pkcs11_object_cache[index].generation);
+}
+
+/** Label index bucket of an object (FNV-1a over the slot, class and label) */
+static CK_ULONG pkcs11_object_index_bucket(CK_SLOT_ID slotId, CK_OBJECT_CLASS class_id, const CK_UTF8CHAR* name, CK_ULONG len)
 {
-    static CK_OBJECT_HANDLE pkcs11_object_last_handle = 1;
+    uint32_t hash = 2166136261u;
+    CK_ULONG i;
 
-    if (0u != pkcs11_object_last_handle)
+    hash = (hash ^ (uint32_t)slotId) * 16777619u;
+    hash = (hash ^ (uint32_t)class_id) * 16777619u;
+    for (i = 0; i < len; i++)
     {
-        pkcs11_object_last_handle++;
+        hash = (hash ^ (uint32_t)name[i]) * 16777619u;
     }
 
-    return pkcs11_object_last_handle;
+    return (CK_ULONG)hash % (CK_ULONG)PKCS11_MAX_OBJECTS_ALLOWED;
+}
+
+static void pkcs11_object_index_rebuild(void)
+{
+    CK_ULONG i;
+
+    (void)memset(pkcs11_object_index, 0, sizeof(pkcs11_object_index));
+
+    /* Link in reverse so each chain lists entries in cache order */
+    for (i = (CK_ULONG)PKCS11_MAX_OBJECTS_ALLOWED; 0u < i--;)
+    {
+        pkcs11_object_ptr pObj = pkcs11_object_cache[i].object;
+
+        if (NULL != pObj)
+        {
+            CK_ULONG bucket = pkcs11_object_index_bucket(pkcs11_object_cache[i].slotid, pObj->class_id,
+                                                         pObj->name, (CK_ULONG)strlen((char*)pObj->name));
+
+            pkcs11_object_cache[i].next = pkcs11_object_index[bucket];
+            pkcs11_object_index[bucket] = i + 1u;
+        }
+    }
+
+    pkcs11_object_index_dirty = CK_FALSE;
 }
 
 /**
@@ -149,9 +194,11 @@ CK_RV pkcs11_object_alloc(CK_SLOT_ID slotId, pkcs11_object_ptr *ppObject)
                 if (NULL != *ppObject)
                 {
                     (void)memset(*ppObject, 0, sizeof(pkcs11_object));
-                    pkcs11_object_cache[i].handle = pkcs11_object_alloc_handle();
+                    (*ppObject)->cache_index = i;
+                    pkcs11_object_cache[i].handle = pkcs11_object_alloc_handle(i);
                     pkcs11_object_cache[i].slotid = slotId;
                     pkcs11_object_cache[i].object = *ppObject;
+                    pkcs11_object_index_dirty = CK_TRUE;
                 }
                 else
                 {
@@ -175,19 +222,32 @@ CK_RV pkcs11_object_alloc(CK_SLOT_ID slotId, pkcs11_object_ptr *ppObject)
     return rv;
 }
 
-CK_RV pkcs11_object_free(pkcs11_object_ptr pObject)
+/** Cache entry holding the object or NULL if the object is not cached */
+static pkcs11_object_cache_t* pkcs11_object_get_cache(pkcs11_object_ptr pObject)
 {
-    CK_ULONG i;
+    pkcs11_object_cache_t* rv = NULL;
 
-    for (i = 0; i < (CK_ULONG)PKCS11_MAX_OBJECTS_ALLOWED; i++)
+    if ((NULL != pObject) && (pObject->cache_index < (CK_ULONG)PKCS11_MAX_OBJECTS_ALLOWED))
     {
-        if (pObject == pkcs11_object_cache[i].object)
+        if (pObject == pkcs11_object_cache[pObject->cache_index].object)
         {
-            /* Delink it */
-            pkcs11_object_cache[i].object = NULL;
-            pkcs11_object_cache[i].handle = 0;
+            rv = &pkcs11_object_cache[pObject->cache_index];
         }
     }
+    return rv;
+}
+
+CK_RV pkcs11_object_free(pkcs11_object_ptr pObject)
+{
+    pkcs11_object_cache_t* entry = pkcs11_object_get_cache(pObject);
+
+    if (NULL != entry)
+    {
+        /* Delink it */
+        entry->object = NULL;
+        entry->handle = 0;
+        pkcs11_object_index_dirty = CK_TRUE;
+    }
 
     if (NULL != pObject)
     {
@@ -221,21 +281,14 @@ CK_RV pkcs11_object_free(pkcs11_object_ptr pObject)
 
 CK_RV pkcs11_object_check(pkcs11_object_ptr *ppObject, CK_OBJECT_HANDLE hObject)
 {
-    CK_ULONG i;
+    CK_ULONG i = PKCS11_UTIL_HANDLE_INDEX(hObject);
 
-    if (0u == hObject)
+    if ((0u == hObject) || (i >= (CK_ULONG)PKCS11_MAX_OBJECTS_ALLOWED))
     {
         return CKR_OBJECT_HANDLE_INVALID;
     }
 
-    for (i = 0; i < (CK_ULONG)PKCS11_MAX_OBJECTS_ALLOWED; i++)
-    {
-        if (hObject == pkcs11_object_cache[i].handle)
-        {
-            break;
-        }
-    }
-    if (i == (CK_ULONG)PKCS11_MAX_OBJECTS_ALLOWED)
+    if (hObject != pkcs11_object_cache[i].handle)
     {
         return CKR_OBJECT_HANDLE_INVALID;
     }
@@ -253,26 +306,20 @@ CK_RV pkcs11_object_check(pkcs11_object_ptr *ppObject, CK_OBJECT_HANDLE hObject)
 
 CK_RV pkcs11_object_get_handle(pkcs11_object_ptr pObject, CK_OBJECT_HANDLE_PTR phObject)
 {
-    CK_ULONG i;
+    pkcs11_object_cache_t* entry;
 
     if (NULL == phObject || NULL == pObject)
     {
         return CKR_ARGUMENTS_BAD;
     }
 
-    for (i = 0; i < (CK_ULONG)PKCS11_MAX_OBJECTS_ALLOWED; i++)
-    {
-        if (pObject == pkcs11_object_cache[i].object)
-        {
-            *phObject = pkcs11_object_cache[i].handle;
-            break;
-        }
-    }
-    if (i == (CK_ULONG)PKCS11_MAX_OBJECTS_ALLOWED)
+    if (NULL == (entry = pkcs11_object_get_cache(pObject)))
     {
         return CKR_OBJECT_HANDLE_INVALID;
     }
 
+    *phObject = entry->handle;
+
     return CKR_OK;
 }
 
@@ -282,22 +329,15 @@ CK_RV pkcs11_object_get_owner(pkcs11_object_ptr pObject, CK_SLOT_ID_PTR pSlotId)
 
     if (NULL != pObject && NULL != pSlotId)
     {
-        CK_ULONG i;
-        for (i = 0; i < (CK_ULONG)PKCS11_MAX_OBJECTS_ALLOWED; i++)
-        {
-            if (pObject == pkcs11_object_cache[i].object)
-            {
-                *pSlotId = pkcs11_object_cache[i].slotid;
-                break;
-            }
-        }
+        pkcs11_object_cache_t* entry = pkcs11_object_get_cache(pObject);
 
-        if ((CK_ULONG)PKCS11_MAX_OBJECTS_ALLOWED == i)
+        if (NULL == entry)
         {
             rv = CKR_OBJECT_HANDLE_INVALID;
         }
         else
         {
+            *pSlotId = entry->slotid;
             rv = CKR_OK;
         }
     }
@@ -433,10 +473,16 @@ CK_RV pkcs11_object_find(CK_SLOT_ID slotId, pkcs11_object_ptr *ppObject, CK_ATTR
 
     if (NULL != pName)
     {
-        for (i = 0; i < (CK_ULONG)PKCS11_MAX_OBJECTS_ALLOWED; i++)
+        if (CK_TRUE == pkcs11_object_index_dirty)
         {
-            pkcs11_object_ptr pObj = pkcs11_object_cache[i].object;
-            if (NULL != pObj && (pkcs11_object_cache[i].slotid == slotId))
+            pkcs11_object_index_rebuild();
+        }
+
+        i = pkcs11_object_index[pkcs11_object_index_bucket(slotId, class, (CK_UTF8CHAR*)pName->pValue, pName->ulValueLen)];
+        for (; 0u != i; i = pkcs11_object_cache[i - 1u].next)
+        {
+            pkcs11_object_ptr pObj = pkcs11_object_cache[i - 1u].object;
+            if (NULL != pObj && (pkcs11_object_cache[i - 1u].slotid == slotId))
             {
                 if ((pObj->class_id == class) && (strlen((char*)pObj->name) == pName->ulValueLen))
                 {
@@ -541,19 +587,19 @@ CK_RV pkcs11_object_create(
         }
     }
 
-    if (CKR_OK == (rv = pkcs11_lock_context(pLibCtx)))
+    if (CKR_OK == (rv = pkcs11_lock_context_exclusive(pLibCtx)))
     {
         if (NULL != pLabel && NULL != pClass)
         {
             if (CKR_OK != (rv = pkcs11_object_find(pSession->slot->slot_id, &pObject, pTemplate, ulCount)))
             {   
-                (void)pkcs11_unlock_context(pLibCtx);
+                (void)pkcs11_unlock_context_exclusive(pLibCtx);
                 return rv;
             }
         }
         else
         {
-            (void)pkcs11_unlock_context(pLibCtx);
+            (void)pkcs11_unlock_context_exclusive(pLibCtx);
             return CKR_ARGUMENTS_BAD;
         }
 
@@ -610,10 +656,10 @@ CK_RV pkcs11_object_create(
                     rv = pkcs11_config_cert(pLibCtx, pSession->slot, pObject, pLabel);
                     if (CKR_OK == rv)
                     {
-                        if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+                        if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
                         {
                             rv = pkcs11_cert_x509_write(pObject, pData, pSession);
-                            (void)pkcs11_unlock_device(pLibCtx);
+                            (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
                         }
                     }
                     break;
@@ -646,7 +692,7 @@ CK_RV pkcs11_object_create(
                         }
                     }
 #endif
-                    if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+                    if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
                     {
                         if (CKR_OK == (rv = pkcs11_config_key(pLibCtx, pSession->slot, pObject, pLabel)))
                         {
@@ -658,7 +704,7 @@ CK_RV pkcs11_object_create(
 #endif
                             }
                         }
-                        (void)pkcs11_unlock_device(pLibCtx);
+                        (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
                     }
                     break;
                 case CKO_PRIVATE_KEY:
@@ -692,7 +738,7 @@ CK_RV pkcs11_object_create(
                         pObject->handle_info.property &= (uint16_t)(~TA_PROP_EXECUTE_ONLY_KEY_GEN_MASK);              
                     }
 #endif
-                    if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+                    if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
                     {
                         if (CKR_OK == (rv = pkcs11_config_key(pLibCtx, pSession->slot, pObject, pLabel)))
                         {
@@ -704,7 +750,7 @@ CK_RV pkcs11_object_create(
 #endif                      
                             }
                         }
-                        (void)pkcs11_unlock_device(pLibCtx);
+                        (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
                     }
                     break;
                 default:
@@ -721,7 +767,7 @@ CK_RV pkcs11_object_create(
                 (void)pkcs11_object_free(pObject);
             }
         }
-        (void)pkcs11_unlock_context(pLibCtx);
+        (void)pkcs11_unlock_context_exclusive(pLibCtx);
     }
 
     return rv;
@@ -754,13 +800,13 @@ CK_RV pkcs11_object_destroy(CK_SESSION_HANDLE hSession, CK_OBJECT_HANDLE hObject
 
     if (PKCS11_OBJECT_FLAG_DESTROYABLE == (pObject->flags & PKCS11_OBJECT_FLAG_DESTROYABLE))
     {
-        if (CKR_OK == (rv = pkcs11_lock_context(pLibCtx)))
+        if (CKR_OK == (rv = pkcs11_lock_context_exclusive(pLibCtx)))
         {
 #if !PKCS11_USE_STATIC_CONFIG
             (void)pkcs11_config_remove_object(pLibCtx, pSession->slot, pObject);
 #endif
             rv = pkcs11_object_free(pObject);
-            (void)pkcs11_unlock_context(pLibCtx);
+            (void)pkcs11_unlock_context_exclusive(pLibCtx);
         }
     }
     else
@@ -774,7 +820,7 @@ CK_RV pkcs11_object_destroy(CK_SESSION_HANDLE hSession, CK_OBJECT_HANDLE hObject
 CK_RV pkcs11_object_deinit(pkcs11_lib_ctx_ptr pContext)
 {
     CK_RV rv = CKR_OK;
-    uint8_t i;
+    CK_ULONG i;
 
     ((void)pContext);
 
@@ -802,7 +848,7 @@ ATCA_STATUS pkcs11_object_load_handle_info(ATCADevice device, pkcs11_lib_ctx_ptr
 
     ((void)pContext);
 
-    for (uint8_t i = 0; i < (CK_ULONG)PKCS11_MAX_OBJECTS_ALLOWED; i++)
+    for (CK_ULONG i = 0; i < (CK_ULONG)PKCS11_MAX_OBJECTS_ALLOWED; i++)
     {
         pkcs11_object_ptr pObj = pkcs11_object_cache[i].object;
         if (NULL != pObj)
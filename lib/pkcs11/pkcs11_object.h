@@ -59,6 +59,8 @@ typedef struct pkcs11_object_s
 #if ATCA_TA_SUPPORT
     ta_element_attributes_t handle_info;
 #endif
+    /** Position of the object in pkcs11_object_cache */
+    CK_ULONG cache_index;
 } pkcs11_object;
 
 typedef struct pkcs11_object_cache_s
@@ -69,6 +71,10 @@ typedef struct pkcs11_object_cache_s
     CK_SLOT_ID slotid;
     /** The actual object  */
     pkcs11_object_ptr object;
+    /** Number of times this entry has been allocated */
+    CK_ULONG generation;
+    /** Next entry (index + 1) in the same label index chain - 0 ends the chain */
+    CK_ULONG next;
 } pkcs11_object_cache_t;
 
 extern pkcs11_object_cache_t pkcs11_object_cache[];
@@ -86,6 +92,7 @@ extern const CK_ULONG pkcs11_object_monotonic_attributes_count;
 #define PKCS11_OBJECT_FLAG_KEY_CACHE        (0x80U)
 #define PKCS11_OBJECT_FLAG_KEY_CACHE_COMPLEMENT    ~(PKCS11_OBJECT_FLAG_KEY_CACHE & 0xffu)
 #define PKCS11_OBJECT_FLAG_CERT_CACHE_COMPLEMENT   ~(PKCS11_OBJECT_FLAG_CERT_CACHE & 0xffu)
+#define PKCS11_OBJECT_FLAG_DESTROYABLE_COMPLEMENT  ~(PKCS11_OBJECT_FLAG_DESTROYABLE & 0xffu)
 
 /* Object System Access */
 CK_RV pkcs11_object_alloc(CK_SLOT_ID slotId, pkcs11_object_ptr * ppObject);
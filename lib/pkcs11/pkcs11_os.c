@@ -29,6 +29,10 @@
 #include "pkcs11_util.h"
 #include "pkcs11_init.h"
 
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
 /**
  * \defgroup pkcs11 OS Abstraction (pkcs11_so_)
    @{ */
@@ -40,7 +44,7 @@
  */
 CK_RV pkcs11_os_create_mutex(CK_VOID_PTR_PTR ppMutex)
 {
-    return pkcs11_util_convert_rv(hal_create_mutex(ppMutex, "atpkcs11_3_6"));
+    return pkcs11_util_convert_rv(hal_create_mutex(ppMutex, "atpkcs11_3_8"));
 }
 
 /*
@@ -70,6 +74,107 @@ CK_RV pkcs11_os_unlock_mutex(CK_VOID_PTR pMutex)
     return pkcs11_util_convert_rv(hal_unlock_mutex(pMutex));
 }
 
+#if defined(_WIN32) || defined(__linux__) || defined(__APPLE__)
+/**
+ * \brief Initialize a process local reader/writer lock
+ * \param[in] pLock pointer to the lock
+ */
+CK_RV pkcs11_os_init_rwlock(pkcs11_os_rwlock_t * pLock)
+{
+    CK_RV rv = CKR_ARGUMENTS_BAD;
+
+    if (NULL != pLock)
+    {
+#if defined(_WIN32)
+        InitializeSRWLock((PSRWLOCK)pLock);
+        rv = CKR_OK;
+#else
+        pthread_rwlockattr_t attr;
+
+        (void)pthread_rwlockattr_init(&attr);
+#if defined(__GLIBC__)
+        /* Keep a steady stream of readers from starving session/object table updates */
+        (void)pthread_rwlockattr_setkind_np(&attr, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+#endif
+        rv = (0 == pthread_rwlock_init(pLock, &attr)) ? CKR_OK : CKR_CANT_LOCK;
+        (void)pthread_rwlockattr_destroy(&attr);
+#endif
+    }
+    return rv;
+}
+
+/**
+ * \brief Destroy a reader/writer lock
+ * \param[in] pLock pointer to the lock
+ */
+CK_RV pkcs11_os_destroy_rwlock(pkcs11_os_rwlock_t * pLock)
+{
+    if (NULL == pLock)
+    {
+        return CKR_ARGUMENTS_BAD;
+    }
+#if defined(_WIN32)
+    /* SRW locks do not need to be destroyed */
+    return CKR_OK;
+#else
+    return (0 == pthread_rwlock_destroy(pLock)) ? CKR_OK : CKR_GENERAL_ERROR;
+#endif
+}
+
+/**
+ * \brief Acquire a reader/writer lock
+ * \param[in] pLock     pointer to the lock
+ * \param[in] exclusive TRUE to take the lock as the writer, FALSE to share it
+ */
+CK_RV pkcs11_os_lock_rwlock(pkcs11_os_rwlock_t * pLock, CK_BBOOL exclusive)
+{
+    if (NULL == pLock)
+    {
+        return CKR_ARGUMENTS_BAD;
+    }
+#if defined(_WIN32)
+    if (exclusive)
+    {
+        AcquireSRWLockExclusive((PSRWLOCK)pLock);
+    }
+    else
+    {
+        AcquireSRWLockShared((PSRWLOCK)pLock);
+    }
+    return CKR_OK;
+#else
+    return (0 == (exclusive ? pthread_rwlock_wrlock(pLock) : pthread_rwlock_rdlock(pLock))) ? CKR_OK : CKR_CANT_LOCK;
+#endif
+}
+
+/**
+ * \brief Release a reader/writer lock
+ * \param[in] pLock     pointer to the lock
+ * \param[in] exclusive must match the mode the lock was acquired with
+ */
+CK_RV pkcs11_os_unlock_rwlock(pkcs11_os_rwlock_t * pLock, CK_BBOOL exclusive)
+{
+    if (NULL == pLock)
+    {
+        return CKR_ARGUMENTS_BAD;
+    }
+#if defined(_WIN32)
+    if (exclusive)
+    {
+        ReleaseSRWLockExclusive((PSRWLOCK)pLock);
+    }
+    else
+    {
+        ReleaseSRWLockShared((PSRWLOCK)pLock);
+    }
+    return CKR_OK;
+#else
+    ((void)exclusive);
+    return (0 == pthread_rwlock_unlock(pLock)) ? CKR_OK : CKR_GENERAL_ERROR;
+#endif
+}
+#endif
+
 CK_RV pkcs11_os_alloc_shared_ctx(void ** ppShared, size_t size)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
@@ -93,11 +198,20 @@ CK_RV pkcs11_os_alloc_shared_ctx(void ** ppShared, size_t size)
     }
 
     // Allocate shared memory
-    if (ATCA_SUCCESS == (status = hal_alloc_shared(ppShared, size, "atpkcs11_3_6", &initialized)))
+    if (ATCA_SUCCESS == (status = hal_alloc_shared(ppShared, size, "atpkcs11_3_8", &initialized)))
     {
         if (initialized)
         {
-            status = hal_init_mutex(*ppShared, true);
+            pkcs11_dev_state * pState = (pkcs11_dev_state*)*ppShared;
+            size_t i;
+
+            status = ATCA_SUCCESS;
+
+            /* Each slot is arbitrated by its own lock */
+            for (i = 0; (ATCA_SUCCESS == status) && (i < PKCS11_MAX_SLOTS_ALLOWED); i++)
+            {
+                status = hal_init_mutex(&pState->resources[i].dev_lock, true);
+            }
         }
     }
 
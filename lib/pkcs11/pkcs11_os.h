@@ -38,6 +38,25 @@ CK_RV pkcs11_os_destroy_mutex(CK_VOID_PTR pMutex);
 CK_RV pkcs11_os_lock_mutex(CK_VOID_PTR pMutex);
 CK_RV pkcs11_os_unlock_mutex(CK_VOID_PTR pMutex);
 
+#if defined(_WIN32)
+/** \brief Reader/writer lock - same layout as a Win32 SRWLOCK */
+typedef struct
+{
+    CK_VOID_PTR ptr;
+} pkcs11_os_rwlock_t;
+#elif defined(__linux__) || defined(__APPLE__)
+#include <pthread.h>
+/** \brief Reader/writer lock */
+typedef pthread_rwlock_t pkcs11_os_rwlock_t;
+#endif
+
+#if defined(_WIN32) || defined(__linux__) || defined(__APPLE__)
+CK_RV pkcs11_os_init_rwlock(pkcs11_os_rwlock_t * pLock);
+CK_RV pkcs11_os_destroy_rwlock(pkcs11_os_rwlock_t * pLock);
+CK_RV pkcs11_os_lock_rwlock(pkcs11_os_rwlock_t * pLock, CK_BBOOL exclusive);
+CK_RV pkcs11_os_unlock_rwlock(pkcs11_os_rwlock_t * pLock, CK_BBOOL exclusive);
+#endif
+
 CK_RV pkcs11_os_alloc_shared_ctx(void ** ppShared, size_t size);
 CK_RV pkcs11_os_free_shared_ctx(void * pShared, size_t size);
 
@@ -47,12 +47,19 @@
  * \defgroup pkcs11 Session Management (pkcs11_)
    @{ */
 
+#if PKCS11_MAX_SESSIONS_ALLOWED >= PKCS11_UTIL_HANDLE_INDEX_MASK
+#error "PKCS11_MAX_SESSIONS_ALLOWED does not fit in the session handle index"
+#endif
+
 #ifdef ATCA_NO_HEAP
 static pkcs11_session_ctx pkcs11_session_cache[PKCS11_MAX_SESSIONS_ALLOWED];
 #else
 static pkcs11_session_ctx_ptr pkcs11_session_cache[PKCS11_MAX_SESSIONS_ALLOWED];
 #endif
 
+/** Number of times each session entry has been allocated */
+static CK_ULONG pkcs11_session_generation[PKCS11_MAX_SESSIONS_ALLOWED];
+
 static pkcs11_session_ctx_ptr pkcs11_allocate_session_context(void)
 {
     pkcs11_session_ctx_ptr rv = NULL;
@@ -85,37 +92,38 @@ static pkcs11_session_ctx_ptr pkcs11_allocate_session_context(void)
     }
 #endif
 
+    if (NULL != rv)
+    {
+        /* Assign the session handle */
+        pkcs11_session_generation[i]++;
+        rv->handle = PKCS11_UTIL_HANDLE(i, pkcs11_session_generation[i]);
+    }
+
     return rv;
 }
 
 pkcs11_session_ctx_ptr pkcs11_get_session_context(CK_SESSION_HANDLE hSession)
 {
     pkcs11_session_ctx_ptr rv = NULL;
+    CK_ULONG i = PKCS11_UTIL_HANDLE_INDEX(hSession);
 
-#ifdef ATCA_NO_HEAP
-    CK_ULONG i;
-    for (i = 0; i < (CK_ULONG)PKCS11_MAX_SESSIONS_ALLOWED; i++)
+    if ((0u != hSession) && (i < (CK_ULONG)PKCS11_MAX_SESSIONS_ALLOWED))
     {
+#ifdef ATCA_NO_HEAP
         if (hSession == pkcs11_session_cache[i].handle)
         {
             rv = &pkcs11_session_cache[i];
-            break;
         }
-    }
 #else
-    CK_ULONG i;
-    for (i = 0; i < (CK_ULONG)PKCS11_MAX_SESSIONS_ALLOWED; i++)
-    {
         if (NULL != pkcs11_session_cache[i])
         {
             if (hSession == pkcs11_session_cache[i]->handle)
             {
                 rv = pkcs11_session_cache[i];
-                break;
             }
         }
-    }
 #endif
+    }
 
     return rv;
 }
@@ -126,17 +134,15 @@ static CK_RV pkcs11_session_free_session_context(pkcs11_session_ctx_ptr session_
 
     if (NULL != session_ctx)
     {
+#ifdef ATCA_HEAP
+        CK_ULONG i = PKCS11_UTIL_HANDLE_INDEX(session_ctx->handle);
+#endif
         (void)pkcs11_util_memset(session_ctx, sizeof(pkcs11_session_ctx), 0, sizeof(pkcs11_session_ctx));
 #ifdef ATCA_HEAP
-        CK_ULONG i;
-        for (i = 0; i < (CK_ULONG)PKCS11_MAX_SESSIONS_ALLOWED; i++)
+        if ((i < (CK_ULONG)PKCS11_MAX_SESSIONS_ALLOWED) && (session_ctx == pkcs11_session_cache[i]))
         {
-            if (session_ctx == pkcs11_session_cache[i])
-            {
-                pkcs11_session_cache[i] = NULL;
-                pkcs11_os_free(session_ctx);
-                break;
-            }
+            pkcs11_session_cache[i] = NULL;
+            pkcs11_os_free(session_ctx);
         }
 #endif
         rv = CKR_OK;
@@ -187,7 +193,7 @@ CK_RV pkcs11_reserve_resource(pkcs11_lib_ctx_ptr pContext, pkcs11_session_ctx_pt
     {
         if ((PKCS11_MAX_SLOTS_ALLOWED > pSession->slot->slot_id) && (PKCS11_MAX_DEV_CTX > resource))
         {
-            if (CKR_OK == pkcs11_lock_both(pContext))
+            if (CKR_OK == pkcs11_lock_both(pContext, pSession->slot))
             {
                 pkcs11_dev_ctx * ctx = &pContext->dev_state->resources[pSession->slot->slot_id].contexts[resource];
 
@@ -214,7 +220,7 @@ CK_RV pkcs11_reserve_resource(pkcs11_lib_ctx_ptr pContext, pkcs11_session_ctx_pt
                     rv = ATCA_SUCCESS;
                     #endif
                 }
-                (void)pkcs11_unlock_both(pContext);
+                (void)pkcs11_unlock_both(pContext, pSession->slot);
             }
         }
     }
@@ -230,7 +236,7 @@ CK_RV pkcs11_release_resource(pkcs11_lib_ctx_ptr pContext, pkcs11_session_ctx_pt
     {
         if ((PKCS11_MAX_SLOTS_ALLOWED > pSession->slot->slot_id) && (PKCS11_MAX_DEV_CTX > resource))
         {
-            if (CKR_OK == pkcs11_lock_both(pContext))
+            if (CKR_OK == pkcs11_lock_both(pContext, pSession->slot))
             {
                 pkcs11_dev_ctx * ctx = &pContext->dev_state->resources[pSession->slot->slot_id].contexts[resource];
                 if ((0U == ctx->session) || (ctx->session == pSession->handle))
@@ -248,7 +254,7 @@ CK_RV pkcs11_release_resource(pkcs11_lib_ctx_ptr pContext, pkcs11_session_ctx_pt
                     rv = ATCA_SUCCESS;
                     #endif
                 }
-                (void)pkcs11_unlock_both(pContext);
+                (void)pkcs11_unlock_both(pContext, pSession->slot);
             }
         }
     }
@@ -306,7 +312,7 @@ CK_RV pkcs11_session_open(
     //     return CKR_TOKEN_WRITE_PROTECTED;
     // }
 
-    if (CKR_OK == pkcs11_lock_context(lib_ctx))
+    if (CKR_OK == pkcs11_lock_context_exclusive(lib_ctx))
     {
         /* Get a new session context */
         session_ctx = pkcs11_allocate_session_context();
@@ -314,6 +320,7 @@ CK_RV pkcs11_session_open(
         /* Check that a session was created */
         if (NULL == session_ctx)
         {
+            (void)pkcs11_unlock_context_exclusive(lib_ctx);
             return CKR_HOST_MEMORY;
         }
 
@@ -323,12 +330,8 @@ CK_RV pkcs11_session_open(
         session_ctx->active_mech = CKM_VENDOR_DEFINED;
         session_ctx->state = CKS_RO_PUBLIC_SESSION;
 
-        /* Assign the session handle */
-        /* coverity[cert_int36_c_violation] A truncated pointer on 64 bit platforms should still be unique in a memory space */
-        session_ctx->handle = (CK_SESSION_HANDLE)session_ctx;
-
         *phSession = session_ctx->handle;
-        (void)pkcs11_unlock_context(lib_ctx);
+        (void)pkcs11_unlock_context_exclusive(lib_ctx);
     }
 
     return CKR_OK;
@@ -367,11 +370,11 @@ CK_RV pkcs11_session_close(CK_SESSION_HANDLE hSession)
         /* We should go looking for the right slot since something got messed up
            that would be a pkcs11_slot_* function to find a slot given a session */
     }
-    if (CKR_OK == pkcs11_lock_context(lib_ctx))
+    if (CKR_OK == pkcs11_lock_context_exclusive(lib_ctx))
     {
         /* Free the session */
         (void)pkcs11_session_free_session_context(session_ctx);
-        (void)pkcs11_unlock_context(lib_ctx);
+        (void)pkcs11_unlock_context_exclusive(lib_ctx);
     }
 
     return CKR_OK;
@@ -544,13 +547,13 @@ CK_RV pkcs11_session_login(CK_SESSION_HANDLE hSession, CK_USER_TYPE userType, CK
 #endif
         {
             uint8_t sn[ATCA_SERIAL_NUM_SIZE];
-            if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+            if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, session_ctx->slot)))
             {
                 if (CKR_OK == (rv = pkcs11_util_convert_rv(atcab_read_serial_number_ext(session_ctx->slot->device_ctx, sn))))
                 {
                     rv = pkcs11_token_convert_pin_to_key(pPin, ulPinLen, sn, (CK_LONG)sizeof(sn), session_ctx->slot->read_key, key_len, session_ctx->slot);
                 }
-                (void)pkcs11_unlock_device(pLibCtx);
+                (void)pkcs11_unlock_device(pLibCtx, session_ctx->slot);
             }
         }
 
@@ -561,14 +564,13 @@ CK_RV pkcs11_session_login(CK_SESSION_HANDLE hSession, CK_USER_TYPE userType, CK
             uint8_t auth_i_nonce[16] = { 0 };
             uint8_t auth_r_nonce[16] = { 0 };
 
-#if PKCS11_AUTH_TERMINATE_BEFORE_LOGIN
-            ATCADevice device = session_ctx->slot->device_ctx;
-            (void)talib_auth_terminate(device);
-#endif
             (void)atcac_sw_random(auth_r_nonce, sizeof(auth_r_nonce));
 
-            if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+            if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, session_ctx->slot)))
             {
+#if PKCS11_AUTH_TERMINATE_BEFORE_LOGIN
+                (void)talib_auth_terminate(session_ctx->slot->device_ctx);
+#endif
                     status = talib_auth_generate_nonce(session_ctx->slot->device_ctx, (TA_HANDLE_AUTH_SESSION0 + auth_idx),
                                                    TA_AUTH_GENERATE_OPT_NONCE_SRC_MASK | TA_AUTH_GENERATE_OPT_RANDOM_MASK, auth_i_nonce);
 
@@ -585,7 +587,7 @@ CK_RV pkcs11_session_login(CK_SESSION_HANDLE hSession, CK_USER_TYPE userType, CK
                     PKCS11_DEBUG(" Login failed: Terminating auth session\r\n");
                     (void)talib_auth_terminate(session_ctx->slot->device_ctx);
                 }
-                (void)pkcs11_unlock_device(pLibCtx);
+                (void)pkcs11_unlock_device(pLibCtx, session_ctx->slot);
             }
         }
 #endif
@@ -631,10 +633,10 @@ CK_RV pkcs11_session_logout(CK_SESSION_HANDLE hSession)
 #if (ATCA_TA_SUPPORT && TALIB_AUTH_EN)
     if (session_ctx->slot->logged_in && atcab_is_ta_device(atcab_get_device_type_ext(session_ctx->slot->device_ctx)))
     {
-        if (CKR_OK == (rv = pkcs11_lock_both(lib_ctx)))
+        if (CKR_OK == (rv = pkcs11_lock_both(lib_ctx, session_ctx->slot)))
         {
             (void)talib_auth_terminate(session_ctx->slot->device_ctx);
-            (void)pkcs11_unlock_both(lib_ctx);
+            (void)pkcs11_unlock_both(lib_ctx, session_ctx->slot);
         }
     }
 #endif
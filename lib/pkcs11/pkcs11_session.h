@@ -82,8 +82,7 @@ typedef struct pkcs11_session_ctx_s
     CK_SESSION_HANDLE       handle;
     CK_STATE                state;
     CK_ULONG                error;
-    CK_ATTRIBUTE_PTR        attrib_list;
-    CK_ULONG                attrib_count;
+    CK_OBJECT_HANDLE        find_handles[PKCS11_MAX_OBJECTS_ALLOWED];
     CK_ULONG                object_index;
     CK_ULONG                object_count;
     CK_OBJECT_HANDLE        active_object;
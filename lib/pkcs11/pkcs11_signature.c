@@ -286,13 +286,13 @@ CK_RV pkcs11_signature_sign(
         case CKM_SHA256_HMAC:
             if (CKR_OK == (rv = pkcs11_signature_check_params(pSignature, pulSignatureLen, ATCA_SHA256_DIGEST_SIZE)))
             {
-                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+                if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
                 {
                     rv =
                         pkcs11_util_convert_rv(atcab_sha_hmac_ext(pSession->slot->device_ctx, pData, ulDataLen, pKey->slot, pSignature,
                                                                   SHA_MODE_TARGET_OUT_ONLY));
 
-                    (void)pkcs11_unlock_device(pLibCtx);
+                    (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
                 }
             }
             break;
@@ -301,17 +301,17 @@ CK_RV pkcs11_signature_sign(
             {   
                 if (atcab_is_ca_device(dev_type))
                 {
-                    if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+                    if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
                     {
 #if ATCA_CA_SUPPORT
                         rv = pkcs11_util_convert_rv(atcab_sign_ext(pSession->slot->device_ctx, pKey->slot, pData, pSignature));
 #endif              
-                        (void)pkcs11_unlock_device(pLibCtx);
+                        (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
                     }
                 }
                 else if (atcab_is_ta_device(dev_type))
                 {   
-                    if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+                    if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
                     {
 #if ATCA_TA_SUPPORT     
                         uint8_t key_type = ((pKey->handle_info.element_CKA & TA_HANDLE_INFO_KEY_TYPE_MASK) >> TA_HANDLE_INFO_KEY_TYPE_SHIFT);
@@ -321,7 +321,7 @@ CK_RV pkcs11_signature_sign(
                         rv = pkcs11_util_convert_rv(talib_sign_external(pSession->slot->device_ctx, key_type, pKey->slot, TA_HANDLE_INPUT_BUFFER, &msg_buf,
                                                                         &sign_buf));
 #endif              
-                        (void)pkcs11_unlock_device(pLibCtx);
+                        (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
                     }
                 }
                 else
@@ -337,7 +337,7 @@ CK_RV pkcs11_signature_sign(
             {
                 if (atcab_is_ta_device(dev_type))
                 {   
-                    if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+                    if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
                     {     
                         uint8_t key_type = ((pKey->handle_info.element_CKA & TA_HANDLE_INFO_KEY_TYPE_MASK) >> TA_HANDLE_INFO_KEY_TYPE_SHIFT);
                         uint8_t mode = (CKM_RSA_PKCS == pSession->active_mech) ? (key_type) : (uint8_t)(key_type | (uint8_t)(TA_ALG_MODE_RSA_SSA_PSS << TA_ALG_MODE_SHIFT));
@@ -359,7 +359,7 @@ CK_RV pkcs11_signature_sign(
                             rv = pkcs11_util_convert_rv(talib_sign_external(pSession->slot->device_ctx, mode, pKey->slot, TA_HANDLE_INPUT_BUFFER, &msg_buf,
                                                                            &sign_buf));
                         }           
-                        (void)pkcs11_unlock_device(pLibCtx);
+                        (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
                     }
                 }   
             }
@@ -529,7 +529,7 @@ CK_RV pkcs11_signature_verify(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_
             return CKR_SIGNATURE_LEN_RANGE;
         }
 
-        if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+        if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
         {
             if (CKR_OK ==
                 (rv = pkcs11_util_convert_rv(atcab_sha_hmac_ext(pSession->slot->device_ctx, pData, ulDataLen, pKey->slot, buf, SHA_MODE_TARGET_OUT_ONLY))))
@@ -540,7 +540,7 @@ CK_RV pkcs11_signature_verify(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_
                 }
             }
 
-            (void)pkcs11_unlock_device(pLibCtx);
+            (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
         }
     }
     break;
@@ -566,7 +566,7 @@ CK_RV pkcs11_signature_verify(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_
 
         if (CKR_OK == (rv = pkcs11_object_is_private(pKey, &is_private, pSession)))
         {
-            if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+            if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
             {
                 ATCADeviceType dev_type = atcab_get_device_type_ext(pSession->slot->device_ctx);
 
@@ -636,7 +636,7 @@ CK_RV pkcs11_signature_verify(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_
                     }
 
                 }
-                (void)pkcs11_unlock_device(pLibCtx);
+                (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
             }
         }
         break;
@@ -664,7 +664,7 @@ CK_RV pkcs11_signature_verify(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_
 
         if (CKR_OK == (rv = pkcs11_object_is_private(pKey, &is_private, pSession)))
         {
-            if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
+            if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
             {
                 ATCADeviceType dev_type = atcab_get_device_type_ext(pSession->slot->device_ctx);
 
@@ -706,7 +706,7 @@ CK_RV pkcs11_signature_verify(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_
 #endif
                     }
                 }
-                (void)pkcs11_unlock_device(pLibCtx);
+                (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
             }
         }
         break;
@@ -521,7 +521,7 @@ CK_RV pkcs11_slot_get_info(CK_SLOT_ID slotID, CK_SLOT_INFO_PTR pInfo)
 
     if (SLOT_STATE_READY == slot_ctx->slot_state)
     {
-        if (CKR_OK == (rv = pkcs11_lock_both(lib_ctx)))
+        if (CKR_OK == (rv = pkcs11_lock_both(lib_ctx, slot_ctx)))
         {
             if (CKR_OK == (rv = pkcs11_util_convert_rv(atcab_info_ext(slot_ctx->device_ctx, buf))))
             {
@@ -529,7 +529,7 @@ CK_RV pkcs11_slot_get_info(CK_SLOT_ID slotID, CK_SLOT_INFO_PTR pInfo)
                 pInfo->hardwareVersion.major = 0;
                 pInfo->hardwareVersion.minor = buf[3];
             }
-            (void)pkcs11_unlock_both(lib_ctx);
+            (void)pkcs11_unlock_both(lib_ctx, slot_ctx);
         }
     }
 
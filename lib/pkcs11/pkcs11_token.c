@@ -160,7 +160,7 @@ CK_RV pkcs11_token_init(CK_SLOT_ID slotID, CK_UTF8CHAR_PTR pPin, CK_ULONG ulPinL
     }
 
     /* Lock the library */
-    rv = pkcs11_lock_context(pLibCtx);
+    rv = pkcs11_lock_both_exclusive(pLibCtx, pSlotCtx);
 
     if (CKR_OK == rv)
     {
@@ -303,7 +303,7 @@ CK_RV pkcs11_token_init(CK_SLOT_ID slotID, CK_UTF8CHAR_PTR pPin, CK_ULONG ulPinL
     (void)atcab_release_ext(&pSlotCtx->device_ctx);
 
     /* Release the lock on the library */
-    (void)pkcs11_unlock_context(pLibCtx);
+    (void)pkcs11_unlock_both_exclusive(pLibCtx, pSlotCtx);
 
     /* Trigger a reinitialization of the slot */
     if (ATCA_SUCCESS == rv)
@@ -519,7 +519,7 @@ CK_RV pkcs11_token_get_info(CK_SLOT_ID slotID, CK_TOKEN_INFO_PTR pInfo)
 
     if (SLOT_STATE_READY == slot_ctx->slot_state)
     {
-        if (CKR_OK == (rv = pkcs11_lock_both(lib_ctx)))
+        if (CKR_OK == (rv = pkcs11_lock_both(lib_ctx, slot_ctx)))
         {
             do
             {
@@ -609,7 +609,7 @@ CK_RV pkcs11_token_get_info(CK_SLOT_ID slotID, CK_TOKEN_INFO_PTR pInfo)
                 }
             }
             while (false);
-            (void)pkcs11_unlock_both(lib_ctx);
+            (void)pkcs11_unlock_both(lib_ctx, slot_ctx);
         }
     }
 
@@ -656,10 +656,10 @@ CK_RV pkcs11_token_random(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pRandomData, C
     {
         do
         {
-            if (CKR_OK == (rv = pkcs11_lock_device(lib_ctx)))
+            if (CKR_OK == (rv = pkcs11_lock_device(lib_ctx, pSession->slot)))
             {
                 rv = pkcs11_util_convert_rv(atcab_random_ext(pSession->slot->device_ctx, buf));
-                (void)pkcs11_unlock_device(lib_ctx);
+                (void)pkcs11_unlock_device(lib_ctx, pSession->slot);
             }
 
             if (CKR_OK == rv)
@@ -776,7 +776,7 @@ CK_RV pkcs11_token_set_pin(CK_SESSION_HANDLE hSession, CK_UTF8CHAR_PTR pOldPin,
     //For ECC, 32 bytes write possible
     key_len = (is_ca_device ? ATCA_SHA256_DIGEST_SIZE : (ATCA_SHA256_DIGEST_SIZE/2u));
 
-    if (CKR_OK == (rv = pkcs11_lock_context(pLibCtx)))
+    if (CKR_OK == (rv = pkcs11_lock_both(pLibCtx, pSession->slot)))
     {
 #ifndef PKCS11_PIN_KDF_ALWAYS
         if (((CK_ULONG)2u * key_len) == ulNewLen)
@@ -808,14 +808,10 @@ CK_RV pkcs11_token_set_pin(CK_SESSION_HANDLE hSession, CK_UTF8CHAR_PTR pOldPin,
 
         if (CKR_OK == rv)
         {
-            if (CKR_OK == (rv = pkcs11_lock_device(pLibCtx)))
-            {
-                rv = pkcs11_util_convert_rv(atcab_write_zone_ext(pSession->slot->device_ctx, ATCA_ZONE_DATA, pin_slot, 0, 0, buf, (uint8_t)key_len));
-                (void)pkcs11_unlock_device(pLibCtx);
-            }
+            rv = pkcs11_util_convert_rv(atcab_write_zone_ext(pSession->slot->device_ctx, ATCA_ZONE_DATA, pin_slot, 0, 0, buf, (uint8_t)key_len));
         }
 
-        (void)pkcs11_unlock_context(pLibCtx);
+        (void)pkcs11_unlock_both(pLibCtx, pSession->slot);
     }
 
     /* Lock the pin once it has been written */
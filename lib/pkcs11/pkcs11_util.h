@@ -34,6 +34,15 @@
 
 #define PKCS11_UTIL_ARRAY_SIZE(x)   sizeof(x) / sizeof(x[0])
 
+/** Object and session handles carry their table position (plus one so a
+   handle is never zero) in the low bits and the number of times that position
+   has been reused above it, so a handle maps straight to its entry and a stale
+   handle no longer matches it */
+#define PKCS11_UTIL_HANDLE_INDEX_BITS           (16u)
+#define PKCS11_UTIL_HANDLE_INDEX_MASK           ((1UL << PKCS11_UTIL_HANDLE_INDEX_BITS) - 1u)
+#define PKCS11_UTIL_HANDLE(index, generation)   ((((CK_ULONG)(generation)) << PKCS11_UTIL_HANDLE_INDEX_BITS) | (((CK_ULONG)(index) + 1u) & PKCS11_UTIL_HANDLE_INDEX_MASK))
+#define PKCS11_UTIL_HANDLE_INDEX(handle)        ((CK_ULONG)(((CK_ULONG)(handle) & PKCS11_UTIL_HANDLE_INDEX_MASK) - 1u))
+
 void pkcs11_util_escape_string(CK_UTF8CHAR_PTR buf, CK_ULONG buf_len);
 CK_RV pkcs11_util_convert_rv(ATCA_STATUS status);
 
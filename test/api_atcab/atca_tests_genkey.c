@@ -85,6 +85,52 @@ TEST(atca_cmd_basic_test, get_pubkey)
     // pub key is random so can't check the full content anyway.
     TEST_ASSERT_NOT_EQUAL(0, memcmp(public_key, frag, 4));
 }
+
+#if CALIB_GENKEY_EN && ATCA_PUBKEY_CACHE_EN
+TEST_CONDITION(atca_cmd_basic_test, get_pubkey_cached)
+{
+    ATCADeviceType dev_type = atca_test_get_device_type();
+
+    return (ATECC108A == dev_type) || (ATECC508A == dev_type) || (ATECC608 == dev_type);
+}
+
+TEST(atca_cmd_basic_test, get_pubkey_cached)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    ATCADevice device = atcab_get_device();
+    uint8_t public_key[64];
+    uint8_t cached_key[64];
+    uint8_t new_key[64];
+    cal_buffer new_key_buf = CAL_BUF_INIT(sizeof(new_key), new_key);
+    uint16_t private_key_id;
+    uint32_t generation;
+
+    test_assert_config_is_locked();
+
+    status = atca_test_config_get_id(TEST_TYPE_ECC_GENKEY, &private_key_id);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    calib_pubkey_cache_invalidate(device);
+
+    status = atcab_get_pubkey(private_key_id, public_key);
+    TEST_ASSERT_SUCCESS(status);
+
+    // Second request is answered from the cache
+    status = atcab_get_pubkey(private_key_id, cached_key);
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT_EQUAL_MEMORY(public_key, cached_key, sizeof(public_key));
+
+    // Generating a new key replaces the cached one
+    generation = calib_slot_generation(device, ATCA_ZONE_DATA, private_key_id);
+    status = atca_test_genkey(device, private_key_id, &new_key_buf);
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT_NOT_EQUAL(generation, calib_slot_generation(device, ATCA_ZONE_DATA, private_key_id));
+
+    status = atcab_get_pubkey(private_key_id, cached_key);
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT_EQUAL_MEMORY(new_key, cached_key, sizeof(new_key));
+}
+#endif
 #endif
 
 // *INDENT-OFF* - Preserve formatting
@@ -93,6 +139,9 @@ t_test_case_info genkey_basic_test_info[] =
 #if TEST_ATCAB_GENKEY_EN
     { REGISTER_TEST_CASE(atca_cmd_basic_test, genkey),     atca_test_cond_p256_sign },
     { REGISTER_TEST_CASE(atca_cmd_basic_test, get_pubkey), atca_test_cond_p256_sign },
+#if CALIB_GENKEY_EN && ATCA_PUBKEY_CACHE_EN
+    { REGISTER_TEST_CASE(atca_cmd_basic_test, get_pubkey_cached), REGISTER_TEST_CONDITION(atca_cmd_basic_test, get_pubkey_cached) },
+#endif
 #endif
     { (fp_test_case)NULL,                     (uint8_t)0 },/* Array Termination element*/
 };
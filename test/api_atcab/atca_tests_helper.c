@@ -26,6 +26,9 @@
  */
 #include <stdlib.h>
 #include "test_atcab.h"
+#if defined(ATCA_HAL_KIT_HID) || defined(ATCA_HAL_KIT_UART)
+#include "hal/kit_protocol.h"
+#endif
 
 static const uint8_t atca_tests_helper_base64_vector_in0[] = "We were henceforth to be hurled along, the playthings of the fierce elements of the deep.       \n";
 static const char atca_tests_helper_base64_vector_out0[] = "V2Ugd2VyZSBoZW5jZWZvcnRoIHRvIGJlIGh1cmxlZCBhbG9uZywgdGhlIHBsYXl0\r\n"
@@ -333,6 +336,63 @@ TEST(atca_helper, base64_url_decode)
                                     atcab_b64rules_urlsafe(), true);
 }
 
+TEST(atca_helper, base64_mime_encode_decode)
+{
+    const uint8_t * in = atca_tests_helper_base64_vector_in1;
+    size_t in_len = sizeof(atca_tests_helper_base64_vector_in1);
+    char encoded[512];
+    size_t encoded_len = sizeof(encoded);
+    uint8_t decoded[512];
+    size_t decoded_len = sizeof(decoded);
+    ATCA_STATUS status;
+    size_t i;
+
+    status = atcab_base64encode_(in, in_len, encoded, &encoded_len, atcab_b64rules_mime());
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    /* 344 characters in lines of 76 */
+    TEST_ASSERT_EQUAL(344 + 4 * 2, encoded_len);
+    for (i = 76; i < encoded_len; i += 78)
+    {
+        TEST_ASSERT_EQUAL('\r', encoded[i]);
+        TEST_ASSERT_EQUAL('\n', encoded[i + 1]);
+    }
+    TEST_ASSERT_EQUAL_MEMORY("/w==", &encoded[encoded_len - 4], 4);
+
+    status = atcab_base64decode_(encoded, encoded_len, decoded, &decoded_len, atcab_b64rules_mime());
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(in_len, decoded_len);
+    TEST_ASSERT_EQUAL_MEMORY(in, decoded, decoded_len);
+}
+
+TEST(atca_helper, base64_decode_invalid)
+{
+    char encoded[sizeof(atca_tests_helper_base64_vector_url1) + 4];
+    uint8_t decoded[512];
+    size_t decoded_len;
+    ATCA_STATUS status;
+
+    /* Character from another ruleset inside a long run */
+    memcpy(encoded, atca_tests_helper_base64_vector_url1, sizeof(atca_tests_helper_base64_vector_url1));
+    encoded[150] = '+';
+    decoded_len = sizeof(decoded);
+    status = atcab_base64decode_(encoded, strlen(encoded), decoded, &decoded_len, atcab_b64rules_urlsafe());
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, status);
+
+    /* Characters after the end padding */
+    memcpy(encoded, atca_tests_helper_base64_vector_out0, sizeof(atca_tests_helper_base64_vector_out0));
+    strcat(encoded, "QQ");
+    decoded_len = sizeof(decoded);
+    status = atcab_base64decode_(encoded, strlen(encoded), decoded, &decoded_len, atcab_b64rules_default());
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, status);
+
+    /* Output buffer one byte short */
+    decoded_len = sizeof(atca_tests_helper_base64_vector_in1) - 1;
+    status = atcab_base64decode_(atca_tests_helper_base64_vector_url1, strlen(atca_tests_helper_base64_vector_url1),
+                                 decoded, &decoded_len, atcab_b64rules_urlsafe());
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, status);
+}
+
 static const uint8_t g_bin2hex_bin[] = {
     0x01, 0x7d, 0x78, 0x1d, 0x95, 0xc6, 0x06, 0x18, 0xbe, 0xe0, 0xfb, 0x92, 0x05, 0xb0, 0x4b, 0x52,
     0xec, 0x43, 0xb3, 0xeb, 0xa1, 0xe5, 0x20, 0x86, 0x32, 0xea, 0x1f, 0xaa, 0xa6, 0x68, 0x1b, 0xbc,
@@ -679,6 +739,183 @@ TEST(atca_helper, lib_strcasestr_api)
 }
 
 
+#if ATCA_CA_SUPPORT
+/* Reference bit serial implementation of the device CRC */
+static void atca_tests_helper_crc_ref(size_t length, const uint8_t *data, uint8_t *crc_le)
+{
+    size_t counter;
+    uint16_t crc_register = 0;
+    uint8_t shift_register;
+    uint8_t data_bit, crc_bit;
+
+    for (counter = 0; counter < length; counter++)
+    {
+        for (shift_register = 0x01; shift_register > 0x00u; shift_register <<= 1)
+        {
+            data_bit = ((data[counter] & shift_register) != 0u) ? 1u : 0u;
+            crc_bit = (uint8_t)(crc_register >> 15);
+            crc_register <<= 1;
+            if (data_bit != crc_bit)
+            {
+                crc_register ^= 0x8005u;
+            }
+        }
+    }
+    crc_le[0] = (uint8_t)(crc_register & 0x00FFu);
+    crc_le[1] = (uint8_t)(crc_register >> 8u);
+}
+
+TEST(atca_helper, crc_info_command)
+{
+    /* Info command (Revision) */
+    const uint8_t packet[] = { 0x07, 0x30, 0x00, 0x00, 0x00 };
+    const uint8_t crc_ref[] = { 0x03, 0x5D };
+    uint8_t crc[2];
+
+    atCRC(sizeof(packet), packet, crc);
+    TEST_ASSERT_EQUAL_MEMORY(crc_ref, crc, sizeof(crc));
+}
+
+TEST(atca_helper, crc_all_lengths)
+{
+    size_t length;
+    uint8_t crc_ref[2];
+    uint8_t crc[2];
+
+    for (length = 0; length <= sizeof(atca_tests_helper_base64_vector_in1); length++)
+    {
+        atca_tests_helper_crc_ref(length, atca_tests_helper_base64_vector_in1, crc_ref);
+        atCRC(length, atca_tests_helper_base64_vector_in1, crc);
+        TEST_ASSERT_EQUAL_MEMORY(crc_ref, crc, sizeof(crc));
+    }
+}
+
+TEST(atca_helper, crc_incremental)
+{
+    size_t split;
+    uint16_t running;
+    uint8_t crc_ref[2];
+    uint8_t crc[2];
+    const size_t length = 155;
+
+    atca_tests_helper_crc_ref(length, &atca_tests_helper_base64_vector_in1[7], crc_ref);
+
+    for (split = 0; split <= length; split++)
+    {
+        running = atCRC_update(ATCA_CRC_INIT, &atca_tests_helper_base64_vector_in1[7], split);
+        running = atCRC_update(running, &atca_tests_helper_base64_vector_in1[7 + split], length - split);
+        atCRC_final(running, crc);
+        TEST_ASSERT_EQUAL_MEMORY(crc_ref, crc, sizeof(crc));
+    }
+}
+#endif
+
+#if defined(ATCA_HAL_KIT_HID) || defined(ATCA_HAL_KIT_UART)
+TEST(atca_helper, kit_frame_round_trip)
+{
+    const size_t lengths[] = { 0, 1, 64, sizeof(atca_tests_helper_base64_vector_in1) };
+    uint8_t frame[sizeof(atca_tests_helper_base64_vector_in1) + KIT_FRAME_OVERHEAD];
+    size_t flen;
+    uint8_t code;
+    const uint8_t* data;
+    size_t dlen;
+    size_t i;
+
+    for (i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++)
+    {
+        flen = sizeof(frame);
+        TEST_ASSERT_SUCCESS(kit_wrap_frame(KIT_FRAME_TALK, atca_tests_helper_base64_vector_in1, lengths[i], frame, &flen));
+        TEST_ASSERT_EQUAL(lengths[i] + KIT_FRAME_OVERHEAD, flen);
+        TEST_ASSERT_EQUAL(KIT_FRAME_SYNC, frame[0]);
+        TEST_ASSERT_EQUAL(flen, kit_frame_size(frame));
+
+        code = 0;
+        TEST_ASSERT_SUCCESS(kit_parse_frame(frame, flen, &code, &data, &dlen));
+        TEST_ASSERT_EQUAL(KIT_FRAME_TALK, code);
+        TEST_ASSERT_EQUAL(lengths[i], dlen);
+        if (0u < dlen)
+        {
+            TEST_ASSERT_EQUAL_MEMORY(atca_tests_helper_base64_vector_in1, data, dlen);
+        }
+    }
+}
+
+TEST(atca_helper, kit_frame_truncated)
+{
+    uint8_t frame[16 + KIT_FRAME_OVERHEAD];
+    size_t flen = sizeof(frame);
+    uint8_t code;
+    const uint8_t* data;
+    size_t dlen;
+
+    TEST_ASSERT_SUCCESS(kit_wrap_frame(KIT_FRAME_TALK, atca_tests_helper_base64_vector_in1, 16, frame, &flen));
+
+    /* Missing the last crc byte */
+    TEST_ASSERT_EQUAL(ATCA_RX_FAIL, kit_parse_frame(frame, flen - 1u, &code, &data, &dlen));
+    /* Not even a complete header and crc */
+    TEST_ASSERT_EQUAL(ATCA_RX_FAIL, kit_parse_frame(frame, KIT_FRAME_OVERHEAD - 1u, &code, &data, &dlen));
+    /* Lost the sync byte */
+    TEST_ASSERT_EQUAL(ATCA_RX_FAIL, kit_parse_frame(&frame[1], flen - 1u, &code, &data, &dlen));
+
+    /* Frame buffer too small to hold the frame */
+    flen = sizeof(frame) - 1u;
+    TEST_ASSERT_EQUAL(ATCA_SMALL_BUFFER, kit_wrap_frame(KIT_FRAME_TALK, atca_tests_helper_base64_vector_in1, 16, frame, &flen));
+}
+
+TEST(atca_helper, kit_frame_bad_length)
+{
+    uint8_t frame[16 + KIT_FRAME_OVERHEAD];
+    size_t flen = sizeof(frame);
+    uint8_t code;
+    const uint8_t* data;
+    size_t dlen;
+
+    TEST_ASSERT_SUCCESS(kit_wrap_frame(KIT_FRAME_TALK, atca_tests_helper_base64_vector_in1, 16, frame, &flen));
+
+    /* Length claims more bytes than were received */
+    frame[2] = 0x01;
+    TEST_ASSERT_EQUAL(16u + 256u + KIT_FRAME_OVERHEAD, kit_frame_size(frame));
+    TEST_ASSERT_EQUAL(ATCA_RX_FAIL, kit_parse_frame(frame, flen, &code, &data, &dlen));
+
+    /* Length claims fewer bytes - the crc no longer lines up */
+    frame[1] = 15;
+    frame[2] = 0x00;
+    TEST_ASSERT_EQUAL(ATCA_RX_CRC_ERROR, kit_parse_frame(frame, flen, &code, &data, &dlen));
+
+    /* More data than a frame can describe */
+    flen = sizeof(frame);
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, kit_wrap_frame(KIT_FRAME_TALK, atca_tests_helper_base64_vector_in1, (size_t)UINT16_MAX + 1u, frame, &flen));
+}
+
+TEST(atca_helper, kit_frame_bad_crc)
+{
+    uint8_t frame[16 + KIT_FRAME_OVERHEAD];
+    size_t flen = sizeof(frame);
+    uint8_t code;
+    const uint8_t* data;
+    size_t dlen;
+
+    TEST_ASSERT_SUCCESS(kit_wrap_frame(KIT_FRAME_TALK, atca_tests_helper_base64_vector_in1, 16, frame, &flen));
+
+    /* Corrupted data */
+    frame[KIT_FRAME_HEADER_SIZE + 5u] ^= 0x10u;
+    TEST_ASSERT_EQUAL(ATCA_RX_CRC_ERROR, kit_parse_frame(frame, flen, &code, &data, &dlen));
+    frame[KIT_FRAME_HEADER_SIZE + 5u] ^= 0x10u;
+
+    /* Corrupted code */
+    frame[3] = KIT_FRAME_WAKE;
+    TEST_ASSERT_EQUAL(ATCA_RX_CRC_ERROR, kit_parse_frame(frame, flen, &code, &data, &dlen));
+    frame[3] = KIT_FRAME_TALK;
+
+    /* Corrupted crc */
+    frame[flen - 1u] ^= 0x01u;
+    TEST_ASSERT_EQUAL(ATCA_RX_CRC_ERROR, kit_parse_frame(frame, flen, &code, &data, &dlen));
+    frame[flen - 1u] ^= 0x01u;
+
+    TEST_ASSERT_SUCCESS(kit_parse_frame(frame, flen, &code, &data, &dlen));
+}
+#endif
+
 // *INDENT-OFF* - Preserve formatting
 t_test_case_info helper_basic_test_info[] =
 {
@@ -700,6 +937,8 @@ t_test_case_info helper_basic_test_info[] =
 
     { REGISTER_TEST_CASE(atca_helper, base64_url_encode),                  NULL },
     { REGISTER_TEST_CASE(atca_helper, base64_url_decode),                  NULL },
+    { REGISTER_TEST_CASE(atca_helper, base64_mime_encode_decode),          NULL },
+    { REGISTER_TEST_CASE(atca_helper, base64_decode_invalid),              NULL },
 
     { REGISTER_TEST_CASE(atca_helper, bin2hex_simple),                     NULL },
     { REGISTER_TEST_CASE(atca_helper, bin2hex_simple_no_null),             NULL },
@@ -719,6 +958,17 @@ t_test_case_info helper_basic_test_info[] =
     { REGISTER_TEST_CASE(atca_helper, transform_hex2bin),                  NULL },
     { REGISTER_TEST_CASE(atca_helper, transform_hex2bin_space),            NULL },
     { REGISTER_TEST_CASE(atca_helper, transform_reversal),                 NULL },
+#if ATCA_CA_SUPPORT
+    { REGISTER_TEST_CASE(atca_helper, crc_info_command),                   NULL },
+    { REGISTER_TEST_CASE(atca_helper, crc_all_lengths),                    NULL },
+    { REGISTER_TEST_CASE(atca_helper, crc_incremental),                    NULL },
+#endif
+#if defined(ATCA_HAL_KIT_HID) || defined(ATCA_HAL_KIT_UART)
+    { REGISTER_TEST_CASE(atca_helper, kit_frame_round_trip),               NULL },
+    { REGISTER_TEST_CASE(atca_helper, kit_frame_truncated),                NULL },
+    { REGISTER_TEST_CASE(atca_helper, kit_frame_bad_length),               NULL },
+    { REGISTER_TEST_CASE(atca_helper, kit_frame_bad_crc),                  NULL },
+#endif
     /* Array Termination element*/
     { (fp_test_case)NULL, NULL },
 };
@@ -83,10 +83,42 @@ TEST(atca_cmd_basic_test, info_chip_status)
 }
 #endif
 
+#if ATCA_KEEP_AWAKE_EN && ATCA_CA_SUPPORT
+TEST(atca_cmd_basic_test, info_session)
+{
+    ATCA_STATUS status = ATCA_GEN_FAIL;
+    uint8_t revision[4];
+    uint8_t first_revision[4];
+    int i;
+
+    status = atcab_session_begin();
+    TEST_ASSERT_SUCCESS(status);
+
+    status = atcab_info(first_revision);
+    TEST_ASSERT_SUCCESS(status);
+
+    // Device is left active between the commands of a session
+    for (i = 0; i < 8; i++)
+    {
+        TEST_ASSERT_EQUAL((uint8_t)ATCA_DEVICE_STATE_ACTIVE, atcab_get_device()->device_state);
+        status = atcab_info(revision);
+        TEST_ASSERT_SUCCESS(status);
+        TEST_ASSERT_EQUAL_MEMORY(first_revision, revision, sizeof(revision));
+    }
+
+    status = atcab_session_end();
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT_EQUAL((uint8_t)ATCA_DEVICE_STATE_IDLE, atcab_get_device()->device_state);
+}
+#endif
+
 // *INDENT-OFF* - Preserve formatting
 t_test_case_info info_basic_test_info[] =
 {
     { REGISTER_TEST_CASE(atca_cmd_basic_test, info), NULL },
+#if ATCA_KEEP_AWAKE_EN && ATCA_CA_SUPPORT
+    { REGISTER_TEST_CASE(atca_cmd_basic_test, info_session), atca_test_cond_ca },
+#endif
 #if ATCA_CA2_SUPPORT
     { REGISTER_TEST_CASE(atca_cmd_basic_test, info_lock_status), atca_test_cond_ca2 },
     { REGISTER_TEST_CASE(atca_cmd_basic_test, info_chip_status), atca_test_cond_ca2 },
@@ -26,6 +26,7 @@
  */
 #include <stdlib.h>
 #include "test_atcab.h"
+#include "atca_pool.h"
 
 #ifndef TEST_ATCAB_RANDOM_EN
 #define TEST_ATCAB_RANDOM_EN            CALIB_RANDOM_EN || TALIB_RANDOM_EN
@@ -49,6 +50,79 @@ TEST(atca_cmd_basic_test, random)
     status = atcab_random(randomnum);
     TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
 }
+
+#if ATCA_POOL_EN
+TEST(atca_cmd_basic_test, random_pool)
+{
+    ATCA_STATUS status = ATCA_GEN_FAIL;
+    atca_pool_t pool;
+    atca_pool_device_cfg_t pool_cfg = { gCfg, 0 };
+    atca_pool_job_t jobs[4];
+    uint8_t randomnum[4][32];
+    size_t i;
+
+    status = atca_pool_init(&pool, &pool_cfg, 1);
+    TEST_ASSERT_SUCCESS(status);
+
+    memset(jobs, 0, sizeof(jobs));
+    for (i = 0; i < 4; i++)
+    {
+        jobs[i].op = ATCA_POOL_OP_RANDOM;
+        jobs[i].result = randomnum[i];
+        status = atca_pool_submit(&pool, &jobs[i]);
+        TEST_ASSERT_SUCCESS(status);
+    }
+
+    for (i = 0; i < 4; i++)
+    {
+        status = atca_pool_wait(&jobs[i]);
+        TEST_ASSERT_SUCCESS(status);
+        TEST_ASSERT_EQUAL_PTR(pool.devices[0], jobs[i].device);
+    }
+
+    // Keyed jobs are not dispatched to devices without a suitable key
+    jobs[0].op = ATCA_POOL_OP_SIGN;
+    jobs[0].key_id = 0;
+    status = atca_pool_submit(&pool, &jobs[0]);
+    TEST_ASSERT_EQUAL(ATCA_NO_DEVICES, status);
+
+    status = atca_pool_release(&pool);
+    TEST_ASSERT_SUCCESS(status);
+}
+#endif
+
+#if ATCA_ASYNC_EN && ATCA_CA_SUPPORT
+TEST(atca_cmd_basic_test, random_async)
+{
+    ATCA_STATUS status = ATCA_GEN_FAIL;
+    calib_async_t ctx;
+    uint8_t randomnum[RANDOM_RSP_SIZE];
+    uint8_t zeros[RANDOM_RSP_SIZE];
+
+    status = atcab_async_init(&ctx);
+    TEST_ASSERT_SUCCESS(status);
+
+    memset(randomnum, 0, sizeof(randomnum));
+    memset(zeros, 0, sizeof(zeros));
+    status = atcab_random_async(&ctx, randomnum);
+    TEST_ASSERT_SUCCESS(status);
+
+    // A second operation can not be started on a handle in use
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, atcab_random_async(&ctx, randomnum));
+
+    while (ATCA_RX_NO_RESPONSE == (status = atcab_async_poll(&ctx)))
+    {
+        atca_delay_ms(atcab_async_wait_time(&ctx));
+    }
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT_NOT_EQUAL(0, memcmp(randomnum, zeros, RANDOM_NUM_SIZE));
+
+    // Polling a finished operation keeps returning its result
+    TEST_ASSERT_SUCCESS(atcab_async_poll(&ctx));
+
+    atcab_async_release(&ctx);
+}
+#endif
 #endif
 
 // *INDENT-OFF* - Preserve formatting
@@ -56,6 +130,12 @@ t_test_case_info random_basic_test_info[] =
 {
 #if TEST_ATCAB_RANDOM_EN
     { REGISTER_TEST_CASE(atca_cmd_basic_test, random), REGISTER_TEST_CONDITION(atca_cmd_basic_test, random) },
+#if ATCA_POOL_EN
+    { REGISTER_TEST_CASE(atca_cmd_basic_test, random_pool), REGISTER_TEST_CONDITION(atca_cmd_basic_test, random) },
+#endif
+#if ATCA_ASYNC_EN && ATCA_CA_SUPPORT
+    { REGISTER_TEST_CASE(atca_cmd_basic_test, random_async), atca_test_cond_ca },
+#endif
 #endif
     { (fp_test_case)NULL,                     (uint8_t)0 },/* Array Termination element*/
 };
@@ -129,6 +129,88 @@ TEST(atca_cmd_basic_test, read_config_zone)
     }
 }
 
+#if CALIB_READ_EN
+TEST_CONDITION(atca_cmd_basic_test, read_config_zone_batch)
+{
+    ATCADeviceType dev_type = atca_test_get_device_type();
+
+    return (ATECC108A == dev_type) || (ATECC508A == dev_type) || (ATECC608 == dev_type);
+}
+#endif
+
+#if CALIB_READ_EN && ATCA_KEEP_AWAKE_EN
+TEST(atca_cmd_basic_test, read_config_zone_batch)
+{
+    ATCA_STATUS status = ATCA_GEN_FAIL;
+    static ATCAPacket packets[ATCA_ECC_CONFIG_SIZE / ATCA_BLOCK_SIZE];
+    calib_batch_result_t results[ATCA_ECC_CONFIG_SIZE / ATCA_BLOCK_SIZE];
+    uint8_t config_data[ATCA_ECC_CONFIG_SIZE];
+    uint16_t addr;
+    uint8_t block;
+
+    for (block = 0; block < (ATCA_ECC_CONFIG_SIZE / ATCA_BLOCK_SIZE); block++)
+    {
+        status = calib_get_addr(ATCA_ZONE_CONFIG, 0, block, 0, &addr);
+        TEST_ASSERT_SUCCESS(status);
+
+        (void)memset(&packets[block], 0, sizeof(ATCAPacket));
+        packets[block].param1 = ATCA_ZONE_CONFIG | ATCA_ZONE_READWRITE_32;
+        packets[block].param2 = addr;
+        status = atRead(gCfg->devtype, &packets[block]);
+        TEST_ASSERT_SUCCESS(status);
+    }
+
+    status = calib_execute_batch(atcab_get_device(), packets, block, results);
+    TEST_ASSERT_SUCCESS(status);
+
+    status = atcab_read_config_zone(config_data);
+    TEST_ASSERT_SUCCESS(status);
+
+    for (block = 0; block < (ATCA_ECC_CONFIG_SIZE / ATCA_BLOCK_SIZE); block++)
+    {
+        TEST_ASSERT_SUCCESS(results[block].status);
+        TEST_ASSERT_EQUAL_MEMORY(&config_data[block * ATCA_BLOCK_SIZE], &packets[block].data[1], ATCA_BLOCK_SIZE);
+    }
+}
+#endif
+
+#if CALIB_READ_EN && ATCA_CONFIG_CACHE_EN
+TEST(atca_cmd_basic_test, read_config_zone_cached)
+{
+    ATCA_STATUS status = ATCA_GEN_FAIL;
+    ATCADevice device = atcab_get_device();
+    uint8_t config_data[ATCA_ECC_CONFIG_SIZE];
+    uint8_t cached_data[ATCA_ECC_CONFIG_SIZE];
+    bool is_locked = false;
+
+    calib_config_cache_invalidate(device);
+    TEST_ASSERT_EQUAL(CALIB_CONFIG_CACHE_EMPTY, device->config_cache_state);
+
+    status = atcab_read_config_zone(config_data);
+    TEST_ASSERT_SUCCESS(status);
+
+    status = atcab_is_locked(LOCK_ZONE_CONFIG, &is_locked);
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT_EQUAL(is_locked ? CALIB_CONFIG_CACHE_VALID : CALIB_CONFIG_CACHE_UNLOCKED, device->config_cache_state);
+
+    // Reads answered from the cache match the device
+    status = atcab_read_config_zone(cached_data);
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT_EQUAL_MEMORY(config_data, cached_data, sizeof(config_data));
+
+#if CALIB_WRITE_EN
+    if (!is_locked)
+    {
+        // Configuration writes update the cached bytes rather than dropping them
+        status = atcab_write_zone(ATCA_ZONE_CONFIG, 0, 0, 4, &config_data[16], ATCA_WORD_SIZE);
+        TEST_ASSERT_SUCCESS(status);
+        TEST_ASSERT_EQUAL(CALIB_CONFIG_CACHE_UNLOCKED, device->config_cache_state);
+        TEST_ASSERT_EQUAL_MEMORY(&config_data[16], &device->config_cache[16], ATCA_WORD_SIZE);
+    }
+#endif
+}
+#endif
+
 #if CALIB_READ_EN
 TEST_CONDITION(atca_cmd_basic_test, read_otp_zone)
 {
@@ -198,6 +280,12 @@ t_test_case_info read_basic_test_info[] =
     { REGISTER_TEST_CASE(atca_cmd_basic_test, read_zone),        REGISTER_TEST_CONDITION(atca_cmd_basic_test, read_otp_zone) },
     { REGISTER_TEST_CASE(atca_cmd_basic_test, read_otp_zone),    REGISTER_TEST_CONDITION(atca_cmd_basic_test, read_otp_zone) },
 #endif
+#if CALIB_READ_EN && ATCA_KEEP_AWAKE_EN
+    { REGISTER_TEST_CASE(atca_cmd_basic_test, read_config_zone_batch), REGISTER_TEST_CONDITION(atca_cmd_basic_test, read_config_zone_batch) },
+#endif
+#if CALIB_READ_EN && ATCA_CONFIG_CACHE_EN
+    { REGISTER_TEST_CASE(atca_cmd_basic_test, read_config_zone_cached), REGISTER_TEST_CONDITION(atca_cmd_basic_test, read_config_zone_batch) },
+#endif
 #if CALIB_READ_CA2_EN
     { REGISTER_TEST_CASE(atca_cmd_basic_test, read_full_length), REGISTER_TEST_CONDITION(atca_cmd_basic_test, read_full_length) },
 #endif
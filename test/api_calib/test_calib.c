@@ -32,9 +32,13 @@
 //extern t_test_case_info calib_packet_info[];
 extern t_test_case_info calib_info_tests[];
 extern t_test_case_info calib_delete_tests[];
+extern t_test_case_info calib_poll_tests[];
 
 static t_test_case_info* calib_test_list[] =
 {
+    /* Host side tests that don't need a device */
+    calib_poll_tests,
+
     /* Basic tests that should pass for all parts */
     calib_info_tests,
 
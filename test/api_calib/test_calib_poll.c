@@ -0,0 +1,198 @@
+/**
+ * \file
+ * \brief Unity tests for the adaptive command polling estimator
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+#include "test_calib.h"
+
+#ifndef TEST_CALIB_POLL_EN
+#ifdef ATCA_NO_POLL
+#define TEST_CALIB_POLL_EN      (0)
+#else
+#define TEST_CALIB_POLL_EN      ATCA_ADAPTIVE_POLL_EN
+#endif
+#endif
+
+#if TEST_CALIB_POLL_EN
+/* Estimates are kept in 1/16 msec units */
+#define TEST_POLL_MSEC(x)       ((uint32_t)(x) << 4u)
+
+/* Start an estimate the way a new opcode entry is seeded */
+static void test_calib_poll_seed(atca_poll_stats_t* stats, uint16_t max_time)
+{
+    (void)memset(stats, 0, sizeof(*stats));
+    stats->opcode = 0x41;
+    stats->max_time = max_time;
+    stats->avg_time = TEST_POLL_MSEC(max_time) / 2u;
+    stats->p90_time = TEST_POLL_MSEC(max_time);
+}
+
+/* The estimator doesn't talk to a device so these tests run without one */
+TEST_GROUP(calib_poll);
+
+TEST_SETUP(calib_poll)
+{
+    UnityMalloc_StartTest();
+}
+
+TEST_TEAR_DOWN(calib_poll)
+{
+    UnityMalloc_EndTest();
+}
+
+TEST(calib_poll, record_warm_up)
+{
+    atca_poll_stats_t stats;
+
+    test_calib_poll_seed(&stats, 100);
+
+    /* The first observation replaces the seed */
+    calib_poll_record(&stats, 20);
+    TEST_ASSERT_EQUAL(1, stats.samples);
+    TEST_ASSERT_EQUAL(TEST_POLL_MSEC(20), stats.avg_time);
+    TEST_ASSERT_EQUAL(TEST_POLL_MSEC(20), stats.p90_time);
+
+    /* Slowest completion seen while warming up */
+    calib_poll_record(&stats, 30);
+    TEST_ASSERT_EQUAL(TEST_POLL_MSEC(25), stats.avg_time);
+    TEST_ASSERT_EQUAL(TEST_POLL_MSEC(30), stats.p90_time);
+}
+
+TEST(calib_poll, record_steady)
+{
+    atca_poll_stats_t stats;
+    int i;
+
+    test_calib_poll_seed(&stats, 100);
+
+    for (i = 0; i < 200; i++)
+    {
+        calib_poll_record(&stats, 20);
+    }
+
+    TEST_ASSERT_EQUAL(TEST_POLL_MSEC(20), stats.avg_time);
+    TEST_ASSERT_EQUAL(TEST_POLL_MSEC(20), stats.p90_time);
+}
+
+TEST(calib_poll, record_spread)
+{
+    atca_poll_stats_t stats;
+    uint32_t above = 0;
+    int i;
+
+    test_calib_poll_seed(&stats, 100);
+
+    /* Completion times spread evenly over 10 to 19 msec */
+    for (i = 0; i < 2000; i++)
+    {
+        uint32_t elapsed = 10u + (((uint32_t)i * 7u) % 10u);
+
+        if ((i >= 1000) && (TEST_POLL_MSEC(elapsed) > stats.p90_time))
+        {
+            above++;
+        }
+        calib_poll_record(&stats, elapsed);
+    }
+
+    TEST_ASSERT_UINT32_WITHIN(TEST_POLL_MSEC(1), TEST_POLL_MSEC(14) + 8u, stats.avg_time);
+    TEST_ASSERT_UINT32_WITHIN(TEST_POLL_MSEC(1), TEST_POLL_MSEC(19), stats.p90_time);
+
+    /* Roughly one in ten completions take longer than the estimate */
+    TEST_ASSERT_UINT32_WITHIN(50, 100, above);
+}
+
+TEST(calib_poll, record_clamped_to_max)
+{
+    atca_poll_stats_t stats;
+    int i;
+
+    test_calib_poll_seed(&stats, 50);
+
+    /* Time spent outside the device (e.g. a descheduled host) is capped at the table time */
+    for (i = 0; i < 100; i++)
+    {
+        calib_poll_record(&stats, 1000);
+    }
+
+    TEST_ASSERT_EQUAL(TEST_POLL_MSEC(50), stats.avg_time);
+    TEST_ASSERT_EQUAL(TEST_POLL_MSEC(50), stats.p90_time);
+    TEST_ASSERT_EQUAL(8, stats.samples);
+}
+
+TEST(calib_poll, interval)
+{
+    atca_poll_stats_t stats;
+
+    test_calib_poll_seed(&stats, 200);
+    stats.avg_time = TEST_POLL_MSEC(80);
+    stats.p90_time = TEST_POLL_MSEC(120);
+
+    /* First poll just ahead of the average */
+    TEST_ASSERT_EQUAL(70, calib_poll_first_delay(&stats));
+
+    /* Window from the first poll to the 90th percentile is covered in eight polls */
+    TEST_ASSERT_EQUAL(6, calib_poll_interval(&stats, 75));
+
+    /* Past the 90th percentile the interval grows with the overrun */
+    TEST_ASSERT_EQUAL(5, calib_poll_interval(&stats, 130));
+    TEST_ASSERT_EQUAL(15, calib_poll_interval(&stats, 150));
+
+    /* ... up to a quarter of the average */
+    TEST_ASSERT_EQUAL(20, calib_poll_interval(&stats, 500));
+}
+
+TEST(calib_poll, interval_lower_bounds)
+{
+    atca_poll_stats_t stats;
+
+    test_calib_poll_seed(&stats, 2);
+    stats.avg_time = TEST_POLL_MSEC(2);
+    stats.p90_time = TEST_POLL_MSEC(2);
+
+    TEST_ASSERT_EQUAL(ATCA_POLLING_INIT_TIME_MSEC, calib_poll_first_delay(&stats));
+    TEST_ASSERT_EQUAL(ATCA_POLLING_FREQUENCY_TIME_MSEC, calib_poll_interval(&stats, 0));
+    TEST_ASSERT_EQUAL(ATCA_POLLING_FREQUENCY_TIME_MSEC, calib_poll_interval(&stats, 3));
+
+    stats.avg_time = 0;
+    stats.p90_time = 0;
+    TEST_ASSERT_EQUAL(ATCA_POLLING_INIT_TIME_MSEC, calib_poll_first_delay(&stats));
+    TEST_ASSERT_EQUAL(ATCA_POLLING_FREQUENCY_TIME_MSEC, calib_poll_interval(&stats, 100));
+}
+#endif
+
+// *INDENT-OFF* - Preserve formatting
+t_test_case_info calib_poll_tests[] =
+{
+#if TEST_CALIB_POLL_EN
+    { REGISTER_TEST_CASE(calib_poll, record_warm_up),          NULL },
+    { REGISTER_TEST_CASE(calib_poll, record_steady),           NULL },
+    { REGISTER_TEST_CASE(calib_poll, record_spread),           NULL },
+    { REGISTER_TEST_CASE(calib_poll, record_clamped_to_max),   NULL },
+    { REGISTER_TEST_CASE(calib_poll, interval),                NULL },
+    { REGISTER_TEST_CASE(calib_poll, interval_lower_bounds),   NULL },
+#endif
+    /* Array Termination element*/
+    { (fp_test_case)NULL, NULL },
+};
+// *INDENT-ON*
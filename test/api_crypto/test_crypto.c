@@ -32,6 +32,7 @@ static t_test_case_info* atcac_tests[] =
     atcac_sha_test_info,
     atcac_pbkdf2_test_info,
     atcac_pad_test_info,
+    atcac_ghash_test_info,
 #if defined(ATCA_MBEDTLS) || defined(ATCA_OPENSSL) || defined(ATCA_WOLFSSL)
     atcac_aes_test_info,
     atcac_pk_test_info,
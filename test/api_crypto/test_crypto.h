@@ -39,6 +39,7 @@ extern t_test_case_info atcac_aes_test_info[];
 extern t_test_case_info atcac_pk_test_info[];
 extern t_test_case_info atcac_pbkdf2_test_info[];
 extern t_test_case_info atcac_pad_test_info[];
+extern t_test_case_info atcac_ghash_test_info[];
 extern t_test_case_info atcac_sha_test_info[];
 
 /* Console function */
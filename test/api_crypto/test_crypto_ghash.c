@@ -0,0 +1,162 @@
+/**
+ * \file
+ * \brief Known-answer tests for the host GHASH multiply used by AES-GCM.
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+
+
+#include "atca_test.h"
+
+#ifndef TEST_ATCAC_GHASH_EN
+#define TEST_ATCAC_GHASH_EN      (CALIB_AES_GCM_EN && (CALIB_GHASH_ENGINE != CALIB_GHASH_DEVICE))
+#endif
+
+#if TEST_ATCAC_GHASH_EN
+typedef void (*ghash_gfmul_fn)(const uint8_t* x, const uint8_t* h, uint8_t* z);
+
+typedef struct
+{
+    uint8_t x[16];
+    uint8_t h[16];
+    uint8_t z[16];
+} ghash_gfmul_vector;
+
+/* Products taken from the GHASH steps of the GCM specification test cases 2 and 3 */
+static const ghash_gfmul_vector ghash_gfmul_vectors[] =
+{
+    {   /* Test case 2: X1 = C1 * H */
+        { 0x03, 0x88, 0xDA, 0xCE, 0x60, 0xB6, 0xA3, 0x92, 0xF3, 0x28, 0xC2, 0xB9, 0x71, 0xB2, 0xFE, 0x78 },
+        { 0x66, 0xE9, 0x4B, 0xD4, 0xEF, 0x8A, 0x2C, 0x3B, 0x88, 0x4C, 0xFA, 0x59, 0xCA, 0x34, 0x2B, 0x2E },
+        { 0x5E, 0x2E, 0xC7, 0x46, 0x91, 0x70, 0x62, 0x88, 0x2C, 0x85, 0xB0, 0x68, 0x53, 0x53, 0xDE, 0xB7 }
+    },
+    {   /* Test case 2: GHASH = (X1 ^ len(A) || len(C)) * H */
+        { 0x5E, 0x2E, 0xC7, 0x46, 0x91, 0x70, 0x62, 0x88, 0x2C, 0x85, 0xB0, 0x68, 0x53, 0x53, 0xDE, 0x37 },
+        { 0x66, 0xE9, 0x4B, 0xD4, 0xEF, 0x8A, 0x2C, 0x3B, 0x88, 0x4C, 0xFA, 0x59, 0xCA, 0x34, 0x2B, 0x2E },
+        { 0xF3, 0x8C, 0xBB, 0x1A, 0xD6, 0x92, 0x23, 0xDC, 0xC3, 0x45, 0x7A, 0xE5, 0xB6, 0xB0, 0xF8, 0x85 }
+    },
+    {   /* Test case 3: X1 = C1 * H */
+        { 0x42, 0x83, 0x1E, 0xC2, 0x21, 0x77, 0x74, 0x24, 0x4B, 0x72, 0x21, 0xB7, 0x84, 0xD0, 0xD4, 0x9C },
+        { 0xB8, 0x3B, 0x53, 0x37, 0x08, 0xBF, 0x53, 0x5D, 0x0A, 0xA6, 0xE5, 0x29, 0x80, 0xD5, 0x3B, 0x78 },
+        { 0x59, 0xED, 0x3F, 0x2B, 0xB1, 0xA0, 0xAA, 0xA0, 0x7C, 0x9F, 0x56, 0xC6, 0xA5, 0x04, 0x64, 0x7B }
+    },
+    {   /* The multiplicative identity (x^0) leaves H unchanged */
+        { 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+        { 0xB8, 0x3B, 0x53, 0x37, 0x08, 0xBF, 0x53, 0x5D, 0x0A, 0xA6, 0xE5, 0x29, 0x80, 0xD5, 0x3B, 0x78 },
+        { 0xB8, 0x3B, 0x53, 0x37, 0x08, 0xBF, 0x53, 0x5D, 0x0A, 0xA6, 0xE5, 0x29, 0x80, 0xD5, 0x3B, 0x78 }
+    },
+    {   /* All ones operands exercise every reduction step */
+        { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF },
+        { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF },
+        { 0xF4, 0x02, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA }
+    },
+};
+
+static void test_ghash_gfmul_vectors(ghash_gfmul_fn gfmul)
+{
+    const ghash_gfmul_vector * pVector = ghash_gfmul_vectors;
+    uint8_t z[16];
+    size_t i;
+
+    for (i = 0; i < sizeof(ghash_gfmul_vectors) / sizeof(ghash_gfmul_vectors[0]); i++, pVector++)
+    {
+        memset(z, 0, sizeof(z));
+        gfmul(pVector->x, pVector->h, z);
+        TEST_ASSERT_EQUAL_MEMORY(pVector->z, z, sizeof(z));
+
+        /* GHASH multiplies its running value in place */
+        memcpy(z, pVector->x, sizeof(z));
+        gfmul(z, pVector->h, z);
+        TEST_ASSERT_EQUAL_MEMORY(pVector->z, z, sizeof(z));
+    }
+}
+
+TEST_GROUP(atcac_ghash);
+
+TEST_SETUP(atcac_ghash)
+{
+    UnityMalloc_StartTest();
+}
+
+TEST_TEAR_DOWN(atcac_ghash)
+{
+    UnityMalloc_EndTest();
+}
+
+TEST(atcac_ghash, gfmul_portable)
+{
+    test_ghash_gfmul_vectors(calib_aes_gcm_gfmul_portable);
+}
+
+TEST(atcac_ghash, gfmul_clmul)
+{
+    if (!calib_aes_gcm_gfmul_is_clmul())
+    {
+        TEST_IGNORE_MESSAGE("No carry-less multiply engine in this build");
+    }
+    test_ghash_gfmul_vectors(calib_aes_gcm_gfmul);
+}
+
+TEST(atcac_ghash, gfmul_engines_match)
+{
+    uint8_t x[16];
+    uint8_t h[16];
+    uint8_t z1[16];
+    uint8_t z2[16];
+    uint32_t seed = 0x12345678u;
+    size_t i;
+    size_t j;
+
+    /* Cross check the selected engine against the portable one on pseudo-random operands */
+    for (i = 0; i < 256u; i++)
+    {
+        for (j = 0; j < sizeof(x); j++)
+        {
+            seed = seed * 1103515245u + 12345u;
+            x[j] = (uint8_t)(seed >> 24);
+            seed = seed * 1103515245u + 12345u;
+            h[j] = (uint8_t)(seed >> 24);
+        }
+        calib_aes_gcm_gfmul_portable(x, h, z1);
+        calib_aes_gcm_gfmul(x, h, z2);
+        TEST_ASSERT_EQUAL_MEMORY(z1, z2, sizeof(z1));
+
+        /* Multiplication in GF(2^128) is commutative */
+        calib_aes_gcm_gfmul(h, x, z2);
+        TEST_ASSERT_EQUAL_MEMORY(z1, z2, sizeof(z1));
+    }
+}
+
+#endif /* TEST_ATCAC_GHASH_EN */
+
+
+t_test_case_info atcac_ghash_test_info[] =
+{
+#if TEST_ATCAC_GHASH_EN
+    { REGISTER_TEST_CASE(atcac_ghash, gfmul_portable),      NULL },
+    { REGISTER_TEST_CASE(atcac_ghash, gfmul_clmul),         NULL },
+    { REGISTER_TEST_CASE(atcac_ghash, gfmul_engines_match), NULL },
+#endif
+    /* Array Termination element*/
+    { (fp_test_case)NULL,                     NULL },
+};
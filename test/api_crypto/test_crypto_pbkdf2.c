@@ -64,6 +64,36 @@ TEST(atcac_pbkdf2, vectors)
         TEST_ASSERT_EQUAL_MEMORY(pVector->dk, result, pVector->dklen);
     }
 }
+
+/* Output spanning several (and a partial) blocks so they are derived together */
+TEST(atcac_pbkdf2, long_output)
+{
+    ATCA_STATUS status;
+    const char password[] = "passwordPASSWORDpassword";
+    const char salt[] = "saltSALTsaltSALTsaltSALTsaltSALTsalt";
+    const uint8_t expected[200] =
+    {
+        0x34, 0x8c, 0x89, 0xdb, 0xcb, 0xd3, 0x2b, 0x2f, 0x32, 0xd8, 0x14, 0xb8, 0x11, 0x6e, 0x84, 0xcf,
+        0x2b, 0x17, 0x34, 0x7e, 0xbc, 0x18, 0x00, 0x18, 0x1c, 0x4e, 0x2a, 0x1f, 0xb8, 0xdd, 0x53, 0xe1,
+        0xc6, 0x35, 0x51, 0x8c, 0x7d, 0xac, 0x47, 0xe9, 0x45, 0x61, 0xf2, 0x68, 0x60, 0x56, 0xe5, 0xfc,
+        0xd3, 0x98, 0x9b, 0xf8, 0x96, 0x0b, 0xb2, 0xa3, 0x6c, 0x90, 0x34, 0x05, 0x86, 0xc4, 0xfa, 0xca,
+        0x44, 0xd5, 0x62, 0x7a, 0x75, 0xce, 0x35, 0x11, 0x54, 0xb9, 0xff, 0x85, 0xe6, 0xf1, 0x95, 0x00,
+        0x73, 0xb0, 0x4e, 0x66, 0x2b, 0x21, 0x1e, 0x3b, 0x88, 0x84, 0x1e, 0x20, 0xc8, 0x06, 0x0d, 0xc2,
+        0xe7, 0x8b, 0x4a, 0xe0, 0x3a, 0x33, 0x7e, 0x27, 0x4b, 0xe0, 0xa3, 0xf4, 0x27, 0x4a, 0xa6, 0x1a,
+        0x9e, 0xef, 0x2a, 0x91, 0xcd, 0x07, 0x6b, 0x56, 0x11, 0xee, 0xf3, 0xf3, 0x0f, 0x89, 0xd1, 0x4b,
+        0x5c, 0xae, 0xe3, 0x00, 0xbb, 0x71, 0x46, 0x37, 0x5a, 0xc1, 0x02, 0xf8, 0x43, 0xc7, 0x9e, 0x99,
+        0xb9, 0xbc, 0x51, 0x55, 0x3c, 0x27, 0x1b, 0x39, 0x5d, 0x6e, 0x0f, 0xc8, 0xc5, 0x4d, 0xc5, 0x06,
+        0x6a, 0x9f, 0xfe, 0x98, 0x81, 0x82, 0xd3, 0xfc, 0x5e, 0x4c, 0x29, 0xd0, 0x06, 0x08, 0xe7, 0x94,
+        0xd2, 0xac, 0x8b, 0xa6, 0x73, 0xcf, 0x7b, 0xfe, 0xcf, 0x26, 0xef, 0x95, 0x52, 0x58, 0x9d, 0x79,
+        0x20, 0x7d, 0x9c, 0xdf, 0x24, 0x79, 0xcc, 0x1f
+    };
+    uint8_t result[sizeof(expected)];
+
+    status = atcac_pbkdf2_sha256(4096, (const uint8_t*)password, sizeof(password) - 1u, (const uint8_t*)salt,
+                                 sizeof(salt) - 1u, result, sizeof(result));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL_MEMORY(expected, result, sizeof(expected));
+}
 #endif /* TEST_ATCAC_PBKDF2_EN */
 
 #if TEST_ATCAB_PBKDF2_EN
@@ -120,15 +150,50 @@ TEST(atcab_pbkdf2, vectors)
         TEST_ASSERT_EQUAL_MEMORY(pVector->dk, result, ATCA_SHA256_DIGEST_SIZE);
     }
 }
+
+static void test_atcab_pbkdf2_progress(void* user_data, size_t block, uint32_t done, uint32_t iter)
+{
+    uint32_t* last_done = (uint32_t*)user_data;
+
+    TEST_ASSERT_EQUAL(0, block);
+    TEST_ASSERT_TRUE(done > *last_done);
+    TEST_ASSERT_TRUE(done <= iter);
+    *last_done = done;
+}
+
+TEST(atcab_pbkdf2, progress)
+{
+    ATCA_STATUS status;
+    const pbkdf2_sha256_fixed_size_test_vector* pVector = pbkdf2_sha256_fixed_size_test_vectors;
+    size_t i;
+    uint8_t result[ATCA_SHA256_DIGEST_SIZE];
+    uint16_t key_id = 6;
+    uint32_t last_done;
+
+    status = atca_test_config_get_id(TEST_TYPE_HMAC, &key_id);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    for (i = 0; i < pbkdf2_sha256_fixed_size_test_vectors_count; i++, pVector++)
+    {
+        last_done = 0;
+        status = atcab_pbkdf2_sha256_progress(atcab_get_device(), pVector->c, key_id, (uint8_t*)pVector->s, pVector->slen,
+                                              result, ATCA_SHA256_DIGEST_SIZE, test_atcab_pbkdf2_progress, &last_done);
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+        TEST_ASSERT_EQUAL(pVector->c, last_done);
+        TEST_ASSERT_EQUAL_MEMORY(pVector->dk, result, ATCA_SHA256_DIGEST_SIZE);
+    }
+}
 #endif /* TEST_ATCAB_PBKDF2_EN */
 
 t_test_case_info atcac_pbkdf2_test_info[] =
 {
 #if TEST_ATCAC_PBKDF2_EN
     { REGISTER_TEST_CASE(atcac_pbkdf2, vectors), NULL     },
+    { REGISTER_TEST_CASE(atcac_pbkdf2, long_output), NULL },
 #endif
 #if TEST_ATCAB_PBKDF2_EN
     { REGISTER_TEST_CASE(atcab_pbkdf2, vectors), REGISTER_TEST_CONDITION(atcab_pbkdf2, vectors)},
+    { REGISTER_TEST_CASE(atcab_pbkdf2, progress), REGISTER_TEST_CONDITION(atcab_pbkdf2, vectors)},
 #endif
     /* Array Termination element*/
     { (fp_test_case)NULL,              NULL },
@@ -47,11 +47,30 @@
 
 #include "crypto/atca_crypto_sw_sha1.h"
 #include "crypto/atca_crypto_sw_sha2.h"
+#include "crypto/hashes/sha2_routines.h"
 
 static const uint8_t nist_hash_msg1[] = "abc";
 static const uint8_t nist_hash_msg2[] = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
 static const uint8_t nist_hash_msg3[] = "a";
 
+#if ATCA_CRYPTO_SHA2_HW_EN && ((TEST_ATCAC_SHA256_EN && ATCA_CRYPTO_SHA256_EN) || \
+    (TEST_ATCAC_SHA512_EN && ATCA_CRYPTO_SHA512_EN))
+static const sw_sha2_kernel_t sw_sha2_kernels[] = {
+    SW_SHA2_KERNEL_C, SW_SHA2_KERNEL_SHANI, SW_SHA2_KERNEL_AVX2, SW_SHA2_KERNEL_ARMV8
+};
+
+/* Message long enough to cover the odd and even block counts of the kernels */
+static void test_sha2_kernel_msg(uint8_t* msg, size_t msg_size)
+{
+    size_t i;
+
+    for (i = 0; i < msg_size; i++)
+    {
+        msg[i] = (uint8_t)(i * 131u + 7u);
+    }
+}
+#endif
+
 TEST_GROUP(atcac_sha);
 
 TEST_SETUP(atcac_sha)
@@ -555,6 +574,119 @@ TEST(atcac_sha, sha256_hmac_nist)
 
 #endif
 }
+
+#if ATCA_CRYPTO_SHA2_HW_EN && ATCA_CRYPTO_SHA256_EN
+TEST(atcac_sha, sha256_kernels)
+{
+    const uint8_t digest_ref[] = {
+        0x24, 0x8D, 0x6A, 0x61, 0xD2, 0x06, 0x38, 0xB8, 0xE5, 0xC0, 0x26, 0x93, 0x0C, 0x3E, 0x60, 0x39,
+        0xA3, 0x3C, 0xE4, 0x59, 0x64, 0xFF, 0x21, 0x67, 0xF6, 0xEC, 0xED, 0xD4, 0x19, 0xDB, 0x06, 0xC1
+    };
+    uint8_t msg[SHA256_BLOCK_SIZE * 9];
+    uint8_t md_ref[SHA256_DIGEST_SIZE];
+    uint8_t md[SHA256_DIGEST_SIZE];
+    size_t k;
+    size_t len;
+    ATCA_STATUS status;
+
+    test_sha2_kernel_msg(msg, sizeof(msg));
+
+    for (k = 0; k < sizeof(sw_sha2_kernels) / sizeof(sw_sha2_kernels[0]); k++)
+    {
+        if (ATCA_UNIMPLEMENTED == sw_sha256_set_kernel(sw_sha2_kernels[k]))
+        {
+            /* Not available on this processor */
+            continue;
+        }
+
+        status = sw_sha256(nist_hash_msg2, sizeof(nist_hash_msg2) - 1, md);
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+        TEST_ASSERT_EQUAL_MEMORY(digest_ref, md, sizeof(digest_ref));
+
+        /* Every kernel must match the portable implementation */
+        for (len = 0; len <= sizeof(msg); len += 13)
+        {
+            TEST_ASSERT_EQUAL(ATCA_SUCCESS, sw_sha256_set_kernel(SW_SHA2_KERNEL_C));
+            status = sw_sha256(msg, (unsigned int)len, md_ref);
+            TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+            TEST_ASSERT_EQUAL(ATCA_SUCCESS, sw_sha256_set_kernel(sw_sha2_kernels[k]));
+            status = sw_sha256(msg, (unsigned int)len, md);
+            TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+            TEST_ASSERT_EQUAL_MEMORY(md_ref, md, sizeof(md_ref));
+        }
+    }
+
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, sw_sha256_set_kernel(SW_SHA2_KERNEL_AUTO));
+}
+#endif
+
+#if ATCA_CRYPTO_SHA256_EN
+TEST(atcac_sha, sha256_multi)
+{
+#if ATCA_CRYPTO_SHA2_HW_EN
+    static const sw_sha2_kernel_t kernels[] = {
+        SW_SHA2_KERNEL_C, SW_SHA2_KERNEL_SSE2, SW_SHA2_KERNEL_AVX2, SW_SHA2_KERNEL_AVX512, SW_SHA2_KERNEL_NEON
+    };
+#endif
+    static uint8_t msg[SHA256_BLOCK_SIZE * 9];
+    const uint8_t* messages[37];
+    uint32_t message_sizes[37];
+    uint8_t digests[37][SHA256_DIGEST_SIZE];
+    uint8_t md_ref[SHA256_DIGEST_SIZE];
+    size_t k = 0;
+    size_t i;
+    ATCA_STATUS status;
+
+    for (i = 0; i < sizeof(msg); i++)
+    {
+        msg[i] = (uint8_t)(i * 131u + 7u);
+    }
+
+    // Messages of different lengths so lanes finish at different times
+    for (i = 0; i < 37u; i++)
+    {
+        messages[i] = &msg[i];
+        message_sizes[i] = (uint32_t)((i * 61u) % (sizeof(msg) - i));
+    }
+    messages[3] = NULL;
+    message_sizes[3] = 0;
+
+    do
+    {
+#if ATCA_CRYPTO_SHA2_HW_EN
+        if (ATCA_UNIMPLEMENTED == sw_sha256_multi_set_kernel(kernels[k]))
+        {
+            /* Not available on this processor */
+            continue;
+        }
+#endif
+        (void)memset(digests, 0, sizeof(digests));
+        status = sw_sha256_multi(messages, message_sizes, 37u, digests);
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+        for (i = 0; i < 37u; i++)
+        {
+            status = sw_sha256(messages[i], message_sizes[i], md_ref);
+            TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+            TEST_ASSERT_EQUAL_MEMORY(md_ref, digests[i], sizeof(md_ref));
+        }
+    }
+#if ATCA_CRYPTO_SHA2_HW_EN
+    while (++k < sizeof(kernels) / sizeof(kernels[0]));
+
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, sw_sha256_multi_set_kernel(SW_SHA2_KERNEL_AUTO));
+#else
+    while (++k < 1u);
+#endif
+
+    messages[5] = NULL;
+    message_sizes[5] = 10;
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, sw_sha256_multi(messages, message_sizes, 37u, digests));
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, sw_sha256_multi(NULL, message_sizes, 37u, digests));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, sw_sha256_multi(NULL, NULL, 0u, NULL));
+}
+#endif
 #endif /* TEST_ATCAC_SHA256_EN */
 
 #if TEST_ATCAC_SHA384_EN
@@ -902,6 +1034,53 @@ TEST(atcac_sha, sha512_nist_monte)
     (void)fclose(rsp_file);
 #endif
 }
+#if ATCA_CRYPTO_SHA2_HW_EN && ATCA_CRYPTO_SHA512_EN
+TEST(atcac_sha, sha512_kernels)
+{
+    const uint8_t digest_ref[] = {
+        0x20, 0x4a, 0x8f, 0xc6, 0xdd, 0xa8, 0x2f, 0x0a, 0x0c, 0xed, 0x7b, 0xeb, 0x8e, 0x08, 0xa4, 0x16,
+        0x57, 0xc1, 0x6e, 0xf4, 0x68, 0xb2, 0x28, 0xa8, 0x27, 0x9b, 0xe3, 0x31, 0xa7, 0x03, 0xc3, 0x35,
+        0x96, 0xfd, 0x15, 0xc1, 0x3b, 0x1b, 0x07, 0xf9, 0xaa, 0x1d, 0x3b, 0xea, 0x57, 0x78, 0x9c, 0xa0,
+        0x31, 0xad, 0x85, 0xc7, 0xa7, 0x1d, 0xd7, 0x03, 0x54, 0xec, 0x63, 0x12, 0x38, 0xca, 0x34, 0x45
+    };
+    uint8_t msg[SHA512_BLOCK_SIZE * 9];
+    uint8_t md_ref[SHA512_DIGEST_SIZE];
+    uint8_t md[SHA512_DIGEST_SIZE];
+    size_t k;
+    size_t len;
+    ATCA_STATUS status;
+
+    test_sha2_kernel_msg(msg, sizeof(msg));
+
+    for (k = 0; k < sizeof(sw_sha2_kernels) / sizeof(sw_sha2_kernels[0]); k++)
+    {
+        if (ATCA_UNIMPLEMENTED == sw_sha512_set_kernel(sw_sha2_kernels[k]))
+        {
+            /* Not available on this processor */
+            continue;
+        }
+
+        status = sw_sha512(nist_hash_msg2, sizeof(nist_hash_msg2) - 1, md);
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+        TEST_ASSERT_EQUAL_MEMORY(digest_ref, md, sizeof(digest_ref));
+
+        /* Every kernel must match the portable implementation */
+        for (len = 0; len <= sizeof(msg); len += 29)
+        {
+            TEST_ASSERT_EQUAL(ATCA_SUCCESS, sw_sha512_set_kernel(SW_SHA2_KERNEL_C));
+            status = sw_sha512(msg, (unsigned int)len, md_ref);
+            TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+            TEST_ASSERT_EQUAL(ATCA_SUCCESS, sw_sha512_set_kernel(sw_sha2_kernels[k]));
+            status = sw_sha512(msg, (unsigned int)len, md);
+            TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+            TEST_ASSERT_EQUAL_MEMORY(md_ref, md, sizeof(md_ref));
+        }
+    }
+
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, sw_sha512_set_kernel(SW_SHA2_KERNEL_AUTO));
+}
+#endif
 #endif /* TEST_ATCAC_SHA512_EN*/
 
 // *INDENT-OFF* - Preserve formatting
@@ -924,6 +1103,12 @@ t_test_case_info atcac_sha_test_info[] =
     { REGISTER_TEST_CASE(atcac_sha, sha256_nist_monte), NULL },
     { REGISTER_TEST_CASE(atcac_sha, sha256_hmac),       NULL },
     { REGISTER_TEST_CASE(atcac_sha, sha256_hmac_nist),  NULL },
+#if ATCA_CRYPTO_SHA2_HW_EN && ATCA_CRYPTO_SHA256_EN
+    { REGISTER_TEST_CASE(atcac_sha, sha256_kernels),    NULL },
+#endif
+#if ATCA_CRYPTO_SHA256_EN
+    { REGISTER_TEST_CASE(atcac_sha, sha256_multi),      NULL },
+#endif
 #endif
 #if TEST_ATCAC_SHA384_EN
     { REGISTER_TEST_CASE(atcac_sha, sha384_nist1),      NULL },
@@ -940,6 +1125,9 @@ t_test_case_info atcac_sha_test_info[] =
     { REGISTER_TEST_CASE(atcac_sha, sha512_nist_short), NULL },
     { REGISTER_TEST_CASE(atcac_sha, sha512_nist_long),  NULL },
     { REGISTER_TEST_CASE(atcac_sha, sha512_nist_monte),  NULL },
+#if ATCA_CRYPTO_SHA2_HW_EN && ATCA_CRYPTO_SHA512_EN
+    { REGISTER_TEST_CASE(atcac_sha, sha512_kernels),    NULL },
+#endif
 #endif
     { NULL, NULL },         /* Array Termination element*/
 };
@@ -236,6 +236,7 @@ bool atca_test_cond_aes_ccm(void);
 bool atca_test_cond_ecc608(void);
 bool atca_test_cond_ta(void);
 bool atca_test_cond_ca2(void);
+bool atca_test_cond_ca(void);
 
 /* Commands */
 int process_options(int argc, char* argv[]);
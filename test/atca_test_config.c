@@ -187,6 +187,12 @@ bool atca_test_cond_ca2(void)
     return atcab_is_ca2_device(atca_test_get_device_type());
 }
 
+/** \brief Configured device is an ATSHA or ATECC device */
+bool atca_test_cond_ca(void)
+{
+    return atcab_is_ca_device(atca_test_get_device_type());
+}
+
 /** \brief Sets the device the command or test suite will use
  *
  * \param[in]  ifacecfg    Platform iface config to use
@@ -95,6 +95,7 @@ extern t_test_case_info atcacert_client_ca2_tests[];
 extern t_test_case_info atcacert_client_ta_tests[];
 extern t_test_case_info atcacert_host_hw_ta_tests[];
 extern t_test_case_info atcacert_host_sw_tests[];
+extern t_test_case_info atcacert_verifier_tests[];
 
 t_test_case_info* atcacert_data_test_list[] = {
 #if ATCACERT_COMPCERT_EN
@@ -158,6 +159,7 @@ t_test_case_info* atcacert_data_test_list[] = {
     atcacert_get_comp_cert_tests,
     atcacert_get_tbs_tests,
     atcacert_get_tbs_digest_tests,
+    atcacert_verifier_tests,
     atcacert_merge_device_loc_tests,
     atcacert_get_device_locs_tests,
     atcacert_cert_build_tests,
@@ -383,6 +383,44 @@ TEST(atcacert_client, atcacert_read_device_loc_data_partial)
     TEST_ASSERT_EQUAL_MEMORY(&data_full[device_loc.offset], data, device_loc.count);
 }
 
+TEST(atcacert_client, atcacert_read_device_locs)
+{
+    int ret;
+    size_t i;
+    uint8_t data_full[72];
+    uint8_t public_key[ATCA_ECCP256_PUBKEY_SIZE];
+    uint8_t config_data[ATCA_BLOCK_SIZE];
+    uint8_t data[4][72];
+    uint8_t* data_ptrs[4] = { data[0], data[1], data[2], data[3] };
+    const atcacert_device_loc_t device_locs[4] = {
+        { DEVZONE_DATA,   12, FALSE, 5,  55 },
+        { DEVZONE_DATA,   12, FALSE, 30, 40 },  // Overlaps the first location and runs past the end of the slot
+        { DEVZONE_DATA,   0,  TRUE,  0,  64 },
+        { DEVZONE_CONFIG, 0,  FALSE, 0,  13 }
+    };
+
+    ret = atcab_read_bytes_zone(ATCA_ZONE_DATA, 12, 0, data_full, sizeof(data_full));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, ret);
+
+    ret = atcab_get_pubkey(0, public_key);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, ret);
+
+    ret = atcab_read_zone(ATCA_ZONE_CONFIG, 0, 0, 0, config_data, ATCA_BLOCK_SIZE);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, ret);
+
+    for (i = 0; i < 4u; i++)
+    {
+        memset(data[i], 0xA5, sizeof(data[i]));
+    }
+
+    ret = atcacert_read_device_locs_ext(atcab_get_device(), device_locs, 4u, data_ptrs);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, ret);
+    TEST_ASSERT_EQUAL_MEMORY(&data_full[5], data[0], 55);
+    TEST_ASSERT_EQUAL_MEMORY(&data_full[30], data[1], sizeof(data_full) - 30u);
+    TEST_ASSERT_EQUAL_MEMORY(public_key, data[2], sizeof(public_key));
+    TEST_ASSERT_EQUAL_MEMORY(config_data, data[3], 13);
+}
+
 TEST(atcacert_client, atcacert_read_cert_signer)
 {
     int ret = 0;
@@ -2413,6 +2451,7 @@ t_test_case_info atcacert_client_tests[] =
     { REGISTER_TEST_CASE(atcacert_client, atcacert_read_device_loc_gen_key),         atca_test_cond_ecc608 },
     { REGISTER_TEST_CASE(atcacert_client, atcacert_read_device_loc_gen_key_partial), atca_test_cond_ecc608 },
     { REGISTER_TEST_CASE(atcacert_client, atcacert_read_device_loc_data_partial),    atca_test_cond_ecc608 },
+    { REGISTER_TEST_CASE(atcacert_client, atcacert_read_device_locs),                atca_test_cond_ecc608 },
 
     { REGISTER_TEST_CASE(atcacert_client, atcacert_read_cert_signer),                atca_test_cond_ecc608 },
     { REGISTER_TEST_CASE(atcacert_client, atcacert_read_cert_device),                atca_test_cond_ecc608 },
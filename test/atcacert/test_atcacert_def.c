@@ -5217,6 +5217,60 @@ TEST(atcacert_get_tbs_digest, bad_params)
 }
 
 
+TEST(atcacert_get_tbs_digest, batch)
+{
+    int ret = 0;
+    uint8_t certs[20][1024];
+    const uint8_t* cert_ptrs[20];
+    size_t cert_sizes[20];
+    uint8_t tbs_digests[20][32];
+    cal_buffer tbs_digest_bufs[20];
+    uint8_t tbs_digest_ref[32];
+    cal_buffer tbs_digest_ref_buf = CAL_BUF_INIT(sizeof(tbs_digest_ref), tbs_digest_ref);
+    size_t i;
+
+    TEST_ASSERT(g_cert_def.cert_template_size <= sizeof(certs[0]));
+
+    // More certificates than a batch, each with different TBS data
+    for (i = 0; i < 20u; i++)
+    {
+        (void)memcpy(certs[i], g_cert_def_cert_template, g_cert_def.cert_template_size);
+        certs[i][g_cert_def.tbs_cert_loc.offset + g_cert_def.tbs_cert_loc.count - 1u] ^= (uint8_t)i;
+        cert_ptrs[i] = certs[i];
+        cert_sizes[i] = g_cert_def.cert_template_size;
+        tbs_digest_bufs[i].buf = tbs_digests[i];
+        tbs_digest_bufs[i].len = sizeof(tbs_digests[i]);
+    }
+
+    ret = atcacert_get_tbs_digest_batch(&g_cert_def, cert_ptrs, cert_sizes, 20u, tbs_digest_bufs);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+
+    for (i = 0; i < 20u; i++)
+    {
+        ret = atcacert_get_tbs_digest(&g_cert_def, cert_ptrs[i], cert_sizes[i], &tbs_digest_ref_buf);
+        TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+        TEST_ASSERT_EQUAL_MEMORY(tbs_digest_ref, tbs_digests[i], sizeof(tbs_digest_ref));
+    }
+
+    // A truncated certificate fails the batch
+    cert_sizes[7] = g_cert_def.tbs_cert_loc.offset;
+    ret = atcacert_get_tbs_digest_batch(&g_cert_def, cert_ptrs, cert_sizes, 20u, tbs_digest_bufs);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_CERT, ret);
+
+    ret = atcacert_get_tbs_digest_batch(&g_cert_def, cert_ptrs, cert_sizes, 0u, tbs_digest_bufs);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+
+    ret = atcacert_get_tbs_digest_batch(NULL, cert_ptrs, cert_sizes, 20u, tbs_digest_bufs);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
+
+    ret = atcacert_get_tbs_digest_batch(&g_cert_def, NULL, cert_sizes, 20u, tbs_digest_bufs);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
+
+    ret = atcacert_get_tbs_digest_batch(&g_cert_def, cert_ptrs, cert_sizes, 20u, NULL);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
+}
+
+
 TEST_GROUP(atcacert_merge_device_loc);
 
 TEST_SETUP(atcacert_merge_device_loc)
@@ -9418,6 +9472,7 @@ t_test_case_info atcacert_get_tbs_digest_tests[] =
 {
     { REGISTER_TEST_CASE(atcacert_get_tbs_digest, good),                        NULL },
     { REGISTER_TEST_CASE(atcacert_get_tbs_digest, bad_params),                  NULL },
+    { REGISTER_TEST_CASE(atcacert_get_tbs_digest, batch),                       NULL },
     /* Array Termination element*/
     { (fp_test_case)NULL, NULL },
 };
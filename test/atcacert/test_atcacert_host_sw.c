@@ -29,6 +29,7 @@
 #if ATCA_HOSTLIB_EN
 #include "atcacert/atcacert_host_sw.h"
 #include "atca_basic.h"
+#include "test_cert_def_1_signer.h"
 #include <string.h>
 
 TEST_GROUP(atcacert_host_sw);
@@ -149,8 +150,178 @@ TEST(atcacert_host_sw, test_atcacert_gen_challenge_sw_success)
     TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
 }
 #endif /* ATCAC_RANDOM_EN */
+
+#if ATCAC_VERIFY_EN && ATCACERT_COMPCERT_EN
+TEST_GROUP(atcacert_verifier);
+
+/* Key that signed the TBS of the g_test_cert_def_1_signer template */
+static const uint8_t g_verifier_ca_public_key[ATCA_ECCP256_PUBKEY_SIZE] = {
+    0x80, 0x95, 0xD2, 0xC9, 0x1B, 0x42, 0x26, 0x8D, 0xDD, 0x3A, 0xF2, 0xD5, 0x72, 0x97, 0x24, 0x14,
+    0x74, 0xFE, 0x3A, 0xFA, 0xFD, 0xC8, 0x0A, 0x24, 0x0D, 0x75, 0xDD, 0xFF, 0x41, 0xAB, 0x27, 0x8D,
+    0x55, 0x60, 0xB7, 0x6F, 0xBB, 0xFF, 0xAC, 0x50, 0xBC, 0xB6, 0xF0, 0x9F, 0x15, 0x68, 0x9C, 0x53,
+    0x2E, 0xF9, 0x1A, 0xEA, 0x83, 0x6D, 0x94, 0x52, 0xA2, 0x8E, 0xB2, 0x3E, 0x6E, 0x88, 0x95, 0x49
+};
+
+/* Signature of the TBS of the g_test_cert_def_1_signer template */
+static const uint8_t g_verifier_signature[ATCA_ECCP256_SIG_SIZE] = {
+    0x84, 0x90, 0xA4, 0xC1, 0x9C, 0xB4, 0x31, 0x2F, 0x3A, 0x0C, 0x62, 0x9B, 0xCA, 0x09, 0x22, 0xC1,
+    0xD4, 0x8F, 0x91, 0x17, 0x0B, 0xD2, 0x2E, 0x31, 0xC3, 0x6D, 0xB4, 0x6C, 0x21, 0xD1, 0xC4, 0xE8,
+    0xD8, 0x99, 0xA3, 0x20, 0x26, 0x7B, 0x4E, 0xBE, 0x2E, 0xCF, 0x15, 0xF3, 0xA5, 0x88, 0x94, 0xCB,
+    0x0D, 0xAC, 0x6C, 0x9E, 0x49, 0x2F, 0xBA, 0x61, 0x75, 0x9B, 0x13, 0x00, 0x0A, 0x59, 0x98, 0x55
+};
+
+TEST_SETUP(atcacert_verifier)
+{
+}
+
+TEST_TEAR_DOWN(atcacert_verifier)
+{
+}
+
+TEST(atcacert_verifier, verify)
+{
+    ATCA_STATUS status;
+    atcacert_verifier_t verifier;
+    atcacert_def_t cert_def;
+    uint8_t certs[3][1024];
+    const uint8_t* cert_ptrs[3];
+    size_t cert_sizes[3];
+    ATCA_STATUS results[3];
+    size_t i;
+    cal_buffer ca_pubkey_buf = CAL_BUF_INIT(sizeof(g_verifier_ca_public_key), (uint8_t*)g_verifier_ca_public_key);
+    cal_buffer sig_buf = CAL_BUF_INIT(sizeof(g_verifier_signature), (uint8_t*)g_verifier_signature);
+
+    (void)memcpy(&cert_def, &g_test_cert_def_1_signer, sizeof(cert_def));
+    TEST_ASSERT(cert_def.cert_template_size <= sizeof(certs[0]));
+
+    for (i = 0; i < 3u; i++)
+    {
+        (void)memcpy(certs[i], cert_def.cert_template, cert_def.cert_template_size);
+        cert_sizes[i] = cert_def.cert_template_size;
+        status = atcacert_set_signature(&cert_def, certs[i], &cert_sizes[i], sizeof(certs[i]), &sig_buf);
+        TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, status);
+        cert_ptrs[i] = certs[i];
+    }
+
+    // The second certificate has been tampered with
+    certs[1][cert_def.tbs_cert_loc.offset + cert_def.tbs_cert_loc.count - 1u] ^= 0x01u;
+
+    status = atcacert_verifier_init(&verifier, &ca_pubkey_buf);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, status);
+
+    // The imported key is reused for every verify
+    status = atcacert_verifier_verify(&verifier, &cert_def, certs[0], cert_sizes[0]);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, status);
+    status = atcacert_verifier_verify(&verifier, &cert_def, certs[1], cert_sizes[1]);
+    TEST_ASSERT_NOT_EQUAL(ATCACERT_E_SUCCESS, status);
+    status = atcacert_verifier_verify(&verifier, &cert_def, certs[2], cert_sizes[2]);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, status);
+
+    status = atcacert_verifier_verify_batch(&verifier, &cert_def, cert_ptrs, cert_sizes, 3u, results);
+    TEST_ASSERT_NOT_EQUAL(ATCACERT_E_SUCCESS, status);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, results[0]);
+    TEST_ASSERT_NOT_EQUAL(ATCACERT_E_SUCCESS, results[1]);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, results[2]);
+
+    status = atcacert_verifier_free(&verifier);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, status);
+
+    // One shot verification gives the same answers
+    status = atcacert_verify_cert_sw(&cert_def, certs[0], cert_sizes[0], &ca_pubkey_buf);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, status);
+    status = atcacert_verify_cert_sw(&cert_def, certs[1], cert_sizes[1], &ca_pubkey_buf);
+    TEST_ASSERT_NOT_EQUAL(ATCACERT_E_SUCCESS, status);
+}
+
+TEST(atcacert_verifier, verify_cert_sw_batch)
+{
+    ATCA_STATUS status;
+    atcacert_def_t cert_def;
+    uint8_t certs[12][1024];
+    const uint8_t* cert_ptrs[12];
+    size_t cert_sizes[12];
+    ATCA_STATUS results[12];
+    size_t i;
+    cal_buffer ca_pubkey_buf = CAL_BUF_INIT(sizeof(g_verifier_ca_public_key), (uint8_t*)g_verifier_ca_public_key);
+    cal_buffer sig_buf = CAL_BUF_INIT(sizeof(g_verifier_signature), (uint8_t*)g_verifier_signature);
+
+    (void)memcpy(&cert_def, &g_test_cert_def_1_signer, sizeof(cert_def));
+    TEST_ASSERT(cert_def.cert_template_size <= sizeof(certs[0]));
+
+    // More certificates than a digest batch
+    for (i = 0; i < 12u; i++)
+    {
+        (void)memcpy(certs[i], cert_def.cert_template, cert_def.cert_template_size);
+        cert_sizes[i] = cert_def.cert_template_size;
+        status = atcacert_set_signature(&cert_def, certs[i], &cert_sizes[i], sizeof(certs[i]), &sig_buf);
+        TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, status);
+        cert_ptrs[i] = certs[i];
+    }
+
+    status = atcacert_verify_cert_sw_batch(&cert_def, cert_ptrs, cert_sizes, 12u, &ca_pubkey_buf, results);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, status);
+    for (i = 0; i < 12u; i++)
+    {
+        TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, results[i]);
+    }
+
+    // A tampered and a truncated certificate only fail themselves
+    certs[9][cert_def.tbs_cert_loc.offset + cert_def.tbs_cert_loc.count - 1u] ^= 0x01u;
+    cert_sizes[4] = cert_def.tbs_cert_loc.offset;
+
+    status = atcacert_verify_cert_sw_batch(&cert_def, cert_ptrs, cert_sizes, 12u, &ca_pubkey_buf, results);
+    TEST_ASSERT_NOT_EQUAL(ATCACERT_E_SUCCESS, status);
+    for (i = 0; i < 12u; i++)
+    {
+        if ((4u == i) || (9u == i))
+        {
+            TEST_ASSERT_NOT_EQUAL(ATCACERT_E_SUCCESS, results[i]);
+        }
+        else
+        {
+            TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, results[i]);
+        }
+    }
+}
+
+TEST(atcacert_verifier, bad_params)
+{
+    ATCA_STATUS status;
+    atcacert_verifier_t verifier;
+    uint8_t ca_public_key[ATCA_ECCP256_PUBKEY_SIZE] = { 0 };
+    cal_buffer ca_pubkey_buf = CAL_BUF_INIT(sizeof(ca_public_key) - 1u, ca_public_key);
+
+    status = atcacert_verifier_init(NULL, &ca_pubkey_buf);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, status);
+
+    status = atcacert_verifier_init(&verifier, NULL);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, status);
+
+    // Not a supported public key size
+    status = atcacert_verifier_init(&verifier, &ca_pubkey_buf);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, status);
+
+    status = atcacert_verifier_verify(NULL, &g_test_cert_def_1_signer, g_test_cert_def_1_signer.cert_template,
+                                      g_test_cert_def_1_signer.cert_template_size);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, status);
+
+    status = atcacert_verifier_free(NULL);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, status);
+}
+#endif /* ATCAC_VERIFY_EN && ATCACERT_COMPCERT_EN */
 #endif /* ATCA_HOSTLIB_EN */
 
+t_test_case_info atcacert_verifier_tests[] =
+{
+#if ATCA_HOSTLIB_EN && ATCAC_VERIFY_EN && ATCACERT_COMPCERT_EN
+    { REGISTER_TEST_CASE(atcacert_verifier, verify),               NULL },
+    { REGISTER_TEST_CASE(atcacert_verifier, verify_cert_sw_batch), NULL },
+    { REGISTER_TEST_CASE(atcacert_verifier, bad_params),           NULL },
+#endif
+    /* Array Termination element*/
+    { (fp_test_case)NULL, NULL },
+};
+
 t_test_case_info atcacert_host_sw_tests[] =
 {
 #if ATCA_HOSTLIB_EN
@@ -66,6 +66,11 @@
 /* JWT Support */
 #include "jwt/test_jwt.h"
 
+#ifdef ATCA_PKCS11
+/* PKCS11 library locking */
+#include "pkcs11/test_pkcs11.h"
+#endif
+
 static int help(int argc, char* argv[]);
 
 #if defined(_WIN32) || defined(__linux__) || defined(__APPLE__)
@@ -149,6 +154,9 @@ static t_menu_info mas_menu_info[] =
 #if defined(ATCA_JWT_EN)
     { "jwt",        "Run JWT support tests",                        run_jwt_tests                       },
 #endif
+#ifdef ATCA_PKCS11
+    { "pkcs11",     "Run PKCS11 library locking tests",             pkcs11_tests                        },
+#endif
 #if ATCA_CA_SUPPORT
     { "calib",      "Run calib api tests",                          run_calib_tests                      },
 #endif
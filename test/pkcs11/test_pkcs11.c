@@ -0,0 +1,180 @@
+/**
+ * \file
+ * \brief Tests for the PKCS11 library locking
+ *
+ * \copyright (c) 2015-2024 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+
+#include "atca_test.h"
+#include "test_pkcs11.h"
+#include "pkcs11/pkcs11_init.h"
+#include "pkcs11/pkcs11_slot.h"
+
+/* How long a thread gets to reach a point the test is waiting for */
+#define TEST_PKCS11_WAIT_MS     (1000u)
+
+/* Library context with just enough state for the device locks */
+static pkcs11_lib_ctx test_pkcs11_ctx;
+static pkcs11_slot_ctx test_pkcs11_slots[2];
+
+/** \brief A thread that locks the device of a slot until told to let go */
+typedef struct
+{
+    pkcs11_slot_ctx_ptr slot;
+    volatile bool       locked;
+    volatile bool       release;
+    volatile CK_RV      rv;
+} test_pkcs11_holder_t;
+
+static void test_pkcs11_hold_device(void* arg)
+{
+    test_pkcs11_holder_t* holder = (test_pkcs11_holder_t*)arg;
+
+    if (CKR_OK == (holder->rv = pkcs11_lock_device(&test_pkcs11_ctx, holder->slot)))
+    {
+        holder->locked = true;
+        while (!holder->release)
+        {
+            hal_delay_ms(1);
+        }
+        holder->rv = pkcs11_unlock_device(&test_pkcs11_ctx, holder->slot);
+    }
+}
+
+/* Wait for a flag to be set by another thread */
+static bool test_pkcs11_wait_for(volatile bool* flag, uint32_t timeout_ms)
+{
+    while (!*flag && (0u < timeout_ms))
+    {
+        hal_delay_ms(1);
+        timeout_ms--;
+    }
+    return *flag;
+}
+
+TEST_GROUP(pkcs11);
+
+TEST_SETUP(pkcs11)
+{
+    CK_ULONG i;
+
+    (void)memset(&test_pkcs11_ctx, 0, sizeof(test_pkcs11_ctx));
+    (void)memset(test_pkcs11_slots, 0, sizeof(test_pkcs11_slots));
+
+    for (i = 0; i < (sizeof(test_pkcs11_slots) / sizeof(test_pkcs11_slots[0])); i++)
+    {
+        test_pkcs11_slots[i].slot_id = i;
+    }
+
+    TEST_ASSERT_EQUAL(CKR_OK, pkcs11_os_alloc_shared_ctx((void**)&test_pkcs11_ctx.dev_state, sizeof(pkcs11_dev_state)));
+    test_pkcs11_ctx.dev_lock_enabled = TRUE;
+}
+
+TEST_TEAR_DOWN(pkcs11)
+{
+    if (NULL != test_pkcs11_ctx.dev_state)
+    {
+        (void)pkcs11_os_free_shared_ctx(test_pkcs11_ctx.dev_state, sizeof(pkcs11_dev_state));
+        test_pkcs11_ctx.dev_state = NULL;
+    }
+}
+
+TEST(pkcs11, lock_device_same_slot)
+{
+    test_pkcs11_holder_t first = { &test_pkcs11_slots[0], false, false, CKR_OK };
+    test_pkcs11_holder_t second = { &test_pkcs11_slots[0], false, false, CKR_OK };
+    void* first_thread = NULL;
+    void* second_thread = NULL;
+
+    TEST_ASSERT_SUCCESS(hal_create_thread(&first_thread, test_pkcs11_hold_device, &first));
+    TEST_ASSERT_TRUE(test_pkcs11_wait_for(&first.locked, TEST_PKCS11_WAIT_MS));
+
+    /* The device of a slot has one owner at a time */
+    TEST_ASSERT_SUCCESS(hal_create_thread(&second_thread, test_pkcs11_hold_device, &second));
+    hal_delay_ms(50);
+    TEST_ASSERT_FALSE(second.locked);
+
+    first.release = true;
+    second.release = true;
+    TEST_ASSERT_TRUE(test_pkcs11_wait_for(&second.locked, TEST_PKCS11_WAIT_MS));
+
+    TEST_ASSERT_SUCCESS(hal_join_thread(first_thread));
+    TEST_ASSERT_SUCCESS(hal_join_thread(second_thread));
+    TEST_ASSERT_EQUAL(CKR_OK, first.rv);
+    TEST_ASSERT_EQUAL(CKR_OK, second.rv);
+}
+
+#if PKCS11_MAX_SLOTS_ALLOWED > 1
+TEST(pkcs11, lock_device_two_slots)
+{
+    test_pkcs11_holder_t first = { &test_pkcs11_slots[0], false, false, CKR_OK };
+    test_pkcs11_holder_t second = { &test_pkcs11_slots[1], false, false, CKR_OK };
+    void* first_thread = NULL;
+    void* second_thread = NULL;
+
+    TEST_ASSERT_SUCCESS(hal_create_thread(&first_thread, test_pkcs11_hold_device, &first));
+    TEST_ASSERT_TRUE(test_pkcs11_wait_for(&first.locked, TEST_PKCS11_WAIT_MS));
+
+    /* Holding the device of one slot doesn't hold up another slot */
+    TEST_ASSERT_SUCCESS(hal_create_thread(&second_thread, test_pkcs11_hold_device, &second));
+    TEST_ASSERT_TRUE(test_pkcs11_wait_for(&second.locked, TEST_PKCS11_WAIT_MS));
+    TEST_ASSERT_FALSE(first.release);
+
+    second.release = true;
+    TEST_ASSERT_SUCCESS(hal_join_thread(second_thread));
+    first.release = true;
+    TEST_ASSERT_SUCCESS(hal_join_thread(first_thread));
+    TEST_ASSERT_EQUAL(CKR_OK, first.rv);
+    TEST_ASSERT_EQUAL(CKR_OK, second.rv);
+}
+#endif
+
+// *INDENT-OFF* - Preserve formatting
+t_test_case_info pkcs11_lock_tests[] =
+{
+    { REGISTER_TEST_CASE(pkcs11, lock_device_same_slot),                   NULL },
+#if PKCS11_MAX_SLOTS_ALLOWED > 1
+    { REGISTER_TEST_CASE(pkcs11, lock_device_two_slots),                   NULL },
+#endif
+    /* Array Termination element*/
+    { (fp_test_case)NULL, NULL },
+};
+// *INDENT-ON*
+
+static t_test_case_info* pkcs11_test_list[] =
+{
+    pkcs11_lock_tests,
+    pkcs11_find_tests,
+    /* Array Termination element*/
+    (t_test_case_info*)NULL,
+};
+
+static void run_pkcs11_tests(void)
+{
+    RunAllTests(pkcs11_test_list);
+}
+
+int pkcs11_tests(int argc, char* argv[])
+{
+    return run_test(argc, argv, run_pkcs11_tests);
+}
@@ -0,0 +1,241 @@
+/**
+ * \file
+ * \brief Tests for the PKCS11 object search
+ *
+ * \copyright (c) 2015-2024 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+
+#include "atca_test.h"
+#include "test_pkcs11.h"
+#include "pkcs11/pkcs11_init.h"
+#include "pkcs11/pkcs11_slot.h"
+#include "pkcs11/pkcs11_session.h"
+#include "pkcs11/pkcs11_object.h"
+#include "pkcs11/pkcs11_find.h"
+
+/* Objects in the table while the search tests run */
+#define TEST_PKCS11_FIND_OBJECTS    (5u)
+
+static pkcs11_lib_ctx test_pkcs11_find_saved_ctx;
+static pkcs11_slot_ctx test_pkcs11_find_slot;
+static CK_SESSION_HANDLE test_pkcs11_find_session;
+static pkcs11_object_ptr test_pkcs11_find_objects[TEST_PKCS11_FIND_OBJECTS];
+
+/** \brief Class getter that isn't the cached field getter so the search has to call it */
+static CK_RV test_pkcs11_find_get_class(CK_VOID_PTR pObject, CK_ATTRIBUTE_PTR pAttribute, pkcs11_session_ctx_ptr pSession)
+{
+    return pkcs11_object_get_class(pObject, pAttribute, pSession);
+}
+
+static const pkcs11_attrib_model test_pkcs11_find_attributes[] =
+{
+    { CKA_CLASS,    pkcs11_object_get_class },
+    { CKA_KEY_TYPE, pkcs11_object_get_type  },
+    { CKA_LABEL,    pkcs11_object_get_name  },
+};
+
+static const pkcs11_attrib_model test_pkcs11_find_getter_attributes[] =
+{
+    { CKA_CLASS,    test_pkcs11_find_get_class },
+    { CKA_LABEL,    pkcs11_object_get_name     },
+};
+
+/** \brief Add an object to the table for the test slot */
+static pkcs11_object_ptr test_pkcs11_find_add(size_t index, CK_OBJECT_CLASS class_id, const char* label,
+                                              const pkcs11_attrib_model* attributes, CK_ULONG count)
+{
+    pkcs11_object_ptr pObject = NULL;
+
+    TEST_ASSERT_EQUAL(CKR_OK, pkcs11_object_alloc(test_pkcs11_find_slot.slot_id, &pObject));
+    pObject->class_id = class_id;
+    pObject->class_type = CKK_EC;
+    pObject->attributes = attributes;
+    pObject->count = count;
+    (void)strncpy((char*)pObject->name, label, PKCS11_MAX_LABEL_SIZE);
+
+    test_pkcs11_find_objects[index] = pObject;
+    return pObject;
+}
+
+static CK_OBJECT_HANDLE test_pkcs11_find_handle(size_t index)
+{
+    CK_OBJECT_HANDLE hObject = 0;
+
+    TEST_ASSERT_EQUAL(CKR_OK, pkcs11_object_get_handle(test_pkcs11_find_objects[index], &hObject));
+    return hObject;
+}
+
+/** \brief Run a complete search and return the number of handles found */
+static CK_ULONG test_pkcs11_find_run(CK_ATTRIBUTE_PTR pTemplate, CK_ULONG ulCount, CK_OBJECT_HANDLE_PTR phObject, CK_ULONG ulMax)
+{
+    CK_ULONG found = 0;
+
+    TEST_ASSERT_EQUAL(CKR_OK, pkcs11_find_init(test_pkcs11_find_session, pTemplate, ulCount));
+    TEST_ASSERT_EQUAL(CKR_OK, pkcs11_find_continue(test_pkcs11_find_session, phObject, ulMax, &found));
+    TEST_ASSERT_EQUAL(CKR_OK, pkcs11_find_finish(test_pkcs11_find_session));
+
+    return found;
+}
+
+TEST_GROUP(pkcs11_find);
+
+TEST_SETUP(pkcs11_find)
+{
+    pkcs11_lib_ctx_ptr pLibCtx = pkcs11_get_context();
+
+    /* Borrow the library context with a single ready slot and no locks */
+    (void)memcpy(&test_pkcs11_find_saved_ctx, pLibCtx, sizeof(test_pkcs11_find_saved_ctx));
+    (void)memset(pLibCtx, 0, sizeof(*pLibCtx));
+    (void)memset(&test_pkcs11_find_slot, 0, sizeof(test_pkcs11_find_slot));
+    (void)memset(test_pkcs11_find_objects, 0, sizeof(test_pkcs11_find_objects));
+
+    test_pkcs11_find_slot.slot_state = SLOT_STATE_READY;
+    pLibCtx->slots = &test_pkcs11_find_slot;
+    pLibCtx->slot_cnt = 1;
+    pLibCtx->initialized = TRUE;
+
+    TEST_ASSERT_EQUAL(CKR_OK, pkcs11_session_open(test_pkcs11_find_slot.slot_id, CKF_SERIAL_SESSION, NULL, NULL,
+                                                  &test_pkcs11_find_session));
+
+    (void)test_pkcs11_find_add(0, CKO_PRIVATE_KEY, "alpha", test_pkcs11_find_attributes, 3);
+    (void)test_pkcs11_find_add(1, CKO_CERTIFICATE, "alpha", test_pkcs11_find_attributes, 3);
+    (void)test_pkcs11_find_add(2, CKO_PRIVATE_KEY, "beta", test_pkcs11_find_attributes, 3);
+    (void)test_pkcs11_find_add(3, CKO_SECRET_KEY, "gamma", test_pkcs11_find_getter_attributes, 2);
+    (void)test_pkcs11_find_add(4, CKO_MECHANISM, "mechanism", test_pkcs11_find_attributes, 3);
+}
+
+TEST_TEAR_DOWN(pkcs11_find)
+{
+    size_t i;
+
+    for (i = 0; i < TEST_PKCS11_FIND_OBJECTS; i++)
+    {
+        if (NULL != test_pkcs11_find_objects[i])
+        {
+            (void)pkcs11_object_free(test_pkcs11_find_objects[i]);
+            test_pkcs11_find_objects[i] = NULL;
+        }
+    }
+
+    (void)pkcs11_session_close(test_pkcs11_find_session);
+    (void)memcpy(pkcs11_get_context(), &test_pkcs11_find_saved_ctx, sizeof(test_pkcs11_find_saved_ctx));
+}
+
+TEST(pkcs11_find, label_and_class)
+{
+    CK_OBJECT_CLASS class_id = CKO_PRIVATE_KEY;
+    CK_ATTRIBUTE search[] =
+    {
+        { CKA_LABEL, "alpha",   5                        },
+        { CKA_CLASS, &class_id, (CK_ULONG)sizeof(class_id) },
+    };
+    CK_OBJECT_HANDLE handles[TEST_PKCS11_FIND_OBJECTS];
+
+    TEST_ASSERT_EQUAL(1, test_pkcs11_find_run(search, 2, handles, TEST_PKCS11_FIND_OBJECTS));
+    TEST_ASSERT_EQUAL(test_pkcs11_find_handle(0), handles[0]);
+}
+
+TEST(pkcs11_find, conflicting_values)
+{
+    CK_OBJECT_CLASS key_class = CKO_PRIVATE_KEY;
+    CK_OBJECT_CLASS cert_class = CKO_CERTIFICATE;
+    CK_ATTRIBUTE search[] =
+    {
+        { CKA_CLASS, &key_class,  (CK_ULONG)sizeof(key_class)  },
+        { CKA_CLASS, &cert_class, (CK_ULONG)sizeof(cert_class) },
+    };
+    CK_OBJECT_HANDLE handles[TEST_PKCS11_FIND_OBJECTS];
+
+    /* One attribute asked for with two different values matches nothing */
+    TEST_ASSERT_EQUAL(0, test_pkcs11_find_run(search, 2, handles, TEST_PKCS11_FIND_OBJECTS));
+}
+
+TEST(pkcs11_find, empty_template)
+{
+    CK_OBJECT_HANDLE handles[TEST_PKCS11_FIND_OBJECTS];
+    CK_ULONG found;
+    CK_ULONG i;
+
+    /* Everything but mechanisms and hardware features */
+    found = test_pkcs11_find_run(NULL, 0, handles, TEST_PKCS11_FIND_OBJECTS);
+    TEST_ASSERT_EQUAL(4, found);
+
+    for (i = 0; i < found; i++)
+    {
+        TEST_ASSERT_NOT_EQUAL(test_pkcs11_find_handle(4), handles[i]);
+    }
+}
+
+TEST(pkcs11_find, getter_fallback)
+{
+    CK_OBJECT_CLASS class_id = CKO_SECRET_KEY;
+    CK_ATTRIBUTE search[] =
+    {
+        { CKA_CLASS, &class_id, (CK_ULONG)sizeof(class_id) },
+    };
+    CK_OBJECT_HANDLE handles[TEST_PKCS11_FIND_OBJECTS];
+
+    /* The object doesn't serve its class from the cached field so it's read into the search buffer */
+    TEST_ASSERT_EQUAL(1, test_pkcs11_find_run(search, 1, handles, TEST_PKCS11_FIND_OBJECTS));
+    TEST_ASSERT_EQUAL(test_pkcs11_find_handle(3), handles[0]);
+}
+
+TEST(pkcs11_find, destroyed_before_continue)
+{
+    CK_OBJECT_CLASS class_id = CKO_PRIVATE_KEY;
+    CK_ATTRIBUTE search[] =
+    {
+        { CKA_CLASS, &class_id, (CK_ULONG)sizeof(class_id) },
+    };
+    CK_OBJECT_HANDLE handles[TEST_PKCS11_FIND_OBJECTS];
+    CK_OBJECT_HANDLE kept = test_pkcs11_find_handle(0);
+    CK_ULONG found = 0;
+
+    TEST_ASSERT_EQUAL(CKR_OK, pkcs11_find_init(test_pkcs11_find_session, search, 1));
+
+    /* Both keys matched when the search started - drop one before the handles are read */
+    (void)pkcs11_object_free(test_pkcs11_find_objects[2]);
+    test_pkcs11_find_objects[2] = NULL;
+
+    TEST_ASSERT_EQUAL(CKR_OK, pkcs11_find_continue(test_pkcs11_find_session, handles, TEST_PKCS11_FIND_OBJECTS, &found));
+    TEST_ASSERT_EQUAL(1, found);
+    TEST_ASSERT_EQUAL(kept, handles[0]);
+
+    /* Nothing is left for a second call */
+    TEST_ASSERT_EQUAL(CKR_OK, pkcs11_find_continue(test_pkcs11_find_session, handles, TEST_PKCS11_FIND_OBJECTS, &found));
+    TEST_ASSERT_EQUAL(0, found);
+    TEST_ASSERT_EQUAL(CKR_OK, pkcs11_find_finish(test_pkcs11_find_session));
+}
+
+// *INDENT-OFF* - Preserve formatting
+t_test_case_info pkcs11_find_tests[] =
+{
+    { REGISTER_TEST_CASE(pkcs11_find, label_and_class),                    NULL },
+    { REGISTER_TEST_CASE(pkcs11_find, conflicting_values),                 NULL },
+    { REGISTER_TEST_CASE(pkcs11_find, empty_template),                     NULL },
+    { REGISTER_TEST_CASE(pkcs11_find, getter_fallback),                    NULL },
+    { REGISTER_TEST_CASE(pkcs11_find, destroyed_before_continue),          NULL },
+    /* Array Termination element*/
+    { (fp_test_case)NULL, NULL },
+};
+// *INDENT-ON*